@@ -3,15 +3,21 @@
 in vec3 vPos;
 in vec3 vNormal;
 in vec2 vUV1;
+in vec3 vMorphPos1;
+in vec3 vMorphPos2;
 
 out vec4 fColor;
 out vec2 fUV1;
 
 // Built-in uniforms
-uniform mat4 gViewMatrix;
-uniform mat4 gProjMatrix;
-uniform mat4 gWorldToProjMatrix;
+layout(std140) uniform Camera
+{
+    mat4 gViewMatrix;
+    mat4 gProjMatrix;
+    mat4 gWorldToProjMatrix;
+};
 uniform mat4 gObjectToWorldMatrix;
+uniform float gMorphWeight = -1.0f;
 
 // User-defined uniforms
 uniform vec4 uColor = vec4(1.0f, 1.0f, 1.0f, 1.0f);
@@ -24,6 +30,13 @@ void main()
     // Pass through the UV attribute.
     fUV1 = vUV1;
     
+    // When playing a vertex animation on the GPU, blend between the two keyframe positions.
+    vec3 position = vPos;
+    if(gMorphWeight >= 0.0f)
+    {
+        position = mix(vMorphPos1, vMorphPos2, gMorphWeight);
+    }
+    
     // Transform position obj->world->view->proj
-    gl_Position = gWorldToProjMatrix * gObjectToWorldMatrix * vec4(vPos, 1.0f);
+    gl_Position = gWorldToProjMatrix * gObjectToWorldMatrix * vec4(position, 1.0f);
 }
@@ -0,0 +1,262 @@
+//
+// ActionIndex.cpp
+//
+// Clark Kromenaker
+//
+#include "ActionIndex.h"
+
+#include <climits>
+#include <iostream>
+
+#include "GMath.h"
+#include "NVC.h"
+
+/*static*/ std::vector<ActionIndex::IndexedAction> ActionIndex::sEmptyIndexedActions;
+
+void ActionIndex::AddActionSet(const std::vector<Action*>& actions, const std::function<VerbTypes(const std::string&)>& getVerbTypes)
+{
+	int actionSetIndex = mActionSetCount;
+	++mActionSetCount;
+	for(auto& action : actions)
+	{
+		int nounId = GetNounId(action->noun);
+		if(nounId < 0)
+		{
+			nounId = static_cast<int>(mNouns.size());
+			mNounIds[action->noun] = nounId;
+			mNouns.push_back(action->noun);
+			mNounActions.emplace_back();
+		}
+		
+		int verbId = GetVerbId(action->verb);
+		if(verbId < 0)
+		{
+			verbId = static_cast<int>(mVerbs.size());
+			mVerbIds[action->verb] = verbId;
+			mVerbs.push_back(action->verb);
+			mVerbTypes.push_back(getVerbTypes(action->verb));
+		}
+		
+		IndexedAction indexedAction;
+		indexedAction.action = action;
+		indexedAction.verbId = verbId;
+		indexedAction.actionSetIndex = actionSetIndex;
+		mNounActions[nounId].push_back(indexedAction);
+		mNounVerbActions[GetNounVerbKey(nounId, verbId)].push_back(indexedAction);
+	}
+	
+	mAnyObjectNounId = GetNounId("ANY_OBJECT");
+	mAnyInvItemVerbId = GetVerbId("ANY_INV_ITEM");
+}
+
+void ActionIndex::Clear()
+{
+	mNouns.clear();
+	mNounIds.clear();
+	mVerbs.clear();
+	mVerbIds.clear();
+	mVerbTypes.clear();
+	
+	mNounActions.clear();
+	mNounVerbActions.clear();
+	mAnyObjectNounId = -1;
+	mAnyInvItemVerbId = -1;
+	mActionSetCount = 0;
+}
+
+int ActionIndex::GetNounId(const std::string& noun) const
+{
+	auto it = mNounIds.find(noun);
+	return it != mNounIds.end() ? it->second : -1;
+}
+
+int ActionIndex::GetVerbId(const std::string& verb) const
+{
+	auto it = mVerbIds.find(verb);
+	return it != mVerbIds.end() ? it->second : -1;
+}
+
+std::string& ActionIndex::GetNoun(int nounId)
+{
+	return mNouns[Math::Clamp(nounId, 0, (int)mNouns.size() - 1)];
+}
+
+std::string& ActionIndex::GetVerb(int verbId)
+{
+	return mVerbs[Math::Clamp(verbId, 0, (int)mVerbs.size() - 1)];
+}
+
+bool ActionIndex::IsVerbType(int verbId, VerbType verbType) const
+{
+	const VerbTypes& verbTypes = mVerbTypes[verbId];
+	switch(verbType)
+	{
+	case VerbType::Normal:
+		return verbTypes.isVerb;
+	case VerbType::Inventory:
+		return verbTypes.isInventoryItem;
+	case VerbType::Topic:
+		return verbTypes.isTopic;
+	}
+	return false;
+}
+
+const std::vector<ActionIndex::IndexedAction>& ActionIndex::GetActions(int nounId, int verbId) const
+{
+	if(nounId < 0 || verbId < 0) { return sEmptyIndexedActions; }
+	auto it = mNounVerbActions.find(GetNounVerbKey(nounId, verbId));
+	return it != mNounVerbActions.end() ? it->second : sEmptyIndexedActions;
+}
+
+const Action* ActionIndex::GetAction(int nounId, int verbId, bool verbIsInventoryItem, const CaseFunc& isCaseMet) const
+{
+	// For any noun/verb pair, there is only ONE possible action that can be performed at any given time.
+	// Keep track of the candidate as we check from most general/broad to most specific.
+	// The most specific valid action will be our candidate.
+	const Action* candidate = nullptr;
+	
+	// If the verb is an inventory item, handle ANY_OBJECT/ANY_INV_ITEM wildcards for noun/verb.
+	if(verbIsInventoryItem)
+	{
+		FindCandidateAction(mAnyObjectNounId, mAnyInvItemVerbId, isCaseMet, candidate);
+	}
+	
+	// Find any matches for "ANY_OBJECT" and this verb next.
+	FindCandidateAction(mAnyObjectNounId, verbId, isCaseMet, candidate);
+	
+	// If the verb is an inventory item, handle noun/ANY_INV_ITEM combo.
+	if(verbIsInventoryItem)
+	{
+		FindCandidateAction(nounId, mAnyInvItemVerbId, isCaseMet, candidate);
+	}
+	
+	// Finally, check for any exact noun/verb matches.
+	FindCandidateAction(nounId, verbId, isCaseMet, candidate);
+	return candidate;
+}
+
+void ActionIndex::GetActions(int nounId, VerbType verbType, const CaseFunc& isCaseMet, std::vector<const Action*>& actions) const
+{
+	// As we find actions for this noun, we don't want repeated "verbs".
+	// For example, if two actions exist for the verb "LOOK", we don't want two look actions on the action bar!
+	// So, keep one action per verb; a later action set's valid action replaces an earlier one.
+	mVerbActions.clear();
+	
+	// "ANY_OBJECT" is a wildcard. Any action with a noun of "ANY_OBJECT" can be valid for any noun passed in.
+	const std::vector<IndexedAction>& anyObjectActions = GetNounActions(mAnyObjectNounId);
+	const std::vector<IndexedAction>& nounActions = GetNounActions(nounId);
+	
+	// Go through action sets in order. Both lists are sorted by action set.
+	size_t anyObjectIndex = 0;
+	size_t nounIndex = 0;
+	while(anyObjectIndex < anyObjectActions.size() || nounIndex < nounActions.size())
+	{
+		int actionSetIndex = INT_MAX;
+		if(anyObjectIndex < anyObjectActions.size())
+		{
+			actionSetIndex = anyObjectActions[anyObjectIndex].actionSetIndex;
+		}
+		if(nounIndex < nounActions.size())
+		{
+			actionSetIndex = Math::Min(actionSetIndex, nounActions[nounIndex].actionSetIndex);
+		}
+		
+		// Wildcard actions are lowest-priority, so we do them first (they might be overwritten later).
+		// Ex: ANY_OBJECT, LOOK, CASE1 matches, but then CANDY, LOOK, CASE2 matches exactly - use the second one.
+		anyObjectIndex = AddViableActions(anyObjectActions, anyObjectIndex, actionSetIndex, verbType, isCaseMet);
+		nounIndex = AddViableActions(nounActions, nounIndex, actionSetIndex, verbType, isCaseMet);
+	}
+	
+	// Finally, fill in the chosen actions.
+	actions.clear();
+	for(auto& indexedAction : mVerbActions)
+	{
+		actions.push_back(indexedAction->action);
+	}
+}
+
+bool ActionIndex::HasTopics(int nounId, const CaseFunc& isCaseMet) const
+{
+	const std::vector<IndexedAction>* actionLists[] = { &GetNounActions(mAnyObjectNounId), &GetNounActions(nounId) };
+	for(auto& actions : actionLists)
+	{
+		for(auto& indexedAction : *actions)
+		{
+			if(indexedAction.verbId != mAnyInvItemVerbId && IsVerbType(indexedAction.verbId, VerbType::Topic) &&
+			   isCaseMet(indexedAction.action, VerbType::Topic))
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+/*static*/ uint64_t ActionIndex::GetNounVerbKey(int nounId, int verbId)
+{
+	return (static_cast<uint64_t>(static_cast<uint32_t>(nounId)) << 32) | static_cast<uint32_t>(verbId);
+}
+
+const std::vector<ActionIndex::IndexedAction>& ActionIndex::GetNounActions(int nounId) const
+{
+	if(nounId < 0 || static_cast<size_t>(nounId) >= mNounActions.size()) { return sEmptyIndexedActions; }
+	return mNounActions[nounId];
+}
+
+void ActionIndex::FindCandidateAction(int nounId, int verbId, const CaseFunc& isCaseMet, const Action*& candidate) const
+{
+	for(auto& indexedAction : GetActions(nounId, verbId))
+	{
+		const Action* action = indexedAction.action;
+		if(isCaseMet(action, VerbType::Normal))
+		{
+			std::cout << "Candidate action matches " << action->noun << "/" << action->verb << std::endl;
+			candidate = action;
+		}
+	}
+}
+
+size_t ActionIndex::AddViableActions(const std::vector<IndexedAction>& actions, size_t startIndex, int actionSetIndex, VerbType verbType, const CaseFunc& isCaseMet) const
+{
+	size_t index = startIndex;
+	for(; index < actions.size() && actions[index].actionSetIndex == actionSetIndex; ++index)
+	{
+		const IndexedAction& indexedAction = actions[index];
+		
+		// The "ANY_INV_ITEM" wildcard only matches if a specific verb was provided.
+		// GetActions doesn't let you specify a verb, so this never matches.
+		if(indexedAction.verbId == mAnyInvItemVerbId) { continue; }
+		
+		// The action's verb must be of the correct type for us to use it.
+		if(!IsVerbType(indexedAction.verbId, verbType)) { continue; }
+		
+		// Find the action already chosen for this verb, if any.
+		size_t verbIndex = 0;
+		for(; verbIndex < mVerbActions.size(); ++verbIndex)
+		{
+			if(mVerbActions[verbIndex]->verbId == indexedAction.verbId) { break; }
+		}
+		
+		// Within a single action set, we only want to use the first matching verb.
+		// Ex: if NOUN, VERB, CASE1 matches and is then followed by NOUN, VERB, CASE2 (which also matches), ignore the second one.
+		// If the chosen action is from this same part of the list, it's an earlier match from this action set.
+		std::less<const IndexedAction*> less;
+		bool verbUsed = verbIndex < mVerbActions.size() &&
+						!less(mVerbActions[verbIndex], &actions[startIndex]) && less(mVerbActions[verbIndex], &indexedAction);
+		if(verbUsed) { continue; }
+		
+		// If the action meets any case specified, we can use this action!
+		if(isCaseMet(indexedAction.action, verbType))
+		{
+			if(verbIndex < mVerbActions.size())
+			{
+				mVerbActions[verbIndex] = &indexedAction;
+			}
+			else
+			{
+				mVerbActions.push_back(&indexedAction);
+			}
+		}
+	}
+	return index;
+}
@@ -0,0 +1,113 @@
+//
+// ActionIndex.h
+//
+// Clark Kromenaker
+//
+// An index of all actions in active action sets, so action queries don't need to search each action set.
+//
+// Nouns and verbs are given int ids (ignoring case) as action sets are added.
+// These ids are also what case evaluation logic sees as n$ and v$.
+//
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "StringUtil.h"
+
+struct Action;
+
+enum class VerbType
+{
+	Normal,
+	Inventory,
+	Topic
+};
+
+class ActionIndex
+{
+public:
+	// Type of a verb. Verb types don't change, so they're only looked up when a verb is first added.
+	struct VerbTypes
+	{
+		bool isVerb = false;
+		bool isInventoryItem = false;
+		bool isTopic = false;
+	};
+	
+	struct IndexedAction
+	{
+		const Action* action = nullptr;
+		int verbId = 0;
+		
+		// Index of the action set the action is from. Lists of indexed actions are in action set order, then file order.
+		int actionSetIndex = 0;
+	};
+	
+	// Returns true if the case for an action is met, for a type of verb.
+	typedef std::function<bool(const Action*, VerbType)> CaseFunc;
+	
+	// Adds the actions from an action set. Actions in later action sets take priority over earlier ones.
+	void AddActionSet(const std::vector<Action*>& actions, const std::function<VerbTypes(const std::string&)>& getVerbTypes);
+	void Clear();
+	
+	// Ids are -1 for nouns/verbs not in any added action set.
+	int GetNounId(const std::string& noun) const;
+	int GetVerbId(const std::string& verb) const;
+	std::string& GetNoun(int nounId);
+	std::string& GetVerb(int verbId);
+	bool IsVerbType(int verbId, VerbType verbType) const;
+	
+	// All actions for a noun/verb pair, in action set order.
+	const std::vector<IndexedAction>& GetActions(int nounId, int verbId) const;
+	
+	// The action to use for a noun/verb pair: the most specific one, from the latest action set, whose case is met.
+	// ANY_OBJECT actions are used for any noun. ANY_INV_ITEM actions are used for any verb that's an inventory item.
+	const Action* GetAction(int nounId, int verbId, bool verbIsInventoryItem, const CaseFunc& isCaseMet) const;
+	
+	// Actions of a verb type whose cases are met for a noun (including ANY_OBJECT actions), with one action per verb.
+	// Fills in the given vector, so repeated queries can reuse its memory.
+	void GetActions(int nounId, VerbType verbType, const CaseFunc& isCaseMet, std::vector<const Action*>& actions) const;
+	
+	// Same as checking whether GetActions gives any topics, but can stop at the first one.
+	bool HasTopics(int nounId, const CaseFunc& isCaseMet) const;
+	
+private:
+	static std::vector<IndexedAction> sEmptyIndexedActions;
+	
+	// Nouns and verbs in added action sets, indexed by id.
+	std::vector<std::string> mNouns;
+	std::unordered_map<std::string, int, StringUtil::IgnoreCaseHash, StringUtil::IgnoreCaseEqual> mNounIds;
+	std::vector<std::string> mVerbs;
+	std::unordered_map<std::string, int, StringUtil::IgnoreCaseHash, StringUtil::IgnoreCaseEqual> mVerbIds;
+	
+	// Type of each verb, indexed by verb id.
+	std::vector<VerbTypes> mVerbTypes;
+	
+	// Actions for each noun, indexed by noun id.
+	std::vector<std::vector<IndexedAction>> mNounActions;
+	
+	// Actions for each noun/verb pair, keyed by both ids (see GetNounVerbKey).
+	std::unordered_map<uint64_t, std::vector<IndexedAction>> mNounVerbActions;
+	
+	// Ids of the wildcard noun/verb, or -1 if no added action set uses them.
+	int mAnyObjectNounId = -1;
+	int mAnyInvItemVerbId = -1;
+	
+	// Number of action sets added.
+	int mActionSetCount = 0;
+	
+	// For GetActions, the action chosen for each verb so far. Kept between queries to reuse its memory.
+	mutable std::vector<const IndexedAction*> mVerbActions;
+	
+	static uint64_t GetNounVerbKey(int nounId, int verbId);
+	const std::vector<IndexedAction>& GetNounActions(int nounId) const;
+	
+	// For GetAction: any action for this noun/verb pair with a met case becomes the candidate.
+	void FindCandidateAction(int nounId, int verbId, const CaseFunc& isCaseMet, const Action*& candidate) const;
+	
+	// For GetActions: adds usable actions from one action set, starting at an index in the list. Returns the index after that action set's actions.
+	size_t AddViableActions(const std::vector<IndexedAction>& actions, size_t startIndex, int actionSetIndex, VerbType verbType, const CaseFunc& isCaseMet) const;
+};
@@ -14,21 +14,31 @@
 #include "IniParser.h"
 #include "Scene.h"
 #include "Services.h"
+#include "SheepScript.h"
 #include "StringUtil.h"
 #include "Timeblock.h"
 
 TYPE_DEF_BASE(ActionManager);
 
+
 void ActionManager::Init()
 {
 	// Pre-populate the Sheep Command action.
 	mSheepCommandAction.noun = "SHEEP_COMMAND";
 	mSheepCommandAction.verb = "NONE";
+	mSheepCommandAction.nounSymbol = Symbol(mSheepCommandAction.noun);
+	mSheepCommandAction.verbSymbol = Symbol(mSheepCommandAction.verb);
 	mSheepCommandAction.caseLabel = "NONE";
 	
 	// Create action bar, which will be used to choose nouns/verbs by the player.
 	mActionBar = new ActionBar();
 	mActionBar->SetIsDestroyOnLoad(false);
+	
+	// Action queries check cases through this.
+	mIsCaseMet = [this](const Action* action, VerbType verbType) { return IsCaseMet(action, verbType); };
+	
+	// Cached case results must be thrown out when the game state they used changes.
+	Services::Get<GameProgress>()->SetChangeCallback(std::bind(&CaseResultCache::OnGameStateChanged, &mCaseResults, std::placeholders::_1));
 }
 
 void ActionManager::AddActionSet(const std::string& assetName)
@@ -43,26 +53,15 @@ void ActionManager::AddActionSet(const std::string& assetName)
 		auto caseLogic = actionSet->GetCases();
 		mCaseLogic.insert(caseLogic.begin(), caseLogic.end());
 		
-		// Iterate actions and add nouns/verbs to lists and maps.
-		// This allows us to convert a noun/verb to a unique integer-based ID, and back again.
-		// Doing this primarily to support n$ and v$ requirement in Sheep eval logic...
-		const std::vector<Action*> actions = actionSet->GetActions();
-		for(auto& action : actions)
-		{
-			auto nounIt = mNounToEnum.find(action->noun);
-			if(nounIt == mNounToEnum.end())
-			{
-				mNounToEnum[action->noun] = (int)mNouns.size();
-				mNouns.push_back(action->noun);
-			}
-			
-			auto verbIt = mVerbToEnum.find(action->verb);
-			if(verbIt == mVerbToEnum.end())
-			{
-				mVerbToEnum[action->verb] = (int)mVerbs.size();
-				mVerbs.push_back(action->verb);
-			}
-		}
+		// Add actions to the action index, which gives each noun/verb an id.
+		VerbManager* verbManager = Services::Get<VerbManager>();
+		mActionIndex.AddActionSet(actionSet->GetActions(), [verbManager](const std::string& verb) {
+			ActionIndex::VerbTypes verbTypes;
+			verbTypes.isVerb = verbManager->IsVerb(verb);
+			verbTypes.isInventoryItem = verbManager->IsInventoryItem(verb);
+			verbTypes.isTopic = verbManager->IsTopic(verb);
+			return verbTypes;
+		});
 	}
 }
 
@@ -94,24 +93,26 @@ void ActionManager::ClearActionSets()
 {
 	mActionSets.clear();
 	mCaseLogic.clear();
-	mNounToEnum.clear();
-	mNouns.clear();
-	mVerbToEnum.clear();
-	mVerbs.clear();
+	mActionIndex.Clear();
+	
+	// Noun/verb ids will be reused for other nouns/verbs, and scene state (location, ego) is about to change.
+	mCaseResults.Clear();
 }
 
 bool ActionManager::ExecuteAction(const std::string& noun, const std::string& verb)
 {
-	// Iterate action sets and find a valid candidate for this noun/verb combo.
+	// Find a valid candidate for this noun/verb combo. Only the first action for the combo in each action set is considered.
 	// Action sets are loaded such that the LAST valid candidate we find is the one we should use.
 	const Action* candidate = nullptr;
-	for(auto& actionSet : mActionSets)
+	int lastActionSetIndex = -1;
+	for(auto& indexedAction : mActionIndex.GetActions(mActionIndex.GetNounId(noun), mActionIndex.GetVerbId(verb)))
 	{
-		const Action* action = actionSet->GetAction(noun, verb);
-		if(action != nullptr && IsCaseMet(action))
+		if(indexedAction.actionSetIndex == lastActionSetIndex) { continue; }
+		lastActionSetIndex = indexedAction.actionSetIndex;
+		
+		if(IsCaseMet(indexedAction.action))
 		{
-			candidate = action;
-			continue;
+			candidate = indexedAction.action;
 		}
 	}
 	
@@ -149,7 +150,7 @@ void ActionManager::ExecuteAction(const Action* action)
 	// If this is a topic, automatically increment topic counts.
 	if(Services::Get<VerbManager>()->IsTopic(action->verb))
 	{
-		Services::Get<GameProgress>()->IncTopicCount(action->noun, action->verb);
+		Services::Get<GameProgress>()->IncTopicCount(action->nounSymbol, action->verbSymbol);
 	}
 	
 	// If no script is associated with the action, that might be an error...
@@ -168,189 +169,31 @@ void ActionManager::ExecuteAction(const Action* action)
 
 const Action* ActionManager::GetAction(const std::string& noun, const std::string& verb) const
 {
-	// For any noun/verb pair, there is only ONE possible action that can be performed at any given time.
-	// Keep track of the candidate as we iterate from most general/broad to most specific.
-	// The most specific valid action will be our candidate.
-	const Action* candidate = nullptr;
-	
-	// If the verb is an inventory item, handle ANY_OBJECT/ANY_INV_ITEM wildcards for noun/verb.
-	bool verbIsInventoryItem = Services::Get<VerbManager>()->IsInventoryItem(verb);
-	if(verbIsInventoryItem)
-	{
-		for(auto& nvc : mActionSets)
-		{
-			std::vector<const Action*> actionsForAnyObject = nvc->GetActions("ANY_OBJECT", "ANY_INV_ITEM");
-			for(auto& action : actionsForAnyObject)
-			{
-				if(IsCaseMet(action))
-				{
-					std::cout << "Candidate action for " << noun << "/" << verb << " matches ANY_OBJECT/ANY_INV_ITEM" << std::endl;
-					candidate = action;
-				}
-			}
-		}
-	}
-	
-	// Find any matches for "ANY_OBJECT" and this verb next.
-	for(auto& nvc : mActionSets)
-	{
-		std::vector<const Action*> actionsForAnyObject = nvc->GetActions("ANY_OBJECT", verb);
-		for(auto& action : actionsForAnyObject)
-		{
-			if(IsCaseMet(action))
-			{
-				std::cout << "Candidate action for " << noun << "/" << verb << " matches ANY_OBJECT/" << verb << std::endl;
-				candidate = action;
-			}
-		}
-	}
-	
-	// If the verb is an inventory item, handle noun/ANY_INV_ITEM combo.
-	// Find any matches for "ANY_OBJECT" and this verb next.
-	if(verbIsInventoryItem)
-	{
-		for(auto& nvc : mActionSets)
-		{
-			std::vector<const Action*> actionsForAnyObject = nvc->GetActions(noun, "ANY_INV_ITEM");
-			for(auto& action : actionsForAnyObject)
-			{
-				if(IsCaseMet(action))
-				{
-					std::cout << "Candidate action for " << noun << "/" << verb << " matches " << noun << "/ANY_INV_ITEM" << std::endl;
-					candidate = action;
-				}
-			}
-		}
-	}
-	
-	// Finally, check for any exact noun/verb matches.
-	for(auto& nvc : mActionSets)
-	{
-		std::vector<const Action*> actionsForAnyObject = nvc->GetActions(noun, verb);
-		for(auto& action : actionsForAnyObject)
-		{
-			if(IsCaseMet(action))
-			{
-				std::cout << "Candidate action for " << noun << "/" << verb << " matches " << noun << "/" << verb << std::endl;
-				candidate = action;
-			}
-		}
-	}
-	return candidate;
+	// A verb that isn't in any action set still might be an inventory item, so ask the verb manager in that case.
+	int nounId = mActionIndex.GetNounId(noun);
+	int verbId = mActionIndex.GetVerbId(verb);
+	bool verbIsInventoryItem = verbId >= 0 ? mActionIndex.IsVerbType(verbId, VerbType::Inventory) : Services::Get<VerbManager>()->IsInventoryItem(verb);
+	return mActionIndex.GetAction(nounId, verbId, verbIsInventoryItem, mIsCaseMet);
 }
 
-std::vector<const Action*> ActionManager::GetActions(const std::string& noun, VerbType verbType) const
+void ActionManager::GetActions(const std::string& noun, VerbType verbType, std::vector<const Action*>& actions) const
 {
-	// As we find actions for this noun, we don't want repeated "verbs".
-	// For example, if two actions exist for the verb "LOOK", we don't want two look actions on the action bar!
-	// So, keep track of the verb-to-action mappings; only the first verb with a true case will be used.
-	std::unordered_map<std::string, const Action*> verbToAction;
-	
-	// Iterate all loaded action sets to find valid actions for this noun.
-	for(auto& actionSet : mActionSets)
-	{
-		// Within a single action set, we only want to use the first matching verb.
-		// Ex: if NOUN, VERB, CASE1 matches and is then followed by NOUN, VERB, CASE2 (which also matches), ignore the second one.
-		std::unordered_set<std::string> usedVerbs;
-		
-		// "ANY_OBJECT" is a wildcard. Any action with a noun of "ANY_OBJECT" can be valid for any noun passed in.
-		// These are lowest-priority, so we do them first (they might be overwritten later).
-		const std::vector<Action>& anyObjectActions = actionSet->GetActions("ANY_OBJECT");
-		for(auto& action : anyObjectActions)
-		{
-			// The "ANY_INV_ITEM" wildcard only matches if a specific verb was provided.
-			// This function doesn't let you specify a verb, so this never matches.
-			bool isWildcardInvItem = StringUtil::EqualsIgnoreCase(action.verb, "ANY_INV_ITEM");
-			if(isWildcardInvItem) { continue; }
-			
-			// Ignore this action if the verb has already been used in this action set.
-			if(usedVerbs.find(action.verb) != usedVerbs.end()) { continue; }
-			
-			// The action's verb must be of the correct type for us to use it.
-			bool validType = false;
-			switch(verbType)
-			{
-			case VerbType::Normal:
-				validType = Services::Get<VerbManager>()->IsVerb(action.verb);
-				break;
-			case VerbType::Inventory:
-				validType = Services::Get<VerbManager>()->IsInventoryItem(action.verb);
-				break;
-			case VerbType::Topic:
-				validType = Services::Get<VerbManager>()->IsTopic(action.verb);
-				break;
-			}
-			
-			// If type is valid and the action meets any case specified, we can use this action!
-			if(validType && IsCaseMet(&action, verbType))
-			{
-				verbToAction[action.verb] = &action;
-				usedVerbs.insert(action.verb);
-			}
-		}
-		
-		// Clear used verbs here - we allow an exact match to overwrite a wildcard match.
-		// Ex: ANY_OBJECT, LOOK, CASE1 matches, but then CANDY, LOOK, CASE2 matches exactly - use the second one.
-		usedVerbs.clear();
-		
-		// Check actions that map directly to this noun.
-		const std::vector<Action>& nounActions = actionSet->GetActions(noun);
-		for(auto& action : nounActions)
-		{
-			// The "ANY_INV_ITEM" wildcard only matches if a specific verb was provided.
-			// This function doesn't let you specify a verb, so this never matches.
-			bool isWildcardInvItem = StringUtil::EqualsIgnoreCase(action.verb, "ANY_INV_ITEM");
-			if(isWildcardInvItem) { continue; }
-			
-			// Ignore this action if the verb has already been used in this action set.
-			if(usedVerbs.find(action.verb) != usedVerbs.end()) { continue; }
-						
-			// The action's verb must be of the correct type for us to use it.
-			bool validType = false;
-			switch(verbType)
-			{
-			case VerbType::Normal:
-				validType = Services::Get<VerbManager>()->IsVerb(action.verb);
-				break;
-			case VerbType::Inventory:
-				validType = Services::Get<VerbManager>()->IsInventoryItem(action.verb);
-				break;
-			case VerbType::Topic:
-				validType = Services::Get<VerbManager>()->IsTopic(action.verb);
-				break;
-			}
-			
-			// If type is valid and the action meets any case specified, we can use this action!
-			if(validType && IsCaseMet(&action, verbType))
-			{
-				verbToAction[action.verb] = &action;
-				usedVerbs.insert(action.verb);
-			}
-		}
-	}
-	
-	// Finally, convert our map to a vector to return.
-	std::vector<const Action*> viableActions;
-	for(auto entry : verbToAction)
-	{
-		viableActions.push_back(entry.second);
-	}
-	return viableActions;
+	mActionIndex.GetActions(mActionIndex.GetNounId(noun), verbType, mIsCaseMet, actions);
 }
 
 bool ActionManager::HasTopicsLeft(const std::string &noun) const
 {
-	return GetActions(noun, VerbType::Topic).size() > 0;
+	return mActionIndex.HasTopics(mActionIndex.GetNounId(noun), mIsCaseMet);
 }
 
 std::string& ActionManager::GetNoun(int nounEnum)
 {
-	return mNouns[Math::Clamp(nounEnum, 0, (int)mNouns.size() - 1)];
+	return mActionIndex.GetNoun(nounEnum);
 }
 
 std::string& ActionManager::GetVerb(int verbEnum)
 {
-	return mVerbs[Math::Clamp(verbEnum, 0, (int)mVerbs.size() - 1)];
+	return mActionIndex.GetVerb(verbEnum);
 }
 
 // Temp, for debugging.
@@ -364,9 +207,9 @@ void OutputActions(const std::vector<const Action*>& actions)
 
 void ActionManager::ShowActionBar(const std::string& noun, std::function<void(const Action*)> selectCallback)
 {
-	auto actions = GetActions(noun, VerbType::Normal);
-	OutputActions(actions);
-	mActionBar->Show(noun, VerbType::Normal, actions, selectCallback, std::bind(&ActionManager::OnActionBarCanceled, this));
+	GetActions(noun, VerbType::Normal, mBarActions);
+	OutputActions(mBarActions);
+	mActionBar->Show(noun, VerbType::Normal, mBarActions, selectCallback, std::bind(&ActionManager::OnActionBarCanceled, this));
 }
 
 bool ActionManager::IsActionBarShowing() const
@@ -378,12 +221,12 @@ void ActionManager::ShowTopicBar(const std::string& noun)
 {
 	// See if we have any more topics to discuss with this noun (person).
 	// If not, we will pre-emptively cancel the bar and return.
-	auto actions = GetActions(noun, VerbType::Topic);
-	if(actions.size() == 0) { return; }
+	GetActions(noun, VerbType::Topic, mBarActions);
+	if(mBarActions.empty()) { return; }
 	
 	// Show topics.
-	OutputActions(actions);
-	mActionBar->Show(noun, VerbType::Topic, actions, nullptr, std::bind(&ActionManager::OnActionBarCanceled, this));
+	OutputActions(mBarActions);
+	mActionBar->Show(noun, VerbType::Topic, mBarActions, nullptr, std::bind(&ActionManager::OnActionBarCanceled, this));
 }
 
 void ActionManager::ShowTopicBar()
@@ -479,11 +322,14 @@ bool ActionManager::IsCaseMet(const Action* action, VerbType verbType) const
 		// Case evaluation logic may have magic variables n$ and v$.
 		// These variables should hold int-based identifiers for the noun/verb of the action we're evaluating.
 		// So, look those up and save the indexes!
-		int n = mNounToEnum.at(action->noun);
-		int v = mVerbToEnum.at(action->verb);
+		int n = mActionIndex.GetNounId(action->noun);
+		int v = mActionIndex.GetVerbId(action->verb);
 		
 		// Evaluate our condition logic with our n$ and v$ values.
-		return Services::GetSheep()->Evaluate(it->second, n, v);
+		SheepScript* script = it->second;
+		return mCaseResults.Evaluate(script, n, v, Services::Get<GameProgress>(), [script, n, v]() {
+			return Services::GetSheep()->Evaluate(script, n, v);
+		});
 	}
 	
 	// Check global case conditions.
@@ -511,11 +357,11 @@ bool ActionManager::IsCaseMet(const Action* action, VerbType verbType) const
 		// 1st_time: condition is met if this is the first time we've executed this action (noun/verb combo).
 		if(verbType == VerbType::Topic)
 		{
-			return Services::Get<GameProgress>()->GetTopicCount(action->noun, action->verb) == 0;
+			return Services::Get<GameProgress>()->GetTopicCount(action->nounSymbol, action->verbSymbol) == 0;
 		}
 		else
 		{
-			return Services::Get<GameProgress>()->GetNounVerbCount(action->noun, action->verb) == 0;
+			return Services::Get<GameProgress>()->GetNounVerbCount(action->nounSymbol, action->verbSymbol) == 0;
 		}
 	}
 	else if(StringUtil::EqualsIgnoreCase(action->caseLabel, "2cd_time"))
@@ -523,11 +369,11 @@ bool ActionManager::IsCaseMet(const Action* action, VerbType verbType) const
 		// 2cd_time: a surprising way to abbreviate "2nd time"...condition is met if this is the 2nd time we did the action.
 		if(verbType == VerbType::Topic)
 		{
-			return Services::Get<GameProgress>()->GetTopicCount(action->noun, action->verb) == 1;
+			return Services::Get<GameProgress>()->GetTopicCount(action->nounSymbol, action->verbSymbol) == 1;
 		}
 		else
 		{
-			return Services::Get<GameProgress>()->GetNounVerbCount(action->noun, action->verb) == 1;
+			return Services::Get<GameProgress>()->GetNounVerbCount(action->nounSymbol, action->verbSymbol) == 1;
 		}
 	}
 	else if(StringUtil::EqualsIgnoreCase(action->caseLabel, "3rd_time"))
@@ -535,11 +381,11 @@ bool ActionManager::IsCaseMet(const Action* action, VerbType verbType) const
 		// 3rd_time: and again for good measure.
 		if(verbType == VerbType::Topic)
 		{
-			return Services::Get<GameProgress>()->GetTopicCount(action->noun, action->verb) == 2;
+			return Services::Get<GameProgress>()->GetTopicCount(action->nounSymbol, action->verbSymbol) == 2;
 		}
 		else
 		{
-			return Services::Get<GameProgress>()->GetNounVerbCount(action->noun, action->verb) == 2;
+			return Services::Get<GameProgress>()->GetNounVerbCount(action->nounSymbol, action->verbSymbol) == 2;
 		}
 	}
 	else if(StringUtil::EqualsIgnoreCase(action->caseLabel, "otr_time"))
@@ -547,11 +393,11 @@ bool ActionManager::IsCaseMet(const Action* action, VerbType verbType) const
 		// otr_time: condition is met if this IS NOT the first time we've executed this action (noun/verb combo).
 		if(verbType == VerbType::Topic)
 		{
-			return Services::Get<GameProgress>()->GetTopicCount(action->noun, action->verb) > 0;
+			return Services::Get<GameProgress>()->GetTopicCount(action->nounSymbol, action->verbSymbol) > 0;
 		}
 		else
 		{
-			return Services::Get<GameProgress>()->GetNounVerbCount(action->noun, action->verb) > 0;
+			return Services::Get<GameProgress>()->GetNounVerbCount(action->nounSymbol, action->verbSymbol) > 0;
 		}
 	}
 	else if(StringUtil::EqualsIgnoreCase(action->caseLabel, "dialogue_topics_left"))
@@ -6,11 +6,14 @@
 // Manages showing/executing action bar.
 //
 #pragma once
+#include <cstdint>
 #include <functional>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "ActionIndex.h"
+#include "CaseResultCache.h"
 #include "NVC.h"
 #include "Type.h"
 
@@ -19,13 +22,6 @@ class GKActor;
 class SheepScript;
 class Timeblock;
 
-enum class VerbType
-{
-	Normal,
-	Inventory,
-	Topic
-};
-
 class ActionManager
 {
 	TYPE_DECL_BASE();
@@ -47,7 +43,7 @@ public:
 	
 	// Action Query
 	const Action* GetAction(const std::string& noun, const std::string& verb) const;
-	std::vector<const Action*> GetActions(const std::string& noun, VerbType verbType) const;
+	void GetActions(const std::string& noun, VerbType verbType, std::vector<const Action*>& actions) const;
 	bool HasTopicsLeft(const std::string& noun) const;
 	
 	// Int-Identifier to Noun/Verb
@@ -104,13 +100,19 @@ private:
 	// Cases must be stored here (rather than in Action Sets) because cases can be shared (especially global/inventory ones).
     std::unordered_map<std::string, SheepScript*> mCaseLogic;
 	
-	// Nouns and verbs that are currently active. Pulled out of action sets as they are loaded.
+	// Nouns and verbs that are currently active are pulled out of action sets as they are loaded, and given int ids.
 	// We do this to support the Sheep-eval feature of specifying n$ and v$ variables as wildcards for current noun/verb.
-	// To use these, we must map each active noun/verb to an integer and back again.
-	std::vector<std::string> mNouns;
-	std::unordered_map<std::string, int> mNounToEnum;
-	std::vector<std::string> mVerbs;
-	std::unordered_map<std::string, int> mVerbToEnum;
+	// The index also lets queries find actions for a noun or noun/verb pair without searching each action set.
+	ActionIndex mActionIndex;
+	
+	// Checks cases for the action index.
+	ActionIndex::CaseFunc mIsCaseMet;
+	
+	// Actions shown on the action bar. Kept to reuse its memory.
+	std::vector<const Action*> mBarActions;
+	
+	// Results of case evaluations, so the same case isn't evaluated again until the game state it read changes.
+	mutable CaseResultCache mCaseResults;
 	
 	// An action that's used for "Sheep Commands."
 	// When an arbitrary SheepScript needs to execute through the action system, we use this Action object.
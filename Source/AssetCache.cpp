@@ -0,0 +1,199 @@
+//
+// AssetCache.cpp
+//
+// Clark Kromenaker
+//
+#include "AssetCache.h"
+
+#include <algorithm>
+#include <utility>
+
+AssetCache::~AssetCache()
+{
+	// Delete most recently added assets first - assets are added after the assets they depend on.
+	std::vector<std::pair<unsigned int, Entry*>> entries;
+	entries.reserve(mEntries.size());
+	for(auto& entry : mEntries)
+	{
+		entries.push_back(std::make_pair(entry.second.addedTime, &entry.second));
+	}
+	std::sort(entries.begin(), entries.end(), [](const std::pair<unsigned int, Entry*>& a, const std::pair<unsigned int, Entry*>& b) {
+		return a.first > b.first;
+	});
+
+	for(auto& entry : entries)
+	{
+		entry.second->deleteAsset(entry.second->asset);
+	}
+}
+
+void* AssetCache::Get(const std::string& name)
+{
+	auto it = mEntries.find(name);
+	if(it == mEntries.end()) { return nullptr; }
+
+	Use(name, it->second);
+	return it->second.asset;
+}
+
+bool AssetCache::Contains(const std::string& name) const
+{
+	return mEntries.find(name) != mEntries.end();
+}
+
+void AssetCache::Add(const std::string& name, void* asset, void (*deleteAsset)(void*),
+					 const std::string& typeName, size_t memorySize, bool evictable,
+					 const std::vector<std::string>& dependencies)
+{
+	// Replacing an existing asset isn't supported.
+	if(asset == nullptr || Contains(name)) { return; }
+
+	Entry& entry = mEntries[name];
+	entry.asset = asset;
+	entry.deleteAsset = deleteAsset;
+	entry.typeName = typeName;
+	entry.memorySize = memorySize;
+	entry.evictable = evictable;
+	entry.dependencies = dependencies;
+	entry.addedTime = mUseCounter;
+
+	mMemoryUsage += memorySize;
+	Usage& usage = mMemoryUsageByType[typeName];
+	++usage.count;
+	usage.memorySize += memorySize;
+
+	Use(name, entry);
+}
+
+void AssetCache::BeginConstruct()
+{
+	mConstructReferences.emplace_back();
+}
+
+std::vector<std::string> AssetCache::EndConstruct()
+{
+	if(mConstructReferences.empty()) { return std::vector<std::string>(); }
+
+	std::vector<std::string> dependencies(mConstructReferences.back().begin(), mConstructReferences.back().end());
+	mConstructReferences.pop_back();
+	return dependencies;
+}
+
+void AssetCache::BeginScope()
+{
+	EndScope();
+	mScopeActive = true;
+}
+
+void AssetCache::EndScope()
+{
+	for(auto& name : mScopeReferences)
+	{
+		Release(name);
+	}
+	mScopeReferences.clear();
+	mScopeActive = false;
+}
+
+int AssetCache::Trim()
+{
+	int evictedCount = 0;
+	while(mMemoryUsage > mMemoryBudget)
+	{
+		// Find all assets that could be evicted, least recently used first.
+		std::vector<std::pair<unsigned int, std::string>> candidates;
+		for(auto& entry : mEntries)
+		{
+			if(entry.second.evictable && entry.second.referenceCount == 0)
+			{
+				candidates.push_back(std::make_pair(entry.second.lastUsedTime, entry.first));
+			}
+		}
+		if(candidates.empty()) { break; }
+		std::sort(candidates.begin(), candidates.end());
+
+		for(auto& candidate : candidates)
+		{
+			if(mMemoryUsage <= mMemoryBudget) { break; }
+			Evict(candidate.second);
+			++evictedCount;
+		}
+
+		// Evicted assets release their dependencies, which may now be candidates too.
+	}
+	return evictedCount;
+}
+
+unsigned int AssetCache::GetUnreferencedCount() const
+{
+	unsigned int count = 0;
+	for(auto& entry : mEntries)
+	{
+		if(entry.second.referenceCount == 0)
+		{
+			++count;
+		}
+	}
+	return count;
+}
+
+void AssetCache::Use(const std::string& name, Entry& entry)
+{
+	entry.lastUsedTime = ++mUseCounter;
+
+	// Whoever is using the asset takes a reference to it, if they don't have one already.
+	if(!mConstructReferences.empty())
+	{
+		if(mConstructReferences.back().insert(name).second)
+		{
+			++entry.referenceCount;
+		}
+	}
+	else if(mScopeActive)
+	{
+		if(mScopeReferences.insert(name).second)
+		{
+			++entry.referenceCount;
+		}
+	}
+	else if(!entry.pinned)
+	{
+		entry.pinned = true;
+		++entry.referenceCount;
+	}
+}
+
+void AssetCache::Release(const std::string& name)
+{
+	auto it = mEntries.find(name);
+	if(it != mEntries.end() && it->second.referenceCount > 0)
+	{
+		--it->second.referenceCount;
+	}
+}
+
+void AssetCache::Evict(const std::string& name)
+{
+	auto it = mEntries.find(name);
+	if(it == mEntries.end()) { return; }
+
+	// Hold onto dependencies, since the entry is about to be erased.
+	std::vector<std::string> dependencies;
+	dependencies.swap(it->second.dependencies);
+
+	Entry& entry = it->second;
+	entry.deleteAsset(entry.asset);
+
+	mMemoryUsage -= entry.memorySize;
+	Usage& usage = mMemoryUsageByType[entry.typeName];
+	--usage.count;
+	usage.memorySize -= entry.memorySize;
+
+	mEntries.erase(it);
+
+	// This asset no longer needs its dependencies.
+	for(auto& dependency : dependencies)
+	{
+		Release(dependency);
+	}
+}
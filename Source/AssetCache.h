@@ -0,0 +1,121 @@
+//
+// AssetCache.h
+//
+// Clark Kromenaker
+//
+// Keeps track of loaded assets by name, along with roughly how much memory each one uses.
+//
+// Assets are reference counted, but references are taken implicitly, based on what's going on when an asset is used:
+// - Assets used while another asset is being constructed are referenced by that asset, until it is evicted.
+// - Otherwise, assets used while a scope (e.g. a scene) is active are referenced by the scope, until it ends.
+// - Assets used at any other time are pinned - they are never released.
+//
+// Unreferenced assets stay cached (in case they're needed again) until memory usage goes over budget.
+// Trimming the cache then evicts the least recently used unreferenced assets.
+//
+#pragma once
+#include <cstddef>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class AssetCache
+{
+public:
+	// Number of assets, and the memory they use, for one type of asset.
+	struct Usage
+	{
+		unsigned int count = 0;
+		size_t memorySize = 0;
+	};
+
+	AssetCache() = default;
+	~AssetCache();
+
+	// The cache owns its assets, so don't allow copying!
+	AssetCache(const AssetCache& other) = delete;
+	AssetCache& operator=(const AssetCache& other) = delete;
+
+	// Returns the asset with the given name, or null if not cached.
+	// Getting an asset counts as using it.
+	void* Get(const std::string& name);
+	bool Contains(const std::string& name) const;
+
+	// Adds an asset to the cache, which counts as using it. The cache deletes the asset when evicted or destroyed.
+	// "Dependencies" are assets that were used while constructing this one (see EndConstruct).
+	// Only evictable assets are ever deleted before the cache itself is destroyed.
+	void Add(const std::string& name, void* asset, void (*deleteAsset)(void*),
+			 const std::string& typeName, size_t memorySize, bool evictable,
+			 const std::vector<std::string>& dependencies);
+
+	// Call before and after constructing an asset. Returns the names of assets used during construction.
+	// These remain referenced, so must be passed to Add (or they'll never be released).
+	void BeginConstruct();
+	std::vector<std::string> EndConstruct();
+
+	// Starts or ends a scope. Only one scope can be active at a time.
+	void BeginScope();
+	void EndScope();
+
+	// Memory budget for cached assets. Only enforced when the cache is trimmed.
+	void SetMemoryBudget(size_t memoryBudget) { mMemoryBudget = memoryBudget; }
+	size_t GetMemoryBudget() const { return mMemoryBudget; }
+
+	// Evicts unreferenced assets, least recently used first, until memory usage is within budget.
+	// Returns the number of assets evicted.
+	int Trim();
+
+	// Memory usage of all cached assets, or broken down by asset type.
+	size_t GetMemoryUsage() const { return mMemoryUsage; }
+	const std::map<std::string, Usage>& GetMemoryUsageByType() const { return mMemoryUsageByType; }
+
+	// Number of cached assets, and how many of those are unreferenced (and so could be evicted).
+	unsigned int GetCount() const { return static_cast<unsigned int>(mEntries.size()); }
+	unsigned int GetUnreferencedCount() const;
+
+private:
+	struct Entry
+	{
+		void* asset = nullptr;
+		void (*deleteAsset)(void*) = nullptr;
+
+		std::string typeName;
+		size_t memorySize = 0;
+		bool evictable = false;
+
+		// Number of references to this asset. If pinned, it holds one reference forever.
+		int referenceCount = 0;
+		bool pinned = false;
+
+		// Assets this one references, which are released when this one is evicted.
+		std::vector<std::string> dependencies;
+
+		// Value of the use counter when this asset was added and last used.
+		unsigned int addedTime = 0;
+		unsigned int lastUsedTime = 0;
+	};
+
+	// All cached assets, by name.
+	std::unordered_map<std::string, Entry> mEntries;
+
+	// Incremented each time an asset is used, to determine least recently used assets.
+	unsigned int mUseCounter = 0;
+
+	// For each asset under construction (innermost last), the names of assets it has referenced.
+	std::vector<std::unordered_set<std::string>> mConstructReferences;
+
+	// Whether a scope is active, and the names of assets it has referenced.
+	bool mScopeActive = false;
+	std::unordered_set<std::string> mScopeReferences;
+
+	// Memory usage totals, and the budget we try to stay within.
+	size_t mMemoryUsage = 0;
+	std::map<std::string, Usage> mMemoryUsageByType;
+	size_t mMemoryBudget = static_cast<size_t>(-1);
+
+	void Use(const std::string& name, Entry& entry);
+	void Release(const std::string& name);
+	void Evict(const std::string& name);
+};
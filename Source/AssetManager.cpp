@@ -14,35 +14,27 @@
 
 #include "FileSystem.h"
 #include "StringUtil.h"
+#include "VertexAnimator.h"
 
 AssetManager::AssetManager()
 {
-    
+	mAssetCache.SetMemoryBudget(kDefaultMemoryBudget);
 }
 
 AssetManager::~AssetManager()
 {
+	// Let any in-flight prefetches finish, and free their results, before tearing down barns.
+	DiscardPrefetches();
+	delete mThreadPool;
+	
 	// All the loaded stuff has to be unloaded!
+	// Cached assets are deleted by the asset cache itself.
 	UnloadAssets(mLoadedShaders);
-	
-	UnloadAssets(mLoadedSheeps);
-	UnloadAssets(mLoadedBSPs);
-    UnloadAssets(mLoadedBSPLightmaps);
-	UnloadAssets(mLoadedActionSets);
-	UnloadAssets(mLoadedSceneAssets);
-	UnloadAssets(mLoadedSIFs);
-	
-	UnloadAssets(mLoadedVertexAnimations);
-	UnloadAssets(mLoadedAnimations);
-	UnloadAssets(mLoadedGases);
-	
-	UnloadAssets(mLoadedTextures);
-	UnloadAssets(mLoadedModels);
-	
-	UnloadAssets(mLoadedYaks);
-	UnloadAssets(mLoadedSoundtracks);
-	UnloadAssets(mLoadedAudios);
-	
+	for(auto& entry : mLoadedBakedBarns)
+	{
+		delete entry.second;
+	}
+	mLoadedBakedBarns.clear();
 	UnloadAssets(mLoadedBarns);
 }
 
@@ -77,6 +69,9 @@ bool AssetManager::LoadBarn(const std::string& barnName)
     // Load barn file.
     BarnFile* barn = new BarnFile(assetPath);
     mLoadedBarns[dictKey] = barn;
+	
+	// Also load the baked version of the barn, if it has been baked.
+	LoadBakedBarn(dictKey, barn);
 	return true;
 }
 
@@ -90,14 +85,38 @@ void AssetManager::UnloadBarn(const std::string& barnName)
     auto iter = mLoadedBarns.find(dictKey);
     if(iter == mLoadedBarns.end()) { return; }
     
-    // Delete barn.
+    // Prefetches may be reading from (or pointing into) this barn, so get rid of them.
+    DiscardPrefetches();
+    
+    // Delete barn, and its baked file.
     BarnFile* barn = iter->second;
+    UnloadBakedBarn(barn);
     delete barn;
     
     // Remove from map.
     mLoadedBarns.erase(dictKey);
 }
 
+void AssetManager::BakeBarns()
+{
+	// Prefetches may point into baked files that are about to be rewritten.
+	DiscardPrefetches();
+	
+	// Make sure the output directory exists.
+	Directory::CreateAll(kBakedDirectory);
+	
+	for(auto& entry : mLoadedBarns)
+	{
+		// A baked file can't be rewritten while it's mapped.
+		UnloadBakedBarn(entry.second);
+		
+		int bakedCount = BakedBarnFile::Bake(*entry.second, GetBakedBarnPath(entry.first));
+		std::cout << "Baked " << bakedCount << " assets from " << entry.first << std::endl;
+		
+		LoadBakedBarn(entry.first, entry.second);
+	}
+}
+
 void AssetManager::WriteBarnAssetToFile(const std::string& assetName)
 {
 	WriteBarnAssetToFile(assetName, "");
@@ -128,82 +147,82 @@ void AssetManager::WriteAllBarnAssetsToFile(const std::string& search, const std
 
 Audio* AssetManager::LoadAudio(const std::string& name)
 {
-    return LoadAsset<Audio>(SanitizeAssetName(name, ".WAV"), &mLoadedAudios);
+    return LoadAsset<Audio>(SanitizeAssetName(name, ".WAV"));
 }
 
 Soundtrack* AssetManager::LoadSoundtrack(const std::string& name)
 {
-    return LoadAsset<Soundtrack>(SanitizeAssetName(name, ".STK"), &mLoadedSoundtracks);
+    return LoadAsset<Soundtrack>(SanitizeAssetName(name, ".STK"));
 }
 
 Animation* AssetManager::LoadYak(const std::string& name)
 {
-    return LoadAsset<Animation>(SanitizeAssetName(name, ".YAK"), &mLoadedYaks);
+    return LoadAsset<Animation>(SanitizeAssetName(name, ".YAK"));
 }
 
 Model* AssetManager::LoadModel(const std::string& name)
 {
-    return LoadAsset<Model>(SanitizeAssetName(name, ".MOD"), &mLoadedModels);
+    return LoadAsset<Model>(SanitizeAssetName(name, ".MOD"));
 }
 
 Texture* AssetManager::LoadTexture(const std::string& name)
 {
-    return LoadAsset<Texture>(SanitizeAssetName(name, ".BMP"), &mLoadedTextures);
+    return LoadAsset<Texture>(SanitizeAssetName(name, ".BMP"));
 }
 
 GAS* AssetManager::LoadGAS(const std::string& name)
 {
-    return LoadAsset<GAS>(SanitizeAssetName(name, ".GAS"), &mLoadedGases);
+    return LoadAsset<GAS>(SanitizeAssetName(name, ".GAS"));
 }
 
 Animation* AssetManager::LoadAnimation(const std::string& name)
 {
-    return LoadAsset<Animation>(SanitizeAssetName(name, ".ANM"), &mLoadedAnimations);
+    return LoadAsset<Animation>(SanitizeAssetName(name, ".ANM"));
 }
 
 VertexAnimation* AssetManager::LoadVertexAnimation(const std::string& name)
 {
-    return LoadAsset<VertexAnimation>(SanitizeAssetName(name, ".ACT"), &mLoadedVertexAnimations);
+    return LoadAsset<VertexAnimation>(SanitizeAssetName(name, ".ACT"));
 }
 
 SceneInitFile* AssetManager::LoadSIF(const std::string& name)
 {
-    return LoadAsset<SceneInitFile>(SanitizeAssetName(name, ".SIF"), &mLoadedSIFs);
+    return LoadAsset<SceneInitFile>(SanitizeAssetName(name, ".SIF"));
 }
 
 SceneAsset* AssetManager::LoadSceneAsset(const std::string& name)
 {
-    return LoadAsset<SceneAsset>(SanitizeAssetName(name, ".SCN"), &mLoadedSceneAssets);
+    return LoadAsset<SceneAsset>(SanitizeAssetName(name, ".SCN"));
 }
 
 NVC* AssetManager::LoadNVC(const std::string& name)
 {
-    return LoadAsset<NVC>(SanitizeAssetName(name, ".NVC"), &mLoadedActionSets);
+    return LoadAsset<NVC>(SanitizeAssetName(name, ".NVC"));
 }
 
 BSP* AssetManager::LoadBSP(const std::string& name)
 {
-    return LoadAsset<BSP>(SanitizeAssetName(name, ".BSP"), &mLoadedBSPs);
+    return LoadAsset<BSP>(SanitizeAssetName(name, ".BSP"));
 }
 
 BSPLightmap* AssetManager::LoadBSPLightmap(const std::string& name)
 {
-    return LoadAsset<BSPLightmap>(SanitizeAssetName(name, ".MUL"), &mLoadedBSPLightmaps);
+    return LoadAsset<BSPLightmap>(SanitizeAssetName(name, ".MUL"));
 }
 
 SheepScript* AssetManager::LoadSheep(const std::string& name)
 {
-    return LoadAsset<SheepScript>(SanitizeAssetName(name, ".SHP"), &mLoadedSheeps);
+    return LoadAsset<SheepScript>(SanitizeAssetName(name, ".SHP"));
 }
 
 Cursor* AssetManager::LoadCursor(const std::string& name)
 {
-    return LoadAsset<Cursor>(SanitizeAssetName(name, ".CUR"), nullptr);
+    return LoadAsset<Cursor>(SanitizeAssetName(name, ".CUR"), false);
 }
 
 Font* AssetManager::LoadFont(const std::string& name)
 {
-	return LoadAsset<Font>(SanitizeAssetName(name, ".FON"), nullptr);
+	return LoadAsset<Font>(SanitizeAssetName(name, ".FON"), false);
 }
 
 Shader* AssetManager::LoadShader(const std::string& name)
@@ -262,6 +281,106 @@ char* AssetManager::LoadRaw(const std::string& name, unsigned int& outBufferSize
 	return CreateAssetBuffer(name, outBufferSize);
 }
 
+void AssetManager::Prefetch(const std::string& assetName)
+{
+	std::string upperName = assetName;
+	StringUtil::ToUpper(upperName);
+	
+	// Vertex animations only parse bytes, so can be constructed entirely on a worker thread.
+	// For everything else, workers extract the bytes, and the asset is constructed by the Load call.
+	if(StringUtil::EndsWith(upperName, ".ACT"))
+	{
+		PrefetchAsset<VertexAnimation>(upperName);
+	}
+	else
+	{
+		PrefetchAsset<Asset>(upperName);
+	}
+}
+
+void AssetManager::Prefetch(const std::vector<std::string>& assetNames)
+{
+	for(auto& assetName : assetNames)
+	{
+		Prefetch(assetName);
+	}
+}
+
+void AssetManager::StartManifest()
+{
+	mRecordingManifest = true;
+	mManifestAssetNames.clear();
+	mManifestAssetNameSet.clear();
+}
+
+void AssetManager::SaveManifest(const std::string& manifestName)
+{
+	if(!mRecordingManifest) { return; }
+	mRecordingManifest = false;
+	
+	// Make sure the output directory exists.
+	Directory::CreateAll(kManifestDirectory);
+	
+	// Manifests are just one asset name per line, in the order they were loaded.
+	std::ofstream file(GetManifestPath(manifestName));
+	if(!file.good())
+	{
+		std::cout << "Could not write asset manifest " << manifestName << std::endl;
+		return;
+	}
+	for(auto& assetName : mManifestAssetNames)
+	{
+		file << assetName << std::endl;
+	}
+}
+
+void AssetManager::PrefetchManifest(const std::string& manifestName)
+{
+	// No manifest yet is fine - it'll be created by the first SaveManifest.
+	std::ifstream file(GetManifestPath(manifestName));
+	if(!file.good()) { return; }
+	
+	// Prefetch in the order assets were loaded last time, since workers process jobs in order too.
+	std::vector<std::string> assetNames;
+	std::string line;
+	while(StringUtil::GetLineSanitized(file, line))
+	{
+		if(!line.empty() && !mAssetCache.Contains(line))
+		{
+			assetNames.push_back(line);
+		}
+	}
+	Prefetch(assetNames);
+}
+
+void AssetManager::BeginSceneAssets()
+{
+	mAssetCache.BeginScope();
+}
+
+void AssetManager::EndSceneAssets()
+{
+	mAssetCache.EndScope();
+}
+
+void AssetManager::TrimAssets()
+{
+	int evictedCount = mAssetCache.Trim();
+	if(evictedCount > 0)
+	{
+		std::cout << "Evicted " << evictedCount << " unused assets to stay within memory budget." << std::endl;
+	}
+}
+
+ThreadPool* AssetManager::GetThreadPool()
+{
+	if(mThreadPool == nullptr)
+	{
+		mThreadPool = new ThreadPool();
+	}
+	return mThreadPool;
+}
+
 BarnFile* AssetManager::GetBarn(const std::string& barnName)
 {
 	// We want our dictionary key to be all uppercase.
@@ -312,6 +431,48 @@ BarnFile* AssetManager::GetBarnContainingAsset(const std::string& fileName)
 	return nullptr;
 }
 
+void AssetManager::LoadBakedBarn(const std::string& barnName, BarnFile* barn)
+{
+	// Not having a baked file is fine - assets will just load from the barn.
+	std::string bakedPath = GetBakedBarnPath(barnName);
+	if(!std::ifstream(bakedPath).good()) { return; }
+	
+	BakedBarnFile* bakedBarn = new BakedBarnFile(bakedPath);
+	if(bakedBarn->IsOpen())
+	{
+		mLoadedBakedBarns[barn] = bakedBarn;
+	}
+	else
+	{
+		delete bakedBarn;
+	}
+}
+
+void AssetManager::UnloadBakedBarn(BarnFile* barn)
+{
+	auto it = mLoadedBakedBarns.find(barn);
+	if(it != mLoadedBakedBarns.end())
+	{
+		delete it->second;
+		mLoadedBakedBarns.erase(it);
+	}
+}
+
+std::string AssetManager::GetBakedBarnPath(const std::string& barnName)
+{
+	return Path::Combine({ kBakedDirectory, StringUtil::ToUpperCopy(Path::GetFileNameNoExtension(barnName)) + ".BAKE" });
+}
+
+const char* AssetManager::GetBakedAssetData(BarnFile* barn, const BarnAsset& barnAsset, unsigned int& outBufferSize)
+{
+	// Usually, nothing is baked.
+	if(mLoadedBakedBarns.empty()) { return nullptr; }
+	
+	auto it = mLoadedBakedBarns.find(barn);
+	if(it == mLoadedBakedBarns.end()) { return nullptr; }
+	return it->second->GetAssetData(barnAsset, outBufferSize);
+}
+
 std::string AssetManager::SanitizeAssetName(const std::string& assetName, const std::string& expectedExtension)
 {
     // First, convert all names to uppercase.
@@ -330,6 +491,11 @@ std::string AssetManager::SanitizeAssetName(const std::string& assetName, const
     return sanitizedName;
 }
 
+std::string AssetManager::GetManifestPath(const std::string& manifestName)
+{
+	return Path::Combine({ kManifestDirectory, StringUtil::ToUpperCopy(manifestName) + ".TXT" });
+}
+
 std::string AssetManager::GetAssetPath(const std::string& fileName)
 {
 	std::string assetPath;
@@ -344,25 +510,108 @@ std::string AssetManager::GetAssetPath(const std::string& fileName)
 }
 
 template<class T>
-T* AssetManager::LoadAsset(const std::string& assetName, std::unordered_map<std::string, T*>* cache)
+static void DeleteAsset(void* asset)
+{
+	delete static_cast<T*>(asset);
+}
+
+// Vertex animations played on the GPU have keyframe buffers, which go with them.
+template<>
+void DeleteAsset<VertexAnimation>(void* asset)
+{
+	VertexAnimator::DeleteKeyframeBuffers(static_cast<VertexAnimation*>(asset));
+	delete static_cast<VertexAnimation*>(asset);
+}
+
+// Approximate memory used by an asset. By default, assume it's about the size of the data it was loaded from.
+template<class T>
+static size_t GetAssetMemorySize(T*, unsigned int bufferSize)
+{
+	return bufferSize;
+}
+
+// Textures are often stored compressed or palettized, but are always expanded to 32-bit pixels.
+static size_t GetAssetMemorySize(Texture* texture, unsigned int)
+{
+	return static_cast<size_t>(texture->GetWidth()) * texture->GetHeight() * 4;
+}
+
+static size_t GetAssetMemorySize(BSPLightmap* lightmap, unsigned int)
+{
+	size_t memorySize = 0;
+	for(auto& texture : lightmap->GetAtlasTextures())
+	{
+		memorySize += GetAssetMemorySize(texture, 0);
+	}
+	return memorySize;
+}
+
+template<class T>
+T* AssetManager::LoadAsset(const std::string& assetName, bool cache)
 {
     std::string upperName = assetName;
     StringUtil::ToUpper(upperName);
     
+    // If recording a manifest, note that this asset was needed.
+    if(mRecordingManifest && mManifestAssetNameSet.insert(upperName).second)
+    {
+        mManifestAssetNames.push_back(upperName);
+    }
+    
+    // If this asset was prefetched, wait for the worker to finish with it.
+    PrefetchedAsset prefetched;
+    bool wasPrefetched = TakePrefetchedAsset(upperName, prefetched);
+    
     // See if this asset is already loaded in the cache
     // If so, we can just return it right away.
-    if(cache != nullptr)
+    if(cache)
     {
-        auto it = cache->find(upperName);
-        if(it != cache->end())
+        T* asset = static_cast<T*>(mAssetCache.Get(upperName));
+        if(asset != nullptr)
         {
-            return it->second;
+            // Any prefetched result is redundant.
+            if(wasPrefetched)
+            {
+                DiscardPrefetchedAsset(prefetched);
+            }
+            return asset;
         }
     }
 	
+	// The worker may have already constructed the asset for us.
+	// Such assets don't load other assets, so have no dependencies.
+	if(wasPrefetched && prefetched.asset != nullptr)
+	{
+		// The deleter identifies the type the worker constructed.
+		if(prefetched.deleteAsset == &DeleteAsset<T>)
+		{
+			T* asset = static_cast<T*>(prefetched.asset);
+			if(cache)
+			{
+				CacheAsset(upperName, asset, prefetched.bufferSize, std::vector<std::string>());
+			}
+			return asset;
+		}
+		
+		// Prefetched as some other type of asset - that's no use here, and its buffer is already gone.
+		DiscardPrefetchedAsset(prefetched);
+	}
+	
 	// Retrieve the buffer, from which we'll create the asset.
+	// Uncompressed assets in memory-mapped barns are read in-place, with no copy.
 	unsigned int bufferSize = 0;
-	char* buffer = CreateAssetBuffer(upperName, bufferSize);
+	bool bufferIsView = false;
+	char* buffer = nullptr;
+	if(wasPrefetched && prefetched.buffer != nullptr)
+	{
+		buffer = prefetched.buffer;
+		bufferSize = prefetched.bufferSize;
+		bufferIsView = prefetched.bufferIsView;
+	}
+	else
+	{
+		buffer = CreateAssetBuffer(upperName, bufferSize, &bufferIsView);
+	}
 	
 	// If no buffer could be found, we're in trouble!
 	if(buffer == nullptr)
@@ -372,23 +621,48 @@ T* AssetManager::LoadAsset(const std::string& assetName, std::unordered_map<std:
 	}
 	
 	// Generate asset from the BARN bytes.
+	// Any assets loaded by the constructor are referenced by this asset.
+	// For uncached assets, those references are never released.
+	mAssetCache.BeginConstruct();
 	T* asset = new T(upperName, buffer, bufferSize);
+	std::vector<std::string> dependencies = mAssetCache.EndConstruct();
 	
-	// Delete the buffer after use (or it'll leak).
-	delete[] buffer;
+	// Delete the buffer after use (or it'll leak). Views into a barn's mapping are owned by the barn.
+	if(!bufferIsView)
+	{
+		delete[] buffer;
+	}
 	
 	// Add entry in cache, if we have a cache.
-	if(cache != nullptr)
+	if(cache)
 	{
-		(*cache)[upperName] = asset;
+		CacheAsset(upperName, asset, bufferSize, dependencies);
 	}
         
 	//std::cout << "Loaded asset " << upperName << std::endl;
 	return asset;
 }
 
-char* AssetManager::CreateAssetBuffer(const std::string& assetName, unsigned int& outBufferSize)
+template<class T>
+void AssetManager::CacheAsset(const std::string& upperName, T* asset, unsigned int bufferSize, const std::vector<std::string>& dependencies)
+{
+	// Memory usage is grouped by asset type, which is indicated by extension.
+	std::string typeName;
+	std::size_t dotIndex = upperName.find_last_of('.');
+	if(dotIndex != std::string::npos)
+	{
+		typeName = upperName.substr(dotIndex + 1);
+	}
+	mAssetCache.Add(upperName, asset, &DeleteAsset<T>, typeName, GetAssetMemorySize(asset, bufferSize), IsEvictableAsset<T>::value, dependencies);
+}
+
+char* AssetManager::CreateAssetBuffer(const std::string& assetName, unsigned int& outBufferSize, bool* outIsView)
 {
+	if(outIsView != nullptr)
+	{
+		*outIsView = false;
+	}
+	
 	// First, see if the asset exists at any asset search path.
 	// If so, we load the asset directly from file.
 	// Loose files take precedence over packaged barn assets.
@@ -431,6 +705,28 @@ char* AssetManager::CreateAssetBuffer(const std::string& assetName, unsigned int
 		
 		// Create a buffer of the correct size.
 		outBufferSize = barnAsset->uncompressedSize;
+		
+		// If the caller accepts a view, and the barn can provide the bytes in-place, skip the copy.
+		// Assets only read from their data buffer during construction, so the const_cast is safe.
+		if(outIsView != nullptr)
+		{
+			// Baked data is preferred, since it's faster to construct assets from.
+			// Only callers constructing assets accept views, so raw loads still get the original bytes.
+			const char* bakedData = GetBakedAssetData(barn, *barnAsset, outBufferSize);
+			if(bakedData != nullptr)
+			{
+				*outIsView = true;
+				return const_cast<char*>(bakedData);
+			}
+			
+			const char* view = barn->GetAssetView(assetName);
+			if(view != nullptr)
+			{
+				*outIsView = true;
+				return const_cast<char*>(view);
+			}
+		}
+		
 		char* buffer = new char[outBufferSize];
 		
 		// Extract the asset to that buffer.
@@ -456,3 +752,111 @@ void AssetManager::UnloadAssets(std::unordered_map<std::string, T*>& cache)
 	// Clear the cache.
 	cache.clear();
 }
+
+template<class T>
+static void* CreateAssetOnWorker(const std::string& name, char* buffer, unsigned int bufferSize, std::true_type)
+{
+	return new T(name, buffer, bufferSize);
+}
+
+template<class T>
+static void* CreateAssetOnWorker(const std::string& name, char* buffer, unsigned int bufferSize, std::false_type)
+{
+	return nullptr;
+}
+
+template<class T>
+void AssetManager::PrefetchAsset(const std::string& upperName)
+{
+	// Already prefetching this one.
+	if(mPrefetches.find(upperName) != mPrefetches.end()) { return; }
+	
+	// Loose files take precedence over barn assets, and are only used during development - don't bother prefetching them.
+	if(!GetAssetPath(upperName).empty()) { return; }
+	
+	// Barn lookups aren't thread-safe, so resolve the barn and asset size up front.
+	BarnFile* barn = GetBarnContainingAsset(upperName);
+	if(barn == nullptr) { return; }
+	BarnAsset* barnAsset = barn->GetAsset(upperName);
+	if(barnAsset == nullptr) { return; }
+	unsigned int bufferSize = barnAsset->uncompressedSize;
+	
+	// Baked assets are read in-place from a mapping, so there's nothing to extract.
+	unsigned int bakedSize = 0;
+	if(GetBakedAssetData(barn, *barnAsset, bakedSize) != nullptr) { return; }
+	
+	// The worker extracts (and decompresses) the bytes - and if the asset type allows it, constructs the asset too.
+	mPrefetches[upperName] = GetThreadPool()->Enqueue([barn, upperName, bufferSize]() {
+		PrefetchedAsset prefetched;
+		prefetched.bufferSize = bufferSize;
+		
+		// Uncompressed assets in memory-mapped barns can be used in-place.
+		const char* view = barn->GetAssetView(upperName);
+		if(view != nullptr)
+		{
+			prefetched.buffer = const_cast<char*>(view);
+			prefetched.bufferIsView = true;
+		}
+		else
+		{
+			prefetched.buffer = new char[bufferSize];
+			if(!barn->Extract(upperName, prefetched.buffer, bufferSize))
+			{
+				delete[] prefetched.buffer;
+				prefetched.buffer = nullptr;
+				return prefetched;
+			}
+		}
+		
+		// Construct the asset, if it's safe to do so here. The buffer is no longer needed after that.
+		prefetched.asset = CreateAssetOnWorker<T>(upperName, prefetched.buffer, bufferSize, std::integral_constant<bool, IsThreadSafeAsset<T>::value>());
+		if(prefetched.asset != nullptr)
+		{
+			prefetched.deleteAsset = &DeleteAsset<T>;
+			if(!prefetched.bufferIsView)
+			{
+				delete[] prefetched.buffer;
+			}
+			prefetched.buffer = nullptr;
+		}
+		return prefetched;
+	});
+}
+
+bool AssetManager::TakePrefetchedAsset(const std::string& upperName, PrefetchedAsset& outPrefetched)
+{
+	// Usually, nothing is pending.
+	if(mPrefetches.empty()) { return false; }
+	
+	auto it = mPrefetches.find(upperName);
+	if(it == mPrefetches.end()) { return false; }
+	
+	// Blocks if the worker isn't done with this asset yet.
+	outPrefetched = it->second.get();
+	mPrefetches.erase(it);
+	return true;
+}
+
+void AssetManager::DiscardPrefetchedAsset(PrefetchedAsset& prefetched)
+{
+	if(prefetched.asset != nullptr)
+	{
+		prefetched.deleteAsset(prefetched.asset);
+		prefetched.asset = nullptr;
+	}
+	if(prefetched.buffer != nullptr && !prefetched.bufferIsView)
+	{
+		delete[] prefetched.buffer;
+	}
+	prefetched.buffer = nullptr;
+}
+
+void AssetManager::DiscardPrefetches()
+{
+	for(auto& entry : mPrefetches)
+	{
+		PrefetchedAsset prefetched = entry.second.get();
+		DiscardPrefetchedAsset(prefetched);
+	}
+	mPrefetches.clear();
+}
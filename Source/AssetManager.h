@@ -6,10 +6,13 @@
 //
 #pragma once
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "Animation.h"
+#include "AssetCache.h"
 #include "Audio.h"
+#include "BakedBarnFile.h"
 #include "BarnFile.h"
 #include "BSP.h"
 #include "BSPLightmap.h"
@@ -24,8 +27,23 @@
 #include "Sheep/SheepScript.h"
 #include "Soundtrack.h"
 #include "Texture.h"
+#include "ThreadPool.h"
 #include "VertexAnimation.h"
 
+// Whether an asset type can be fully constructed on a worker thread.
+// Only true for types whose constructors just parse bytes - no GL calls, and no loading of other assets.
+template<class T> struct IsThreadSafeAsset { static const bool value = false; };
+template<> struct IsThreadSafeAsset<VertexAnimation> { static const bool value = true; };
+
+// Whether an asset type can be evicted from the cache when unreferenced and over the memory budget.
+// Only true for large types that are just referenced by scene objects - script and audio assets may still be in use after a scene ends.
+template<class T> struct IsEvictableAsset { static const bool value = false; };
+template<> struct IsEvictableAsset<Texture> { static const bool value = true; };
+template<> struct IsEvictableAsset<Model> { static const bool value = true; };
+template<> struct IsEvictableAsset<BSP> { static const bool value = true; };
+template<> struct IsEvictableAsset<BSPLightmap> { static const bool value = true; };
+template<> struct IsEvictableAsset<VertexAnimation> { static const bool value = true; };
+
 class AssetManager
 {
 public:
@@ -39,6 +57,10 @@ public:
     bool LoadBarn(const std::string& barnName);
     void UnloadBarn(const std::string& barnName);
 	
+	// Bakes supported assets in all loaded barns into faster-loading formats.
+	// Once baked, those assets are loaded from the baked files, unless the original barn asset changes.
+	void BakeBarns();
+	
 	// Write an asset from a bundle to a file.
     void WriteBarnAssetToFile(const std::string& assetName);
 	void WriteBarnAssetToFile(const std::string& assetName, const std::string& outputDir);
@@ -74,8 +96,67 @@ public:
 	Shader* LoadShader(const std::string& vertName, const std::string& fragName);
 	
 	char* LoadRaw(const std::string& name, unsigned int& outBufferSize);
+	
+	// Starts extracting and decompressing assets on worker threads (names must include extensions).
+	// A later Load call for a prefetched asset waits for (and uses) the worker's result, rather than extracting serially.
+	// Assets that can't be constructed off the main thread are still constructed by that Load call.
+	// Like the Load functions, this should only be called from the main thread.
+	void Prefetch(const std::string& assetName);
+	void Prefetch(const std::vector<std::string>& assetNames);
+	
+	// Waits for any pending prefetches and frees their results. Use when prefetched assets are no longer expected to be loaded.
+	void DiscardPrefetches();
+	
+	// A manifest records the names of all assets loaded during some operation (e.g. a scene load), and is saved to disk.
+	// The next time the operation occurs, the manifest can be used to prefetch all those assets in parallel up front.
+	void StartManifest();
+	void SaveManifest(const std::string& manifestName);
+	void PrefetchManifest(const std::string& manifestName);
+	
+	// Assets loaded during a scene are referenced by that scene, and released when it ends.
+	// Assets loaded outside a scene (e.g. by systems during startup) are never released.
+	void BeginSceneAssets();
+	void EndSceneAssets();
+	
+	// Evicts unreferenced assets, least recently used first, until memory usage is within budget.
+	void TrimAssets();
+	
+	// Memory budget for cached assets, in bytes.
+	void SetMemoryBudget(size_t memoryBudget) { mAssetCache.SetMemoryBudget(memoryBudget); }
+	
+	// Approximate memory usage of cached assets.
+	const AssetCache& GetAssetCache() const { return mAssetCache; }
+	
+	// Worker threads for background work (prefetching assets, but also usable by other systems). Created on first use.
+	ThreadPool* GetThreadPool();
     
 private:
+	// Result of a prefetch job: either a fully constructed asset, or just the bytes to construct one from.
+	struct PrefetchedAsset
+	{
+		char* buffer = nullptr;
+		unsigned int bufferSize = 0;
+		bool bufferIsView = false;
+		
+		void* asset = nullptr;
+		void (*deleteAsset)(void*) = nullptr;
+	};
+	
+	// Worker threads - created on first use.
+	ThreadPool* mThreadPool = nullptr;
+	
+	// Prefetches that have not yet been consumed by a Load call.
+	std::unordered_map<std::string, std::future<PrefetchedAsset>> mPrefetches;
+	
+	// Directory manifests are saved to and loaded from.
+	const std::string kManifestDirectory = "Manifests";
+	
+	// When recording a manifest, names of assets loaded so far, in load order (and as a set, to avoid duplicates).
+	bool mRecordingManifest = false;
+	std::vector<std::string> mManifestAssetNames;
+	std::unordered_set<std::string> mManifestAssetNameSet;
+	
+
     // A list of paths to search for assets.
     // In priority order, since we'll search in order, and stop when we find the item.
     std::vector<std::string> mSearchPaths;
@@ -83,40 +164,51 @@ private:
     // A map of loaded barn files. If an asset isn't found on any search path,
     // we then search each loaded barn file for the asset.
     std::unordered_map<std::string, BarnFile*> mLoadedBarns;
-    
-    // A list of loaded assets, so we can just return existing assets if already loaded.
-    std::unordered_map<std::string, Audio*> mLoadedAudios;
-	std::unordered_map<std::string, Soundtrack*> mLoadedSoundtracks;
-	std::unordered_map<std::string, Animation*> mLoadedYaks;
 	
-	std::unordered_map<std::string, Model*> mLoadedModels;
-    std::unordered_map<std::string, Texture*> mLoadedTextures;
+	// Directory baked files are saved to and loaded from.
+	const std::string kBakedDirectory = "Baked";
 	
-	std::unordered_map<std::string, GAS*> mLoadedGases;
-	std::unordered_map<std::string, Animation*> mLoadedAnimations;
-	std::unordered_map<std::string, VertexAnimation*> mLoadedVertexAnimations;
-	
-	std::unordered_map<std::string, SceneInitFile*> mLoadedSIFs;
-	std::unordered_map<std::string, SceneAsset*> mLoadedSceneAssets;
-	std::unordered_map<std::string, NVC*> mLoadedActionSets;
-    
-	std::unordered_map<std::string, BSP*> mLoadedBSPs;
-    std::unordered_map<std::string, BSPLightmap*> mLoadedBSPLightmaps;
+	// Baked files for loaded barns, if they've been baked.
+	std::unordered_map<BarnFile*, BakedBarnFile*> mLoadedBakedBarns;
     
-	std::unordered_map<std::string, SheepScript*> mLoadedSheeps;
+    // Loaded assets, so we can just return existing assets if already loaded.
+    AssetCache mAssetCache;
+	
+	// Budget used unless changed via SetMemoryBudget.
+	static const size_t kDefaultMemoryBudget = 256 * 1024 * 1024;
 	
     std::unordered_map<std::string, Shader*> mLoadedShaders;
 	
 	// Retrieve a barn bundle by name, or by contained asset.
 	BarnFile* GetBarn(const std::string& barnName);
 	BarnFile* GetBarnContainingAsset(const std::string& assetName);
+	
+	// Load or unload the baked file for a barn. Loading does nothing if the barn hasn't been baked.
+	void LoadBakedBarn(const std::string& barnName, BarnFile* barn);
+	void UnloadBakedBarn(BarnFile* barn);
+	std::string GetBakedBarnPath(const std::string& barnName);
+	
+	// Retrieves up-to-date baked data for an asset in a barn, or null if there is none.
+	const char* GetBakedAssetData(BarnFile* barn, const BarnAsset& barnAsset, unsigned int& outBufferSize);
     
     std::string SanitizeAssetName(const std::string& assetName, const std::string& expectedExtension);
     
     std::string GetAssetPath(const std::string& fileName);
     
-    template<class T> T* LoadAsset(const std::string& assetName, std::unordered_map<std::string, T*>* cache);
-	char* CreateAssetBuffer(const std::string& assetName, unsigned int& outBufferSize);
+    template<class T> T* LoadAsset(const std::string& assetName, bool cache = true);
+	
+	// Creates a buffer containing an asset's bytes. Caller must delete the buffer.
+	// If "outIsView" is provided, the returned buffer may instead point directly into a memory-mapped barn.
+	// In that case, "outIsView" is set to true, and the caller must NOT delete or modify the buffer.
+	char* CreateAssetBuffer(const std::string& assetName, unsigned int& outBufferSize, bool* outIsView = nullptr);
 	
 	template<class T> void UnloadAssets(std::unordered_map<std::string, T*>& cache);
+	
+	template<class T> void CacheAsset(const std::string& upperName, T* asset, unsigned int bufferSize, const std::vector<std::string>& dependencies);
+	
+	template<class T> void PrefetchAsset(const std::string& upperName);
+	bool TakePrefetchedAsset(const std::string& upperName, PrefetchedAsset& outPrefetched);
+	void DiscardPrefetchedAsset(PrefetchedAsset& prefetched);
+
+	std::string GetManifestPath(const std::string& manifestName);
 };
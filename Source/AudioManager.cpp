@@ -14,8 +14,10 @@
 
 #include "Audio.h"
 
-bool AudioManager::Initialize()
+bool AudioManager::Initialize(bool headless)
 {
+	if(headless) { return true; }
+	
 	// Create the FMOD system.
     FMOD_RESULT result = FMOD::System_Create(&mSystem);
     if(result != FMOD_OK)
@@ -55,6 +57,8 @@ bool AudioManager::Initialize()
 
 void AudioManager::Shutdown()
 {
+	if(mSystem == nullptr) { return; }
+	
 	// Close and release FMOD system.
     FMOD_RESULT result = mSystem->close();
     result = mSystem->release();
@@ -62,6 +66,7 @@ void AudioManager::Shutdown()
 
 void AudioManager::Update(float deltaTime)
 {
+	if(mSystem == nullptr) { return; }
     mSystem->update();
 }
 
@@ -72,7 +77,7 @@ void AudioManager::Play(Audio* audio)
 
 void AudioManager::Play(Audio* audio, int fadeInMs)
 {
-    if(audio == nullptr) { return; }
+    if(audio == nullptr || mSystem == nullptr) { return; }
 	
 	// Need to pass FMOD the length of our audio.
     FMOD_CREATESOUNDEXINFO exinfo;
@@ -101,7 +106,7 @@ void AudioManager::Play(Audio* audio, int fadeInMs)
 
 void AudioManager::Play3D(Audio* audio, const Vector3& position, float minDist, float maxDist)
 {
-    if(audio == nullptr) { return; }
+    if(audio == nullptr || mSystem == nullptr) { return; }
 	
 	// Create extra info struct containing length of audio buffer.
     FMOD_CREATESOUNDEXINFO exinfo;
@@ -137,6 +142,7 @@ void AudioManager::Play3D(Audio* audio, const Vector3& position, float minDist,
 
 void AudioManager::UpdateListener(const Vector3& position, const Vector3& velocity, const Vector3& forward, const Vector3& up)
 {
+    if(mSystem == nullptr) { return; }
     FMOD_RESULT result = mSystem->set3DListenerAttributes(0, (const FMOD_VECTOR*)&position, (const FMOD_VECTOR*)&velocity,
                                                          (const FMOD_VECTOR*)&forward, (const FMOD_VECTOR*)&up);
     if(result != FMOD_OK)
@@ -17,7 +17,8 @@ class Quaternion;
 class AudioManager
 {
 public:
-    bool Initialize();
+    // When headless, no audio system is created, and playing audio does nothing.
+    bool Initialize(bool headless = false);
     void Shutdown();
     
     void Update(float deltaTime);
@@ -5,11 +5,14 @@
 //
 #include "BSP.h"
 
+#include <cassert>
+#include <climits>
 #include <iostream>
 #include <unordered_map>
 
 #include "BinaryReader.h"
 #include "BSPActor.h"
+#include "BSPLightmap.h"
 #include "Debug.h"
 #include "Services.h"
 #include "StringUtil.h"
@@ -33,105 +36,79 @@ bool BSP::RaycastNearest(const Ray& ray, RaycastHit& outHitInfo)
 {
 	// Values for tracking closest found hit.
     outHitInfo.t = FLT_MAX;
-    std::string* closest = nullptr;
 	
-	// Iterate through all polygons in the BSP and see if the ray intersects
-	// with any triangles inside the polygon. Triangles within the BSP are made
-	// up of "triangle fans", so the first vertex in a polygon is shared by all triangles.
-    for(auto& polygon : mPolygons)
-    {
-        BSPSurface& surface = mSurfaces[polygon.surfaceIndex];
-        if(!surface.interactive) { continue; }
-		
-        Vector3 p0 = mVertices[mVertexIndices[polygon.vertexIndexOffset]];
-        for(int i = 1; i < polygon.vertexIndexCount - 1; i++)
-        {
-            Vector3 p1 = mVertices[mVertexIndices[polygon.vertexIndexOffset + i]];
-            Vector3 p2 = mVertices[mVertexIndices[polygon.vertexIndexOffset + i + 1]];
-			RaycastHit hitInfo;
-			if(Collisions::TestRayTriangle(ray, p0, p1, p2, hitInfo))
-            {
-                if(hitInfo.t < outHitInfo.t)
-                {
-					// Save closest distance.
-                    outHitInfo.t = hitInfo.t;
-                    
-                    // Find surface for this polygon, and then name for the surface.
-                    closest = &mObjectNames[surface.objectIndex];
-                }
-            }
-        }
-    }
+	// Find the closest hit with any interactive surface.
+	BVH::Hit hit;
+	bool hitAny = mBVH.RaycastNearest(ray, [this](int triangleIndex) {
+		return GetTriangleSurface(triangleIndex).interactive;
+	}, hit);
 	
 	// If no closest object was found, no hits occurred. Early out.
-	if(closest == nullptr) { return false; }
+	if(!hitAny) { return false; }
 	
 	// Otherwise, fill in out hit info and return.
-	outHitInfo.name = *closest;
+	outHitInfo.t = hit.t;
+	outHitInfo.name = mObjectNames[GetTriangleSurface(hit.triangleIndex).objectIndex];
 	return true;
 }
 
 bool BSP::RaycastSingle(const Ray& ray, std::string name, RaycastHit& outHitInfo)
 {
-	for(auto& polygon : mPolygons)
+	// We're only interested in intersections with a certain object.
+	std::vector<bool> objectMatches(mObjectNames.size());
+	for(int i = 0; i < mObjectNames.size(); i++)
 	{
-		// We're only interested in intersections with a certain object.
-		// So, if this isn't the object, we can continue!
-        BSPSurface& surface = mSurfaces[polygon.surfaceIndex];
-        if(mObjectNames[surface.objectIndex] != name) { continue; }
-        if(!surface.interactive) { continue; }
-		
-        Vector3 p0 = mVertices[mVertexIndices[polygon.vertexIndexOffset]];
-        for(int i = 1; i < polygon.vertexIndexCount - 1; i++)
-		{
-            Vector3 p1 = mVertices[mVertexIndices[polygon.vertexIndexOffset + i]];
-            Vector3 p2 = mVertices[mVertexIndices[polygon.vertexIndexOffset + i + 1]];
-			if(Collisions::TestRayTriangle(ray, p0, p1, p2, outHitInfo))
-			{
-				// Save name of hit object.
-				outHitInfo.name = name;
-				return true;
-			}
-		}
+		objectMatches[i] = (mObjectNames[i] == name);
 	}
 	
+	std::vector<BVH::Hit> hits;
+	mBVH.RaycastAll(ray, [this, &objectMatches](int triangleIndex) {
+		const BSPSurface& surface = GetTriangleSurface(triangleIndex);
+		return objectMatches[surface.objectIndex] && surface.interactive;
+	}, hits);
+	
 	// Couldn't find the given name, or ray didn't intersect object with given name.
-	return false;
+	if(hits.empty()) { return false; }
+	
+	// Use the first hit polygon in the object - not necessarily the nearest.
+	outHitInfo.t = hits[0].t;
+	outHitInfo.name = name;
+	return true;
 }
 
 std::vector<RaycastHit> BSP::RaycastAll(const Ray& ray)
 {
-	std::vector<RaycastHit> hits;
+	std::vector<BVH::Hit> bvhHits;
+	mBVH.RaycastAll(ray, [this](int triangleIndex) {
+		return GetTriangleSurface(triangleIndex).interactive;
+	}, bvhHits);
 	
-	// Iterate through all polygons in the BSP and see if the ray intersects
-	// with any triangles inside the polygon. Triangles within the BSP are made
-	// up of "triangle fans", so the first vertex in a polygon is shared by all triangles.
-	for(auto& polygon : mPolygons)
+	// Convert to hit infos, with hit object names.
+	std::vector<RaycastHit> hits;
+	hits.reserve(bvhHits.size());
+	for(auto& bvhHit : bvhHits)
 	{
-        BSPSurface& surface = mSurfaces[polygon.surfaceIndex];
-        if(!surface.interactive) { continue; }
-		
-        Vector3 p0 = mVertices[mVertexIndices[polygon.vertexIndexOffset]];
-        for(int i = 1; i < polygon.vertexIndexCount - 1; i++)
-		{
-            Vector3 p1 = mVertices[mVertexIndices[polygon.vertexIndexOffset + i]];
-            Vector3 p2 = mVertices[mVertexIndices[polygon.vertexIndexOffset + i + 1]];
-			RaycastHit hitInfo;
-			if(Collisions::TestRayTriangle(ray, p0, p1, p2, hitInfo))
-			{
-				// Save hit object name.
-                hitInfo.name = mObjectNames[surface.objectIndex];
-				
-				// Add to hit info vector.
-				hits.push_back(hitInfo);
-			}
-		}
+		RaycastHit hitInfo;
+		hitInfo.t = bvhHit.t;
+		hitInfo.name = mObjectNames[GetTriangleSurface(bvhHit.triangleIndex).objectIndex];
+		hits.push_back(hitInfo);
 	}
-
-	// Return vector of hits.
 	return hits;
 }
 
+void BSP::GetObjectTriangles(const std::string& objectName, std::vector<Vector3>& outVertices, std::vector<const BSPSurface*>& outSurfaces) const
+{
+	// Same triangles as the BVH uses, and in the same order - but only those in the given object.
+	for(int triangleIndex = 0; triangleIndex < mTrianglePolygonIndexes.size(); triangleIndex++)
+	{
+		const BSPSurface& surface = GetTriangleSurface(triangleIndex);
+		if(mObjectNames[surface.objectIndex] != objectName) { continue; }
+		
+		mBVH.GetTriangle(triangleIndex, outVertices);
+		outSurfaces.push_back(&surface);
+	}
+}
+
 bool BSP::RaycastPolygon(const Ray& ray, const BSPPolygon* polygon, RaycastHit& outHitInfo)
 {
 	Vector3 p0 = mVertices[mVertexIndices[polygon->vertexIndexOffset]];
@@ -150,205 +127,95 @@ bool BSP::RaycastPolygon(const Ray& ray, const BSPPolygon* polygon, RaycastHit&
 BSPActor* BSP::CreateBSPActor(const std::string& objectName)
 {
 	// Find index for object name or fail.
-	int objectIndex = -1;
-	for(int i = 0; i < mObjectNames.size(); i++)
-	{
-		if(StringUtil::EqualsIgnoreCase(mObjectNames[i], objectName))
-		{
-			objectIndex = i;
-			break;
-		}
-	}
+	int objectIndex = GetObjectIndex(objectName);
 	if(objectIndex == -1) { return nullptr; }
 	
 	// OK, we found it! Create the actor.
 	BSPActor* actor = new BSPActor(this, objectName);
 	
-	// Generate AABB from this BSP object's position data.
-	bool firstPoint = true;
-	AABB aabb;
-	for(int surfaceIndex = 0; surfaceIndex < mSurfaces.size(); surfaceIndex++)
+	const BSPObject& object = mObjects[objectIndex];
+	for(auto& surfaceIndex : object.surfaceIndexes)
 	{
-        if(mSurfaces[surfaceIndex].objectIndex == objectIndex)
-		{
-			actor->AddSurface(&mSurfaces[surfaceIndex]);
-			
-			for(int polygonIndex = 0; polygonIndex < mPolygons.size(); polygonIndex++)
-			{
-                if(mPolygons[polygonIndex].surfaceIndex == surfaceIndex)
-				{
-					actor->AddPolygon(&mPolygons[polygonIndex]);
-					
-                    int start = mPolygons[polygonIndex].vertexIndexOffset;
-                    int end = start + mPolygons[polygonIndex].vertexIndexCount;
-					for(int k = start; k < end; k++)
-					{
-						if(firstPoint)
-						{
-							aabb = AABB(mVertices[mVertexIndices[k]], mVertices[mVertexIndices[k]]);
-							firstPoint = false;
-						}
-						else
-						{
-							aabb.GrowToContain(mVertices[mVertexIndices[k]]);
-						}
-					}
-				}
-			}
-		}
+		actor->AddSurface(&mSurfaces[surfaceIndex]);
 	}
-	actor->SetAABB(aabb);
+	for(auto& polygonIndex : object.polygonIndexes)
+	{
+		actor->AddPolygon(&mPolygons[polygonIndex]);
+	}
+	actor->SetAABB(object.aabb);
 	
 	// Position actor at center of BSP object position.
-	actor->SetPosition(GetPosition(objectName));
+	actor->SetPosition(object.center);
 	return actor;
 }
 
 void BSP::SetVisible(std::string objectName, bool visible)
 {
-	// Find index of the object name.
-	int index = -1;
-	for(int i = 0; i < mObjectNames.size(); i++)
-	{
-		if(StringUtil::EqualsIgnoreCase(mObjectNames[i], objectName))
-		{
-			index = i;
-			break;
-		}
-	}
-	
 	// Can't hide an object if the passed name isn't present.
+	int index = GetObjectIndex(objectName);
 	if(index == -1) { return; }
 	
 	// All surfaces belonging to this object will be hidden.
-	for(auto& surface : mSurfaces)
+	for(auto& surfaceIndex : mObjects[index].surfaceIndexes)
 	{
-        if(surface.objectIndex == index)
-		{
-            surface.visible = visible;
-		}
+		mSurfaces[surfaceIndex].visible = visible;
 	}
 }
 
 void BSP::SetTexture(std::string objectName, Texture* texture)
 {
-	// Find index of the object name.
-	int index = -1;
-	for(int i = 0; i < mObjectNames.size(); i++)
-	{
-		if(StringUtil::EqualsIgnoreCase(mObjectNames[i], objectName))
-		{
-			index = i;
-			break;
-		}
-	}
-	
-	// Can't hide an object if the passed name isn't present.
+	// Can't set texture if the passed name isn't present.
+	int index = GetObjectIndex(objectName);
 	if(index == -1) { return; }
 	
-	// All surfaces belonging to this object will be hidden.
-	for(auto& surface : mSurfaces)
+	// All surfaces belonging to this object get the texture.
+	for(auto& surfaceIndex : mObjects[index].surfaceIndexes)
 	{
-        if(surface.objectIndex == index)
-		{
-            surface.texture = texture;
-		}
+		mSurfaces[surfaceIndex].texture = texture;
 	}
 }
 
 bool BSP::Exists(std::string objectName) const
 {
-	for(int i = 0; i < mObjectNames.size(); i++)
-	{
-		if(StringUtil::EqualsIgnoreCase(mObjectNames[i], objectName))
-		{
-			return true;
-		}
-	}
-	return false;
+	return GetObjectIndex(objectName) != -1;
 }
 
 bool BSP::IsVisible(std::string objectName) const
 {
-	// Find index of the object name.
-	int index = -1;
-	for(int i = 0; i < mObjectNames.size(); i++)
-	{
-		if(StringUtil::EqualsIgnoreCase(mObjectNames[i], objectName))
-		{
-			index = i;
-			break;
-		}
-	}
-	
 	// If can't find object name, it's certainly not visible...
+	int index = GetObjectIndex(objectName);
 	if(index == -1) { return false; }
 	
-	// Find any surface belonging to this object and see if it is visible.
-	for(auto& surface : mSurfaces)
-	{
-        if(surface.objectIndex == index)
-		{
-            return surface.visible;
-		}
-	}
-	
 	// Worst case, no surfaces belong to this object. Must not be visible then!
-	return false;
+	const std::vector<unsigned int>& surfaceIndexes = mObjects[index].surfaceIndexes;
+	if(surfaceIndexes.empty()) { return false; }
+	
+	// Use visibility of the first surface belonging to this object.
+	return mSurfaces[surfaceIndexes[0]].visible;
 }
 
 Vector3 BSP::GetPosition(const std::string& objectName) const
 {
-	// Find index of the object name.
-	int objectIndex = -1;
-	for(int i = 0; i < mObjectNames.size(); i++)
-	{
-		if(StringUtil::EqualsIgnoreCase(mObjectNames[i], objectName))
-		{
-			objectIndex = i;
-			break;
-		}
-	}
-	
 	// Couldn't find object!
 	//TODO: Maybe we should return true/false with an out parameter?
+	int objectIndex = GetObjectIndex(objectName);
 	if(objectIndex == -1) { return Vector3::Zero; }
-	
-	// Find index of a surface.
-	Vector3 pos = Vector3::Zero;
-	int vertexCount = 0;
-	for(int i = 0; i < mSurfaces.size(); i++)
-	{
-        if(mSurfaces[i].objectIndex == objectIndex)
-		{
-			for(int j = 0; j < mPolygons.size(); j++)
-			{
-                if(mPolygons[j].surfaceIndex == i)
-				{
-                    int start = mPolygons[j].vertexIndexOffset;
-                    int end = start + mPolygons[j].vertexIndexCount;
-					
-					for(int k = start; k < end; k++)
-					{
-						pos += mVertices[mVertexIndices[k]];
-						vertexCount++;
-					}
-				}
-			}
-		}
-	}
-	
-	// Get average position.
-	return pos / vertexCount;
+	return mObjects[objectIndex].center;
 }
 
 void BSP::ApplyLightmap(const BSPLightmap& lightmap)
 {
-    const std::vector<Texture*>& lightmapTextures = lightmap.GetLightmapTextures();
-    for(int i = 0; i < mSurfaces.size(); ++i)
+    // Point each surface at its region of the lightmap atlas.
+    const std::vector<Texture*>& atlasTextures = lightmap.GetAtlasTextures();
+    for(size_t i = 0; i < mSurfaces.size() && i < static_cast<size_t>(lightmap.GetRegionCount()); ++i)
     {
-        mSurfaces[i].lightmapTexture = lightmapTextures[i];
+        BSPSurface& surface = mSurfaces[i];
+        const BSPLightmap::Region& region = lightmap.GetRegion(static_cast<int>(i));
+        surface.lightmapTexture = atlasTextures[region.page];
+        surface.lightmapUvScale = surface.surfaceLightmapUvScale * region.uvScale;
+        surface.lightmapUvOffset = surface.surfaceLightmapUvOffset * region.uvScale + region.uvOffset;
     }
+    RefreshLightmapUVs();
 }
 
 // For debugging BSP issues, helpful to track polygons rendered and tree depth.
@@ -357,27 +224,42 @@ int treeDepth = 0;
 
 void BSP::RenderOpaque(const Vector3& cameraPosition, const Vector3& cameraDirection)
 {
-    // Activate material for rendering.
-    mMaterial.Activate(Matrix4::Identity);
+    // Nothing to render if render vertices couldn't be built.
+    if(mRenderVertices.empty()) { return; }
     
     // Reset render stat values.
     renderedPolygonCount = 0;
     treeDepth = 0;
     
-    //glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+    // Gather visible polygons front-to-back. Translucent ones go on the alpha chain.
+    mOpaquePolygons.clear();
+    mAlphaPolygons = nullptr;
     RenderTree(mNodes[mRootNodeIndex], cameraPosition, cameraDirection);
+    
+    // Group polygons into batches and upload the indexes for all batches (opaque and translucent) at once.
+    BuildBatches();
+    if(!mBatchIndexes.empty())
+    {
+        mVertexArray.ChangeIndexData(&mBatchIndexes[0], static_cast<unsigned int>(mBatchIndexes.size()));
+    }
+    
+    // Activate material for rendering.
+    mMaterial.Activate(Matrix4::Identity);
+    
+    //glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+    DrawBatches(mOpaqueBatches);
     //glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
     
-    //std::cout << "Rendered " << renderedPolygonCount << " polygons." << std::endl;
+    //std::cout << "Rendered " << renderedPolygonCount << " polygons in " << mOpaqueBatches.size() << " batches." << std::endl;
 }
 
 void BSP::RenderTranslucent()
 {
-    BSPPolygon* polygon = mAlphaPolygons;
-    while(polygon != nullptr)
+    if(!mTranslucentBatches.empty())
     {
-        RenderPolygon(*polygon, true);
-        polygon = polygon->next;
+        mMaterial.Activate(Matrix4::Identity);
+        DrawBatches(mTranslucentBatches);
+        mTranslucentBatches.clear();
     }
     mAlphaPolygons = nullptr;
 }
@@ -460,7 +342,7 @@ void BSP::RenderTree(const BSPNode& node, const Vector3& cameraPosition, const V
         {
             for(int i = node.polygonIndex; i < node.polygonIndex + node.polygonCount; i++)
             {
-                RenderPolygon(mPolygons[i], false);
+                AddPolygon(mPolygons[i]);
                 ++renderedPolygonCount;
             }
         }
@@ -470,7 +352,7 @@ void BSP::RenderTree(const BSPNode& node, const Vector3& cameraPosition, const V
         {
             for(int i = node.polygonIndex2; i < node.polygonIndex2 + node.polygonCount2; i++)
             {
-                RenderPolygon(mPolygons[i], false);
+                AddPolygon(mPolygons[i]);
                 ++renderedPolygonCount;
             }
         }
@@ -485,48 +367,131 @@ void BSP::RenderTree(const BSPNode& node, const Vector3& cameraPosition, const V
     }
 }
 
-void BSP::RenderPolygon(BSPPolygon& polygon, bool translucent)
+void BSP::AddPolygon(BSPPolygon& polygon)
 {
     // If we have a valid surface reference, use it to get rendering configured.
     BSPSurface& surface = mSurfaces[polygon.surfaceIndex];
     
-    // Not going to render non-visible surfaces.
-    if(!surface.visible) { return; }
-		
-    // Retrieve texture and activate it, if possible.
+    // Not going to render non-visible (or degenerate) surfaces.
+    if(!surface.visible || polygon.vertexIndexCount < 3) { return; }
+    
+    // If has alpha, don't render it now, but add it to the alpha chain.
+    // Since polygons are added front-to-back, the chain ends up back-to-front.
     Texture* tex = surface.texture;
-    if(tex != nullptr)
+    if(tex != nullptr && tex->GetRenderType() == Texture::RenderType::Translucent)
     {
-        // If has alpha, don't render it now, but add it to the alpha chain.
-        if(tex->GetRenderType() == Texture::RenderType::Translucent && translucent)
+        polygon.next = mAlphaPolygons;
+        mAlphaPolygons = &polygon;
+        return;
+    }
+    mOpaquePolygons.push_back(&polygon);
+}
+
+void BSP::BuildBatches()
+{
+    // Assign each opaque polygon to the batch for its texture/lightmap, and count indexes each batch needs.
+    // Opaque rendering uses the z-buffer, so draw order between batches doesn't matter.
+    mOpaqueBatches.clear();
+    mSurfaceBatchIndexes.assign(mSurfaces.size(), -1);
+    for(BSPPolygon* polygon : mOpaquePolygons)
+    {
+        int& batchIndex = mSurfaceBatchIndexes[polygon->surfaceIndex];
+        if(batchIndex < 0)
         {
-            polygon.next = mAlphaPolygons;
-            mAlphaPolygons = &polygon;
-            return;
+            // Not many textures are visible at once, so a linear search is fine.
+            const BSPSurface& surface = mSurfaces[polygon->surfaceIndex];
+            for(size_t i = 0; i < mOpaqueBatches.size(); ++i)
+            {
+                if(mOpaqueBatches[i].texture == surface.texture && mOpaqueBatches[i].lightmapTexture == surface.lightmapTexture)
+                {
+                    batchIndex = static_cast<int>(i);
+                    break;
+                }
+            }
+            if(batchIndex < 0)
+            {
+                mOpaqueBatches.emplace_back();
+                mOpaqueBatches.back().texture = surface.texture;
+                mOpaqueBatches.back().lightmapTexture = surface.lightmapTexture;
+                batchIndex = static_cast<int>(mOpaqueBatches.size()) - 1;
+            }
         }
-        tex->Activate(0);
+        mOpaqueBatches[batchIndex].indexCount += (polygon->vertexIndexCount - 2) * 3;
     }
-    else
+    
+    // Lay out opaque batches one after another, then fill in indexes (each polygon is a triangle fan, converted to a triangle list).
+    unsigned int opaqueIndexCount = 0;
+    for(auto& batch : mOpaqueBatches)
     {
-        Texture::Deactivate();
+        batch.indexOffset = opaqueIndexCount;
+        opaqueIndexCount += batch.indexCount;
+        batch.indexCount = 0;
     }
-     
-    // Activate lightmap texture, if any.
-    Texture* lightmapTex = surface.lightmapTexture;
-    if(lightmapTex != nullptr)
+    mBatchIndexes.resize(opaqueIndexCount);
+    for(BSPPolygon* polygon : mOpaquePolygons)
     {
-        lightmapTex->Activate(1);
+        BSPBatch& batch = mOpaqueBatches[mSurfaceBatchIndexes[polygon->surfaceIndex]];
+        unsigned int indexOffset = batch.indexOffset + batch.indexCount;
+        AddBatchIndexes(*polygon, indexOffset);
+        batch.indexCount = indexOffset - batch.indexOffset;
     }
     
-    // Lightmap scale/offsets are used in shaders to calculate proper lightmap UVs.
-    Vector4 lightmapUvScaleOffset(surface.lightmapUvScale.x,
-                          surface.lightmapUvScale.y,
-                          surface.lightmapUvOffset.x,
-                          surface.lightmapUvOffset.y);
-    mMaterial.GetShader()->SetUniformVector4("uLightmapScaleOffset", lightmapUvScaleOffset);
+    // Translucent polygons must be drawn in alpha chain order, so only neighbors with the same texture/lightmap are batched.
+    mTranslucentBatches.clear();
+    for(BSPPolygon* polygon = mAlphaPolygons; polygon != nullptr; polygon = polygon->next)
+    {
+        const BSPSurface& surface = mSurfaces[polygon->surfaceIndex];
+        if(mTranslucentBatches.empty() ||
+           mTranslucentBatches.back().texture != surface.texture ||
+           mTranslucentBatches.back().lightmapTexture != surface.lightmapTexture)
+        {
+            mTranslucentBatches.emplace_back();
+            mTranslucentBatches.back().texture = surface.texture;
+            mTranslucentBatches.back().lightmapTexture = surface.lightmapTexture;
+            mTranslucentBatches.back().indexOffset = static_cast<unsigned int>(mBatchIndexes.size());
+        }
+        
+        unsigned int indexOffset = static_cast<unsigned int>(mBatchIndexes.size());
+        mBatchIndexes.resize(indexOffset + (polygon->vertexIndexCount - 2) * 3);
+        AddBatchIndexes(*polygon, indexOffset);
+        mTranslucentBatches.back().indexCount = indexOffset - mTranslucentBatches.back().indexOffset;
+    }
+}
 
-    // Draw the polygon.
-    mVertexArray.DrawTriangleFans(polygon.vertexIndexOffset, polygon.vertexIndexCount);
+void BSP::AddBatchIndexes(const BSPPolygon& polygon, unsigned int& indexOffset)
+{
+    // Same triangles a triangle fan would draw: the first vertex is shared by all triangles.
+    const unsigned short* fanIndexes = &mRenderVertexIndices[polygon.vertexIndexOffset];
+    for(int i = 1; i < polygon.vertexIndexCount - 1; ++i)
+    {
+        mBatchIndexes[indexOffset++] = fanIndexes[0];
+        mBatchIndexes[indexOffset++] = fanIndexes[i];
+        mBatchIndexes[indexOffset++] = fanIndexes[i + 1];
+    }
+}
+
+void BSP::DrawBatches(const std::vector<BSPBatch>& batches)
+{
+    for(auto& batch : batches)
+    {
+        // Activate texture, if possible.
+        if(batch.texture != nullptr)
+        {
+            batch.texture->Activate(0);
+        }
+        else
+        {
+            Texture::Deactivate();
+        }
+        
+        // Activate lightmap texture, if any.
+        if(batch.lightmapTexture != nullptr)
+        {
+            batch.lightmapTexture->Activate(1);
+        }
+        
+        mVertexArray.DrawTriangles(batch.indexOffset, batch.indexCount);
+    }
 }
 
 void BSP::ParseFromData(char *data, int dataLength)
@@ -573,8 +538,13 @@ void BSP::ParseFromData(char *data, int dataLength)
         
         surface.texture = Services::GetAssets()->LoadTexture(reader.ReadString(32));
         
-        surface.lightmapUvOffset = reader.ReadVector2();
-        surface.lightmapUvScale = reader.ReadVector2();
+        // The file applies offset before scale: lightmap UV = (UV + offset) * scale.
+        // Store as scale then offset, which is easier to remap to an atlas: UV * scale + (offset * scale).
+        Vector2 fileLightmapUvOffset = reader.ReadVector2();
+        surface.surfaceLightmapUvScale = reader.ReadVector2();
+        surface.surfaceLightmapUvOffset = fileLightmapUvOffset * surface.surfaceLightmapUvScale;
+        surface.lightmapUvScale = surface.surfaceLightmapUvScale;
+        surface.lightmapUvOffset = surface.surfaceLightmapUvOffset;
         
         reader.ReadFloat(); // Unknown - I had assumed this was a scale earlier, but I'm not sure.
         
@@ -702,24 +672,181 @@ void BSP::ParseFromData(char *data, int dataLength)
     }
     */
     
-    // Generate mesh definition.
+    // Build per-object data and BVH for faster object lookups and raycasts.
+    BuildObjects();
+    BuildBVH();
+    
+    // Create vertex array for rendering.
+    BuildVertexArray();
+}
+
+void BSP::BuildBVH()
+{
+	// Split each polygon's triangle fan into individual triangles, in polygon order.
+	// The first vertex in a polygon is shared by all its triangles.
+	std::vector<Vector3> triangleVertices;
+	for(int polygonIndex = 0; polygonIndex < mPolygons.size(); polygonIndex++)
+	{
+		const BSPPolygon& polygon = mPolygons[polygonIndex];
+		const Vector3& p0 = mVertices[mVertexIndices[polygon.vertexIndexOffset]];
+		for(int i = 1; i < polygon.vertexIndexCount - 1; i++)
+		{
+			triangleVertices.push_back(p0);
+			triangleVertices.push_back(mVertices[mVertexIndices[polygon.vertexIndexOffset + i]]);
+			triangleVertices.push_back(mVertices[mVertexIndices[polygon.vertexIndexOffset + i + 1]]);
+			mTrianglePolygonIndexes.push_back(polygonIndex);
+		}
+	}
+	mBVH.Build(triangleVertices);
+}
+
+void BSP::BuildObjects()
+{
+	// Object names are looked up case-insensitively. If names only differ in case, the first one wins.
+	mObjectIndexesByName.reserve(mObjectNames.size());
+	for(int i = 0; i < mObjectNames.size(); i++)
+	{
+		mObjectIndexesByName.insert(std::make_pair(StringUtil::ToLowerCopy(mObjectNames[i]), i));
+	}
+	
+	// Group polygons by surface, and surfaces by object (keeping the original order in both cases).
+	std::vector<std::vector<unsigned int>> surfacePolygonIndexes(mSurfaces.size());
+	for(int polygonIndex = 0; polygonIndex < mPolygons.size(); polygonIndex++)
+	{
+		unsigned short surfaceIndex = mPolygons[polygonIndex].surfaceIndex;
+		if(surfaceIndex < mSurfaces.size())
+		{
+			surfacePolygonIndexes[surfaceIndex].push_back(polygonIndex);
+		}
+	}
+	
+	mObjects.resize(mObjectNames.size());
+	for(int surfaceIndex = 0; surfaceIndex < mSurfaces.size(); surfaceIndex++)
+	{
+		unsigned int objectIndex = mSurfaces[surfaceIndex].objectIndex;
+		if(objectIndex < mObjects.size())
+		{
+			BSPObject& object = mObjects[objectIndex];
+			object.surfaceIndexes.push_back(surfaceIndex);
+			object.polygonIndexes.insert(object.polygonIndexes.end(), surfacePolygonIndexes[surfaceIndex].begin(), surfacePolygonIndexes[surfaceIndex].end());
+		}
+	}
+	
+	// Calculate each object's center (average of its polygons' vertices) and bounds.
+	for(auto& object : mObjects)
+	{
+		Vector3 pos = Vector3::Zero;
+		int vertexCount = 0;
+		for(auto& polygonIndex : object.polygonIndexes)
+		{
+			int start = mPolygons[polygonIndex].vertexIndexOffset;
+			int end = start + mPolygons[polygonIndex].vertexIndexCount;
+			for(int k = start; k < end; k++)
+			{
+				const Vector3& vertex = mVertices[mVertexIndices[k]];
+				if(vertexCount == 0)
+				{
+					object.aabb = AABB(vertex, vertex);
+				}
+				else
+				{
+					object.aabb.GrowToContain(vertex);
+				}
+				pos += vertex;
+				vertexCount++;
+			}
+		}
+		object.center = pos / vertexCount;
+	}
+}
+
+void BSP::BuildVertexArray()
+{
+    // Give each vertex/surface combination used by polygons its own render vertex.
+    // Batch indexes are unsigned shorts, so there can't be more render vertices than that can index.
+    std::unordered_map<unsigned int, unsigned short> renderVertexIndexes;
+    mRenderVertexIndices.resize(mVertexIndices.size());
+    for(auto& polygon : mPolygons)
+    {
+        for(int i = polygon.vertexIndexOffset; i < polygon.vertexIndexOffset + polygon.vertexIndexCount; ++i)
+        {
+            unsigned short vertexIndex = mVertexIndices[i];
+            unsigned int key = (static_cast<unsigned int>(polygon.surfaceIndex) << 16) | vertexIndex;
+            auto it = renderVertexIndexes.find(key);
+            if(it == renderVertexIndexes.end())
+            {
+                if(mRenderVertices.size() > USHRT_MAX)
+                {
+                    std::cout << "BSP has too many render vertices (more than " << USHRT_MAX + 1 << ") - it won't be rendered!" << std::endl;
+                    assert(false);
+                    mRenderVertices.clear();
+                    mRenderUVs.clear();
+                    mRenderVertexSurfaceIndexes.clear();
+                    mRenderVertexIndices.clear();
+                    return;
+                }
+                it = renderVertexIndexes.insert(std::make_pair(key, static_cast<unsigned short>(mRenderVertices.size()))).first;
+                mRenderVertices.push_back(mVertices[vertexIndex]);
+                mRenderUVs.push_back(mUVs[vertexIndex]);
+                mRenderVertexSurfaceIndexes.push_back(polygon.surfaceIndex);
+            }
+            mRenderVertexIndices[i] = it->second;
+        }
+    }
+    mRenderLightmapUVs.resize(mRenderVertices.size());
+    if(mRenderVertices.empty()) { return; }
+    
+    // Room for indexes for every polygon, so index changes each frame never need to reallocate.
+    unsigned int maxIndexCount = 0;
+    for(auto& polygon : mPolygons)
+    {
+        if(polygon.vertexIndexCount >= 3)
+        {
+            maxIndexCount += (polygon.vertexIndexCount - 2) * 3;
+        }
+    }
+    
+    // Generate mesh definition. Indexes are filled in each frame, for visible polygons only.
     MeshDefinition meshDefinition;
-    meshDefinition.meshUsage = MeshUsage::Static;
+    meshDefinition.meshUsage = MeshUsage::Dynamic;
     
     meshDefinition.vertexDefinition.layout = VertexDefinition::Layout::Packed;
     meshDefinition.vertexDefinition.attributes.push_back(VertexAttribute::Position);
     meshDefinition.vertexDefinition.attributes.push_back(VertexAttribute::UV1);
+    meshDefinition.vertexDefinition.attributes.push_back(VertexAttribute::UV2);
     
-    meshDefinition.vertexCount = static_cast<int>(mVertices.size());
+    meshDefinition.vertexCount = static_cast<int>(mRenderVertices.size());
     
     std::vector<float*> vertexData;
-    vertexData.push_back(reinterpret_cast<float*>(&mVertices[0]));
-    vertexData.push_back(reinterpret_cast<float*>(&mUVs[0]));
+    vertexData.push_back(reinterpret_cast<float*>(&mRenderVertices[0]));
+    vertexData.push_back(reinterpret_cast<float*>(&mRenderUVs[0]));
+    vertexData.push_back(reinterpret_cast<float*>(&mRenderLightmapUVs[0]));
     meshDefinition.vertexData = &vertexData[0];
     
-    meshDefinition.indexCount = static_cast<int>(mVertexIndices.size());
-    meshDefinition.indexData = static_cast<unsigned short*>(&mVertexIndices[0]);
+    meshDefinition.indexCount = maxIndexCount;
+    meshDefinition.indexData = nullptr;
     
-    // Create vertex array.
+    // Create vertex array, then fill in lightmap UVs.
     mVertexArray = VertexArray(meshDefinition);
+    RefreshLightmapUVs();
+}
+
+void BSP::RefreshLightmapUVs()
+{
+    // Each surface defines offset/scale to apply to texture UVs to get lightmap UVs.
+    for(size_t i = 0; i < mRenderVertices.size(); ++i)
+    {
+        const BSPSurface& surface = mSurfaces[mRenderVertexSurfaceIndexes[i]];
+        mRenderLightmapUVs[i] = mRenderUVs[i] * surface.lightmapUvScale + surface.lightmapUvOffset;
+    }
+    if(!mRenderLightmapUVs.empty())
+    {
+        mVertexArray.ChangeVertexData(VertexAttribute::Semantic::UV2, &mRenderLightmapUVs[0]);
+    }
+}
+
+int BSP::GetObjectIndex(const std::string& objectName) const
+{
+	auto it = mObjectIndexesByName.find(StringUtil::ToLowerCopy(objectName));
+	return it != mObjectIndexesByName.end() ? it->second : -1;
 }
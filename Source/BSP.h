@@ -12,6 +12,8 @@
 #include <unordered_map>
 #include <vector>
 
+#include "AABB.h"
+#include "BVH.h"
 #include "Material.h"
 #include "Mesh.h"
 #include "Plane.h"
@@ -75,15 +77,18 @@ struct BSPSurface
     // The texture used for this surface.
     Texture* texture = nullptr;
     
-    // An optional lightmap texture - applied from a lightmap asset.
-    //TODO: this works OK, but it'd be more efficient to use a lightmap atlas instead of many individual textures.
+    // An optional lightmap texture - an atlas page, applied from a lightmap asset.
     Texture* lightmapTexture = nullptr;
     
     // UVs used for the lightmap are often different from the UVs used for diffuse textures.
-    // The surface defines offset/scale to apply to each UV to properly render a lightmap on that surface.
+    // Lightmap UV = UV * scale + offset. Once a lightmap is applied, these address the surface's region of the atlas.
     Vector2 lightmapUvOffset;
     Vector2 lightmapUvScale;
     
+    // Lightmap UV offset/scale from the BSP file, relative to a lightmap just for this surface.
+    Vector2 surfaceLightmapUvOffset;
+    Vector2 surfaceLightmapUvScale;
+    
     // If true, this surface is rendered.
     bool visible = true;
 	
@@ -103,6 +108,9 @@ public:
 	std::vector<RaycastHit> RaycastAll(const Ray& ray);
 	bool RaycastPolygon(const Ray& ray, const BSPPolygon* polygon, RaycastHit& outHitInfo);
 	
+	// Gets triangles (three vertices each) making up an object, along with the surface each triangle belongs to.
+	void GetObjectTriangles(const std::string& objectName, std::vector<Vector3>& outVertices, std::vector<const BSPSurface*>& outSurfaces) const;
+	
 	void SetVisible(std::string objectName, bool visible);
 	void SetTexture(std::string objectName, Texture* texture);
 	
@@ -131,6 +139,9 @@ private:
     // reference polygons to be rendered at that node.
     std::vector<BSPPolygon> mPolygons;
     
+    // Opaque polygons to render this frame, in front-to-back order.
+    std::vector<BSPPolygon*> mOpaquePolygons;
+    
     // Opaque rendering occurs front-to-back, and a linked list of translucent polygons are generated.
     // The linked list can be iterated afterwards to render translucent geometry in the correct order.
     // Saw this in id's Quake/Doom code and thought it was pretty cool!
@@ -142,6 +153,20 @@ private:
     // Each BSP map is logically divided into objects.
     std::vector<std::string> mObjectNames;
     
+    // Per-object data, precalculated so object lookups don't need to scan all geometry.
+    // Indexes match object names list. Surfaces and polygons are in the order they appear in the BSP.
+    struct BSPObject
+    {
+        std::vector<unsigned int> surfaceIndexes;
+        std::vector<unsigned int> polygonIndexes;
+        Vector3 center;
+        AABB aabb;
+    };
+    std::vector<BSPObject> mObjects;
+    
+    // Maps lowercase object name to object index.
+    std::unordered_map<std::string, int> mObjectIndexesByName;
+    
     // Vertex attributes for BSP mesh.
     std::vector<Vector3> mVertices;
     std::vector<Vector2> mUVs;
@@ -149,14 +174,58 @@ private:
     // Vertex indices for BSP mesh.
     std::vector<unsigned short> mVertexIndices;
     
-    // Vertex array is loaded up with vertices/uvs/indices to perform rendering.
+    // Polygons are triangle fans; raycasts use a BVH over all those triangles.
+    // For each triangle in the BVH, the index of the polygon it's part of.
+    BVH mBVH;
+    std::vector<unsigned int> mTrianglePolygonIndexes;
+    
+    // Rendering uses its own copy of the vertices, since lightmap UVs are per-vertex, but calculated per-surface.
+    // A BSP vertex used by several surfaces is duplicated for each surface.
+    std::vector<Vector3> mRenderVertices;
+    std::vector<Vector2> mRenderUVs;
+    std::vector<Vector2> mRenderLightmapUVs;
+    std::vector<unsigned short> mRenderVertexSurfaceIndexes;
+    
+    // Same layout as vertex indices, but indexing render vertices.
+    std::vector<unsigned short> mRenderVertexIndices;
+    
+    // Visible polygons are drawn in batches: one draw per texture/lightmap combination.
+    // Each batch is a range of triangle list indexes, rebuilt every frame.
+    struct BSPBatch
+    {
+        Texture* texture = nullptr;
+        Texture* lightmapTexture = nullptr;
+        unsigned int indexOffset = 0;
+        unsigned int indexCount = 0;
+    };
+    std::vector<BSPBatch> mOpaqueBatches;
+    std::vector<BSPBatch> mTranslucentBatches;
+    std::vector<unsigned short> mBatchIndexes;
+    
+    // For each surface, the opaque batch it's in this frame (or -1 if not yet assigned).
+    std::vector<int> mSurfaceBatchIndexes;
+    
+    // Vertex array is loaded up with render vertices/uvs, and batch indexes each frame, to perform rendering.
     VertexArray mVertexArray;
     
     // Material for rendering BSP.
 	Material mMaterial;
     
     void RenderTree(const BSPNode& node, const Vector3& cameraPosition, const Vector3& cameraDirection);
-    void RenderPolygon(BSPPolygon& polygon, bool translucent);
+    void AddPolygon(BSPPolygon& polygon);
+    
+    void BuildBatches();
+    void AddBatchIndexes(const BSPPolygon& polygon, unsigned int& indexOffset);
+    void DrawBatches(const std::vector<BSPBatch>& batches);
     
     void ParseFromData(char* data, int dataLength);
+    void BuildObjects();
+    void BuildBVH();
+    void BuildVertexArray();
+    void RefreshLightmapUVs();
+    
+    // Returns index of object with name (case-insensitive), or -1 if it doesn't exist.
+    int GetObjectIndex(const std::string& objectName) const;
+    
+    const BSPSurface& GetTriangleSurface(int triangleIndex) const { return mSurfaces[mPolygons[mTrianglePolygonIndexes[triangleIndex]].surfaceIndex]; }
 };
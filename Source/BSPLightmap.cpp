@@ -5,52 +5,183 @@
 //
 #include "BSPLightmap.h"
 
+#include <cstring>
+
 #include "BinaryReader.h"
+#include "BinaryWriter.h"
+#include "GMath.h"
+#include "RectPacker.h"
 #include "Texture.h"
 
+// Atlas pages are at most this size. Lightmaps are small, so most scenes fit on one page.
+static const int kMaxAtlasPageSize = 1024;
+
+// Pixels around each lightmap in the atlas, copied from its edges.
+// Keeps bilinear filtering from blending in neighboring lightmaps.
+static const int kAtlasPadding = 2;
+
 BSPLightmap::BSPLightmap(std::string name, char* data, int dataLength) :
     Asset(name)
 {
     BinaryReader reader(data, dataLength);
     
-    // 4 bytes: file identifier "TULM" (MULT backwards).
+    // 4 bytes: file identifier - either "TULM" (MULT backwards) or our own baked atlas.
     std::string identifier = reader.ReadString(4);
-    if(identifier != "TLUM")
+    if(identifier == "TLUM")
+    {
+        ParseFromMulFormat(reader);
+    }
+    else if(identifier == "SLTA")
+    {
+        ParseFromBakedFormat(reader);
+    }
+    else
     {
         std::cout << "BSP lightmap asset does not have MULT identifier! Instead has " << identifier << std::endl;
-        return;
     }
+}
+
+BSPLightmap::~BSPLightmap()
+{
+    // This class owns the atlas textures, so we must delete them.
+    for(auto& texture : mAtlasTextures)
+    {
+        delete texture;
+    }
+    mAtlasTextures.clear();
+}
+
+void BSPLightmap::WriteBaked(BinaryWriter& writer)
+{
+    // 4 bytes: baked identifier "ATLS" (backwards, like the original).
+    writer.WriteString("SLTA");
     
+    // Atlas pages, as baked textures.
+    writer.WriteUInt(static_cast<uint32_t>(mAtlasTextures.size()));
+    for(auto& texture : mAtlasTextures)
+    {
+        texture->WriteBaked(writer);
+    }
+    
+    // Per-surface regions.
+    writer.WriteUInt(static_cast<uint32_t>(mRegions.size()));
+    for(auto& region : mRegions)
+    {
+        writer.WriteUInt(region.page);
+        writer.WriteFloat(region.uvScale.x);
+        writer.WriteFloat(region.uvScale.y);
+        writer.WriteFloat(region.uvOffset.x);
+        writer.WriteFloat(region.uvOffset.y);
+    }
+}
+
+void BSPLightmap::ParseFromMulFormat(BinaryReader& reader)
+{
     // 4 bytes: number of bitmaps in this asset.
     // This value correlates to the number of BSP surfaces in the corresponding BSP asset.
     unsigned int bitmapCount = reader.ReadUInt();
     
     // Iterate and read in each bitmap in turn.
+    // The texture will be read in using the same reader object.
+    // This should leave the reader ready to read in the NEXT texture (assuming no texture parsing bugs).
+    std::vector<Texture*> lightmapTextures;
     for(unsigned int i = 0; i < bitmapCount; i++)
     {
-        // The texture will be read in using the same reader object.
-        // This should leave the reader ready to read in the NEXT texture (assuming no texture parsing bugs).
-        Texture* texture = new Texture(reader);
-        texture->SetFilterMode(Texture::FilterMode::Bilinear);
-        texture->SetWrapMode(Texture::WrapMode::Clamp);
-        mLightmapTextures.push_back(texture);
+        lightmapTextures.push_back(new Texture(reader));
     }
     
     /*
     // Write out for debugging...
-    for(int i = 0; i < mLightmapTextures.size(); i++)
+    for(int i = 0; i < lightmapTextures.size(); i++)
     {
-        mLightmapTextures[i]->WriteToFile(GetNameNoExtension() + "_lm_" + std::to_string(i) + ".bmp");
+        lightmapTextures[i]->WriteToFile(GetNameNoExtension() + "_lm_" + std::to_string(i) + ".bmp");
     }
     */
+    
+    // Individual textures are only needed to build the atlas.
+    BuildAtlas(lightmapTextures);
+    for(auto& texture : lightmapTextures)
+    {
+        delete texture;
+    }
 }
 
-BSPLightmap::~BSPLightmap()
+void BSPLightmap::ParseFromBakedFormat(BinaryReader& reader)
 {
-    // This class owns the textures created in the constructor, so we must delete them.
-    for(auto& texture : mLightmapTextures)
+    // Atlas pages.
+    unsigned int pageCount = reader.ReadUInt();
+    for(unsigned int i = 0; i < pageCount; i++)
     {
-        delete texture;
+        Texture* texture = new Texture(reader);
+        texture->SetFilterMode(Texture::FilterMode::Bilinear);
+        texture->SetWrapMode(Texture::WrapMode::Clamp);
+        mAtlasTextures.push_back(texture);
+    }
+    
+    // Per-surface regions.
+    unsigned int regionCount = reader.ReadUInt();
+    mRegions.resize(regionCount);
+    for(auto& region : mRegions)
+    {
+        region.page = reader.ReadUInt();
+        region.uvScale = reader.ReadVector2();
+        region.uvOffset = reader.ReadVector2();
+    }
+}
+
+void BSPLightmap::BuildAtlas(const std::vector<Texture*>& lightmapTextures)
+{
+    // Figure out where each lightmap goes.
+    std::vector<RectPacker::Rect> rects(lightmapTextures.size());
+    for(int i = 0; i < lightmapTextures.size(); ++i)
+    {
+        rects[i].width = lightmapTextures[i]->GetWidth();
+        rects[i].height = lightmapTextures[i]->GetHeight();
+    }
+    RectPacker packer(kMaxAtlasPageSize, kMaxAtlasPageSize, kAtlasPadding);
+    packer.Pack(rects);
+    
+    // Create atlas pages.
+    for(int i = 0; i < packer.GetPageCount(); ++i)
+    {
+        Texture* texture = new Texture(packer.GetPageWidth(i), packer.GetPageHeight(i), Color32::White);
+        texture->SetFilterMode(Texture::FilterMode::Bilinear);
+        texture->SetWrapMode(Texture::WrapMode::Clamp);
+        mAtlasTextures.push_back(texture);
+    }
+    
+    // Copy each lightmap into its page, including padding.
+    mRegions.resize(lightmapTextures.size());
+    for(int i = 0; i < lightmapTextures.size(); ++i)
+    {
+        const Texture* source = lightmapTextures[i];
+        const RectPacker::Rect& rect = rects[i];
+        Texture* page = mAtlasTextures[rect.page];
+        
+        int width = rect.width;
+        int height = rect.height;
+        if(width > 0 && height > 0)
+        {
+            // Padding pixels repeat the nearest edge pixel - the same result clamping gave with separate textures.
+            for(int y = -kAtlasPadding; y < height + kAtlasPadding; ++y)
+            {
+                int sourceY = Math::Clamp(y, 0, height - 1);
+                unsigned char* destRow = page->GetPixelData() + ((rect.y + y) * page->GetWidth() + rect.x) * 4;
+                const unsigned char* sourceRow = source->GetPixelData() + sourceY * width * 4;
+                for(int x = -kAtlasPadding; x < width + kAtlasPadding; ++x)
+                {
+                    int sourceX = Math::Clamp(x, 0, width - 1);
+                    std::memcpy(destRow + x * 4, sourceRow + sourceX * 4, 4);
+                }
+            }
+        }
+        
+        // Lightmap UVs (0-1 across the surface's lightmap) map to the lightmap's rect in the atlas.
+        Region& region = mRegions[i];
+        region.page = rect.page;
+        region.uvScale = Vector2(static_cast<float>(width) / page->GetWidth(),
+                                 static_cast<float>(height) / page->GetHeight());
+        region.uvOffset = Vector2(static_cast<float>(rect.x) / page->GetWidth(),
+                                  static_cast<float>(rect.y) / page->GetHeight());
     }
-    mLightmapTextures.clear();
 }
@@ -3,14 +3,14 @@
 //
 // Clark Kromenaker
 //
-// A lightmap for BSP geometry. Contains an array of textures meant to
-// be applied to BSP surfaces to give the appearance of light and shadows.
+// A lightmap for BSP geometry. Gives BSP surfaces the appearance of light and shadows.
 //
 // Each lightmap is meant for a specific BSP geometry. A BSP may have multiple
 // lightmaps (e.g. a lightmap for morning, one for evening, one for night).
 //
 // In-memory representation of .MUL files. The MUL file format is basically
-// a blob containing one or more BMP files.
+// a blob containing one or more BMP files, one per BSP surface. On load, these are
+// packed into one (or a few) atlas textures, so BSP rendering needs far fewer textures.
 //
 #pragma once
 #include "Asset.h"
@@ -18,19 +18,46 @@
 #include <string>
 #include <vector>
 
+#include "Vector2.h"
+
+class BinaryReader;
+class BinaryWriter;
 class Texture;
 
 class BSPLightmap : public Asset
 {
 public:
+    // Where a surface's lightmap ended up in the atlas.
+    // To get atlas UVs, multiply the surface's lightmap UVs by scale, then add offset.
+    struct Region
+    {
+        int page = 0;
+        Vector2 uvScale = Vector2::One;
+        Vector2 uvOffset;
+    };
+    
     BSPLightmap(std::string name, char* data, int dataLength);
     ~BSPLightmap();
     
-    const std::vector<Texture*>& GetLightmapTextures() const { return mLightmapTextures; }
+    const std::vector<Texture*>& GetAtlasTextures() const { return mAtlasTextures; }
+    
+    // Regions are in the same order as the surfaces in the BSP file.
+    int GetRegionCount() const { return static_cast<int>(mRegions.size()); }
+    const Region& GetRegion(int surfaceIndex) const { return mRegions[surfaceIndex]; }
+    
+    // Writes the lightmap already packed into an atlas. This is read back in by the normal constructor.
+    void WriteBaked(BinaryWriter& writer);
     
 private:
-    // Textures loaded from the MUL file.
-    // Order is important, and aligns with order of surfaces in BSP file.
+    // Atlas textures, with all surface lightmaps packed into them.
     // Unlike most Textures, this asset owns these Textures, and is responsible for cleanup!
-    std::vector<Texture*> mLightmapTextures;
+    std::vector<Texture*> mAtlasTextures;
+    
+    // Per-surface location in the atlas.
+    std::vector<Region> mRegions;
+    
+    void ParseFromMulFormat(BinaryReader& reader);
+    void ParseFromBakedFormat(BinaryReader& reader);
+    
+    void BuildAtlas(const std::vector<Texture*>& lightmapTextures);
 };
@@ -0,0 +1,144 @@
+//
+// BVH.cpp
+//
+// Clark Kromenaker
+//
+#include "BVH.h"
+
+#include "GMath.h"
+
+namespace
+{
+	// Node bounds are grown slightly, so rounding in box tests never skips a triangle the triangle test would hit.
+	const float kBoundsPadding = 0.01f;
+}
+
+BVH::RayInfo::RayInfo(const Ray& ray) :
+	origin(ray.origin)
+{
+	for(int i = 0; i < 3; ++i)
+	{
+		parallel[i] = (ray.direction[i] == 0.0f);
+		inverseDirection[i] = parallel[i] ? 0.0f : 1.0f / ray.direction[i];
+	}
+}
+
+void BVH::Build(const std::vector<Vector3>& triangleVertices)
+{
+	mVertices = triangleVertices;
+	mNodes.clear();
+	mTriangleOrder.clear();
+
+	int triangleCount = GetTriangleCount();
+	if(triangleCount == 0) { return; }
+
+	// Triangles are sorted by their centroids when splitting nodes.
+	std::vector<Vector3> centroids;
+	centroids.reserve(triangleCount);
+	mTriangleOrder.reserve(triangleCount);
+	for(int i = 0; i < triangleCount; ++i)
+	{
+		centroids.push_back((mVertices[i * 3] + mVertices[i * 3 + 1] + mVertices[i * 3 + 2]) / 3.0f);
+		mTriangleOrder.push_back(i);
+	}
+
+	// A binary tree with small leaves has fewer than this many nodes.
+	mNodes.reserve(triangleCount * 2);
+	mNodes.emplace_back();
+	BuildNode(0, 0, triangleCount, 1, centroids);
+}
+
+void BVH::BuildNode(int nodeIndex, int start, int count, int depth, const std::vector<Vector3>& centroids)
+{
+	// Calculate bounds of all triangles, and of their centroids.
+	Vector3 min(FLT_MAX, FLT_MAX, FLT_MAX);
+	Vector3 max(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+	Vector3 centroidMin = min;
+	Vector3 centroidMax = max;
+	for(int i = start; i < start + count; ++i)
+	{
+		int triangleIndex = mTriangleOrder[i];
+		for(int axis = 0; axis < 3; ++axis)
+		{
+			for(int vertex = 0; vertex < 3; ++vertex)
+			{
+				float value = mVertices[triangleIndex * 3 + vertex][axis];
+				min[axis] = Math::Min(min[axis], value);
+				max[axis] = Math::Max(max[axis], value);
+			}
+			centroidMin[axis] = Math::Min(centroidMin[axis], centroids[triangleIndex][axis]);
+			centroidMax[axis] = Math::Max(centroidMax[axis], centroids[triangleIndex][axis]);
+		}
+	}
+	Vector3 padding(kBoundsPadding, kBoundsPadding, kBoundsPadding);
+	mNodes[nodeIndex].min = min - padding;
+	mNodes[nodeIndex].max = max + padding;
+
+	// Make a leaf if there are few enough triangles, or the tree is too deep.
+	if(count <= kMaxLeafTriangles || depth >= kMaxDepth)
+	{
+		mNodes[nodeIndex].start = start;
+		mNodes[nodeIndex].count = count;
+		return;
+	}
+
+	// Split in half along the longest axis of the centroid bounds.
+	Vector3 centroidSize = centroidMax - centroidMin;
+	int axis = 0;
+	if(centroidSize.y > centroidSize[axis]) { axis = 1; }
+	if(centroidSize.z > centroidSize[axis]) { axis = 2; }
+
+	int half = count / 2;
+	std::nth_element(mTriangleOrder.begin() + start, mTriangleOrder.begin() + start + half, mTriangleOrder.begin() + start + count, [&centroids, axis](int a, int b) {
+		return centroids[a][axis] < centroids[b][axis];
+	});
+
+	// Children are added next to each other. Careful: adding nodes invalidates references into the node list.
+	int childIndex = static_cast<int>(mNodes.size());
+	mNodes.emplace_back();
+	mNodes.emplace_back();
+	mNodes[nodeIndex].start = childIndex;
+	mNodes[nodeIndex].count = 0;
+
+	BuildNode(childIndex, start, half, depth + 1, centroids);
+	BuildNode(childIndex + 1, start + half, count - half, depth + 1, centroids);
+}
+
+bool BVH::RaycastNode(const RayInfo& rayInfo, const Node& node, float maxT, float& outEnterT) const
+{
+	// Find range of "t" for which the ray is inside all three slabs of the box.
+	float enterT = 0.0f;
+	float exitT = maxT;
+	for(int axis = 0; axis < 3; ++axis)
+	{
+		// A ray parallel to a slab is either always or never inside it.
+		if(rayInfo.parallel[axis])
+		{
+			if(rayInfo.origin[axis] < node.min[axis] || rayInfo.origin[axis] > node.max[axis]) { return false; }
+			continue;
+		}
+
+		float t1 = (node.min[axis] - rayInfo.origin[axis]) * rayInfo.inverseDirection[axis];
+		float t2 = (node.max[axis] - rayInfo.origin[axis]) * rayInfo.inverseDirection[axis];
+		if(t1 > t2) { std::swap(t1, t2); }
+
+		if(t1 > enterT) { enterT = t1; }
+		if(t2 < exitT) { exitT = t2; }
+		if(enterT > exitT) { return false; }
+	}
+
+	outEnterT = enterT;
+	return true;
+}
+
+bool BVH::RaycastTriangle(const Ray& ray, int triangleIndex, float& outT) const
+{
+	// Use the same test as non-BVH raycasts, so results are identical.
+	RaycastHit hitInfo;
+	if(Collisions::TestRayTriangle(ray, mVertices[triangleIndex * 3], mVertices[triangleIndex * 3 + 1], mVertices[triangleIndex * 3 + 2], hitInfo))
+	{
+		outT = hitInfo.t;
+		return true;
+	}
+	return false;
+}
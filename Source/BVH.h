@@ -0,0 +1,209 @@
+//
+// BVH.h
+//
+// Clark Kromenaker
+//
+// A "bounding volume hierarchy" over a set of triangles, to speed up raycasts.
+// Triangles are grouped into a tree of AABBs, so a raycast only needs to test
+// triangles in boxes the ray passes through, rather than every triangle.
+//
+// Triangles are identified by the order they were provided in. Raycasts give the same
+// results as testing every triangle in that order would (including how ties are broken).
+//
+#pragma once
+#include <algorithm>
+#include <cfloat>
+#include <vector>
+
+#include "Collisions.h"
+#include "Ray.h"
+#include "Vector3.h"
+
+class BVH
+{
+public:
+	struct Hit
+	{
+		// Index of the triangle that was hit.
+		int triangleIndex = -1;
+
+		// The "t" value at which the hit occurred.
+		float t = FLT_MAX;
+	};
+
+	// Builds the hierarchy. Each consecutive three vertices define a triangle.
+	void Build(const std::vector<Vector3>& triangleVertices);
+
+	int GetTriangleCount() const { return static_cast<int>(mVertices.size() / 3); }
+
+	// Appends a triangle's three vertices to a list.
+	void GetTriangle(int triangleIndex, std::vector<Vector3>& outVertices) const
+	{
+		outVertices.insert(outVertices.end(), mVertices.begin() + triangleIndex * 3, mVertices.begin() + triangleIndex * 3 + 3);
+	}
+
+	// Finds the nearest hit triangle for which filter(triangleIndex) returns true.
+	// If several are hit at the same distance, the one with the lowest index is chosen.
+	template<class Filter> bool RaycastNearest(const Ray& ray, Filter filter, Hit& outHit) const;
+
+	// Finds all hit triangles for which filter(triangleIndex) returns true, in triangle index order.
+	template<class Filter> void RaycastAll(const Ray& ray, Filter filter, std::vector<Hit>& outHits) const;
+
+private:
+	struct Node
+	{
+		// Bounds of all triangles under this node.
+		Vector3 min;
+		Vector3 max;
+
+		// For leaves, a range in the triangle order list.
+		// For interior nodes, count is zero, and start is the index of the first child node (the second follows it).
+		int start = 0;
+		int count = 0;
+	};
+
+	// Ray values that are reused for every box test in a raycast.
+	struct RayInfo
+	{
+		RayInfo(const Ray& ray);
+
+		Vector3 origin;
+		Vector3 inverseDirection;
+		bool parallel[3];
+	};
+
+	// Max triangles in a leaf node.
+	static const int kMaxLeafTriangles = 4;
+
+	// Max depth of the tree, which limits the size of the stack needed for traversal.
+	static const int kMaxDepth = 64;
+
+	// Triangle vertices, three per triangle, in the order provided.
+	std::vector<Vector3> mVertices;
+
+	// Triangle indexes, ordered so each leaf node's triangles are contiguous.
+	std::vector<int> mTriangleOrder;
+
+	// Tree nodes - the first node is the root.
+	std::vector<Node> mNodes;
+
+	void BuildNode(int nodeIndex, int start, int count, int depth, const std::vector<Vector3>& centroids);
+
+	// Tests ray against a node's bounds. If hit, outputs the "t" value at which the ray enters the box.
+	bool RaycastNode(const RayInfo& rayInfo, const Node& node, float maxT, float& outEnterT) const;
+
+	bool RaycastTriangle(const Ray& ray, int triangleIndex, float& outT) const;
+};
+
+template<class Filter>
+bool BVH::RaycastNearest(const Ray& ray, Filter filter, Hit& outHit) const
+{
+	if(mNodes.empty()) { return false; }
+	RayInfo rayInfo(ray);
+
+	Hit nearest;
+	int stack[kMaxDepth * 2];
+	int stackSize = 0;
+	stack[stackSize++] = 0;
+	while(stackSize > 0)
+	{
+		// Skip nodes that are missed, or only entered beyond the nearest hit so far.
+		// Nodes entered at exactly that distance could still contain a tie with a lower index.
+		const Node& node = mNodes[stack[--stackSize]];
+		float enterT = 0.0f;
+		if(!RaycastNode(rayInfo, node, nearest.t, enterT)) { continue; }
+
+		if(node.count > 0)
+		{
+			for(int i = node.start; i < node.start + node.count; ++i)
+			{
+				int triangleIndex = mTriangleOrder[i];
+				float t = 0.0f;
+				if(filter(triangleIndex) && RaycastTriangle(ray, triangleIndex, t))
+				{
+					if(t < nearest.t || (t == nearest.t && triangleIndex < nearest.triangleIndex))
+					{
+						nearest.t = t;
+						nearest.triangleIndex = triangleIndex;
+					}
+				}
+			}
+		}
+		else
+		{
+			// Visit the nearer child first (it's pushed last), so more of the farther child can be skipped.
+			const Node& first = mNodes[node.start];
+			const Node& second = mNodes[node.start + 1];
+			float firstT = 0.0f;
+			float secondT = 0.0f;
+			bool hitFirst = RaycastNode(rayInfo, first, nearest.t, firstT);
+			bool hitSecond = RaycastNode(rayInfo, second, nearest.t, secondT);
+			if(hitFirst && hitSecond)
+			{
+				if(firstT <= secondT)
+				{
+					stack[stackSize++] = node.start + 1;
+					stack[stackSize++] = node.start;
+				}
+				else
+				{
+					stack[stackSize++] = node.start;
+					stack[stackSize++] = node.start + 1;
+				}
+			}
+			else if(hitFirst)
+			{
+				stack[stackSize++] = node.start;
+			}
+			else if(hitSecond)
+			{
+				stack[stackSize++] = node.start + 1;
+			}
+		}
+	}
+
+	if(nearest.triangleIndex < 0) { return false; }
+	outHit = nearest;
+	return true;
+}
+
+template<class Filter>
+void BVH::RaycastAll(const Ray& ray, Filter filter, std::vector<Hit>& outHits) const
+{
+	outHits.clear();
+	if(mNodes.empty()) { return; }
+	RayInfo rayInfo(ray);
+
+	int stack[kMaxDepth * 2];
+	int stackSize = 0;
+	stack[stackSize++] = 0;
+	while(stackSize > 0)
+	{
+		const Node& node = mNodes[stack[--stackSize]];
+		float enterT = 0.0f;
+		if(!RaycastNode(rayInfo, node, FLT_MAX, enterT)) { continue; }
+
+		if(node.count > 0)
+		{
+			for(int i = node.start; i < node.start + node.count; ++i)
+			{
+				Hit hit;
+				hit.triangleIndex = mTriangleOrder[i];
+				if(filter(hit.triangleIndex) && RaycastTriangle(ray, hit.triangleIndex, hit.t))
+				{
+					outHits.push_back(hit);
+				}
+			}
+		}
+		else
+		{
+			stack[stackSize++] = node.start;
+			stack[stackSize++] = node.start + 1;
+		}
+	}
+
+	// Report hits in the same order as testing triangles in order would.
+	std::sort(outHits.begin(), outHits.end(), [](const Hit& a, const Hit& b) {
+		return a.triangleIndex < b.triangleIndex;
+	});
+}
@@ -0,0 +1,162 @@
+//
+// BakedBarnFile.cpp
+//
+// Clark Kromenaker
+//
+#include "BakedBarnFile.h"
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "BarnFile.h"
+#include "BinaryReader.h"
+#include "BinaryWriter.h"
+#include "BSPLightmap.h"
+#include "StringUtil.h"
+#include "Texture.h"
+
+/*static*/ int BakedBarnFile::Bake(BarnFile& barn, const std::string& filePath)
+{
+	BinaryWriter writer(filePath.c_str());
+	if(!writer.OK()) { return 0; }
+
+	// Header - count and index offset are filled in at the end.
+	writer.WriteUInt(kIdentifier);
+	writer.WriteUInt(kVersion);
+	writer.WriteUInt(0);
+	writer.WriteUInt(0);
+
+	// Bake assets in a consistent order, so baking the same barn twice gives the same file.
+	std::vector<std::string> assetNames = barn.GetAssetNames();
+	std::sort(assetNames.begin(), assetNames.end());
+
+	std::vector<std::pair<std::string, Entry>> entries;
+	for(auto& assetName : assetNames)
+	{
+		if(!CanBake(assetName)) { continue; }
+
+		// Extract original asset bytes.
+		BarnAsset* barnAsset = barn.GetAsset(assetName);
+		std::unique_ptr<char[]> buffer(new char[barnAsset->uncompressedSize]);
+		if(!barn.Extract(assetName, buffer.get(), barnAsset->uncompressedSize)) { continue; }
+
+		// Load the asset from the original bytes, and write it back out baked.
+		// Assets that fail to load aren't baked, so the original gets used (and reports the problem) at runtime.
+		Entry entry;
+		entry.offset = writer.GetPosition();
+		if(StringUtil::EndsWith(assetName, ".BMP"))
+		{
+			Texture texture(assetName, buffer.get(), barnAsset->uncompressedSize);
+			if(texture.GetPixelData() == nullptr) { continue; }
+			texture.WriteBaked(writer);
+		}
+		else if(StringUtil::EndsWith(assetName, ".MUL"))
+		{
+			BSPLightmap lightmap(assetName, buffer.get(), barnAsset->uncompressedSize);
+			if(lightmap.GetAtlasTextures().empty()) { continue; }
+			lightmap.WriteBaked(writer);
+		}
+		entry.size = writer.GetPosition() - entry.offset;
+
+		entry.sourceOffset = barnAsset->offset;
+		entry.sourceCompressionType = static_cast<unsigned int>(barnAsset->compressionType);
+		entry.sourceCompressedSize = barnAsset->compressedSize;
+		entry.sourceUncompressedSize = barnAsset->uncompressedSize;
+		entries.push_back(std::make_pair(assetName, entry));
+	}
+
+	// Index goes after all the data.
+	unsigned int indexOffset = writer.GetPosition();
+	for(auto& entry : entries)
+	{
+		writer.WriteUByte(static_cast<uint8_t>(entry.first.size()));
+		writer.WriteString(entry.first);
+		writer.WriteUInt(entry.second.offset);
+		writer.WriteUInt(entry.second.size);
+		writer.WriteUInt(entry.second.sourceOffset);
+		writer.WriteUInt(entry.second.sourceCompressionType);
+		writer.WriteUInt(entry.second.sourceCompressedSize);
+		writer.WriteUInt(entry.second.sourceUncompressedSize);
+	}
+
+	// Go back and fill in the header.
+	writer.Seek(8);
+	writer.WriteUInt(static_cast<uint32_t>(entries.size()));
+	writer.WriteUInt(indexOffset);
+	return writer.OK() ? static_cast<int>(entries.size()) : 0;
+}
+
+BakedBarnFile::BakedBarnFile(const std::string& filePath) :
+	mMappedFile(filePath)
+{
+	if(!mMappedFile.IsOpen()) { return; }
+	BinaryReader reader(mMappedFile.GetData(), mMappedFile.GetSize());
+
+	// Baked files from other engine versions may not be compatible, so just ignore them.
+	unsigned int identifier = reader.ReadUInt();
+	unsigned int version = reader.ReadUInt();
+	if(identifier != kIdentifier || version != kVersion)
+	{
+		std::cout << "Ignoring baked file " << filePath << ", as it is out of date." << std::endl;
+		return;
+	}
+
+	unsigned int entryCount = reader.ReadUInt();
+	unsigned int indexOffset = reader.ReadUInt();
+	reader.Seek(indexOffset);
+
+	mEntries.reserve(entryCount);
+	for(unsigned int i = 0; i < entryCount; ++i)
+	{
+		unsigned char nameLength = reader.ReadUByte();
+		std::string name = reader.ReadString(nameLength);
+
+		Entry entry;
+		entry.offset = reader.ReadUInt();
+		entry.size = reader.ReadUInt();
+		entry.sourceOffset = reader.ReadUInt();
+		entry.sourceCompressionType = reader.ReadUInt();
+		entry.sourceCompressedSize = reader.ReadUInt();
+		entry.sourceUncompressedSize = reader.ReadUInt();
+
+		// Don't trust entries that point outside the file.
+		if(entry.offset > mMappedFile.GetSize() || entry.size > mMappedFile.GetSize() - entry.offset) { break; }
+		mEntries[name] = entry;
+	}
+
+	// If the file is truncated or corrupt, ignore it entirely.
+	if(!reader.OK())
+	{
+		std::cout << "Ignoring baked file " << filePath << ", as it is corrupt." << std::endl;
+		mEntries.clear();
+		return;
+	}
+	mOpen = true;
+}
+
+const char* BakedBarnFile::GetAssetData(const BarnAsset& barnAsset, unsigned int& outSize) const
+{
+	auto it = mEntries.find(barnAsset.name);
+	if(it == mEntries.end()) { return nullptr; }
+
+	// If the barn asset has changed since baking, the baked data is stale.
+	const Entry& entry = it->second;
+	if(entry.sourceOffset != barnAsset.offset ||
+	   entry.sourceCompressionType != static_cast<unsigned int>(barnAsset.compressionType) ||
+	   entry.sourceCompressedSize != barnAsset.compressedSize ||
+	   entry.sourceUncompressedSize != barnAsset.uncompressedSize)
+	{
+		return nullptr;
+	}
+
+	outSize = entry.size;
+	return mMappedFile.GetData() + entry.offset;
+}
+
+/*static*/ bool BakedBarnFile::CanBake(const std::string& assetName)
+{
+	// Textures and lightmaps spend most of their load time expanding pixels (and packing, for lightmaps), so benefit the most from baking.
+	return StringUtil::EndsWith(assetName, ".BMP") || StringUtil::EndsWith(assetName, ".MUL");
+}
@@ -0,0 +1,69 @@
+//
+// BakedBarnFile.h
+//
+// Clark Kromenaker
+//
+// A companion to a barn file, containing some of the barn's assets converted ("baked") ahead of time
+// into formats that are much faster to load than the originals (e.g. textures with already expanded pixels).
+//
+// The baked file is memory-mapped, and baked data is handed to asset constructors in place,
+// which recognize baked formats. Each baked asset remembers which barn asset it was made from;
+// if that barn asset has since changed, the baked data is ignored and the original is used instead.
+//
+// File layout (little-endian; offsets are from the start of the file):
+//   Header:  4 bytes "GBAK", 4 bytes version, 4 bytes asset count, 4 bytes index offset
+//   Data:    Baked asset data, back-to-back
+//   Index:   Per asset: 1 byte name length, name, then 4 bytes each for data offset, data size,
+//            and source offset, compression type, compressed size, and uncompressed size in the barn
+//
+#pragma once
+#include <string>
+#include <unordered_map>
+
+#include "BarnAsset.h"
+#include "MemoryMappedFile.h"
+
+class BarnFile;
+
+class BakedBarnFile
+{
+public:
+	// Bakes all supported assets in a barn, and writes them to a file. Returns the number of assets baked.
+	static int Bake(BarnFile& barn, const std::string& filePath);
+
+	BakedBarnFile(const std::string& filePath);
+
+	// True if the file was mapped, and is a baked file of the current version.
+	bool IsOpen() const { return mOpen; }
+
+	// Returns a read-only pointer to baked data for a barn asset, or null if there's no up-to-date baked data.
+	const char* GetAssetData(const BarnAsset& barnAsset, unsigned int& outSize) const;
+
+private:
+	// Identifies the file type, and the version of the baked formats.
+	// Bump the version whenever any baked format changes, so stale files are ignored.
+	static const unsigned int kIdentifier = 0x4B414247; // GBAK
+	static const unsigned int kVersion = 1;
+
+	struct Entry
+	{
+		// Where the baked data is in this file.
+		unsigned int offset = 0;
+		unsigned int size = 0;
+
+		// Where the asset was in the barn, when it was baked.
+		unsigned int sourceOffset = 0;
+		unsigned int sourceCompressionType = 0;
+		unsigned int sourceCompressedSize = 0;
+		unsigned int sourceUncompressedSize = 0;
+	};
+
+	// Mapping of the entire file.
+	MemoryMappedFile mMappedFile;
+	bool mOpen = false;
+
+	// Baked assets, by name.
+	std::unordered_map<std::string, Entry> mEntries;
+
+	static bool CanBake(const std::string& assetName);
+};
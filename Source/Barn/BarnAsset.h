@@ -36,5 +36,5 @@ public:
     unsigned int uncompressedSize = 0;
     
     // True if this BarnAsset is just a pointer to another barn file.
-    bool IsPointer() { return !barnFileName.empty(); }
+    bool IsPointer() const { return !barnFileName.empty(); }
 };
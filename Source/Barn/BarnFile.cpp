@@ -6,8 +6,10 @@
 //
 #include "BarnFile.h"
 
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <vector>
 
 #include "minilzo.h"
@@ -16,12 +18,33 @@
 #include "FileSystem.h"
 #include "Texture.h"
 
-BarnFile::BarnFile(const std::string& filePath) :
-    mName(filePath),
-    mReader(filePath)
+BarnFile::BarnFile(const std::string& filePath, bool memoryMap) :
+    mName(filePath)
 {
+	// Map the entire barn into memory, if desired.
+	if(memoryMap)
+	{
+		mMappedFile = new MemoryMappedFile(filePath);
+		if(!mMappedFile->IsOpen())
+		{
+			std::cout << "Can't memory map barn file at " << filePath << "; falling back on file reads." << std::endl;
+			delete mMappedFile;
+			mMappedFile = nullptr;
+		}
+	}
+	
+	// Header and table of contents are read the same way in either case; only the backing store differs.
+	if(mMappedFile != nullptr)
+	{
+		mReader = new BinaryReader(mMappedFile->GetData(), mMappedFile->GetSize());
+	}
+	else
+	{
+		mReader = new BinaryReader(filePath);
+	}
+	
     // Make sure we can actually read this file.
-    if(!mReader.OK())
+    if(!mReader->OK())
     {
 		std::cout << "Can't read barn file at " << filePath << std::endl;
         return;
@@ -29,8 +52,8 @@ BarnFile::BarnFile(const std::string& filePath) :
     
 	// 8 bytes: two specific 4-byte ints must appear at the beginning of the file.
     // In text form, this is a string "GK3!Barn".
-    unsigned int gameIdentifier = mReader.ReadUInt();
-    unsigned int barnIdentifier = mReader.ReadUInt();
+    unsigned int gameIdentifier = mReader->ReadUInt();
+    unsigned int barnIdentifier = mReader->ReadUInt();
     if(gameIdentifier != kGameIdentifier && barnIdentifier != kBarnIdentifier)
     {
 		std::cout << "Invalid file type!" << std::endl;
@@ -40,64 +63,64 @@ BarnFile::BarnFile(const std::string& filePath) :
     // 4-bytes: unknown constant value (65536)
 	// 4-bytes: unknown constant value (65536)
 	// 4-bytes: appears to be file size, or size of assets in BRN bundle.
-	mReader.Skip(12);
+	mReader->Skip(12);
     
     // This value indicates the offset past the file header data to what I'd
     // call the "table of contents" or "toc".
-    unsigned int tocOffset = mReader.ReadUInt();
+    unsigned int tocOffset = mReader->ReadUInt();
 
     // This additional header data can be read in if desired, but it
     // isn't really relevant to the file functionality.
     /*
     {
         // 4-bytes: EXE/Content build # (119 in both cases)
-        mReader.ReadUInt();
-        mReader.ReadUInt();
+        mReader->ReadUInt();
+        mReader->ReadUInt();
         
         // 4-bytes: unknown value
-        mReader.ReadUInt();
+        mReader->ReadUInt();
         
         // Two dates, 2-bytes per element.
         // The dates are both on the same day, just a few minutes apart.
         // Maybe like a build start/end time for the bundles?
         short year, month, day, hour, minute, second;
-        year = mReader.ReadShort();
-        month = mReader.ReadShort();
-        mReader.ReadShort(); // unknown value
-        day = mReader.ReadShort();
-        hour = mReader.ReadShort();
-        minute = mReader.ReadShort();
-        second = mReader.ReadShort();
+        year = mReader->ReadShort();
+        month = mReader->ReadShort();
+        mReader->ReadShort(); // unknown value
+        day = mReader->ReadShort();
+        hour = mReader->ReadShort();
+        minute = mReader->ReadShort();
+        second = mReader->ReadShort();
         cout << year << "/" << month << "/" << day << ", " << hour << ":" << minute << ":" << second << endl;
         
         // 2-bytes: unknown variable value.
-        mReader.ReadShort();
+        mReader->ReadShort();
         
-        year = mReader.ReadShort();
-        month = mReader.ReadShort();
-        mReader.ReadShort(); // unknown value
-        day = mReader.ReadShort();
-        hour = mReader.ReadShort();
-        minute = mReader.ReadShort();
-        second = mReader.ReadShort();
+        year = mReader->ReadShort();
+        month = mReader->ReadShort();
+        mReader->ReadShort(); // unknown value
+        day = mReader->ReadShort();
+        hour = mReader->ReadShort();
+        minute = mReader->ReadShort();
+        second = mReader->ReadShort();
         cout << year << "/" << month << "/" << day << ", " << hour << ":" << minute << ":" << second << endl;
         
         // 2-bytes: unknown variable value.
-        mReader.ReadShort();
+        mReader->ReadShort();
         
         // Copyright notice!
         char copyright[65];
-        mReader.Read(copyright, 64);
+        mReader->Read(copyright, 64);
         copyright[64] = '\0';
         cout << copyright << endl;
     }
     */
     
     // Seek to table of contents offset.
-    mReader.Seek(tocOffset);
+    mReader->Seek(tocOffset);
     
     // First value in toc is number of toc entries.
-    unsigned int tocEntryCount = mReader.ReadUInt();
+    unsigned int tocEntryCount = mReader->ReadUInt();
     
     // Each toc entry will specify a header offset and a data offset.
 	std::vector<unsigned int> headerOffsets;
@@ -112,17 +135,17 @@ BarnFile::BarnFile(const std::string& filePath) :
         // The type is either "DDir" or "Data".
         // DDir specifies a directory of assets.
         // Data specifies file offset to start reading actual data.
-        unsigned int type = mReader.ReadUInt();
+        unsigned int type = mReader->ReadUInt();
         
         // Some unknown values.
-        mReader.ReadUInt();
-        mReader.ReadUInt();
-        mReader.ReadUInt();
-        mReader.ReadUInt();
+        mReader->ReadUInt();
+        mReader->ReadUInt();
+        mReader->ReadUInt();
+        mReader->ReadUInt();
         
         // Read header and data offsets.
-        unsigned int headerOffset = mReader.ReadUInt();
-        unsigned int dataOffset = mReader.ReadUInt();
+        unsigned int headerOffset = mReader->ReadUInt();
+        unsigned int dataOffset = mReader->ReadUInt();
         
         // For DDir, we'll save the offsets so we can iterate over them below.
         // For Data, we'll just save the data offset value.
@@ -141,30 +164,30 @@ BarnFile::BarnFile(const std::string& filePath) :
     // The header specifies data that is common to all assets in the data section.
     for(int i = 0; i < headerOffsets.size(); i++)
     {
-        mReader.Seek(headerOffsets[i]);
+        mReader->Seek(headerOffsets[i]);
         
         // The name of the Barn file for these assets. NOTE that it appears
         // a Barn file can contain "pointers" to assets in other Barn files.
         // If this name is empty, it means the asset is contained within THIS Barn file.
         // However, if the name isn't empty, it means the asset is in another Barn file.
         char barnFileName[33];
-        mReader.Read(barnFileName, 32);
+        mReader->Read(barnFileName, 32);
         barnFileName[32] = '\0';
         
         // Unknown value.
-        mReader.ReadUInt();
+        mReader->ReadUInt();
         
         // A human-readable description for this Barn file.
         // Ex: "Gabriel Knight 3 Day 1/2/3 Common"
         char barnDescription[40];
-        mReader.Read(barnDescription, 40);
+        mReader->Read(barnDescription, 40);
         
         // Unknown value.
-        mReader.ReadUInt();
+        mReader->ReadUInt();
         
-        int numAssets = mReader.ReadUInt();
+        int numAssets = mReader->ReadUInt();
         
-		mReader.Seek(dataOffsets[i]);
+		mReader->Seek(dataOffsets[i]);
         for(int j = 0; j < numAssets; j++)
         {
             BarnAsset asset;
@@ -175,17 +198,17 @@ BarnFile::BarnFile(const std::string& filePath) :
             
             // Asset size, in bytes, but we need to read compression
             // value before we know whether this is compressed or uncompressed size.
-            unsigned int assetSize = mReader.ReadUInt();
+            unsigned int assetSize = mReader->ReadUInt();
             
             // Read in the asset offset. This is the offset from the start of the data section.
-            asset.offset = mReader.ReadUInt();
+            asset.offset = mReader->ReadUInt();
             
             // Unknown values.
-            mReader.ReadUInt();
-            mReader.ReadUByte();
+            mReader->ReadUInt();
+            mReader->ReadUByte();
             
             // Read in compression type.
-            asset.compressionType = (CompressionType)mReader.ReadUByte();
+            asset.compressionType = (CompressionType)mReader->ReadUByte();
             
             // Compression type 3 should just be treated as type none.
             // Not sure if type 3 is actually different in some way?
@@ -208,19 +231,19 @@ BarnFile::BarnFile(const std::string& filePath) :
                 // So, we can actually seek to that offset in the file and read the uncompressed size.
                 if(!asset.IsPointer())
                 {
-                    int pos = mReader.GetPosition();
-                    mReader.Seek(mDataOffset + asset.offset);
-                    asset.uncompressedSize = mReader.ReadUInt();
-                    mReader.Seek(pos);
+                    int pos = mReader->GetPosition();
+                    mReader->Seek(mDataOffset + asset.offset);
+                    asset.uncompressedSize = mReader->ReadUInt();
+                    mReader->Seek(pos);
                 }
             }
 			
             // Read in asset name. This name appears to be null-terminated (+1).
             // So, max size is 256 + 1 = 257.
             //TODO: Might be better to only store a char array of the correct length?
-            unsigned int assetNameLength = mReader.ReadUByte();
+            unsigned int assetNameLength = mReader->ReadUByte();
             char assetName[257];
-            mReader.Read(assetName, assetNameLength + 1);
+            mReader->Read(assetName, assetNameLength + 1);
             
             // Save asset name.
             asset.name = assetName;
@@ -233,9 +256,15 @@ BarnFile::BarnFile(const std::string& filePath) :
     }
 }
 
+BarnFile::~BarnFile()
+{
+	delete mReader;
+	delete mMappedFile;
+}
+
 bool BarnFile::CanRead() const
 {
-    return mReader.OK();
+    return mReader->OK();
 }
 
 BarnAsset* BarnFile::GetAsset(const std::string& assetName)
@@ -248,6 +277,17 @@ BarnAsset* BarnFile::GetAsset(const std::string& assetName)
     return nullptr;
 }
 
+std::vector<std::string> BarnFile::GetAssetNames() const
+{
+	std::vector<std::string> assetNames;
+	for(auto& entry : mAssetMap)
+	{
+		if(entry.second.IsPointer()) { continue; }
+		assetNames.push_back(entry.first);
+	}
+	return assetNames;
+}
+
 bool BarnFile::Extract(const std::string& assetName, char *buffer, int bufferSize)
 {
     // Get the asset handle associated with this asset name.
@@ -273,24 +313,60 @@ bool BarnFile::Extract(const std::string& assetName, char *buffer, int bufferSiz
         return false;
     }
     
+    // Compressed assets have an 8-byte header before the compressed data; uncompressed assets don't.
+    unsigned int dataPosition = mDataOffset + asset->offset;
+    if(asset->compressionType != CompressionType::None)
+    {
+        dataPosition += 8;
+    }
+    
+    // Get a pointer to the asset's stored (possibly compressed) bytes.
+    // If memory-mapped, this points directly into the mapping. Otherwise, we must read the bytes from file.
+    const unsigned char* storedData = nullptr;
+    std::unique_ptr<unsigned char[]> readBuffer;
+    if(mMappedFile != nullptr)
+    {
+        if(dataPosition + asset->compressedSize > mMappedFile->GetSize())
+        {
+            std::cout << "Asset " << assetName << " extends past the end of the Barn file!" << std::endl;
+            return false;
+        }
+        storedData = reinterpret_cast<const unsigned char*>(mMappedFile->GetData()) + dataPosition;
+    }
+    else if(asset->compressionType == CompressionType::None)
+    {
+        // Seek to the data position and read the data into the buffer. Since it's already uncompressed, we're done!
+        std::lock_guard<std::mutex> lock(mReaderMutex);
+        mReader->Seek(dataPosition);
+        mReader->Read(buffer, asset->uncompressedSize);
+        return true;
+    }
+    else
+    {
+        // Read compressed data into a temporary buffer.
+        readBuffer.reset(new unsigned char[asset->compressedSize]);
+        std::lock_guard<std::mutex> lock(mReaderMutex);
+        mReader->Seek(dataPosition);
+        int readCount = mReader->Read(readBuffer.get(), asset->compressedSize);
+        if(readCount != asset->compressedSize)
+        {
+            std::cout << "Didn't read desired number of bytes." << std::endl;
+            return false;
+        }
+        storedData = readBuffer.get();
+    }
+    
     // Method used to extract will depend upon the compression type for the asset.
     if(asset->compressionType == CompressionType::None)
     {
-        // Seek to the data possion and read the data into the buffer. Since it's already uncompressed, we're done!
-        //cout << "Reading from offset " << mDataOffset + asset->offset << endl;
-        //cout << "Reading " << asset->uncompressedSize << " bytes " << endl;
-        mReader.Seek(mDataOffset + asset->offset);
-        mReader.Read(buffer, asset->uncompressedSize);
+        // Data is already uncompressed, so just copy it out of the mapping.
+        std::memcpy(buffer, storedData, asset->uncompressedSize);
     }
     else if(asset->compressionType == CompressionType::Zlib)
     {
-        // Read compressed data into a buffer.
-        unsigned char* compressedBuffer = new unsigned char[asset->compressedSize];
-        mReader.Seek(mDataOffset + 8 + asset->offset);
-        mReader.Read(compressedBuffer, asset->compressedSize);
-    
+        // Inflate straight from the stored bytes (zlib won't modify the input, despite the non-const pointer).
         z_stream strm;
-        strm.next_in = compressedBuffer;
+        strm.next_in = const_cast<unsigned char*>(storedData);
         strm.avail_in = asset->compressedSize;
         strm.next_out = (unsigned char*)buffer;
         strm.avail_out = bufferSize;
@@ -303,7 +379,6 @@ bool BarnFile::Extract(const std::string& assetName, char *buffer, int bufferSiz
         if(result != Z_OK)
         {
 			std::cout << "Error when calling inflateInit: " << result << std::endl;
-            delete[] compressedBuffer;
             return false;
         }
         
@@ -312,7 +387,7 @@ bool BarnFile::Extract(const std::string& assetName, char *buffer, int bufferSiz
         if(result != Z_STREAM_END)
         {
 			std::cout << "Inflate didn't inflate entire stream, or an error occurred: " << result << std::endl;
-            delete[] compressedBuffer;
+            inflateEnd(&strm);
             return false;
         }
         
@@ -321,56 +396,25 @@ bool BarnFile::Extract(const std::string& assetName, char *buffer, int bufferSiz
         if(result != Z_OK)
         {
 			std::cout << "Error while ending inflate: " << result << std::endl;
-            delete[] compressedBuffer;
             return false;
         }
-
-        // Delete compressed data buffer.
-        delete[] compressedBuffer;
     }
     else if(asset->compressionType == CompressionType::Lzo)
     {
-		// Create buffer to hold compressed data.
-        unsigned char* compressedBuffer = new unsigned char[asset->compressedSize];
-		if(compressedBuffer == nullptr)
-		{
-			std::cout << "Out of memory" << std::endl;
-			return false;
-		}
-		
-		// Read compressed data into a buffer.
-        mReader.Seek(mDataOffset + 8 + asset->offset);
-        int readCount = mReader.Read(compressedBuffer, asset->compressedSize);
-		if(readCount != asset->compressedSize)
-		{
-			std::cout << "Didn't read desired number of bytes." << std::endl;
-			delete[] compressedBuffer;
-			return false;
-		}
-		
         // Make sure LZO library is initialized.
-		static bool initLzo = false;
+		// Function-local static init is thread-safe, so concurrent extractions only init once.
+		static const bool initLzo = (lzo_init() == LZO_E_OK);
 		if(!initLzo)
 		{
-			int initResult = lzo_init();
-			if(initResult == LZO_E_OK)
-			{
-				initLzo = true;
-			}
-			else
-			{
-				std::cout << "Failed to init LZO!" << std::endl;
-				delete[] compressedBuffer;
-				return false;
-			}
+			std::cout << "Failed to init LZO!" << std::endl;
+			return false;
 		}
 		
         // Decompress using LZO library. GK3 data appears to be compressed with lzo1x.
 		//std::cout << asset->name << ": decompressing " << asset->compressedSize << " bytes to a buffer of size " << bufferSize << std::endl;
-		int result = lzo1x_decompress((lzo_bytep)compressedBuffer, (lzo_uint)asset->compressedSize, (lzo_bytep)buffer, (lzo_uintp)&bufferSize, nullptr);
-		
-		// Delete compressed data buffer.
-		delete[] compressedBuffer;
+		// As with zlib, LZO only reads from the input despite the non-const pointer.
+		lzo_uint decompressedSize = bufferSize;
+		int result = lzo1x_decompress(const_cast<unsigned char*>(storedData), (lzo_uint)asset->compressedSize, (lzo_bytep)buffer, &decompressedSize, nullptr);
 		
 		// For some reason *most* GK3 data decompresses with result of LZO_E_INPUT_NOT_CONSUMED.
 		// This still works OK. It may indicate that "compressedSize" passed is larger than the compressed data.
@@ -391,6 +435,27 @@ bool BarnFile::Extract(const std::string& assetName, char *buffer, int bufferSiz
     return true;
 }
 
+const char* BarnFile::GetAssetView(const std::string& assetName)
+{
+	// Only possible when the barn is mapped into memory.
+	if(mMappedFile == nullptr) { return nullptr; }
+	
+	// Asset must exist, must be in this barn, and must not be compressed.
+	BarnAsset* asset = GetAsset(assetName);
+	if(asset == nullptr || asset->IsPointer() || asset->compressionType != CompressionType::None)
+	{
+		return nullptr;
+	}
+	
+	// Guard against bad offsets reading past the end of the mapping.
+	unsigned int dataPosition = mDataOffset + asset->offset;
+	if(dataPosition + asset->uncompressedSize > mMappedFile->GetSize())
+	{
+		return nullptr;
+	}
+	return mMappedFile->GetData() + dataPosition;
+}
+
 bool BarnFile::WriteToFile(const std::string& assetName)
 {
 	return WriteToFile(assetName, "");
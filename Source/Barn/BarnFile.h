@@ -5,26 +5,48 @@
 //  Created by Clark Kromenaker on 8/4/17.
 //
 #pragma once
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "BarnAsset.h"
 #include "BinaryReader.h"
+#include "MemoryMappedFile.h"
 
 class BarnFile
 {
 public:
-    BarnFile(const std::string& filePath);
+	// If memory mapping is requested, the whole barn is mapped once and assets are read from the mapping.
+	// If mapping fails, we fall back on reading through a file stream.
+    BarnFile(const std::string& filePath, bool memoryMap = true);
+	~BarnFile();
+	
+	// Owns a file stream and/or mapping, so don't allow copying!
+	BarnFile(const BarnFile& other) = delete;
+	BarnFile& operator=(const BarnFile& other) = delete;
 	
 	// Ensure we can actually read assets from this barn.
     bool CanRead() const;
 	
+	// True if this barn is being read from a memory mapping.
+	bool IsMemoryMapped() const { return mMappedFile != nullptr; }
+	
 	// Retrieves an asset handle, if it exists in this bundle.
     BarnAsset* GetAsset(const std::string& assetName);
 	
+	// Names of all assets stored in this bundle (pointers to assets in other bundles are excluded).
+	std::vector<std::string> GetAssetNames() const;
+	
 	// Extracts an asset into the provided buffer.
+	// Safe to call from multiple threads at once: memory-mapped barns have no shared read position,
+	// and stream reads are serialized (decompression still happens in parallel).
     bool Extract(const std::string& assetName, char* buffer, int bufferSize);
 	
+	// For memory-mapped barns, returns a read-only pointer to an uncompressed asset's bytes, directly in the mapping (no copy).
+	// Returns null if the barn isn't mapped or the asset is compressed - use Extract in that case.
+	const char* GetAssetView(const std::string& assetName);
+	
 	// For debugging, write assets to file.
     bool WriteToFile(const std::string& assetName);
 	bool WriteToFile(const std::string& assetName, const std::string outputDir);
@@ -52,7 +74,14 @@ private:
     std::string mName;
     
     // Binary reader for extracting data.
-    BinaryReader mReader;
+	// Reads from the memory mapping if we have one, or from the file otherwise.
+    BinaryReader* mReader = nullptr;
+	
+	// The reader has a single seek position, so only one thread can use it at a time.
+	std::mutex mReaderMutex;
+	
+	// If memory-mapped, the mapping of the entire barn file.
+	MemoryMappedFile* mMappedFile = nullptr;
     
     // Offset within the file to where the data is located.
     unsigned int mDataOffset = 0;
@@ -0,0 +1,116 @@
+//
+// CaseResultCache.cpp
+//
+// Clark Kromenaker
+//
+#include "CaseResultCache.h"
+
+#include <string>
+#include <unordered_set>
+
+#include "GameProgress.h"
+#include "SheepScript.h"
+#include "StringUtil.h"
+
+namespace
+{
+	// Sheep functions that only read game state which reports its changes, or state that only changes on scene load.
+	// Case scripts that call any other function aren't cached, since there'd be no way to know when their results change.
+	const std::unordered_set<std::string, StringUtil::IgnoreCaseHash, StringUtil::IgnoreCaseEqual> kCacheableCaseFunctions = {
+		"GetFlag",
+		"GetChatCount",
+		"GetGameVariableInt",
+		"GetNounVerbCount",
+		"GetScore",
+		"GetTopicCount",
+		"GetTopicCountInt",
+		"IsCurrentTime",
+		"WasLastTime",
+		"IsCurrentLocation",
+		"WasLastLocation",
+		"IsCurrentEgo"
+	};
+}
+
+std::size_t CaseResultCache::KeyHash::operator()(const Key& key) const
+{
+	std::size_t hash = std::hash<SheepScript*>()(key.script);
+	hash = hash * 31 + std::hash<int>()(key.n);
+	hash = hash * 31 + std::hash<int>()(key.v);
+	return hash;
+}
+
+bool CaseResultCache::Evaluate(SheepScript* script, int n, int v, GameProgress* gameProgress, const std::function<bool()>& evaluate)
+{
+	if(script == nullptr || gameProgress == nullptr || !IsCacheable(script))
+	{
+		return evaluate();
+	}
+	
+	// Use the previous result if none of the state it read has changed since.
+	Key key;
+	key.script = script;
+	key.n = n;
+	key.v = v;
+	auto it = mResults.find(key);
+	if(it != mResults.end())
+	{
+		return it->second;
+	}
+	
+	// Evaluate, recording what game state was read.
+	mReadKeys.clear();
+	gameProgress->StartRecordingReads(&mReadKeys);
+	bool result = evaluate();
+	gameProgress->StopRecordingReads();
+	
+	// Save result, and remember which state it depends on.
+	mResults[key] = result;
+	for(auto& readKey : mReadKeys)
+	{
+		mDependents[readKey].insert(key);
+	}
+	return result;
+}
+
+void CaseResultCache::OnGameStateChanged(uint64_t key)
+{
+	auto it = mDependents.find(key);
+	if(it != mDependents.end())
+	{
+		for(auto& resultKey : it->second)
+		{
+			mResults.erase(resultKey);
+		}
+		mDependents.erase(it);
+	}
+}
+
+void CaseResultCache::Clear()
+{
+	mResults.clear();
+	mDependents.clear();
+	mCacheableScripts.clear();
+}
+
+bool CaseResultCache::IsCacheable(SheepScript* script)
+{
+	auto it = mCacheableScripts.find(script);
+	if(it != mCacheableScripts.end())
+	{
+		return it->second;
+	}
+	
+	// A script's imports are all the functions it can call.
+	bool cacheable = true;
+	for(int i = 0; script->GetSysImport(i) != nullptr; ++i)
+	{
+		if(kCacheableCaseFunctions.find(script->GetSysImport(i)->name) == kCacheableCaseFunctions.end())
+		{
+			cacheable = false;
+			break;
+		}
+	}
+	mCacheableScripts[script] = cacheable;
+	return cacheable;
+}
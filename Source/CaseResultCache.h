@@ -0,0 +1,60 @@
+//
+// CaseResultCache.h
+//
+// Clark Kromenaker
+//
+// Results of NVC case evaluations, so the same case isn't evaluated again until the game state it read changes.
+//
+// Only cases that call functions which read game state (flags, counts, variables, timeblock, etc.) are cached.
+// Game state reports its changes (see GameProgress::SetChangeCallback), so results that read changed state can be removed.
+//
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class GameProgress;
+class SheepScript;
+
+class CaseResultCache
+{
+public:
+	// Returns the result of a previous evaluation of the script with this noun/verb, or evaluates it with the given function.
+	// Reads of game progress during evaluation are recorded, so the result is dropped when any of that state changes.
+	bool Evaluate(SheepScript* script, int n, int v, GameProgress* gameProgress, const std::function<bool()>& evaluate);
+	
+	// Called when game state changes, to remove results that used that state.
+	void OnGameStateChanged(uint64_t key);
+	
+	void Clear();
+	
+	int GetResultCount() const { return static_cast<int>(mResults.size()); }
+	
+private:
+	struct Key
+	{
+		SheepScript* script = nullptr;
+		int n = 0;
+		int v = 0;
+		
+		bool operator==(const Key& other) const { return script == other.script && n == other.n && v == other.v; }
+	};
+	struct KeyHash
+	{
+		std::size_t operator()(const Key& key) const;
+	};
+	std::unordered_map<Key, bool, KeyHash> mResults;
+	
+	// For each bit of game state, the results that read it.
+	std::unordered_map<uint64_t, std::unordered_set<Key, KeyHash>> mDependents;
+	
+	// Whether each case script's results can be cached.
+	std::unordered_map<SheepScript*, bool> mCacheableScripts;
+	
+	// Game state read by the case currently being evaluated.
+	std::vector<uint64_t> mReadKeys;
+	
+	bool IsCacheable(SheepScript* script);
+};
@@ -311,7 +311,7 @@ CharacterManager::CharacterManager()
 		IniParser actorsParser(actorsBuffer, actorsBufferSize);
 		actorsParser.ParseAll();
 		
-		IniSection actors = actorsParser.GetSection("ACTORS");
+		IniSection& actors = actorsParser.GetSection("ACTORS");
 		for(auto& line : actors.lines)
 		{
 			IniKeyValue& entry = line.entries.front();
@@ -350,21 +350,11 @@ void FaceController::UpdateFaceTexture()
 	// Downsample & copy left eye.
 	if(mCurrentLeftEyeTexture != nullptr)
 	{
-		//stbir_resize_uint8(mCurrentLeftEyeTexture->GetPixelData(), mCurrentLeftEyeTexture->GetWidth(), mCurrentLeftEyeTexture->GetHeight(), 0,
-		//				   mDownSampledLeftEyeTexture->GetPixelData(), mDownSampledLeftEyeTexture->GetWidth(), mDownSampledLeftEyeTexture->GetHeight(), 0, 4);
-		 
 		//TODO: Am I using the "bias" correctly?
-		//TODO: Is CATMULLROM the best filter? Some filters trigger an assertion if the x/y offset become too big...
 		//const Vector2& leftEyeBias = mCharacterConfig->faceConfig.leftEyeBias;
-		stbir_resize_subpixel(mCurrentLeftEyeTexture->GetPixelData(), mCurrentLeftEyeTexture->GetWidth(), mCurrentLeftEyeTexture->GetHeight(), 0,
-							  mDownSampledLeftEyeTexture->GetPixelData(), mDownSampledLeftEyeTexture->GetWidth(), mDownSampledLeftEyeTexture->GetHeight(), 0,
-							  STBIR_TYPE_UINT8, 4, -1, 0,
-							  STBIR_EDGE_WRAP, STBIR_EDGE_WRAP, STBIR_FILTER_CATMULLROM, STBIR_FILTER_CATMULLROM,
-							  STBIR_COLORSPACE_LINEAR, NULL,
-							  //0.25f, 0.25f, mEyeJitterX + leftEyeBias.x, mEyeJitterY + leftEyeBias.y);
-							  0.25f, 0.25f, 0.0f, 0.0f);
-		
-		mDownSampledLeftEyeTexture->UploadToGPU();
+		//Vector2 leftEyeSubpixelOffset(mEyeJitterX + leftEyeBias.x, mEyeJitterY + leftEyeBias.y);
+		Vector2 leftEyeSubpixelOffset(0.0f, 0.0f);
+		DownsampleEye(mCurrentLeftEyeTexture, leftEyeSubpixelOffset, mDownSampledLeftEyeTexture, mDownSampledLeftEyeSource, mDownSampledLeftEyeOffset);
 		
 		const Vector2& leftEyeOffset = mCharacterConfig->faceConfig.leftEyeOffset;
 		Texture::BlendPixels(*mDownSampledLeftEyeTexture, *mFaceTexture, leftEyeOffset.x, leftEyeOffset.y);
@@ -373,21 +363,11 @@ void FaceController::UpdateFaceTexture()
 	// Downsample & copy right eye.
 	if(mCurrentRightEyeTexture != nullptr)
 	{
-		//stbir_resize_uint8(mCurrentRightEyeTexture->GetPixelData(), mCurrentRightEyeTexture->GetWidth(), mCurrentRightEyeTexture->GetHeight(), 0,
-		//				   mDownSampledRightEyeTexture->GetPixelData(), mDownSampledRightEyeTexture->GetWidth(), mDownSampledRightEyeTexture->GetHeight(), 0, 4);
-		
 		//TODO: Am I using the "bias" correctly?
-		//TODO: Is CATMULLROM the best filter? Some filters trigger an assertion if the x/y offset become too big...
 		//const Vector2& rightEyeBias = mCharacterConfig->faceConfig.rightEyeBias;
-		stbir_resize_subpixel(mCurrentRightEyeTexture->GetPixelData(), mCurrentRightEyeTexture->GetWidth(), mCurrentRightEyeTexture->GetHeight(), 0,
-							  mDownSampledRightEyeTexture->GetPixelData(), mDownSampledRightEyeTexture->GetWidth(), mDownSampledRightEyeTexture->GetHeight(), 0,
-							  STBIR_TYPE_UINT8, 4, -1, 0,
-							  STBIR_EDGE_WRAP, STBIR_EDGE_WRAP, STBIR_FILTER_CATMULLROM, STBIR_FILTER_CATMULLROM,
-							  STBIR_COLORSPACE_LINEAR, NULL,
-							  //0.25f, 0.25f, mEyeJitterX + rightEyeBias.x, mEyeJitterY + rightEyeBias.y);
-							  0.25f, 0.25f, 0.0f, 0.0f);
-							  
-		mDownSampledRightEyeTexture->UploadToGPU();
+		//Vector2 rightEyeSubpixelOffset(mEyeJitterX + rightEyeBias.x, mEyeJitterY + rightEyeBias.y);
+		Vector2 rightEyeSubpixelOffset(0.0f, 0.0f);
+		DownsampleEye(mCurrentRightEyeTexture, rightEyeSubpixelOffset, mDownSampledRightEyeTexture, mDownSampledRightEyeSource, mDownSampledRightEyeOffset);
 		
 		const Vector2& rightEyeOffset = mCharacterConfig->faceConfig.rightEyeOffset;
 		Texture::BlendPixels(*mDownSampledRightEyeTexture, *mFaceTexture, rightEyeOffset.x, rightEyeOffset.y);
@@ -407,6 +387,23 @@ void FaceController::UpdateFaceTexture()
 		Texture::BlendPixels(*mCurrentForeheadTexture, *mFaceTexture, foreheadOffset.x, foreheadOffset.y);
 	}
 		
-	// Upload all changes to the GPU.
-	mFaceTexture->UploadToGPU();
+	// Upload changes to the GPU. Only the areas blended above need to go up, not the whole face.
+	mFaceTexture->UploadChangesToGPU();
+}
+
+void FaceController::DownsampleEye(Texture* eyeTexture, const Vector2& offset, Texture* downsampledTexture, Texture*& downsampledSource, Vector2& downsampledOffset)
+{
+	// Still have the result from last time?
+	if(eyeTexture == downsampledSource && offset == downsampledOffset) { return; }
+	downsampledSource = eyeTexture;
+	downsampledOffset = offset;
+	
+	// Eye textures are only ever blended into the face on the CPU, so the result doesn't need uploading.
+	//TODO: Is CATMULLROM the best filter? Some filters trigger an assertion if the x/y offset become too big...
+	stbir_resize_subpixel(eyeTexture->GetPixelData(), eyeTexture->GetWidth(), eyeTexture->GetHeight(), 0,
+						  downsampledTexture->GetPixelData(), downsampledTexture->GetWidth(), downsampledTexture->GetHeight(), 0,
+						  STBIR_TYPE_UINT8, 4, -1, 0,
+						  STBIR_EDGE_WRAP, STBIR_EDGE_WRAP, STBIR_FILTER_CATMULLROM, STBIR_FILTER_CATMULLROM,
+						  STBIR_COLORSPACE_LINEAR, NULL,
+						  0.25f, 0.25f, offset.x, offset.y);
 }
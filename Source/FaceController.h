@@ -9,6 +9,8 @@
 #pragma once
 #include "Component.h"
 
+#include "Vector2.h"
+
 class Animation;
 struct CharacterConfig;
 class Texture;
@@ -96,6 +98,13 @@ private:
 	Texture* mDownSampledLeftEyeTexture = nullptr;
 	Texture* mDownSampledRightEyeTexture = nullptr;
 	
+	// The eye textures and subpixel offsets the downsampled eyes were made from.
+	// Downsampling is only redone when one of these changes.
+	Texture* mDownSampledLeftEyeSource = nullptr;
+	Texture* mDownSampledRightEyeSource = nullptr;
+	Vector2 mDownSampledLeftEyeOffset;
+	Vector2 mDownSampledRightEyeOffset;
+	
 	// A timer for how frequently the face should blink.
 	// Set randomly based on interval specified in face config.
 	float mBlinkTimer = 0.0f;
@@ -117,4 +126,5 @@ private:
 	void RollEyeJitterTimer();
 
 	void UpdateFaceTexture();
+	void DownsampleEye(Texture* eyeTexture, const Vector2& offset, Texture* downsampledTexture, Texture*& downsampledSource, Vector2& downsampledOffset);
 };
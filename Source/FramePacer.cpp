@@ -0,0 +1,99 @@
+//
+// FramePacer.cpp
+//
+// Clark Kromenaker
+//
+#include "FramePacer.h"
+
+#include <thread>
+
+#include "GMath.h"
+
+namespace
+{
+	// Sleeps aren't precise, so stop sleeping this long before the next frame, and spin the rest of the way.
+	const std::chrono::microseconds kSpinDuration(2000);
+
+	// Caps fixed steps simulated in one frame. If simulating falls behind, leftover time is dropped rather than
+	// trying to catch up (which would make each frame even slower).
+	const int kMaxFixedStepsPerFrame = 8;
+}
+
+FramePacer::FramePacer()
+{
+	SetTargetFrameRate(60);
+}
+
+void FramePacer::SetTargetFrameRate(int framesPerSecond)
+{
+	mTargetFrameRate = Math::Max(framesPerSecond, 0);
+	if(mTargetFrameRate > 0)
+	{
+		mFrameDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(1)) / mTargetFrameRate;
+	}
+	else
+	{
+		mFrameDuration = Clock::duration::zero();
+	}
+}
+
+void FramePacer::SetFixedTimestep(float seconds)
+{
+	mFixedTimestep = Math::Max(seconds, 0.0f);
+	mFixedTimeAccumulator = 0.0f;
+}
+
+float FramePacer::WaitForNextFrame()
+{
+	Clock::time_point now = Clock::now();
+	if(!mStarted)
+	{
+		mStarted = true;
+		mLastFrameTime = now;
+		mNextFrameTime = now + mFrameDuration;
+		return 0.0f;
+	}
+
+	// Sleep through most of the remaining frame time, then spin for the rest.
+	if(now < mNextFrameTime)
+	{
+		if(mNextFrameTime - now > kSpinDuration)
+		{
+			std::this_thread::sleep_for(mNextFrameTime - now - kSpinDuration);
+		}
+		while((now = Clock::now()) < mNextFrameTime)
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	// Schedule the next frame relative to when this one was scheduled, so frame times don't drift.
+	// But if we've fallen more than a frame behind, don't rush frames out to catch up.
+	mNextFrameTime += mFrameDuration;
+	if(mNextFrameTime < now)
+	{
+		mNextFrameTime = now + mFrameDuration;
+	}
+
+	float deltaTime = std::chrono::duration<float>(now - mLastFrameTime).count();
+	mLastFrameTime = now;
+	return Math::Clamp(deltaTime, 0.0f, mMaxDeltaTime);
+}
+
+int FramePacer::ConsumeFixedSteps(float deltaTime)
+{
+	if(mFixedTimestep <= 0.0f) { return 0; }
+
+	mFixedTimeAccumulator += deltaTime;
+	int stepCount = static_cast<int>(mFixedTimeAccumulator / mFixedTimestep);
+	if(stepCount > kMaxFixedStepsPerFrame)
+	{
+		stepCount = kMaxFixedStepsPerFrame;
+		mFixedTimeAccumulator = 0.0f;
+	}
+	else
+	{
+		mFixedTimeAccumulator -= stepCount * mFixedTimestep;
+	}
+	return stepCount;
+}
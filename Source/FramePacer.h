@@ -0,0 +1,59 @@
+//
+// FramePacer.h
+//
+// Clark Kromenaker
+//
+// Paces the game loop to a target frame rate, and measures time between frames.
+//
+// Waiting sleeps for most of the remaining frame time, and only spins for the last
+// little bit (sleeps can overshoot by a millisecond or two), so waiting uses almost no CPU.
+//
+// Optionally, also provides a fixed timestep for simulation updates: frame time accumulates,
+// and is consumed in fixed-size steps, independent of how often frames are rendered.
+//
+#pragma once
+#include <chrono>
+
+class FramePacer
+{
+public:
+	FramePacer();
+
+	// Frames per second to pace to. Zero means uncapped (run as fast as possible, e.g. for benchmarking).
+	void SetTargetFrameRate(int framesPerSecond);
+	int GetTargetFrameRate() const { return mTargetFrameRate; }
+
+	// Largest delta time reported for a single frame, so a long stall (breakpoint, window drag) doesn't cause a huge jump.
+	void SetMaxDeltaTime(float seconds) { mMaxDeltaTime = seconds; }
+
+	// Size of each fixed simulation step, in seconds. Zero disables the fixed timestep.
+	void SetFixedTimestep(float seconds);
+	float GetFixedTimestep() const { return mFixedTimestep; }
+	bool IsFixedTimestepEnabled() const { return mFixedTimestep > 0.0f; }
+
+	// Waits until it's time to start the next frame.
+	// Returns time passed since the previous frame started, in seconds.
+	float WaitForNextFrame();
+
+	// Adds a frame's delta time to the fixed timestep accumulator.
+	// Returns how many fixed steps should be simulated this frame.
+	int ConsumeFixedSteps(float deltaTime);
+
+private:
+	typedef std::chrono::steady_clock Clock;
+
+	// Target frame rate, and the resulting time per frame (zero if uncapped).
+	int mTargetFrameRate = 0;
+	Clock::duration mFrameDuration = Clock::duration::zero();
+
+	// When the previous frame started, and when the next frame should start.
+	Clock::time_point mLastFrameTime;
+	Clock::time_point mNextFrameTime;
+	bool mStarted = false;
+
+	float mMaxDeltaTime = 0.05f;
+
+	// Fixed timestep size, and time not yet consumed by fixed steps.
+	float mFixedTimestep = 0.0f;
+	float mFixedTimeAccumulator = 0.0f;
+};
@@ -0,0 +1,109 @@
+//
+// FrameTimings.cpp
+//
+// Clark Kromenaker
+//
+#include "FrameTimings.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "StringUtil.h"
+
+FrameTimings::Scope::Scope(FrameTimings* timings, const char* name) :
+	mTimings(timings),
+	mName(name)
+{
+	if(mTimings != nullptr)
+	{
+		mStartTime = std::chrono::steady_clock::now();
+	}
+}
+
+FrameTimings::Scope::~Scope()
+{
+	if(mTimings != nullptr)
+	{
+		std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - mStartTime;
+		mTimings->AddTime(mName, elapsed.count());
+	}
+}
+
+void FrameTimings::BeginFrame()
+{
+	mFrameStartTime = std::chrono::steady_clock::now();
+}
+
+void FrameTimings::EndFrame()
+{
+	std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - mFrameStartTime;
+	mFrameTimes.push_back(elapsed.count());
+}
+
+void FrameTimings::AddTime(const char* name, float milliseconds)
+{
+	// Few subsystems are timed, so a linear search is fine.
+	auto it = std::find_if(mSubsystems.begin(), mSubsystems.end(), [name](const Subsystem& subsystem) {
+		return std::strcmp(subsystem.name.c_str(), name) == 0;
+	});
+	if(it == mSubsystems.end())
+	{
+		mSubsystems.emplace_back();
+		mSubsystems.back().name = name;
+		it = mSubsystems.end() - 1;
+	}
+
+	int frameIndex = GetFrameCount();
+	if(it->lastFrameIndex == frameIndex && !it->times.empty())
+	{
+		it->times.back() += milliseconds;
+	}
+	else
+	{
+		it->times.push_back(milliseconds);
+		it->lastFrameIndex = frameIndex;
+	}
+}
+
+std::vector<FrameTimings::Summary> FrameTimings::GetSummaries() const
+{
+	std::vector<Summary> summaries;
+	summaries.push_back(Summarize("Frame", mFrameTimes));
+	for(auto& subsystem : mSubsystems)
+	{
+		summaries.push_back(Summarize(subsystem.name, subsystem.times));
+	}
+	return summaries;
+}
+
+std::string FrameTimings::GetReport() const
+{
+	std::string report = StringUtil::Format("%-16s %8s %10s %10s %10s %10s %12s\n",
+											"Timing (ms)", "Frames", "Average", "Median", "95th", "Max", "Total");
+	for(auto& summary : GetSummaries())
+	{
+		report += StringUtil::Format("%-16s %8d %10.3f %10.3f %10.3f %10.3f %12.3f\n",
+									 summary.name.c_str(), summary.frameCount, summary.average,
+									 summary.median, summary.percentile95, summary.max, summary.total);
+	}
+	return report;
+}
+
+/*static*/ FrameTimings::Summary FrameTimings::Summarize(const std::string& name, std::vector<float> times)
+{
+	Summary summary;
+	summary.name = name;
+	summary.frameCount = static_cast<int>(times.size());
+	if(times.empty()) { return summary; }
+
+	std::sort(times.begin(), times.end());
+	for(float time : times)
+	{
+		summary.total += time;
+	}
+	summary.average = summary.total / times.size();
+	summary.median = times[times.size() / 2];
+	summary.percentile95 = times[std::min(times.size() - 1, times.size() * 95 / 100)];
+	summary.max = times.back();
+	return summary;
+}
@@ -0,0 +1,79 @@
+//
+// FrameTimings.h
+//
+// Clark Kromenaker
+//
+// Records how long each frame takes, and how long each subsystem takes within each frame.
+// At the end of a run, summarizes timings (average, percentiles, max) for spotting performance regressions.
+//
+#pragma once
+#include <chrono>
+#include <string>
+#include <vector>
+
+class FrameTimings
+{
+public:
+	// Times a subsystem from construction to destruction. Does nothing if timings is null.
+	class Scope
+	{
+	public:
+		Scope(FrameTimings* timings, const char* name);
+		~Scope();
+
+	private:
+		FrameTimings* mTimings = nullptr;
+		const char* mName = nullptr;
+		std::chrono::steady_clock::time_point mStartTime;
+	};
+
+	struct Summary
+	{
+		std::string name;
+
+		// Number of frames in which this was timed.
+		int frameCount = 0;
+
+		// Times, in milliseconds, per frame.
+		float average = 0.0f;
+		float median = 0.0f;
+		float percentile95 = 0.0f;
+		float max = 0.0f;
+
+		// Total time, in milliseconds, over all frames.
+		float total = 0.0f;
+	};
+
+	// Frames are timed from begin to end. Subsystem times outside of a frame (e.g. scene loads) still count.
+	void BeginFrame();
+	void EndFrame();
+
+	// Adds time spent in a named subsystem. Time for the same subsystem within one frame is combined.
+	void AddTime(const char* name, float milliseconds);
+
+	int GetFrameCount() const { return static_cast<int>(mFrameTimes.size()); }
+
+	// Summaries for all frames, followed by each subsystem (in the order first timed).
+	std::vector<Summary> GetSummaries() const;
+
+	// Summaries as a human-readable table.
+	std::string GetReport() const;
+
+private:
+	// Total time for each frame.
+	std::vector<float> mFrameTimes;
+	std::chrono::steady_clock::time_point mFrameStartTime;
+
+	// Time for each subsystem, per frame timed.
+	struct Subsystem
+	{
+		std::string name;
+		std::vector<float> times;
+
+		// Frame the last time was added in, so times within one frame are combined.
+		int lastFrameIndex = -1;
+	};
+	std::vector<Subsystem> mSubsystems;
+
+	static Summary Summarize(const std::string& name, std::vector<float> times);
+};
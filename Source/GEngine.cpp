@@ -5,6 +5,10 @@
 //
 #include "GEngine.h"
 
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
 #include <SDL2/SDL.h>
 
 #include "ActionManager.h"
@@ -19,8 +23,10 @@
 #include "InventoryManager.h"
 #include "Localizer.h"
 #include "LocationManager.h"
+#include "Random.h"
 #include "Scene.h"
 #include "Services.h"
+#include "StringUtil.h"
 #include "TextInput.h"
 
 GEngine* GEngine::sInstance = nullptr;
@@ -48,19 +54,33 @@ bool GEngine::Initialize()
 	
 	// Add "Assets/GK3" directory, which should contain the actual assets from GK3 data folder.
 	mAssetManager.AddSearchPath("Assets/GK3/");
+	
+	// Vertex animation sampling gets its own worker threads, so it never queues behind asset prefetches.
+	mVertexAnimationSampler.CreateThreadPool();
     
     // Initialize input.
     Services::SetInput(&mInputManager);
     
+	// Headless runs should be repeatable, so avoid time-based random seeds and use a fixed timestep.
+	if(mHeadless)
+	{
+		Random::Seed(0);
+		if(!mFramePacer.IsFixedTimestepEnabled())
+		{
+			mFramePacer.SetFixedTimestep(1.0f / 60.0f);
+		}
+		mFrameTimings = new FrameTimings();
+	}
+	
     // Initialize renderer.
-    if(!mRenderer.Initialize())
+    if(!mRenderer.Initialize(mHeadless))
     {
         return false;
     }
     Services::SetRenderer(&mRenderer);
     
     // Initialize audio.
-    if(!mAudioManager.Initialize())
+    if(!mAudioManager.Initialize(mHeadless))
     {
         return false;
     }
@@ -92,16 +112,20 @@ bool GEngine::Initialize()
     
     // Initialize sheep manager.
     Services::SetSheep(&mSheepManager);
+	mSheepManager.LoadCompiledCache();
     
     //SDL_Log(SDL_GetBasePath());
     //SDL_Log(SDL_GetPrefPath("Test", "GK3"));
 	
-	// Load cursors and use the default one to start.
-	mDefaultCursor = mAssetManager.LoadCursor("C_POINT.CUR");
-	mHighlightRedCursor = mAssetManager.LoadCursor("C_ZOOM.CUR");
-	mHighlightBlueCursor = mAssetManager.LoadCursor("C_ZOOM_2.CUR");
-	mWaitCursor = mAssetManager.LoadCursor("C_WAIT.CUR");
-	UseDefaultCursor();
+	// Load cursors and use the default one to start (no mouse when headless).
+	if(!mHeadless)
+	{
+		mDefaultCursor = mAssetManager.LoadCursor("C_POINT.CUR");
+		mHighlightRedCursor = mAssetManager.LoadCursor("C_ZOOM.CUR");
+		mHighlightBlueCursor = mAssetManager.LoadCursor("C_ZOOM_2.CUR");
+		mWaitCursor = mAssetManager.LoadCursor("C_WAIT.CUR");
+		UseDefaultCursor();
+	}
 	
     //mAssetManager.WriteBarnAssetToFile("BLKMUSTACHE_3.BMP");
     //mAssetManager.WriteAllBarnAssetsToFile(".BMP", "Bitmaps");
@@ -169,6 +193,8 @@ bool GEngine::Initialize()
 
 void GEngine::Shutdown()
 {
+	mVertexAnimationSampler.ClearRequests();
+	
 	// Delete all actors.
 	for(auto& actor : mActors)
 	{
@@ -178,6 +204,13 @@ void GEngine::Shutdown()
 	
     mRenderer.Shutdown();
     mAudioManager.Shutdown();
+	mSheepManager.SaveCompiledCache();
+	
+	if(mFrameTimings != nullptr)
+	{
+		delete mFrameTimings;
+		mFrameTimings = nullptr;
+	}
     
     //TODO: Ideally, I don't want the engine to know about SDL.
     SDL_Quit();
@@ -191,6 +224,11 @@ void GEngine::Run()
     // Loop until not running anymore.
     while(mRunning)
     {
+		if(mFrameTimings != nullptr)
+		{
+			mFrameTimings->BeginFrame();
+		}
+		
 		// Our main loop: inputs, updates, outputs.
         ProcessInput();
         Update();
@@ -198,7 +236,55 @@ void GEngine::Run()
 		
 		// After frame is done, check whether we need a scene change.
 		LoadSceneInternal();
+		
+		if(mFrameTimings != nullptr)
+		{
+			mFrameTimings->EndFrame();
+		}
+		
+		// Headless runs end after a set number of frames.
+		++mFrameCount;
+		if(mHeadless && mFrameCount >= mHeadlessFrameCount)
+		{
+			Quit();
+		}
     }
+	
+	// Report headless timings, so they can be compared between runs.
+	if(mFrameTimings != nullptr)
+	{
+		std::string report = mFrameTimings->GetReport();
+		mReportManager.Log("Generic", report);
+		std::cout << report;
+	}
+}
+
+bool GEngine::LoadCommandScript(const std::string& filePath)
+{
+	std::ifstream file(filePath);
+	if(!file.good()) { return false; }
+	
+	std::string line;
+	while(StringUtil::GetLineSanitized(file, line))
+	{
+		// Ignore empty lines and comments.
+		if(line.empty() || line[0] == '#') { continue; }
+		
+		// Line is "<frame> <command>".
+		size_t spaceIndex = line.find(' ');
+		if(spaceIndex == std::string::npos) { continue; }
+		int frame = StringUtil::ToInt(line.substr(0, spaceIndex));
+		std::string command = line.substr(spaceIndex + 1);
+		StringUtil::Trim(command);
+		mScriptCommands.push_back(std::make_pair(frame, command));
+	}
+	
+	// Commands for the same frame keep their order from the file.
+	std::stable_sort(mScriptCommands.begin(), mScriptCommands.end(), [](const std::pair<int, std::string>& a, const std::pair<int, std::string>& b) {
+		return a.first < b.first;
+	});
+	mNextScriptCommandIndex = 0;
+	return true;
 }
 
 void GEngine::Quit()
@@ -241,6 +327,14 @@ void GEngine::UseWaitCursor()
 
 void GEngine::ProcessInput()
 {
+	FrameTimings::Scope timingScope(mFrameTimings, "Input");
+	
+	// Scripted commands run on their frame, whether headless or not.
+	ProcessScriptCommands();
+	
+	// Headless runs have no real input.
+	if(mHeadless) { return; }
+	
     // Update the input manager.
     // Retrieve input device states for us to use.
     mInputManager.Update();
@@ -330,42 +424,42 @@ void GEngine::ProcessInput()
 
 void GEngine::Update()
 {
-    // Tracks the next "GetTicks" value that is acceptable to perform an update.
-    static unsigned int nextTicks = 0;
-    
-    // Tracks the last ticks value each time we run this loop.
-    static uint32_t lastTicks = 0;
-    
-    // Limit to ~60FPS. "nextTicks" is always +16 at start of frame.
-    // If we get here again and 16ms have not passed, we wait.
-	while(SDL_GetTicks() < nextTicks) { }
+	// Wait until it's time for the next frame, and get the time passed since the last one.
+	// Headless runs don't wait, and always advance by exactly one fixed timestep, so runs are repeatable.
+	float deltaTime = mHeadless ? mFramePacer.GetFixedTimestep() : mFramePacer.WaitForNextFrame();
 	
-    // Get current ticks and save next ticks as +16. Limits FPS to ~60.
-    uint32_t currentTicks = SDL_GetTicks();
-    nextTicks = currentTicks + 16;
-	
-    // Calculate the time delta.
-	uint32_t deltaTicks = currentTicks - lastTicks;
-    float deltaTime = deltaTicks * 0.001f;
-	
-	// Save last ticks for next frame.
-    lastTicks = currentTicks;
-    
-    // Limit the time delta. At least 0s, and at most, 0.05s.
-	if(deltaTime < 0.0f) { deltaTime = 0.0f; }
-    if(deltaTime > 0.05f) { deltaTime = 0.05f; }
-    
-    // Update all actors.
-    for(size_t i = 0; i < mActors.size(); i++)
-    {
-        mActors[i]->Update(deltaTime);
-    }
+	// Update all actors.
+	// With a fixed timestep, actors are updated in zero or more fixed-size steps, regardless of frame rate.
+	{
+		FrameTimings::Scope timingScope(mFrameTimings, "Actors");
+		if(mFramePacer.IsFixedTimestepEnabled() && !mHeadless)
+		{
+			int stepCount = mFramePacer.ConsumeFixedSteps(deltaTime);
+			for(int i = 0; i < stepCount; ++i)
+			{
+				UpdateActors(mFramePacer.GetFixedTimestep());
+			}
+		}
+		else
+		{
+			UpdateActors(deltaTime);
+		}
+		
+		// Delete any destroyed actors.
+		DeleteDestroyedActors();
+	}
 	
-	// Delete any destroyed actors.
-	DeleteDestroyedActors();
+	// Take vertex animation samples requested during actor updates.
+	{
+		FrameTimings::Scope timingScope(mFrameTimings, "Animation");
+		mVertexAnimationSampler.SampleAll();
+	}
     
     // Also update audio system (before or after actors?)
-    mAudioManager.Update(deltaTime);
+	{
+		FrameTimings::Scope timingScope(mFrameTimings, "Audio");
+		mAudioManager.Update(deltaTime);
+	}
     
 	// If a sheep is running, show "wait" cursor.
 	// If not, go back to normal cursor.
@@ -391,8 +485,28 @@ void GEngine::Update()
 	Debug::Update(deltaTime);
 }
 
+void GEngine::UpdateActors(float deltaTime)
+{
+	// Actors may be added during update, so don't use iterators here.
+	for(size_t i = 0; i < mActors.size(); i++)
+	{
+		mActors[i]->Update(deltaTime);
+	}
+}
+
+void GEngine::ProcessScriptCommands()
+{
+	while(mNextScriptCommandIndex < mScriptCommands.size() &&
+		  mScriptCommands[mNextScriptCommandIndex].first <= mFrameCount)
+	{
+		mConsole.ExecuteCommand(mScriptCommands[mNextScriptCommandIndex].second);
+		++mNextScriptCommandIndex;
+	}
+}
+
 void GEngine::GenerateOutputs()
 {
+	FrameTimings::Scope timingScope(mFrameTimings, "Render");
     mRenderer.Render();
 }
 
@@ -404,6 +518,10 @@ void GEngine::AddActor(Actor* actor)
 void GEngine::LoadSceneInternal()
 {
 	if(mSceneToLoad.empty()) { return; }
+	FrameTimings::Scope timingScope(mFrameTimings, "SceneLoad");
+	
+	// Any pending animation samples may be for models that are about to be unloaded.
+	mVertexAnimationSampler.ClearRequests();
 	
 	// Delete the current scene, if any.
 	if(mScene != nullptr)
@@ -425,15 +543,36 @@ void GEngine::LoadSceneInternal()
 	// After destroy pass, delete destroyed actors.
 	DeleteDestroyedActors();
 	
+	// Nothing from the old scene is using its assets anymore. Assets the new scene loads will be referenced by it instead.
+	mAssetManager.EndSceneAssets();
+	mAssetManager.BeginSceneAssets();
+	
+	// Start extracting the assets this location/timeblock needed last time, in parallel, before loading it for real.
+	// Meanwhile, record what's actually needed this time, to make a better guess next time.
+	const Timeblock& timeblock = Services::Get<GameProgress>()->GetTimeblock();
+	std::string manifestName = mSceneToLoad + timeblock.ToString();
+	mAssetManager.PrefetchManifest(manifestName);
+	mAssetManager.StartManifest();
+	
 	// Create the new scene.
 	//TODO: Scene constructor should probably ONLY take a scene name.
 	//TODO: Internally, we can call to GameProgress or whatnot as needed, but that's very GK3-specific stuff.
-	mScene = new Scene(mSceneToLoad, Services::Get<GameProgress>()->GetTimeblock());
+	mScene = new Scene(mSceneToLoad, timeblock);
 	
 	// Load the scene - this is separate from constructor
 	// b/c load operations may need to reference the scene itself!
 	mScene->Load();
 	
+	// Save what the scene needed, and free anything that was prefetched but not needed after all.
+	mAssetManager.SaveManifest(manifestName);
+	mAssetManager.DiscardPrefetches();
+	
+	// Save any condition scripts compiled for the first time, so they needn't be compiled again.
+	mSheepManager.SaveCompiledCache();
+	
+	// Assets used by previous scenes, but not this one, can now be evicted if we're over budget.
+	mAssetManager.TrimAssets();
+	
 	// Clear scene load request.
 	mSceneToLoad.clear();
 }
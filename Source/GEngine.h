@@ -13,10 +13,13 @@
 #include "AssetManager.h"
 #include "AudioManager.h"
 #include "Console.h"
+#include "FramePacer.h"
+#include "FrameTimings.h"
 #include "InputManager.h"
 #include "Renderer.h"
 #include "SheepManager.h"
 #include "ReportManager.h"
+#include "VertexAnimationSampler.h"
 
 class Actor;
 class Scene;
@@ -36,6 +39,21 @@ public:
     void Quit();
     
     void AddActor(Actor* actor);
+	
+	// Controls frame rate, and whether actors update with a fixed timestep.
+	FramePacer& GetFramePacer() { return mFramePacer; }
+	
+	// Vertex animation samples requested during actor updates are taken here, in parallel, once all actors have updated.
+	VertexAnimationSampler& GetVertexAnimationSampler() { return mVertexAnimationSampler; }
+	
+	// Headless mode runs without a window, GL context, audio, or real input, for automated testing and timing.
+	// Each frame advances by exactly one fixed timestep. After the frame count is reached, the game quits and reports frame timings.
+	// Must be set before initializing.
+	void SetHeadless(bool headless, int frameCount) { mHeadless = headless; mHeadlessFrameCount = frameCount; }
+	
+	// Loads commands to replay, headless or not. Each line is a frame number, followed by a console (sheep) command to execute that frame.
+	// Headless runs use these instead of real input; windowed runs execute them alongside real input.
+	bool LoadCommandScript(const std::string& filePath);
     
 	void LoadScene(std::string name) { mSceneToLoad = name; }
     Scene* GetScene() { return mScene; }
@@ -61,6 +79,24 @@ private:
 	ReportManager mReportManager;
 	ActionManager mActionManager;
 	Console mConsole;
+	
+	// Paces frames and tracks delta time.
+	FramePacer mFramePacer;
+	
+	// Samples vertex animations for all actors at once.
+	VertexAnimationSampler mVertexAnimationSampler;
+	
+	// Headless mode, and how many frames to run.
+	bool mHeadless = false;
+	int mHeadlessFrameCount = 0;
+	int mFrameCount = 0;
+	
+	// Commands to replay in headless mode (frame number and command), in frame order.
+	std::vector<std::pair<int, std::string>> mScriptCommands;
+	size_t mNextScriptCommandIndex = 0;
+	
+	// Frame and subsystem timings, only recorded when headless.
+	FrameTimings* mFrameTimings = nullptr;
     
     // A list of all actors that currently exist in the game.
     std::vector<Actor*> mActors;
@@ -83,7 +119,9 @@ private:
     Cursor* mCursor = nullptr;
     
     void ProcessInput();
+	void ProcessScriptCommands();
     void Update();
+	void UpdateActors(float deltaTime);
     void GenerateOutputs();
 	
 	void LoadSceneInternal();
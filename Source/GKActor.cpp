@@ -49,6 +49,9 @@ GKActor::GKActor(const std::string& identifier) : GKObject(),
 	CharacterConfig& config = Services::Get<CharacterManager>()->GetCharacterConfig(mIdentifier);
 	mCharConfig = &config;
 	
+	// The hip vertex decides where the actor is during animations, so must stay up to date on the CPU.
+	mVertexAnimator->SampleOnCPU(config.hipAxesMeshIndex, config.hipAxesGroupIndex);
+	
 	// Create and configure face controller.
 	mFaceController = AddComponent<FaceController>();
 	mFaceController->SetCharacterConfig(config);
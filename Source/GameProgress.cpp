@@ -5,16 +5,54 @@
 //
 #include "GameProgress.h"
 
+#include <cassert>
+
 #include "GMath.h"
 #include "Localizer.h"
 #include "Services.h"
-#include "StringUtil.h"
 
 TYPE_DEF_BASE(GameProgress);
 
+namespace
+{
+	// Key for state read by a name that wasn't a symbol yet (see GetSymbolKey).
+	const uint64_t kUnknownNameKey = (1ULL << 56) - 1;
+	
+	// Gets a value by symbol id, or the default value if it was never set (or the symbol is invalid).
+	template<typename T> T GetValue(const std::vector<T>& values, Symbol symbol)
+	{
+		return symbol.IsValid() && static_cast<size_t>(symbol.GetId()) < values.size() ? values[symbol.GetId()] : T();
+	}
+	
+	// Gets a value by symbol id to be set, growing the values to fit if needed.
+	// Symbol must be valid - callers ignore sets with invalid symbols.
+	template<typename T> typename std::vector<T>::reference GetValueForSet(std::vector<T>& values, Symbol symbol)
+	{
+		assert(symbol.IsValid());
+		if(static_cast<size_t>(symbol.GetId()) >= values.size())
+		{
+			values.resize(symbol.GetId() + 1);
+		}
+		return values[symbol.GetId()];
+	}
+	
+	int GetCount(const std::unordered_map<uint64_t, int>& counts, uint64_t key)
+	{
+		auto it = counts.find(key);
+		return it != counts.end() ? it->second : 0;
+	}
+}
+
+int GameProgress::GetScore() const
+{
+	OnRead(StateType::Score, 0);
+	return mScore;
+}
+
 void GameProgress::SetScore(int score)
 {
 	mScore = Math::Clamp(score, 0, kMaxScore);
+	OnChanged(StateType::Score, 0);
 }
 
 void GameProgress::IncreaseScore(int points)
@@ -22,13 +60,33 @@ void GameProgress::IncreaseScore(int points)
 	SetScore(mScore + points);
 }
 
+const Timeblock& GameProgress::GetTimeblock() const
+{
+	OnRead(StateType::Time, 0);
+	return mTimeblock;
+}
+
+const Timeblock& GameProgress::GetLastTimeblock() const
+{
+	OnRead(StateType::Time, 0);
+	return mLastTimeblock;
+}
+
 void GameProgress::SetTimeblock(const Timeblock& timeblock)
 {
 	mLastTimeblock = mTimeblock;
 	mTimeblock = timeblock;
+	OnChanged(StateType::Time, 0);
 	
 	// Chat counts are reset on time block change.
-	mChatCounts.clear();
+	for(int i = 0; i < mChatCounts.size(); ++i)
+	{
+		if(mChatCounts[i] != 0)
+		{
+			mChatCounts[i] = 0;
+			OnChanged(StateType::ChatCount, i);
+		}
+	}
 }
 
 std::string GameProgress::GetTimeblockDisplayName() const
@@ -37,134 +95,166 @@ std::string GameProgress::GetTimeblockDisplayName() const
     return Services::Get<Localizer>()->GetText("Day" + mTimeblock.ToString());
 }
 
-bool GameProgress::GetFlag(const std::string& flagName) const
+bool GameProgress::GetFlag(Symbol flag) const
 {
-	// If the flag exists, it implies a "true" value.
-	// Absence of flag implies "false" value.
-	auto it = mGameFlags.find(flagName);
-	return it != mGameFlags.end();
+	// Flags that were never set are false.
+	OnRead(StateType::Flag, GetSymbolKey(flag));
+	return GetValue(mGameFlags, flag);
 }
 
-void GameProgress::SetFlag(const std::string& flagName)
+void GameProgress::SetFlag(Symbol flag)
 {
-	// Doesn't matter whether we are setting an already set flag.
-	mGameFlags.insert(flagName);
+	if(!flag.IsValid()) { return; }
+	GetValueForSet(mGameFlags, flag) = true;
+	OnChanged(StateType::Flag, flag.GetId());
 }
 
-void GameProgress::ClearFlag(const std::string& flagName)
+void GameProgress::ClearFlag(Symbol flag)
 {
-	// Erase the flag from the container to "clear" it.
-	auto it = mGameFlags.find(flagName);
-	if(it != mGameFlags.end())
+	if(flag.IsValid() && static_cast<size_t>(flag.GetId()) < mGameFlags.size())
 	{
-		mGameFlags.erase(it);
+		mGameFlags[flag.GetId()] = false;
+		OnChanged(StateType::Flag, flag.GetId());
 	}
 }
 
-int GameProgress::GetGameVariable(const std::string& varName) const
+int GameProgress::GetGameVariable(Symbol var) const
 {
-	auto it = mGameVariables.find(StringUtil::ToLowerCopy(varName));
-	if(it != mGameVariables.end())
-	{
-		return it->second;
-	}
-	return 0;
+	OnRead(StateType::Variable, GetSymbolKey(var));
+	return GetValue(mGameVariables, var);
 }
 
-void GameProgress::SetGameVariable(const std::string& varName, int value)
+void GameProgress::SetGameVariable(Symbol var, int value)
 {
-	mGameVariables[StringUtil::ToLowerCopy(varName)] = value;
+	if(!var.IsValid()) { return; }
+	GetValueForSet(mGameVariables, var) = value;
+	OnChanged(StateType::Variable, var.GetId());
 }
 
-void GameProgress::IncGameVariable(const std::string& varName)
+void GameProgress::IncGameVariable(Symbol var)
 {
-	++mGameVariables[StringUtil::ToLowerCopy(varName)];
+	if(!var.IsValid()) { return; }
+	++GetValueForSet(mGameVariables, var);
+	OnChanged(StateType::Variable, var.GetId());
 }
 
-int GameProgress::GetChatCount(const std::string& noun) const
+int GameProgress::GetChatCount(Symbol noun) const
 {
-	auto it = mChatCounts.find(StringUtil::ToLowerCopy(noun));
-	if(it != mChatCounts.end())
-	{
-		return it->second;
-	}
-	return 0;
+	OnRead(StateType::ChatCount, GetSymbolKey(noun));
+	return GetValue(mChatCounts, noun);
 }
 
-void GameProgress::SetChatCount(const std::string& noun, int count)
+void GameProgress::SetChatCount(Symbol noun, int count)
 {
-	mChatCounts[StringUtil::ToLowerCopy(noun)] = count;
+	if(!noun.IsValid()) { return; }
+	GetValueForSet(mChatCounts, noun) = count;
+	OnChanged(StateType::ChatCount, noun.GetId());
 }
 
-void GameProgress::IncChatCount(const std::string& noun)
+void GameProgress::IncChatCount(Symbol noun)
 {
-	++mChatCounts[StringUtil::ToLowerCopy(noun)];
+	if(!noun.IsValid()) { return; }
+	++GetValueForSet(mChatCounts, noun);
+	OnChanged(StateType::ChatCount, noun.GetId());
 }
 
-int GameProgress::GetTopicCount(const std::string& noun, const std::string& topic) const
+int GameProgress::GetTopicCount(Symbol noun, Symbol topic) const
 {
-	// Key is noun+topic.
-	// Make sure it's all lowercase, for consistency.
-	std::string key = noun + topic;
-	StringUtil::ToLower(key);
-	
-	// Find and return, or return default.
-	auto it = mTopicCounts.find(key);
-	if(it != mTopicCounts.end())
+	if(!noun.IsValid() || !topic.IsValid())
 	{
-		return it->second;
+		OnRead(StateType::TopicCount, kUnknownNameKey);
+		return 0;
 	}
-	return 0;
+	uint64_t key = GetPairKey(noun, topic);
+	OnRead(StateType::TopicCount, key);
+	return GetCount(mTopicCounts, key);
 }
 
-void GameProgress::SetTopicCount(const std::string& noun, const std::string& topic, int count)
+void GameProgress::SetTopicCount(Symbol noun, Symbol topic, int count)
 {
-	// Key is noun+topic.
-	// Make sure it's all lowercase, for consistency.
-	std::string key = noun + topic;
-	StringUtil::ToLower(key);
+	if(!noun.IsValid() || !topic.IsValid()) { return; }
+	uint64_t key = GetPairKey(noun, topic);
 	mTopicCounts[key] = count;
+	OnChanged(StateType::TopicCount, key);
 }
 
-void GameProgress::IncTopicCount(const std::string& noun, const std::string& topic)
+void GameProgress::IncTopicCount(Symbol noun, Symbol topic)
 {
-	// Key is noun+topic.
-	// Make sure it's all lowercase, for consistency.
-	std::string key = noun + topic;
-	StringUtil::ToLower(key);
+	if(!noun.IsValid() || !topic.IsValid()) { return; }
+	uint64_t key = GetPairKey(noun, topic);
 	++mTopicCounts[key];
+	OnChanged(StateType::TopicCount, key);
 }
 
-int GameProgress::GetNounVerbCount(const std::string& noun, const std::string& verb) const
+int GameProgress::GetNounVerbCount(Symbol noun, Symbol verb) const
 {
-	// Key is noun+verb.
-	// Make sure it's all lowercase, for consistency.
-	std::string key = noun + verb;
-	StringUtil::ToLower(key);
-	
-	// Find and return, or return default.
-	auto it = mNounVerbCounts.find(key);
-	if(it != mNounVerbCounts.end())
+	if(!noun.IsValid() || !verb.IsValid())
 	{
-		return it->second;
+		OnRead(StateType::NounVerbCount, kUnknownNameKey);
+		return 0;
 	}
-	return 0;
+	uint64_t key = GetPairKey(noun, verb);
+	OnRead(StateType::NounVerbCount, key);
+	return GetCount(mNounVerbCounts, key);
 }
 
-void GameProgress::SetNounVerbCount(const std::string& noun, const std::string& verb, int count)
+void GameProgress::SetNounVerbCount(Symbol noun, Symbol verb, int count)
 {
-	// Key is noun+verb.
-	// Make sure it's all lowercase, for consistency.
-	std::string key = noun + verb;
-	StringUtil::ToLower(key);
+	if(!noun.IsValid() || !verb.IsValid()) { return; }
+	uint64_t key = GetPairKey(noun, verb);
 	mNounVerbCounts[key] = count;
+	OnChanged(StateType::NounVerbCount, key);
 }
 
-void GameProgress::IncNounVerbCount(const std::string& noun, const std::string& verb)
+void GameProgress::IncNounVerbCount(Symbol noun, Symbol verb)
 {
-	// Key is noun+verb.
-	// Make sure it's all lowercase, for consistency.
-	std::string key = noun + verb;
-	StringUtil::ToLower(key);
+	if(!noun.IsValid() || !verb.IsValid()) { return; }
+	uint64_t key = GetPairKey(noun, verb);
 	++mNounVerbCounts[key];
+	OnChanged(StateType::NounVerbCount, key);
+}
+
+/*static*/ uint64_t GameProgress::GetSymbolKey(Symbol symbol)
+{
+	// State read by a name that isn't a symbol was never set. It can only change once the name becomes a symbol (see OnChanged).
+	return symbol.IsValid() ? static_cast<uint64_t>(symbol.GetId()) : kUnknownNameKey;
+}
+
+/*static*/ uint64_t GameProgress::GetPairKey(Symbol first, Symbol second)
+{
+	// Symbol ids are non-negative ints, so each fits in 32 bits.
+	return (static_cast<uint64_t>(static_cast<uint32_t>(first.GetId())) << 32) | static_cast<uint32_t>(second.GetId());
+}
+
+/*static*/ uint64_t GameProgress::GetStateKey(StateType type, uint64_t key)
+{
+	// Pair keys can use the bits the type goes in, so different state may share a key.
+	// That's okay: the key only decides which cached results to drop, and dropping extra ones is just slower.
+	return (static_cast<uint64_t>(type) << 56) ^ key;
+}
+
+void GameProgress::OnRead(StateType type, uint64_t key) const
+{
+	if(mReadKeys != nullptr)
+	{
+		mReadKeys->push_back(GetStateKey(type, key));
+	}
+}
+
+void GameProgress::OnChanged(StateType type, uint64_t key)
+{
+	if(mChangeCallback)
+	{
+		// If new symbols appeared since the last change, state read by names that weren't symbols yet may have been set.
+		int symbolCount = Symbol::GetCount();
+		if(symbolCount != mSymbolCount)
+		{
+			mSymbolCount = symbolCount;
+			for(StateType nameType : { StateType::Flag, StateType::Variable, StateType::ChatCount, StateType::TopicCount, StateType::NounVerbCount })
+			{
+				mChangeCallback(GetStateKey(nameType, kUnknownNameKey));
+			}
+		}
+		mChangeCallback(GetStateKey(type, key));
+	}
 }
@@ -8,10 +8,13 @@
 // flag states, game logic variable states, noun/verb counts, etc.
 //
 #pragma once
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <unordered_map>
-#include <unordered_set>
+#include <vector>
 
+#include "Symbol.h"
 #include "Timeblock.h"
 #include "Type.h"
 
@@ -20,35 +23,60 @@ class GameProgress
 	TYPE_DECL_BASE();
 public:
 	int GetMaxScore() const { return kMaxScore; }
-	int GetScore() const { return mScore; }
+	int GetScore() const;
 	void SetScore(int score);
 	void IncreaseScore(int points);
 	
-	const Timeblock& GetTimeblock() const { return mTimeblock; }
-	const Timeblock& GetLastTimeblock() const { return mLastTimeblock; }
+	const Timeblock& GetTimeblock() const;
+	const Timeblock& GetLastTimeblock() const;
 	void SetTimeblock(const Timeblock& timeblock);
     
     std::string GetTimeblockDisplayName() const;
 	
-	bool GetFlag(const std::string& flagName) const;
-	void SetFlag(const std::string& flagName);
-	void ClearFlag(const std::string& flagName);
+	// Names (flags, variables, nouns, verbs, topics) ignore case.
+	// They can be passed as strings, or as symbols, which are faster if the same name is used often.
+	// Invalid symbols read as false/zero, and setting them does nothing.
+	// Reading by name doesn't intern names that aren't symbols yet - such names were never set, so read as false/zero.
+	bool GetFlag(const std::string& flagName) const { return GetFlag(Symbol::Find(flagName)); }
+	bool GetFlag(Symbol flag) const;
+	void SetFlag(const std::string& flagName) { SetFlag(Symbol(flagName)); }
+	void SetFlag(Symbol flag);
+	void ClearFlag(const std::string& flagName) { ClearFlag(Symbol::Find(flagName)); }
+	void ClearFlag(Symbol flag);
 	
-	int GetGameVariable(const std::string& varName) const;
-	void SetGameVariable(const std::string& varName, int value);
-	void IncGameVariable(const std::string& varName);
+	int GetGameVariable(const std::string& varName) const { return GetGameVariable(Symbol::Find(varName)); }
+	int GetGameVariable(Symbol var) const;
+	void SetGameVariable(const std::string& varName, int value) { SetGameVariable(Symbol(varName), value); }
+	void SetGameVariable(Symbol var, int value);
+	void IncGameVariable(const std::string& varName) { IncGameVariable(Symbol(varName)); }
+	void IncGameVariable(Symbol var);
 	
-	int GetChatCount(const std::string& noun) const;
-	void SetChatCount(const std::string&, int count);
-	void IncChatCount(const std::string& noun);
+	int GetChatCount(const std::string& noun) const { return GetChatCount(Symbol::Find(noun)); }
+	int GetChatCount(Symbol noun) const;
+	void SetChatCount(const std::string& noun, int count) { SetChatCount(Symbol(noun), count); }
+	void SetChatCount(Symbol noun, int count);
+	void IncChatCount(const std::string& noun) { IncChatCount(Symbol(noun)); }
+	void IncChatCount(Symbol noun);
 	
-	int GetTopicCount(const std::string& noun, const std::string& topic) const;
-	void SetTopicCount(const std::string& noun, const std::string& topic, int count);
-	void IncTopicCount(const std::string& noun, const std::string& topic);
+	int GetTopicCount(const std::string& noun, const std::string& topic) const { return GetTopicCount(Symbol::Find(noun), Symbol::Find(topic)); }
+	int GetTopicCount(Symbol noun, Symbol topic) const;
+	void SetTopicCount(const std::string& noun, const std::string& topic, int count) { SetTopicCount(Symbol(noun), Symbol(topic), count); }
+	void SetTopicCount(Symbol noun, Symbol topic, int count);
+	void IncTopicCount(const std::string& noun, const std::string& topic) { IncTopicCount(Symbol(noun), Symbol(topic)); }
+	void IncTopicCount(Symbol noun, Symbol topic);
 	
-	int GetNounVerbCount(const std::string& noun, const std::string& verb) const;
-	void SetNounVerbCount(const std::string& noun, const std::string& verb, int count);
-	void IncNounVerbCount(const std::string& noun, const std::string& verb);
+	int GetNounVerbCount(const std::string& noun, const std::string& verb) const { return GetNounVerbCount(Symbol::Find(noun), Symbol::Find(verb)); }
+	int GetNounVerbCount(Symbol noun, Symbol verb) const;
+	void SetNounVerbCount(const std::string& noun, const std::string& verb, int count) { SetNounVerbCount(Symbol(noun), Symbol(verb), count); }
+	void SetNounVerbCount(Symbol noun, Symbol verb, int count);
+	void IncNounVerbCount(const std::string& noun, const std::string& verb) { IncNounVerbCount(Symbol(noun), Symbol(verb)); }
+	void IncNounVerbCount(Symbol noun, Symbol verb);
+	
+	// Reads of game state can be recorded, so results computed from that state can be cached until it changes.
+	// While recording, every read adds a key identifying the state that was read. Every change passes the changed state's key to the callback.
+	void StartRecordingReads(std::vector<uint64_t>* readKeys) { mReadKeys = readKeys; }
+	void StopRecordingReads() { mReadKeys = nullptr; }
+	void SetChangeCallback(std::function<void(uint64_t)> callback) { mChangeCallback = callback; }
 	
 private:
 	// Score tracking.
@@ -59,23 +87,49 @@ private:
 	Timeblock mTimeblock;
 	Timeblock mLastTimeblock;
 	
-	// General-use true/false flags for game logic.
-	// Absence of a flag implies false; otherwise, true.
-	std::unordered_set<std::string> mGameFlags;
+	// General-use true/false flags for game logic, indexed by symbol id.
+	// Flags past the end are false.
+	std::vector<bool> mGameFlags;
 	
-	// Tracks the number of times the player has chatted with a noun.
-	std::unordered_map<std::string, int> mChatCounts;
+	// Tracks the number of times the player has chatted with a noun, indexed by symbol id.
+	std::vector<int> mChatCounts;
 	
-	// Maps noun/topic combos to a count value.
+	// Maps noun/topic combos (see GetPairKey) to a count value.
 	// Tracks the number of times we've talked to a noun about a topic.
-	std::unordered_map<std::string, int> mTopicCounts;
+	std::unordered_map<uint64_t, int> mTopicCounts;
 	
-	// Maps noun/verb to a count value.
+	// Maps noun/verb (see GetPairKey) to a count value.
 	// Tracks the number of times we've triggered a verb on a noun.
-	std::unordered_map<std::string, int> mNounVerbCounts;
+	std::unordered_map<uint64_t, int> mNounVerbCounts;
 
-	// Maps a variable name to an integer value.
-	// For general game logic variables.
-	std::unordered_map<std::string, int> mGameVariables;
+	// General game logic variables, indexed by symbol id.
+	// Variables past the end are zero.
+	std::vector<int> mGameVariables;
+	
+	// If not null, keys for any state that's read are added here.
+	std::vector<uint64_t>* mReadKeys = nullptr;
+	
+	// If set, called with the key of any state that changes.
+	std::function<void(uint64_t)> mChangeCallback;
+	
+	// Number of symbols when changes were last reported. When more symbols appear, state read by names that weren't symbols may change.
+	int mSymbolCount = Symbol::GetCount();
+	
+	// Kinds of state, used in state keys.
+	enum class StateType : uint64_t
+	{
+		Score = 1,
+		Time,
+		Flag,
+		Variable,
+		ChatCount,
+		TopicCount,
+		NounVerbCount
+	};
+	static uint64_t GetSymbolKey(Symbol symbol);
+	static uint64_t GetPairKey(Symbol first, Symbol second);
+	static uint64_t GetStateKey(StateType type, uint64_t key);
+	
+	void OnRead(StateType type, uint64_t key) const;
+	void OnChanged(StateType type, uint64_t key);
 };
-
@@ -0,0 +1,116 @@
+//
+// HeightGrid.cpp
+//
+// Clark Kromenaker
+//
+#include "HeightGrid.h"
+
+#include <cfloat>
+
+#include "GMath.h"
+
+namespace
+{
+	// Triangle bounds are grown slightly when sorting into cells, so rounding never puts a point in a cell missing its triangle.
+	const float kBoundsPadding = 0.01f;
+
+	// Aim for about this many triangles per cell.
+	const float kTrianglesPerCell = 4.0f;
+
+	// Limits grid memory for very large or oddly shaped floors.
+	const int kMaxCellsPerAxis = 256;
+}
+
+/*static*/ const float HeightGrid::kRayOriginY = 10000.0f;
+
+void HeightGrid::Build(const std::vector<Vector3>& triangleVertices)
+{
+	mVertices = triangleVertices;
+	mCellStarts.clear();
+	mCellTriangles.clear();
+	mColumnCount = 0;
+	mRowCount = 0;
+
+	int triangleCount = GetTriangleCount();
+	if(triangleCount == 0) { return; }
+
+	// Calculate XZ bounds of all triangles.
+	mMinX = mMinZ = FLT_MAX;
+	mMaxX = mMaxZ = -FLT_MAX;
+	for(auto& vertex : mVertices)
+	{
+		mMinX = Math::Min(mMinX, vertex.x);
+		mMinZ = Math::Min(mMinZ, vertex.z);
+		mMaxX = Math::Max(mMaxX, vertex.x);
+		mMaxZ = Math::Max(mMaxZ, vertex.z);
+	}
+	mMinX -= kBoundsPadding;
+	mMinZ -= kBoundsPadding;
+	mMaxX += kBoundsPadding;
+	mMaxZ += kBoundsPadding;
+
+	// Pick a cell size that spreads triangles over cells fairly evenly (assuming they're evenly spread over the floor).
+	float width = mMaxX - mMinX;
+	float depth = mMaxZ - mMinZ;
+	mCellSize = Math::Sqrt(width * depth * kTrianglesPerCell / triangleCount);
+	mCellSize = Math::Max(mCellSize, Math::Max(width, depth) / kMaxCellsPerAxis);
+	mColumnCount = Math::Clamp(static_cast<int>(width / mCellSize) + 1, 1, kMaxCellsPerAxis);
+	mRowCount = Math::Clamp(static_cast<int>(depth / mCellSize) + 1, 1, kMaxCellsPerAxis);
+	int cellCount = mColumnCount * mRowCount;
+
+	// Each triangle goes in every cell its (padded) bounds overlap.
+	// First pass counts triangles per cell, second pass fills in triangle indexes.
+	// Iterating triangles in order keeps each cell's triangles in index order.
+	std::vector<int> triangleCells(triangleCount * 4);
+	for(int i = 0; i < triangleCount; ++i)
+	{
+		const Vector3& p0 = mVertices[i * 3];
+		const Vector3& p1 = mVertices[i * 3 + 1];
+		const Vector3& p2 = mVertices[i * 3 + 2];
+		triangleCells[i * 4] = GetColumn(Math::Min(p0.x, Math::Min(p1.x, p2.x)) - kBoundsPadding);
+		triangleCells[i * 4 + 1] = GetRow(Math::Min(p0.z, Math::Min(p1.z, p2.z)) - kBoundsPadding);
+		triangleCells[i * 4 + 2] = GetColumn(Math::Max(p0.x, Math::Max(p1.x, p2.x)) + kBoundsPadding);
+		triangleCells[i * 4 + 3] = GetRow(Math::Max(p0.z, Math::Max(p1.z, p2.z)) + kBoundsPadding);
+	}
+
+	mCellStarts.resize(cellCount + 1, 0);
+	for(int i = 0; i < triangleCount; ++i)
+	{
+		for(int row = triangleCells[i * 4 + 1]; row <= triangleCells[i * 4 + 3]; ++row)
+		{
+			for(int column = triangleCells[i * 4]; column <= triangleCells[i * 4 + 2]; ++column)
+			{
+				++mCellStarts[row * mColumnCount + column + 1];
+			}
+		}
+	}
+	for(int i = 0; i < cellCount; ++i)
+	{
+		mCellStarts[i + 1] += mCellStarts[i];
+	}
+
+	mCellTriangles.resize(mCellStarts[cellCount]);
+	std::vector<int> cellFillCounts(cellCount, 0);
+	for(int i = 0; i < triangleCount; ++i)
+	{
+		for(int row = triangleCells[i * 4 + 1]; row <= triangleCells[i * 4 + 3]; ++row)
+		{
+			for(int column = triangleCells[i * 4]; column <= triangleCells[i * 4 + 2]; ++column)
+			{
+				int cellIndex = row * mColumnCount + column;
+				mCellTriangles[mCellStarts[cellIndex] + cellFillCounts[cellIndex]] = i;
+				++cellFillCounts[cellIndex];
+			}
+		}
+	}
+}
+
+int HeightGrid::GetColumn(float x) const
+{
+	return Math::Clamp(static_cast<int>((x - mMinX) / mCellSize), 0, mColumnCount - 1);
+}
+
+int HeightGrid::GetRow(float z) const
+{
+	return Math::Clamp(static_cast<int>((z - mMinZ) / mCellSize), 0, mRowCount - 1);
+}
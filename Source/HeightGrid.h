@@ -0,0 +1,82 @@
+//
+// HeightGrid.h
+//
+// Clark Kromenaker
+//
+// Answers "what is the height of the ground below this point?" for a set of triangles (e.g. a scene's floor).
+// Triangles are sorted into a uniform grid of cells on the XZ plane, so a query only tests the few triangles
+// that overlap the cell the point is in, rather than every triangle.
+//
+// A height query gives the same result as casting a ray straight down from high above, and testing
+// every triangle in the order provided (using the first triangle hit, which is not necessarily the highest).
+//
+#pragma once
+#include <vector>
+
+#include "Collisions.h"
+#include "Ray.h"
+#include "Vector3.h"
+
+class HeightGrid
+{
+public:
+	// Height from which rays are cast down.
+	static const float kRayOriginY;
+
+	// Builds the grid. Each consecutive three vertices define a triangle.
+	void Build(const std::vector<Vector3>& triangleVertices);
+
+	int GetTriangleCount() const { return static_cast<int>(mVertices.size() / 3); }
+
+	// Gets height below a position (only X/Z are used), using the first triangle for which filter(triangleIndex) returns true.
+	// Returns false if no such triangle is under the position.
+	template<class Filter> bool GetHeight(const Vector3& position, Filter filter, float& outHeight) const;
+
+private:
+	// Triangle vertices, three per triangle, in the order provided.
+	std::vector<Vector3> mVertices;
+
+	// Bounds of the grid on the XZ plane.
+	float mMinX = 0.0f;
+	float mMinZ = 0.0f;
+	float mMaxX = 0.0f;
+	float mMaxZ = 0.0f;
+
+	// Size and count of cells.
+	float mCellSize = 1.0f;
+	int mColumnCount = 0;
+	int mRowCount = 0;
+
+	// Triangles overlapping each cell, in triangle index order.
+	// Cell i's triangles are from mCellStarts[i] up to (not including) mCellStarts[i + 1].
+	std::vector<int> mCellStarts;
+	std::vector<int> mCellTriangles;
+
+	int GetColumn(float x) const;
+	int GetRow(float z) const;
+};
+
+template<class Filter>
+bool HeightGrid::GetHeight(const Vector3& position, Filter filter, float& outHeight) const
+{
+	if(mCellStarts.empty()) { return false; }
+	if(position.x < mMinX || position.x > mMaxX || position.z < mMinZ || position.z > mMaxZ) { return false; }
+
+	Ray downRay(Vector3(position.x, kRayOriginY, position.z), -Vector3::UnitY);
+
+	// Cell triangles are in index order, so the first hit is the first hit in the full triangle list.
+	int cellIndex = GetRow(position.z) * mColumnCount + GetColumn(position.x);
+	for(int i = mCellStarts[cellIndex]; i < mCellStarts[cellIndex + 1]; ++i)
+	{
+		int triangleIndex = mCellTriangles[i];
+		if(!filter(triangleIndex)) { continue; }
+
+		RaycastHit hitInfo;
+		if(Collisions::TestRayTriangle(downRay, mVertices[triangleIndex * 3], mVertices[triangleIndex * 3 + 1], mVertices[triangleIndex * 3 + 2], hitInfo))
+		{
+			outHeight = downRay.GetPoint(hitInfo.t).y;
+			return true;
+		}
+	}
+	return false;
+}
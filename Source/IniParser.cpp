@@ -5,11 +5,72 @@
 //
 #include "IniParser.h"
 
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 
-#include "imstream.h"
-#include "StringUtil.h"
+namespace
+{
+	// Parses "count" numbers separated by "delimiter" (e.g. "4.23, 5.23, 10.04") without making substrings.
+	// An opening brace is skipped, and anything after the last number (like a closing brace) is ignored.
+	// Returns false if there are too few delimiters.
+	bool ParseNumbers(const std::string& str, char delimiter, float* numbers, int count)
+	{
+		const char* current = str.c_str();
+		if(*current == '{') { ++current; }
+		
+		for(int i = 0; i < count; ++i)
+		{
+			// All but the last number must be followed by a delimiter.
+			const char* delimiterPos = nullptr;
+			if(i < count - 1)
+			{
+				delimiterPos = strchr(current, delimiter);
+				if(delimiterPos == nullptr) { return false; }
+			}
+			
+			numbers[i] = strtof(current, nullptr);
+			if(delimiterPos != nullptr)
+			{
+				current = delimiterPos + 1;
+			}
+		}
+		return true;
+	}
+	
+	inline bool IsWhitespace(char c)
+	{
+		return c == ' ' || c == '\t';
+	}
+	
+	// Trims spaces and tabs from both ends of a range.
+	void TrimRange(const char*& start, const char*& end)
+	{
+		while(start < end && IsWhitespace(*start)) { ++start; }
+		while(end > start && IsWhitespace(*(end - 1))) { --end; }
+	}
+	
+	// Copies a range into a string, leaving out any rogue tab characters. Range should already be trimmed.
+	void AssignWithoutTabs(std::string& str, const char* start, const char* end)
+	{
+		str.clear();
+		for(const char* c = start; c < end; ++c)
+		{
+			if(*c != '\t')
+			{
+				str.push_back(*c);
+			}
+		}
+	}
+	
+	inline bool StartsWithComment(const char* start, const char* end)
+	{
+		return end - start >= 2 && start[0] == '/' && start[1] == '/';
+	}
+}
 
 float IniKeyValue::GetValueAsFloat() const
 {
@@ -29,194 +90,119 @@ bool IniKeyValue::GetValueAsBool() const
 Vector2 IniKeyValue::GetValueAsVector2() const
 {
     // We assume the string form of {4.23, 5.23}
-    // First, let's get rid of the braces.
-    std::string noBraces = value;
-    if(noBraces[0] == '{' && noBraces[noBraces.size() - 1] == '}')
-    {
-        noBraces = value.substr(1, value.length() - 2);
-    }
-    
-    // Find the comma index. If not present,
-    // this isn't the right form, so we fail.
-    std::size_t commaIndex = noBraces.find(',');
-    if(commaIndex == std::string::npos)
+    float numbers[2];
+    if(!ParseNumbers(value, ',', numbers, 2))
     {
         return Vector2::Zero;
     }
-    
-    // Split at the comma.
-    std::string firstNum = noBraces.substr(0, commaIndex);
-    std::string secondNum = noBraces.substr(commaIndex + 1, std::string::npos);
-    
-    // Convert to numbers and return.
-    return Vector2(std::stof(firstNum), std::stof(secondNum));
+    return Vector2(numbers[0], numbers[1]);
 }
 
 Vector3 IniKeyValue::GetValueAsVector3() const
 {
     // We assume the string form of {4.23, 5.23, 10.04}
-    // First, let's get rid of the braces.
-    std::string noBraces = value;
-    if(noBraces[0] == '{' && noBraces[noBraces.size() - 1] == '}')
-    {
-        noBraces = value.substr(1, value.length() - 2);
-    }
-	else if(noBraces[0] == '{')
-	{
-		// Error resiliance: some typos exist, like missing closing bracket.
-		// Don't want it to crash the game :P
-		noBraces = value.substr(1, value.length() - 1);
-	}
-    
-    // Find the two commas.
-    std::size_t firstCommaIndex = noBraces.find(',');
-    if(firstCommaIndex == std::string::npos)
+	// Some typos exist (like a missing closing brace), but those parse fine too.
+    float numbers[3];
+    if(!ParseNumbers(value, ',', numbers, 3))
     {
         return Vector3::Zero;
     }
-    std::size_t secondCommaIndex = noBraces.find(',', firstCommaIndex + 1);
-    if(secondCommaIndex == std::string::npos)
-    {
-        return Vector3::Zero;
-    }
-    
-    // Split at commas.
-    std::string firstNum = noBraces.substr(0, firstCommaIndex);
-    std::string secondNum = noBraces.substr(firstCommaIndex + 1, secondCommaIndex - firstCommaIndex);
-    std::string thirdNum = noBraces.substr(secondCommaIndex + 1, std::string::npos);
-    
-    // Convert to numbers and return.
-    return Vector3(std::stof(firstNum), std::stof(secondNum), std::stof(thirdNum));
+    return Vector3(numbers[0], numbers[1], numbers[2]);
 }
 
 Color32 IniKeyValue::GetValueAsColor32() const
 {
 	// Assume string form of R/G/B
-	std::size_t firstSlashIndex = value.find('/');
-	if(firstSlashIndex == std::string::npos)
-	{
-		return Color32::Black;
-	}
-	std::size_t secondSlashIndex = value.find('/', firstSlashIndex + 1);
-	if(secondSlashIndex == std::string::npos)
+	float numbers[3];
+	if(!ParseNumbers(value, '/', numbers, 3))
 	{
 		return Color32::Black;
 	}
-	
-	// Split at slashes.
-	std::string firstNum = value.substr(0, firstSlashIndex);
-	std::string secondNum = value.substr(firstSlashIndex + 1, secondSlashIndex - firstSlashIndex - 1);
-	std::string thirdNum = value.substr(secondSlashIndex + 1, std::string::npos);
-	
-	// Convert to number and return.
-	return Color32(std::stoi(firstNum), std::stoi(secondNum), std::stoi(thirdNum));
+	return Color32(static_cast<int>(numbers[0]), static_cast<int>(numbers[1]), static_cast<int>(numbers[2]));
 }
 
 Rect IniKeyValue::GetValueAsRect() const
 {
 	// We assume the string form of {4.23, 5.23, 10.04, 5.23}
 	// Values are in order of x1, z1, x2, z2 for two points.
-	// First, let's get rid of the braces.
-    std::string noBraces = value;
-    if(noBraces[0] == '{' && noBraces[noBraces.size() - 1] == '}')
-    {
-        noBraces = value.substr(1, value.length() - 2);
-    }
-    
-    // Find the three commas.
-    std::size_t firstCommaIndex = noBraces.find(',');
-    if(firstCommaIndex == std::string::npos)
-    {
-		return Rect();
-    }
-    std::size_t secondCommaIndex = noBraces.find(',', firstCommaIndex + 1);
-    if(secondCommaIndex == std::string::npos)
-    {
-		return Rect();
-    }
-	std::size_t thirdCommaIndex = noBraces.find(',', secondCommaIndex + 1);
-	if(thirdCommaIndex == std::string::npos)
+	float numbers[4];
+	if(!ParseNumbers(value, ',', numbers, 4))
 	{
 		return Rect();
 	}
-    
-    // Split at commas.
-    std::string firstNum = noBraces.substr(0, firstCommaIndex);
-    std::string secondNum = noBraces.substr(firstCommaIndex + 1, secondCommaIndex - firstCommaIndex);
-    std::string thirdNum = noBraces.substr(secondCommaIndex + 1, thirdCommaIndex - secondCommaIndex);
-    std::string fourthNum = noBraces.substr(thirdCommaIndex + 1, std::string::npos);
-	
-    // Convert to numbers and return.
-	Vector2 p1(std::stof(firstNum), std::stof(secondNum));
-	Vector2 p2(std::stof(thirdNum), std::stof(fourthNum));
-    return Rect(p1, p2);
+	return Rect(Vector2(numbers[0], numbers[1]), Vector2(numbers[2], numbers[3]));
 }
 
 IniParser::IniParser(const char* filePath)
 {
-    // Create stream to read from file.
-    mStream = new std::ifstream(filePath, std::ios::in);
-    if(!mStream->good())
+    // Read the whole file into memory, and parse it from there.
+    std::ifstream file(filePath, std::ios::in | std::ios::binary);
+    if(!file.good())
     {
         std::cout << "IniParser can't read from file " << filePath << "!" << std::endl;
     }
+    mFileContents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    
+    mText = mFileContents.data();
+    mTextLength = static_cast<unsigned int>(mFileContents.size());
 }
 
-IniParser::IniParser(const char* memory, unsigned int memoryLength)
-{
-    // Create stream to read from memory.
-    mStream = new imstream(memory, memoryLength);
-}
-
-IniParser::~IniParser()
+IniParser::IniParser(const char* memory, unsigned int memoryLength) :
+    mText(memory),
+    mTextLength(memory != nullptr ? memoryLength : 0)
 {
-    delete mStream;
+    
 }
 
 void IniParser::ParseAll()
 {
     // Clear any existing sections.
     mSections.clear();
+    mSectionIndexes.clear();
     
     // Reset cursor to top of file.
     ResetToTop();
     
-    // Read in each section and add to list.
-    IniSection section;
-    while(ReadNextSection(section))
+    // Read in each section directly into the list.
+    mSections.emplace_back();
+    while(ReadNextSection(mSections.back()))
     {
-        mSections.push_back(section);
+        mSectionIndexes[mSections.back().name].push_back(static_cast<int>(mSections.size() - 1));
+        mSections.emplace_back();
     }
+    mSections.pop_back();
 }
 
-std::vector<IniSection> IniParser::GetSections(const std::string& name)
+std::vector<IniSection*> IniParser::GetSections(const std::string& name)
 {
-    std::vector<IniSection> toReturn;
-    for(auto& section : mSections)
+    std::vector<IniSection*> toReturn;
+    auto it = mSectionIndexes.find(name);
+    if(it != mSectionIndexes.end())
     {
-        if(StringUtil::EqualsIgnoreCase(section.name, name))
+        for(int index : it->second)
         {
-            toReturn.push_back(section);
+            toReturn.push_back(&mSections[index]);
         }
     }
     return toReturn;
 }
 
-IniSection IniParser::GetSection(const std::string& name)
+IniSection& IniParser::GetSection(const std::string& name)
 {
-    for(auto& section : mSections)
+    auto it = mSectionIndexes.find(name);
+    if(it != mSectionIndexes.end())
     {
-        if(StringUtil::EqualsIgnoreCase(section.name, name))
-        {
-            return section;
-        }
+        return mSections[it->second.front()];
     }
-    return IniSection();
+    
+    // Caller may have modified the empty section, so make sure it's still empty.
+    mEmptySection = IniSection();
+    return mEmptySection;
 }
 
 void IniParser::ResetToTop()
 {
-    mStream->seekg(0);
+    mPosition = 0;
 }
 
 bool IniParser::ReadNextSection(IniSection& sectionOut)
@@ -227,61 +213,55 @@ bool IniParser::ReadNextSection(IniSection& sectionOut)
     sectionOut.lines.clear();
     
     // Always remember the current position *before* reading the next line, so we can set it back if needs be.
-    imstream::pos_type currentPos = mStream->tellg();
+    unsigned int currentPos = mPosition;
     
     // Just read the whole file one line at a time...
-	// GetLineSanitized ensures: no line break or tab characters, no whitespace before/after, etc.
-    std::string line;
-    while(StringUtil::GetLineSanitized(*mStream, line))
+	// ReadNextLine ensures: no line break characters, no whitespace before/after, etc.
+    const char* lineStart = nullptr;
+    const char* lineEnd = nullptr;
+    while(ReadNextLine(lineStart, lineEnd))
     {
-        // Ignore empty lines.
-        if(line.empty())
-        {
-            currentPos = mStream->tellg();
-            continue;
-        }
-        
-        // Ignore comment lines.
-        if(line.length() >= 2 && line[0] == '/' && line[1] == '/')
+        // Ignore empty lines and comment lines.
+        if(lineStart == lineEnd || StartsWithComment(lineStart, lineEnd))
         {
-            currentPos = mStream->tellg();
+            currentPos = mPosition;
             continue;
         }
         
         // The line is a header if it starts with [ followed by a later ] (e.g. [General], [Hacks]).
 		// If this is the header for the current section, we should note it and keep reading.
 		// If this is the header for the NEXT section, we should STOP reading (since this function only reads one section and returns).
-		std::size_t endHeaderIndex = std::string::npos;
-		if(line.length() > 2 && line[0] == '[')
+		const char* endHeader = nullptr;
+		if(lineEnd - lineStart > 2 && lineStart[0] == '[')
 		{
-			endHeaderIndex = line.find(']', 1);
+			endHeader = std::find(lineStart + 1, lineEnd, ']');
+			if(endHeader == lineEnd) { endHeader = nullptr; }
 		}
-		if(endHeaderIndex != std::string::npos)
+		if(endHeader != nullptr)
         {
 			// If the section has entries, we can use that to determine that this header belongs to the next section.
-			// We set the stream back to before this header was read in, so next call to ReadNextSection starts at the right spot.
+			// We set the position back to before this header was read in, so next call to ReadNextSection starts at the right spot.
             if(sectionOut.lines.size() > 0)
             {
-                mStream->seekg(currentPos);
+                mPosition = currentPos;
 				
 				// Return true to indicate that we read a section and there was data!
                 return true;
             }
             
             // Subtract the brackets to get the section name.
-            sectionOut.name = line.substr(1, endHeaderIndex - 1);
-            
             // If there's an equals sign, it means this section is conditional.
 			// A conditional section may be ignored by game code if the condition is not met.
 			// The condition is usually Sheepscript code.
-            std::size_t equalsIndex = sectionOut.name.find('=');
-            if(equalsIndex != std::string::npos)
+            const char* nameStart = lineStart + 1;
+            const char* equals = std::find(nameStart, endHeader, '=');
+            sectionOut.name.assign(nameStart, equals);
+            if(equals != endHeader)
             {
-                sectionOut.condition = sectionOut.name.substr(equalsIndex + 1, std::string::npos);
-                sectionOut.name = sectionOut.name.substr(0, equalsIndex);
+                sectionOut.condition.assign(equals + 1, endHeader);
             }
             
-            currentPos = mStream->tellg();
+            currentPos = mPosition;
             continue;
         }
 		
@@ -291,89 +271,12 @@ bool IniParser::ReadNextSection(IniSection& sectionOut)
 		IniLine& iniLine = sectionOut.lines.back();
 		
         // We need to split the line into individual key/value pairs.
-        while(!line.empty())
+        while(lineStart < lineEnd)
         {
-            // First, determine the token we want to work with on the current line.
-            // We want the first item, if there are multiple comma-separated values on a single line.
-            // Otherwise, we just want the whole remaining line.
-            std::string currentKeyValuePair;
-            
-			// If a line can have multiple key/value pairs, we'll need to determine
-			// what portion of the current line constitutes the next key/value pair.
-            if(mMultipleKeyValuePairsPerLine)
-            {
-				// Need to find index of a comma, which is the delimiter between key/value pairs on a single line.
-                // We can't just use string::find because we want to ignore commas that are inside braces.
-                // Ex: pos={10, 20, 30} should NOT be considered multiple key/value pairs.
-				std::size_t delimiterIndex = std::string::npos;
-                int braceDepth = 0;
-                for(int i = 0; i < line.length(); i++)
-                {
-                    if(line[i] == '{') { braceDepth++; }
-                    if(line[i] == '}') { braceDepth--; }
-                    
-                    if(line[i] == ',' && braceDepth == 0)
-                    {
-                        delimiterIndex = i;
-                        break;
-                    }
-                }
-                
-                // If we found a valid delimiter, we only want to deal with the parts in front of the delimiter.
-                // If no delimiter, then the rest of the line is our focus.
-                if(delimiterIndex != std::string::npos)
-                {
-                    currentKeyValuePair = line.substr(0, delimiterIndex);
-                    line = line.substr(delimiterIndex + 1, std::string::npos);
-                }
-                else
-                {
-                    currentKeyValuePair = line;
-                    line.clear();
-                }
-            }
-            else
-            {
-				// If no multiple key/value pairs per line, this is easy: the whole line is one key/value pair!
-                currentKeyValuePair = line;
-                line.clear();
-            }
-			
-			// Trim off any comment on the line.
-			StringUtil::TrimComment(currentKeyValuePair);
-			
-			// Get rid of any rogue tab characters.
-			StringUtil::RemoveAll(currentKeyValuePair, '\t');
-			
-            // Trim any whitespace.
-            StringUtil::Trim(currentKeyValuePair);
-            
-			// Build the key/value object, to be filled with data next.
 			iniLine.entries.emplace_back();
-			IniKeyValue& keyValue = iniLine.entries.back();
-			
-			// The delimiter between keys and values is the '=' symbol (e.g. "model=gab")
-			// If there is no delimiter (fairly common), it still works, but it's just a key with no value (e.g. "hidden").
-            std::size_t equalsIndex = currentKeyValuePair.find('=');
-            if(equalsIndex != std::string::npos)
-            {
-                keyValue.key = currentKeyValuePair.substr(0, equalsIndex);
-                keyValue.value = currentKeyValuePair.substr(equalsIndex + 1, std::string::npos);
-				
-				// Ooof, we may also have to trim these now...
-				StringUtil::Trim(keyValue.key);
-				StringUtil::Trim(keyValue.value);
-            }
-            else
-            {
-                keyValue.key = currentKeyValuePair;
-				
-				// In this case, set "value" to same thing so that we can still use "value" and value getters.
-				//TODO: Seems kind of wasteful - perhaps we can say "use key field only" in this case; may want to augment/change GetValueAsX functions to work with this.
-                keyValue.value = currentKeyValuePair;
-            }
+			ReadKeyValuePair(lineStart, lineEnd, iniLine.entries.back(), true);
         }
-        currentPos = mStream->tellg();
+        currentPos = mPosition;
     }
     
     // If we run out of things to read, return true if there's any data.
@@ -383,27 +286,26 @@ bool IniParser::ReadNextSection(IniSection& sectionOut)
 
 bool IniParser::ReadLine()
 {
-    if(mStream->eof()) { return false; }
-    
-    std::string line;
-    while(StringUtil::GetLineSanitized(*mStream, line))
+    const char* lineStart = nullptr;
+    const char* lineEnd = nullptr;
+    while(ReadNextLine(lineStart, lineEnd))
     {
         // Ignore empty lines.
-        if(line.empty()) { continue; }
+        if(lineStart == lineEnd) { continue; }
         
         // Ignore comment lines.
-        if(line.length() > 2 && line[0] == '/' && line[1] == '/') { continue; }
+        if(lineEnd - lineStart > 2 && StartsWithComment(lineStart, lineEnd)) { continue; }
         
         // Detect headers and react to them, but don't stop parsing.
-        if(line.length() > 2 && line[0] == '[' && line[line.length() - 1] == ']')
+        if(lineEnd - lineStart > 2 && lineStart[0] == '[' && *(lineEnd - 1) == ']')
         {
-            mCurrentSection = line.substr(1, line.length() - 2);
+            mCurrentSection.assign(lineStart + 1, lineEnd - 1);
             continue;
         }
         
         // Save the current line.
-        mCurrentLine = line;
-        mCurrentLineWorking = line;
+        mCurrentLineStart = lineStart;
+        mCurrentLineEnd = lineEnd;
         return true;
     }
     
@@ -414,74 +316,96 @@ bool IniParser::ReadLine()
 bool IniParser::ReadKeyValuePair()
 {
     // If nothing left in current line, we're done.
-    if(mCurrentLineWorking.empty()) { return false; }
+    if(mCurrentLineStart >= mCurrentLineEnd) { return false; }
     
-    // First, determine the token we want to work with on the current line.
-    // We want the first item, if there are multiple comma-separated values.
-    // Otherwise, we just want the whole remaining line.
-    std::string currentKeyValuePair;
+    ReadKeyValuePair(mCurrentLineStart, mCurrentLineEnd, mCurrentKeyValue, false);
+    return true;
+}
+
+bool IniParser::ReadNextLine(const char*& lineStart, const char*& lineEnd)
+{
+    if(mText == nullptr || mPosition >= mTextLength) { return false; }
+    
+    // The line runs up to the next line break (or end of text). Next line starts after the line break.
+    const char* textEnd = mText + mTextLength;
+    lineStart = mText + mPosition;
+    lineEnd = std::find(lineStart, textEnd, '\n');
+    mPosition = static_cast<unsigned int>(lineEnd - mText) + (lineEnd < textEnd ? 1 : 0);
+    
+    // Windows line breaks might include the '\r' character too, like "\r\n".
+    if(lineEnd > lineStart && *(lineEnd - 1) == '\r')
+    {
+        --lineEnd;
+    }
     
-    std::size_t found = std::string::npos;
+    // Trim the line of any whitespaces and tabs.
+    while(lineStart < lineEnd && *lineStart == ' ') { ++lineStart; }
+    while(lineEnd > lineStart && *(lineEnd - 1) == ' ') { --lineEnd; }
+    while(lineStart < lineEnd && *lineStart == '\t') { ++lineStart; }
+    while(lineEnd > lineStart && *(lineEnd - 1) == '\t') { --lineEnd; }
+    return true;
+}
+
+void IniParser::ReadKeyValuePair(const char*& lineStart, const char* lineEnd, IniKeyValue& keyValue, bool keyOnlySetsValue)
+{
+    // First, determine the part of the line we want to work with.
+    // We want the first item, if there are multiple comma-separated values on a single line.
+    // Otherwise, we just want the whole remaining line.
+    const char* pairStart = lineStart;
+    const char* pairEnd = lineEnd;
+    lineStart = lineEnd;
     if(mMultipleKeyValuePairsPerLine)
     {
-        // We can't just use string::find because we want to ignore commas that are inside braces.
-        // Ex: pos={10, 20, 30} should not be considered multiple key/value pairs.
+        // Need to find a comma, which is the delimiter between key/value pairs on a single line.
+        // Commas inside braces don't count. Ex: pos={10, 20, 30} should NOT be considered multiple key/value pairs.
         int braceDepth = 0;
-        for(int i = 0; i < mCurrentLineWorking.length(); i++)
+        for(const char* c = pairStart; c < lineEnd; ++c)
         {
-            if(mCurrentLineWorking[i] == '{') { braceDepth++; }
-            if(mCurrentLineWorking[i] == '}') { braceDepth--; }
+            if(*c == '{') { braceDepth++; }
+            if(*c == '}') { braceDepth--; }
             
-            if(mCurrentLineWorking[i] == ',' && braceDepth == 0)
+            if(*c == ',' && braceDepth == 0)
             {
-                found = i;
+                pairEnd = c;
+                lineStart = c + 1;
                 break;
             }
         }
+    }
     
-        // If we found a valid comma separator, then we only want to deal with the parts in front of the comma.
-        // If no comma, then the rest of the line is our focus.
-        if(found != std::string::npos)
-        {
-            currentKeyValuePair = mCurrentLineWorking.substr(0, found);
-            mCurrentLineWorking = mCurrentLineWorking.substr(found + 1, std::string::npos);
-        }
-        else
+    // Trim off any comment.
+    for(const char* c = pairStart; c + 1 < pairEnd; ++c)
+    {
+        if(c[0] == '/' && c[1] == '/')
         {
-            currentKeyValuePair = mCurrentLineWorking;
-            mCurrentLineWorking.clear();
+            pairEnd = c;
+            break;
         }
     }
-    else
-    {
-        currentKeyValuePair = mCurrentLineWorking;
-        mCurrentLineWorking.clear();
-    }
     
-    // Trim off any comment on the line.
-	StringUtil::TrimComment(currentKeyValuePair);
-	
-	// Get rid of any rogue tab characters.
-	StringUtil::RemoveAll(currentKeyValuePair, '\t');
-	
-	// Trim any whitespace.
-	StringUtil::Trim(currentKeyValuePair);
+    // Trim any whitespace.
+    TrimRange(pairStart, pairEnd);
     
-    // OK, so now we have a string representing a key/value pair, "model=blahblah" or similar.
-    // But it might also just be a keyword (no value) like "hidden".
-    found = currentKeyValuePair.find('=');
-    if(found != std::string::npos)
+    // The delimiter between keys and values is the '=' symbol (e.g. "model=gab")
+    // If there is no delimiter (fairly common), it still works, but it's just a key with no value (e.g. "hidden").
+    const char* equals = std::find(pairStart, pairEnd, '=');
+    if(equals != pairEnd)
     {
-        mCurrentKeyValue.key = currentKeyValuePair.substr(0, found);
-        mCurrentKeyValue.value = currentKeyValuePair.substr(found + 1, std::string::npos);
-		
-		// Ooof, we may also have to trim these now...
-		StringUtil::Trim(mCurrentKeyValue.key);
-		StringUtil::Trim(mCurrentKeyValue.value);
+        const char* keyEnd = equals;
+        const char* valueStart = equals + 1;
+        TrimRange(pairStart, keyEnd);
+        TrimRange(valueStart, pairEnd);
+        AssignWithoutTabs(keyValue.key, pairStart, keyEnd);
+        AssignWithoutTabs(keyValue.value, valueStart, pairEnd);
     }
     else
     {
-        mCurrentKeyValue.key = currentKeyValuePair;
+        AssignWithoutTabs(keyValue.key, pairStart, pairEnd);
+        
+        // In this case, set "value" to same thing so that we can still use "value" and value getters.
+        if(keyOnlySetsValue)
+        {
+            keyValue.value = keyValue.key;
+        }
     }
-    return true;
 }
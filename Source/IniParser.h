@@ -6,13 +6,17 @@
 // Parses key/value data from INI-format files.
 // Does contain some special-sauce unique to GK3.
 //
+// The text is tokenized in place: lines and key/value pairs are found by scanning the buffer,
+// and only the final keys/values are copied out into strings.
+//
 #pragma once
-#include <fstream>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "Color32.h"
 #include "Rect.h"
+#include "StringUtil.h"
 #include "Vector2.h"
 #include "Vector3.h"
 
@@ -46,13 +50,15 @@ class IniParser
 {
 public:
     IniParser(const char* filePath);
+    
+    // The memory is parsed in place, so it must stay valid while the parser is used.
     IniParser(const char* memory, unsigned int memoryLength);
-    ~IniParser();
     
     // MODE A: Read it all in at once and use it.
+    // Sections are looked up by name, ignoring case. Getting a section that doesn't exist gives an empty section.
     void ParseAll();
-    std::vector<IniSection> GetSections(const std::string& name);
-    IniSection GetSection(const std::string& name);
+    std::vector<IniSection*> GetSections(const std::string& name);
+    IniSection& GetSection(const std::string& name);
     
     // MODE B: Read one section at a time.
     void ResetToTop();
@@ -66,23 +72,37 @@ public:
     void SetMultipleKeyValuePairsPerLine(bool areThere) { mMultipleKeyValuePairsPerLine = areThere; }
     
 private:
-    // The stream object we use to read in the file contents.
-    std::istream* mStream = nullptr;
+    // If reading from a file, the file's contents.
+    std::string mFileContents;
+    
+    // The text being parsed, and the position of the next line to read.
+    const char* mText = nullptr;
+    unsigned int mTextLength = 0;
+    unsigned int mPosition = 0;
     
     // The section we are currently in. For example, if [General] in file, this might be "General".
     std::string mCurrentSection;
     
-    // Whatever the current line is. Can move to next line by calling "ReadLine".
-    std::string mCurrentLine;
-    
-    // Values used when parsing a single line's key/value pairs.
-    std::string mCurrentLineWorking;
+    // Remaining part of the current line, when reading key/value pairs one at a time.
+    const char* mCurrentLineStart = nullptr;
+    const char* mCurrentLineEnd = nullptr;
     IniKeyValue mCurrentKeyValue;
     
-    // When we read in all at once or next section, we store all sections here.
+    // When we read in all at once, we store all sections here.
+    // Indexes of sections with each name are kept too, so sections can be found without comparing every name.
     std::vector<IniSection> mSections;
+    std::unordered_map<std::string, std::vector<int>, StringUtil::IgnoreCaseHash, StringUtil::IgnoreCaseEqual> mSectionIndexes;
+    
+    // Returned when asking for a section that doesn't exist.
+    IniSection mEmptySection;
     
     // If true, we assume that each line can have multiple key/value pairs.
     // As a result, we split based on commas. Otherwise, we assume whole line has one key/value pair.
     bool mMultipleKeyValuePairsPerLine = true;
+    
+    // Finds the next line, with line breaks and surrounding whitespace trimmed. Returns false at end of text.
+    bool ReadNextLine(const char*& lineStart, const char*& lineEnd);
+    
+    // Finds the next key/value pair in part of a line, and moves the line start past it.
+    void ReadKeyValuePair(const char*& lineStart, const char* lineEnd, IniKeyValue& keyValue, bool keyOnlySetsValue);
 };
@@ -15,7 +15,7 @@ InputManager::InputManager()
     mKeyboardState = SDL_GetKeyboardState(&mNumKeys);
     
     // Allocate previous keyboard state array.
-    mPrevKeyboardState = new uint8_t[mNumKeys];
+    mPrevKeyboardState = new uint8_t[mNumKeys]();
 }
 
 void InputManager::Update()
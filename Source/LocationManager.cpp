@@ -23,7 +23,7 @@ LocationManager::LocationManager()
 	IniParser parser(buffer, bufferSize);
 	parser.ParseAll();
 	
-	IniSection locations = parser.GetSection("LOCATIONS");
+	IniSection& locations = parser.GetSection("LOCATIONS");
 	for(auto& line : locations.lines)
 	{
 		IniKeyValue& entry = line.entries.front();
@@ -8,17 +8,91 @@
 #define SDL_MAIN_HANDLED // For Windows: we provide our own main, so use that!
 #include "GEngine.h"
 
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "Services.h"
+#include "VertexAnimator.h"
+
 int main(int argc, const char* argv[])
 {
     // Create the engine.
 	GEngine engine;
 	
+    // With "-bake", convert barn assets to faster-loading baked formats, rather than running the game.
+    bool bake = false;
+    bool threadedSheep = true;
+    int assetMemoryBudgetMB = -1;
+    for(int i = 1; i < argc; ++i)
+    {
+        std::string arg(argv[i]);
+        if(arg == "-bake")
+        {
+            bake = true;
+        }
+        // "-fps N" sets target frame rate. Zero means uncapped, for benchmarking.
+        else if(arg == "-fps" && i + 1 < argc)
+        {
+            engine.GetFramePacer().SetTargetFrameRate(std::atoi(argv[++i]));
+        }
+        // "-fixedstep N" updates actors N times per second, independent of frame rate.
+        else if(arg == "-fixedstep" && i + 1 < argc)
+        {
+            int stepsPerSecond = std::atoi(argv[++i]);
+            engine.GetFramePacer().SetFixedTimestep(stepsPerSecond > 0 ? 1.0f / stepsPerSecond : 0.0f);
+        }
+        // "-headless N" runs N frames without a window or audio, then reports frame timings.
+        else if(arg == "-headless" && i + 1 < argc)
+        {
+            engine.SetHeadless(true, std::atoi(argv[++i]));
+        }
+        // "-gpuanim" plays vertex animations on the GPU (see VertexAnimator::SetUseGPUPlayback).
+        else if(arg == "-gpuanim")
+        {
+            VertexAnimator::SetUseGPUPlayback(true);
+        }
+        // "-assetmemory N" sets the asset cache memory budget to N megabytes (see AssetManager::SetMemoryBudget).
+        else if(arg == "-assetmemory" && i + 1 < argc)
+        {
+            assetMemoryBudgetMB = std::atoi(argv[++i]);
+        }
+        // "-sheepbytecode" always interprets sheep bytecode directly (see SheepVM::SetThreadedCodeEnabled).
+        else if(arg == "-sheepbytecode")
+        {
+            threadedSheep = false;
+        }
+        // "-script path" replays commands from a file (see GEngine::LoadCommandScript).
+        else if(arg == "-script" && i + 1 < argc)
+        {
+            if(!engine.LoadCommandScript(argv[++i]))
+            {
+                std::cout << "Could not load command script: " << argv[i] << std::endl;
+                return 1;
+            }
+        }
+    }
+	
     // If init succeeds, we can "run" the engine.
     // If init fails, the program ends immediately.
 	bool initSucceeded = engine.Initialize();
     if(initSucceeded)
     {
-        engine.Run();
+        // Asset and sheep systems don't exist until init, so apply these now.
+        if(assetMemoryBudgetMB >= 0)
+        {
+            Services::GetAssets()->SetMemoryBudget(static_cast<size_t>(assetMemoryBudgetMB) * 1024 * 1024);
+        }
+        Services::GetSheep()->SetThreadedCodeEnabled(threadedSheep);
+        
+        if(bake)
+        {
+            Services::GetAssets()->BakeBarns();
+        }
+        else
+        {
+            engine.Run();
+        }
     }
     else
     {
@@ -17,14 +17,19 @@ Matrix4 Material::sCurrentProjMatrix;
 
 float Material::sAlphaTestValue = 0.0f;
 
+GLuint Material::sCameraBuffer = GL_NONE;
+bool Material::sCameraBufferDirty = true;
+
 void Material::SetViewMatrix(const Matrix4& viewMatrix)
 {
 	sCurrentViewMatrix = viewMatrix;
+	sCameraBufferDirty = true;
 }
 
 void Material::SetProjMatrix(const Matrix4& projMatrix)
 {
 	sCurrentProjMatrix = projMatrix;
+	sCameraBufferDirty = true;
 }
 
 void Material::UseAlphaTest(bool use)
@@ -32,6 +37,25 @@ void Material::UseAlphaTest(bool use)
 	sAlphaTestValue = use ? 0.1f : 0.0f;
 }
 
+void Material::CreateCameraBuffer()
+{
+	// Layout matches the "Camera" uniform block (std140): view, projection, and world-to-projection matrices.
+	glGenBuffers(1, &sCameraBuffer);
+	glBindBuffer(GL_UNIFORM_BUFFER, sCameraBuffer);
+	glBufferData(GL_UNIFORM_BUFFER, 3 * 16 * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+	glBindBufferBase(GL_UNIFORM_BUFFER, Shader::kCameraBlockBinding, sCameraBuffer);
+	sCameraBufferDirty = true;
+}
+
+void Material::DestroyCameraBuffer()
+{
+	if(sCameraBuffer != GL_NONE)
+	{
+		glDeleteBuffers(1, &sCameraBuffer);
+		sCameraBuffer = GL_NONE;
+	}
+}
+
 Material::Material() : mShader(sDefaultShader)
 {
     SetColor(Color32::White);
@@ -44,54 +68,111 @@ Material::Material(Shader* shader) : mShader(shader)
 
 void Material::Activate(const Matrix4& objectToWorldMatrix)
 {
+	ActivateShader();
+	ActivateParameters();
+	SetObjectToWorldMatrix(objectToWorldMatrix);
+}
+
+void Material::ActivateShader()
+{
+	// Camera matrices are shared by all shaders, so only need updating when they change.
+	if(sCameraBufferDirty)
+	{
+		UpdateCameraBuffer();
+	}
+	
     // Must activate shader BEFORE setting uniforms to get correct results.
     // See https://stackoverflow.com/questions/42357380/why-must-i-use-a-shader-program-before-i-can-set-its-uniforms
     mShader->Activate();
-    
-	// Set built-in transform matrices.
-    mShader->SetUniformMatrix4("gObjectToWorldMatrix", objectToWorldMatrix);
-    mShader->SetUniformMatrix4("gViewMatrix", sCurrentViewMatrix);
-    mShader->SetUniformMatrix4("gProjMatrix", sCurrentProjMatrix);
-	mShader->SetUniformMatrix4("gWorldToProjMatrix", sCurrentProjMatrix * sCurrentViewMatrix);
 	
 	// Set built-in alpha test value.
-	mShader->SetUniformFloat("gAlphaTest", sAlphaTestValue);
+	mShader->SetUniformFloat(mShader->GetUniformIndex(BuiltInUniform::AlphaTest), sAlphaTestValue);
+	
+	// Draws that blend morph positions turn this on themselves.
+	SetMorphWeight(-1.0f);
+}
+
+void Material::ActivateParameters()
+{
+	// Find parameter uniforms the first time this shader is used.
+	if(mParameterShader != mShader)
+	{
+		RefreshParameterUniforms();
+	}
 	
     // Set user-defined color values.
-    for(auto& entry : mColors)
+    for(auto& color : mColors)
     {
-        mShader->SetUniformColor(entry.first.c_str(), entry.second);
+        mShader->SetUniformColor(color.uniformIndex, color.color);
     }
     
     // Set user-defined textures.
     int textureUnit = 0;
-    for(auto& entry : mTextures)
+    for(auto& texture : mTextures)
     {
-        mShader->SetUniformInt(entry.first.c_str(), textureUnit);
-        entry.second->Activate(textureUnit);
+        mShader->SetUniformInt(texture.uniformIndex, textureUnit);
+        texture.texture->Activate(textureUnit);
         ++textureUnit;
     }
     
 	//TODO: May need to "deactivate" texture units if no texture is defined in material, but a texture sampler exists in the shader.
 }
 
+void Material::SetObjectToWorldMatrix(const Matrix4& objectToWorldMatrix)
+{
+    mShader->SetUniformMatrix4(mShader->GetUniformIndex(BuiltInUniform::ObjectToWorldMatrix), objectToWorldMatrix);
+}
+
+void Material::SetMorphWeight(float weight)
+{
+	mShader->SetUniformFloat(mShader->GetUniformIndex(BuiltInUniform::MorphWeight), weight);
+}
+
 void Material::SetColor(const std::string& name, const Color32& color)
 {
-    mColors[name] = color;
+	for(auto& parameter : mColors)
+	{
+		if(parameter.name == name)
+		{
+			parameter.color = color;
+			return;
+		}
+	}
+	
+	ColorParameter parameter;
+	parameter.name = name;
+	parameter.color = color;
+	parameter.uniformIndex = mParameterShader != nullptr ? mParameterShader->GetUniformIndex(name.c_str()) : -1;
+	mColors.push_back(parameter);
 }
 
 void Material::SetTexture(const std::string& name, Texture* texture)
 {
-    mTextures[name] = texture;
+	for(auto& parameter : mTextures)
+	{
+		if(parameter.name == name)
+		{
+			parameter.texture = texture;
+			return;
+		}
+	}
+	
+	TextureParameter parameter;
+	parameter.name = name;
+	parameter.texture = texture;
+	parameter.uniformIndex = mParameterShader != nullptr ? mParameterShader->GetUniformIndex(name.c_str()) : -1;
+	mTextures.push_back(parameter);
 }
 
 Texture* Material::GetTexture(const std::string& name) const
 {
-    auto it = mTextures.find(name);
-    if(it != mTextures.end())
-    {
-        return it->second;
-    }
+	for(auto& parameter : mTextures)
+	{
+		if(parameter.name == name)
+		{
+			return parameter.texture;
+		}
+	}
     return nullptr;
 }
 
@@ -100,3 +181,31 @@ bool Material::IsTranslucent()
 	//TODO: Maybe use render queue value for this?
 	return false;
 }
+
+void Material::UpdateCameraBuffer()
+{
+	if(sCameraBuffer == GL_NONE) { return; }
+	
+	Matrix4 worldToProjMatrix = sCurrentProjMatrix * sCurrentViewMatrix;
+	const float* matrices[3] = { sCurrentViewMatrix, sCurrentProjMatrix, worldToProjMatrix };
+	
+	glBindBuffer(GL_UNIFORM_BUFFER, sCameraBuffer);
+	for(int i = 0; i < 3; ++i)
+	{
+		glBufferSubData(GL_UNIFORM_BUFFER, i * 16 * sizeof(float), 16 * sizeof(float), matrices[i]);
+	}
+	sCameraBufferDirty = false;
+}
+
+void Material::RefreshParameterUniforms()
+{
+	mParameterShader = mShader;
+	for(auto& parameter : mColors)
+	{
+		parameter.uniformIndex = mShader->GetUniformIndex(parameter.name.c_str());
+	}
+	for(auto& parameter : mTextures)
+	{
+		parameter.uniformIndex = mShader->GetUniformIndex(parameter.name.c_str());
+	}
+}
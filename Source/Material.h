@@ -7,9 +7,11 @@
 // It indicates the shader to use and any input parameters for the shader (texture, color, etc).
 //
 #pragma once
-#include <unordered_map>
+#include <string>
 #include <vector>
 
+#include <GL/glew.h>
+
 #include "Color32.h"
 #include "Matrix4.h"
 
@@ -24,11 +26,25 @@ public:
 	static void SetProjMatrix(const Matrix4& projMatrix);
 	static void UseAlphaTest(bool use);
 	
+	// Creates the buffer that holds camera matrices for all shaders. Requires a GL context.
+	static void CreateCameraBuffer();
+	static void DestroyCameraBuffer();
+	
     Material();
 	Material(Shader* shader);
     
 	void Activate(const Matrix4& objectToWorldMatrix);
 	
+	// The parts of activation, for when some state is known to be set already (e.g. by the previous draw).
+	// Parameters and transform require the shader to be active.
+	void ActivateShader();
+	void ActivateParameters();
+	void SetObjectToWorldMatrix(const Matrix4& objectToWorldMatrix);
+	
+	// Blend amount between morph positions for the next draw, or -1 to not blend (see Submesh::GetMorphWeight).
+	// Activating the shader resets this to -1.
+	void SetMorphWeight(float weight);
+	
     void SetShader(Shader* shader) { mShader = shader; }
     Shader* GetShader() const { return mShader; }
     
@@ -51,11 +67,35 @@ private:
 	static Matrix4 sCurrentProjMatrix;
 	static float sAlphaTestValue;
 	
+	// Uniform buffer containing camera matrices (see "Camera" uniform block in shaders).
+	// Only updated when the matrices change, which is a few times per frame at most.
+	static GLuint sCameraBuffer;
+	static bool sCameraBufferDirty;
+	
     // Shader to use.
     Shader* mShader = nullptr;
     
-    std::unordered_map<std::string, Color32> mColors;
-    std::unordered_map<std::string, Texture*> mTextures;
+    // User-defined shader parameters, each with the index of its uniform in the shader.
+    struct ColorParameter
+    {
+        std::string name;
+        Color32 color;
+        int uniformIndex = -1;
+    };
+    struct TextureParameter
+    {
+        std::string name;
+        Texture* texture = nullptr;
+        int uniformIndex = -1;
+    };
+    std::vector<ColorParameter> mColors;
+    std::vector<TextureParameter> mTextures;
+    
+    // The shader that parameter uniform indexes were found for. If the shader changes, they must be found again.
+    Shader* mParameterShader = nullptr;
+    
+    void UpdateCameraBuffer();
+    void RefreshParameterUniforms();
     
     //TODO: Opaque vs. transparent? Render queue value?
 };
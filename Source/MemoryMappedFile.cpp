@@ -0,0 +1,103 @@
+//
+// MemoryMappedFile.cpp
+//
+// Clark Kromenaker
+//
+#include "MemoryMappedFile.h"
+
+#include <iostream>
+
+#if defined(PLATFORM_WINDOWS)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MemoryMappedFile::MemoryMappedFile(const std::string& filePath)
+{
+#if defined(PLATFORM_WINDOWS)
+	// Open the file for reading.
+	HANDLE fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if(fileHandle == INVALID_HANDLE_VALUE)
+	{
+		std::cout << "Failed to open " << filePath << " for memory mapping." << std::endl;
+		return;
+	}
+
+	// Empty files can't be mapped.
+	LARGE_INTEGER fileSize;
+	if(!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+	{
+		CloseHandle(fileHandle);
+		return;
+	}
+
+	// Create a read-only mapping object for the whole file.
+	HANDLE mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+	if(mappingHandle == NULL)
+	{
+		std::cout << "Failed to create file mapping for " << filePath << std::endl;
+		CloseHandle(fileHandle);
+		return;
+	}
+
+	// Map a view of the entire file.
+	void* data = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	if(data == NULL)
+	{
+		std::cout << "Failed to map view of " << filePath << std::endl;
+		CloseHandle(mappingHandle);
+		CloseHandle(fileHandle);
+		return;
+	}
+
+	mFileHandle = fileHandle;
+	mMappingHandle = mappingHandle;
+	mData = static_cast<const char*>(data);
+	mSize = static_cast<unsigned int>(fileSize.QuadPart);
+#else
+	// Open the file for reading.
+	int fileDescriptor = open(filePath.c_str(), O_RDONLY);
+	if(fileDescriptor < 0)
+	{
+		std::cout << "Failed to open " << filePath << " for memory mapping." << std::endl;
+		return;
+	}
+
+	// Empty files can't be mapped.
+	struct stat fileStat;
+	if(fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0)
+	{
+		close(fileDescriptor);
+		return;
+	}
+
+	// Map the entire file read-only. The mapping stays valid after the descriptor is closed.
+	void* data = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+	close(fileDescriptor);
+	if(data == MAP_FAILED)
+	{
+		std::cout << "Failed to memory map " << filePath << std::endl;
+		return;
+	}
+
+	mData = static_cast<const char*>(data);
+	mSize = static_cast<unsigned int>(fileStat.st_size);
+#endif
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+	if(mData == nullptr) { return; }
+
+#if defined(PLATFORM_WINDOWS)
+	UnmapViewOfFile(mData);
+	CloseHandle(mMappingHandle);
+	CloseHandle(mFileHandle);
+#else
+	munmap(const_cast<char*>(mData), mSize);
+#endif
+}
@@ -0,0 +1,46 @@
+//
+// MemoryMappedFile.h
+//
+// Clark Kromenaker
+//
+// Maps an entire file into the address space as read-only memory.
+//
+// The OS pages in file contents on demand, so reading from the mapping avoids
+// a seek/read syscall pair (and an intermediate copy) for each access.
+// Pointers into the mapping are valid for the lifetime of this object.
+//
+#pragma once
+#include <string>
+
+#include "Platform.h"
+
+class MemoryMappedFile
+{
+public:
+	MemoryMappedFile(const std::string& filePath);
+	~MemoryMappedFile();
+
+	// Owns OS handles to the mapping, so don't allow copying!
+	MemoryMappedFile(const MemoryMappedFile& other) = delete;
+	MemoryMappedFile& operator=(const MemoryMappedFile& other) = delete;
+
+	// True if the file was opened and mapped successfully.
+	bool IsOpen() const { return mData != nullptr; }
+
+	// Start of the mapped file contents, and the size of the contents in bytes.
+	const char* GetData() const { return mData; }
+	unsigned int GetSize() const { return mSize; }
+
+private:
+	// Pointer to the start of the mapped memory, or null if mapping failed.
+	const char* mData = nullptr;
+
+	// Size of the mapping, in bytes.
+	unsigned int mSize = 0;
+
+#if defined(PLATFORM_WINDOWS)
+	// Windows requires holding onto file and mapping handles until unmapped.
+	void* mFileHandle = nullptr;
+	void* mMappingHandle = nullptr;
+#endif
+};
@@ -9,6 +9,7 @@
 #include "Debug.h"
 #include "Mesh.h"
 #include "Model.h"
+#include "RenderQueue.h"
 #include "Services.h"
 #include "Texture.h"
 
@@ -24,7 +25,7 @@ MeshRenderer::~MeshRenderer()
     Services::GetRenderer()->RemoveMeshRenderer(this);
 }
 
-void MeshRenderer::RenderOpaque()
+void MeshRenderer::AddOpaqueToQueue(RenderQueue& queue, const Vector3& cameraPosition)
 {
 	// Don't render if actor is inactive or component is disabled.
 	if(!IsActiveAndEnabled()) { return; }
@@ -46,11 +47,14 @@ void MeshRenderer::RenderOpaque()
 			// Ignore translucent rendering.
 			if(!material.IsTranslucent())
 			{
-				// Activate material.
-				material.Activate(meshWorldTransformMatrix);
-				
-				// Render the submesh!
-				submeshes[j]->Render();
+				RenderCommand command;
+				command.material = &material;
+				command.shader = material.GetShader();
+				command.texture = material.GetDiffuseTexture();
+				command.submesh = submeshes[j];
+				command.objectToWorldMatrix = meshWorldTransformMatrix;
+				command.depth = (meshWorldTransformMatrix.GetTranslation() - cameraPosition).GetLengthSq();
+				queue.Add(command);
 			}
 			
 			// Draw debug axes if desired.
@@ -86,6 +90,7 @@ void MeshRenderer::RenderTranslucent()
 			{
 				// Activate material.
 				material.Activate(meshWorldTransform);
+				material.SetMorphWeight(submeshes[j]->GetMorphWeight());
 				
 				// Render the submesh!
 				submeshes[j]->Render();
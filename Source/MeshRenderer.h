@@ -15,6 +15,7 @@
 class Mesh;
 class Model;
 class Ray;
+class RenderQueue;
 struct RaycastHit;
 class Texture;
 
@@ -25,7 +26,8 @@ public:
     MeshRenderer(Actor* actor);
     ~MeshRenderer();
 	
-	void RenderOpaque();
+	// Adds draws for opaque submeshes to a render queue. Camera position is used to sort draws front-to-back.
+	void AddOpaqueToQueue(RenderQueue& queue, const Vector3& cameraPosition);
 	void RenderTranslucent();
     
     void SetModel(Model* model);
@@ -67,7 +67,7 @@ void NVC::ParseFromData(char *data, int dataLength)
     parser.ParseAll();
     
     // Main section contains all the Noun/Verb/Cases on individual lines.
-    IniSection mainSection = parser.GetSection("");
+    IniSection& mainSection = parser.GetSection("");
     for(auto& line : mainSection.lines)
     {
         Action action;
@@ -81,6 +81,8 @@ void NVC::ParseFromData(char *data, int dataLength)
 		IniKeyValue& second = line.entries[1];
         action.verb = second.key;
 		StringUtil::ToLower(action.verb);
+		action.nounSymbol = Symbol(action.noun);
+		action.verbSymbol = Symbol(action.verb);
         
 		// Third entry is always the case (requires a bit of trimming/conditioning sometimes).
 		IniKeyValue& third = line.entries[2];
@@ -160,7 +162,7 @@ void NVC::ParseFromData(char *data, int dataLength)
 				}
 				
 				// Compile and save script.
-				action.script = Services::GetSheep()->Compile("Case Evaluation", action.scriptText);
+				action.script = Services::GetSheep()->CompileCached("Case Evaluation", action.scriptText);
             }
 		}
         
@@ -188,7 +190,7 @@ void NVC::ParseFromData(char *data, int dataLength)
     // Some "CASE" values are special, and handled by the system (like ALL, GABE_ALL, GRACE_ALL)
     // But an NVC item can also specify a custom case value. In that case,
     // this section maps the case value to a sheep expression to evaluate, to see whether the case is met.
-    IniSection logicSection = parser.GetSection("LOGIC");
+    IniSection& logicSection = parser.GetSection("LOGIC");
     for(auto& line : logicSection.lines)
     {
         // Only add this case entry if it isn't a duplicate entry.
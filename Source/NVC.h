@@ -15,6 +15,8 @@
 #include <unordered_map>
 #include <vector>
 
+#include "Symbol.h"
+
 class GKActor;
 class SheepScript;
 
@@ -26,6 +28,10 @@ struct Action
 	// The verb is what action we perform on the noun.
     std::string verb;
 	
+	// Interned noun and verb, for fast game progress lookups (e.g. noun/verb and topic counts).
+	Symbol nounSymbol;
+	Symbol verbSymbol;
+	
 	// The "case" for this action. A label that refers to a case under which this action is valid.
 	// The label can refer to arbitrary SheepScript that evaluates to true/false in the NVC file.
 	// Or, it can refer to a hard-coded global condition (e.g. ALL, GABE_ALL, GRACE_ALL).
@@ -65,7 +71,7 @@ class NVC : public Asset
 public:
     NVC(std::string name, char* data, int dataLength);
 	
-	const std::vector<Action*> GetActions() const { return mActions; }
+	const std::vector<Action*>& GetActions() const { return mActions; }
 	const std::vector<Action>& GetActions(const std::string& noun) const;
 	std::vector<const Action*> GetActions(const std::string& noun, const std::string& verb) const;
 	const Action* GetAction(const std::string& noun, const std::string& verb) const;
@@ -0,0 +1,84 @@
+//
+// PixelUtil.cpp
+//
+// Clark Kromenaker
+//
+#include "PixelUtil.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PIXEL_UTIL_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define PIXEL_UTIL_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(PIXEL_UTIL_SSE2)
+namespace
+{
+	// Blends two pixels, with each channel widened to 16 bits. Same math as the scalar version.
+	__m128i BlendPixelPair(__m128i source, __m128i dest)
+	{
+		// Copy each pixel's alpha to all four of its channels.
+		__m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(source, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+		__m128i inverseAlpha = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+		
+		// At most 255 * 255, so this fits in 16 bits.
+		__m128i value = _mm_add_epi16(_mm_mullo_epi16(dest, inverseAlpha), _mm_mullo_epi16(source, alpha));
+		
+		// Divide by 255 (see DivideBy255).
+		return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(value, _mm_set1_epi16(1)), _mm_srli_epi16(value, 8)), 8);
+	}
+}
+#endif
+
+void PixelUtil::BlendRow(const unsigned char* source, unsigned char* dest, int pixelCount)
+{
+	int i = 0;
+	
+#if defined(PIXEL_UTIL_SSE2)
+	// Four pixels at a time.
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i alphaMask = _mm_set1_epi32(0xFF000000);
+	for(; i + 4 <= pixelCount; i += 4)
+	{
+		__m128i sourcePixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4));
+		__m128i destPixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dest + i * 4));
+		
+		__m128i low = BlendPixelPair(_mm_unpacklo_epi8(sourcePixels, zero), _mm_unpacklo_epi8(destPixels, zero));
+		__m128i high = BlendPixelPair(_mm_unpackhi_epi8(sourcePixels, zero), _mm_unpackhi_epi8(destPixels, zero));
+		__m128i blended = _mm_packus_epi16(low, high);
+		
+		// Put dest alpha back.
+		blended = _mm_or_si128(_mm_andnot_si128(alphaMask, blended), _mm_and_si128(alphaMask, destPixels));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i * 4), blended);
+	}
+#elif defined(PIXEL_UTIL_NEON)
+	// Eight pixels at a time, with channels split into separate registers. Dest alpha is stored back unchanged.
+	for(; i + 8 <= pixelCount; i += 8)
+	{
+		uint8x8x4_t sourcePixels = vld4_u8(source + i * 4);
+		uint8x8x4_t destPixels = vld4_u8(dest + i * 4);
+		uint8x8_t alpha = sourcePixels.val[3];
+		uint8x8_t inverseAlpha = vmvn_u8(alpha);
+		for(int channel = 0; channel < 3; ++channel)
+		{
+			uint16x8_t value = vmlal_u8(vmull_u8(destPixels.val[channel], inverseAlpha), sourcePixels.val[channel], alpha);
+			destPixels.val[channel] = vshrn_n_u16(vaddq_u16(vaddq_u16(value, vdupq_n_u16(1)), vshrq_n_u16(value, 8)), 8);
+		}
+		vst4_u8(dest + i * 4, destPixels);
+	}
+#endif
+	
+	// Any pixels left over (or all of them, without SIMD).
+	for(; i < pixelCount; ++i)
+	{
+		const unsigned char* sourcePixel = source + i * 4;
+		unsigned char* destPixel = dest + i * 4;
+		unsigned int alpha = sourcePixel[3];
+		unsigned int inverseAlpha = 255 - alpha;
+		destPixel[0] = static_cast<unsigned char>(DivideBy255(destPixel[0] * inverseAlpha + sourcePixel[0] * alpha));
+		destPixel[1] = static_cast<unsigned char>(DivideBy255(destPixel[1] * inverseAlpha + sourcePixel[1] * alpha));
+		destPixel[2] = static_cast<unsigned char>(DivideBy255(destPixel[2] * inverseAlpha + sourcePixel[2] * alpha));
+	}
+}
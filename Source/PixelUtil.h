@@ -0,0 +1,22 @@
+//
+// PixelUtil.h
+//
+// Clark Kromenaker
+//
+// Utilities for working directly with 32-bit RGBA pixel data.
+//
+#pragma once
+
+namespace PixelUtil
+{
+	// Blends a row of source pixels into dest pixels, based on each source pixel's alpha. Dest alpha is left unchanged.
+	// Each color channel becomes (dest * (255 - alpha) + source * alpha) / 255, rounded down.
+	// Uses SSE2 or NEON when available, to blend several pixels at once.
+	void BlendRow(const unsigned char* source, unsigned char* dest, int pixelCount);
+	
+	// Exact division by 255, for any value up to 255 * 255, without a divide.
+	inline unsigned int DivideBy255(unsigned int value)
+	{
+		return (value + 1 + (value >> 8)) >> 8;
+	}
+}
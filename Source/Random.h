@@ -7,24 +7,36 @@
 //
 #pragma once
 #include <chrono>
+#include <cstdlib>
 #include <functional>
 #include <random>
 
 namespace Random
 {
-	// A default random generator.
+	// A default random generator, shared by all users.
 	// Seeded by the current time to ensure different results on different runs of the program.
-	static std::default_random_engine generator { (unsigned int)std::chrono::system_clock::now().time_since_epoch().count() };
+	inline std::default_random_engine& Generator()
+	{
+		static std::default_random_engine generator { (unsigned int)std::chrono::system_clock::now().time_since_epoch().count() };
+		return generator;
+	}
+	
+	// Reseeds random generators, so a run of the program can be repeated exactly.
+	inline void Seed(unsigned int seed)
+	{
+		Generator().seed(seed);
+		std::srand(seed);
+	}
 	
 	inline float Range(float minInclusive, float maxInclusive)
 	{
 		std::uniform_real_distribution<float> distribution(minInclusive, maxInclusive);
-		return distribution(generator);
+		return distribution(Generator());
 	}
 	
 	inline int Range(int minInclusive, int maxExclusive)
 	{
 		std::uniform_int_distribution<int> distribution(minInclusive, maxExclusive - 1);
-		return distribution(generator);
+		return distribution(Generator());
 	}
 }
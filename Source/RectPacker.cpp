@@ -0,0 +1,86 @@
+//
+// RectPacker.cpp
+//
+// Clark Kromenaker
+//
+#include "RectPacker.h"
+
+#include <algorithm>
+
+RectPacker::RectPacker(int maxPageWidth, int maxPageHeight, int padding) :
+    mMaxPageWidth(maxPageWidth),
+    mMaxPageHeight(maxPageHeight),
+    mPadding(padding)
+{
+
+}
+
+void RectPacker::Pack(std::vector<Rect>& rects)
+{
+    mPageSizes.clear();
+
+    // Place tallest rectangles first, so each shelf wastes little height. Ties keep their original order.
+    std::vector<int> order(rects.size());
+    for(int i = 0; i < order.size(); ++i)
+    {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&rects](int a, int b) {
+        return rects[a].height > rects[b].height;
+    });
+
+    // Position of the next rectangle on the current shelf, and the shelf's top/height (all including padding).
+    int shelfX = 0;
+    int shelfY = 0;
+    int shelfHeight = 0;
+    for(int index : order)
+    {
+        Rect& rect = rects[index];
+        int paddedWidth = rect.width + mPadding * 2;
+        int paddedHeight = rect.height + mPadding * 2;
+
+        // Too big for any page, so it gets a page of its own. Mark that page full so nothing else goes on it.
+        if(paddedWidth > mMaxPageWidth || paddedHeight > mMaxPageHeight)
+        {
+            mPageSizes.emplace_back();
+            mPageSizes.back().width = paddedWidth;
+            mPageSizes.back().height = paddedHeight;
+            rect.page = GetPageCount() - 1;
+            rect.x = mPadding;
+            rect.y = mPadding;
+
+            shelfX = 0;
+            shelfY = mMaxPageHeight;
+            shelfHeight = 0;
+            continue;
+        }
+
+        // Start a new shelf if this one is full.
+        if(!mPageSizes.empty() && shelfX + paddedWidth > mMaxPageWidth)
+        {
+            shelfX = 0;
+            shelfY += shelfHeight;
+            shelfHeight = 0;
+        }
+
+        // Start a new page if this one is full (or this is the first rectangle).
+        if(mPageSizes.empty() || shelfY + paddedHeight > mMaxPageHeight)
+        {
+            mPageSizes.emplace_back();
+            shelfX = 0;
+            shelfY = 0;
+            shelfHeight = 0;
+        }
+
+        rect.page = GetPageCount() - 1;
+        rect.x = shelfX + mPadding;
+        rect.y = shelfY + mPadding;
+
+        shelfX += paddedWidth;
+        shelfHeight = std::max(shelfHeight, paddedHeight);
+
+        Rect& pageSize = mPageSizes.back();
+        pageSize.width = std::max(pageSize.width, shelfX);
+        pageSize.height = std::max(pageSize.height, shelfY + paddedHeight);
+    }
+}
@@ -0,0 +1,48 @@
+//
+// RectPacker.h
+//
+// Clark Kromenaker
+//
+// Packs many small rectangles into one or more larger pages (e.g. for building a texture atlas).
+//
+// Uses shelf packing: rectangles are sorted tallest first, then placed left-to-right in rows ("shelves").
+// Not optimal, but fast, and works well when rectangles are similar in size (like lightmaps).
+//
+#pragma once
+#include <vector>
+
+class RectPacker
+{
+public:
+    struct Rect
+    {
+        // Size of the rectangle to pack.
+        int width = 0;
+        int height = 0;
+
+        // Filled in by packing: page the rectangle was placed on, and its position on that page.
+        int page = 0;
+        int x = 0;
+        int y = 0;
+    };
+
+    // Padding is added around each rectangle, so neighbors on a page never touch.
+    // A rectangle too big to fit a page (with padding) gets a page of its own, sized to fit.
+    RectPacker(int maxPageWidth, int maxPageHeight, int padding);
+
+    // Places all rectangles. Packing again starts over.
+    void Pack(std::vector<Rect>& rects);
+
+    // Pages used by the last pack. Page sizes are shrunk to fit what was placed on them.
+    int GetPageCount() const { return static_cast<int>(mPageSizes.size()); }
+    int GetPageWidth(int page) const { return mPageSizes[page].width; }
+    int GetPageHeight(int page) const { return mPageSizes[page].height; }
+
+private:
+    int mMaxPageWidth = 0;
+    int mMaxPageHeight = 0;
+    int mPadding = 0;
+
+    // Only width/height are used.
+    std::vector<Rect> mPageSizes;
+};
@@ -0,0 +1,88 @@
+//
+// RenderQueue.cpp
+//
+// Clark Kromenaker
+//
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <cstring>
+
+void RenderQueue::Submit(RenderBackend& backend)
+{
+	mStats = RenderStats();
+
+	// Sort by key. Commands with equal keys keep the order they were added in.
+	mSortedCommands.clear();
+	for(int i = 0; i < static_cast<int>(mCommands.size()); ++i)
+	{
+		mSortedCommands.push_back(std::make_pair(CalculateSortKey(mCommands[i]), i));
+	}
+	std::sort(mSortedCommands.begin(), mSortedCommands.end());
+
+	// Submit, only changing state that differs from the previous command.
+	const RenderCommand* previous = nullptr;
+	for(auto& entry : mSortedCommands)
+	{
+		const RenderCommand& command = mCommands[entry.second];
+
+		bool shaderChanged = previous == nullptr || command.shader != previous->shader;
+		if(shaderChanged)
+		{
+			backend.ActivateShader(command);
+			++mStats.shaderChangeCount;
+		}
+
+		// Material parameters are per shader program, so set them again if the shader changed.
+		if(shaderChanged || command.material != previous->material)
+		{
+			backend.ActivateMaterial(command);
+			++mStats.materialChangeCount;
+
+			if(previous == nullptr || command.texture != previous->texture)
+			{
+				++mStats.textureChangeCount;
+			}
+		}
+
+		backend.Draw(command);
+		++mStats.drawCount;
+		previous = &command;
+	}
+
+	mCommands.clear();
+
+	// IDs only need to be consistent within one submit. Shaders and textures may be deleted
+	// (and their addresses reused) before the next one, so don't let stale IDs carry over.
+	mStateIds.clear();
+}
+
+uint64_t RenderQueue::CalculateSortKey(const RenderCommand& command)
+{
+	// Key layout, from most to least significant: shader (16 bits), texture (24 bits), depth (24 bits).
+	uint64_t shaderId = GetStateId(command.shader) & 0xFFFF;
+	uint64_t textureId = GetStateId(command.texture) & 0xFFFFFF;
+
+	// For non-negative floats, the bit pattern increases as the value increases.
+	// So, the top bits of the float sort correctly, with some lost precision.
+	float depth = command.depth > 0.0f ? command.depth : 0.0f;
+	uint32_t depthBits = 0;
+	std::memcpy(&depthBits, &depth, sizeof(depthBits));
+	uint64_t depthKey = depthBits >> 8;
+
+	return (shaderId << 48) | (textureId << 24) | depthKey;
+}
+
+uint32_t RenderQueue::GetStateId(const void* state)
+{
+	if(state == nullptr) { return 0; }
+
+	auto it = mStateIds.find(state);
+	if(it != mStateIds.end())
+	{
+		return it->second;
+	}
+	uint32_t id = static_cast<uint32_t>(mStateIds.size()) + 1;
+	mStateIds[state] = id;
+	return id;
+}
@@ -0,0 +1,99 @@
+//
+// RenderQueue.h
+//
+// Clark Kromenaker
+//
+// Collects draws for a render pass, then submits them sorted by state (shader, then texture, then depth).
+// Sorting groups draws that use the same state together, so fewer state changes are needed to submit them.
+//
+// Submitting goes through a backend, which does the actual state changes and draws. The queue only tracks
+// which state changes are needed, so it can be used (and state changes counted) without a GPU.
+//
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Matrix4.h"
+
+class Material;
+class Shader;
+class Submesh;
+class Texture;
+
+struct RenderCommand
+{
+	// Material to use, and the shader and main texture it uses (used for sorting and detecting state changes).
+	Material* material = nullptr;
+	Shader* shader = nullptr;
+	Texture* texture = nullptr;
+
+	// What to draw, and where.
+	const Submesh* submesh = nullptr;
+	Matrix4 objectToWorldMatrix;
+
+	// Distance from the camera. Within the same state, closer draws are submitted first.
+	float depth = 0.0f;
+};
+
+class RenderBackend
+{
+public:
+	virtual ~RenderBackend() { }
+
+	// Called when a command uses a different shader than the previous command.
+	virtual void ActivateShader(const RenderCommand& command) = 0;
+
+	// Called when a command uses a different material than the previous command (or the shader changed).
+	virtual void ActivateMaterial(const RenderCommand& command) = 0;
+
+	// Called for every command.
+	virtual void Draw(const RenderCommand& command) = 0;
+};
+
+// A backend that does nothing. Useful when only the cost of building and sorting the queue matters (e.g. headless).
+class NullRenderBackend : public RenderBackend
+{
+public:
+	void ActivateShader(const RenderCommand&) override { }
+	void ActivateMaterial(const RenderCommand&) override { }
+	void Draw(const RenderCommand&) override { }
+};
+
+struct RenderStats
+{
+	int drawCount = 0;
+	int shaderChangeCount = 0;
+	int materialChangeCount = 0;
+	int textureChangeCount = 0;
+};
+
+class RenderQueue
+{
+public:
+	void Add(const RenderCommand& command) { mCommands.push_back(command); }
+
+	int GetCommandCount() const { return static_cast<int>(mCommands.size()); }
+
+	// Sorts and submits all commands to the backend, then clears the queue.
+	void Submit(RenderBackend& backend);
+
+	// Stats for the most recent submit.
+	const RenderStats& GetStats() const { return mStats; }
+
+private:
+	// Commands added since the last submit.
+	std::vector<RenderCommand> mCommands;
+
+	// Sort key and index of each command. Reused between submits to avoid allocating.
+	std::vector<std::pair<uint64_t, int>> mSortedCommands;
+
+	// Small IDs for shaders and textures, assigned in the order first seen during a submit, to pack into sort keys.
+	std::unordered_map<const void*, uint32_t> mStateIds;
+
+	RenderStats mStats;
+
+	uint64_t CalculateSortKey(const RenderCommand& command);
+	uint32_t GetStateId(const void* state);
+};
@@ -109,64 +109,41 @@ float ui_quad_uvs[] = {
 
 Mesh* uiQuad = nullptr;
 
-bool Renderer::Initialize()
+namespace
 {
-    // Init video subsystem.
-    if(SDL_InitSubSystem(SDL_INIT_VIDEO) != 0)
-    {
-        return false;
-    }
-    
-    // Tell SDL we want to use OpenGL 3.3
-    SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
-    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
-    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
-    
-    // Request some GL parameters, just in case
-    SDL_GL_SetAttribute(SDL_GL_RED_SIZE, 8);
-    SDL_GL_SetAttribute(SDL_GL_GREEN_SIZE, 8);
-    SDL_GL_SetAttribute(SDL_GL_BLUE_SIZE, 8);
-    SDL_GL_SetAttribute(SDL_GL_ALPHA_SIZE, 8);
-    SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 24);
-    SDL_GL_SetAttribute(SDL_GL_STENCIL_SIZE, 8);
-    SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
-    SDL_GL_SetAttribute(SDL_GL_ACCELERATED_VISUAL, 1);
-    
-    // Create a window.
-    mWindow = SDL_CreateWindow("GK3", 100, 100, mScreenWidth, mScreenHeight, SDL_WINDOW_OPENGL);
-    if(!mWindow) { return false; }
-    
-    // Create OpenGL context.
-    mContext = SDL_GL_CreateContext(mWindow);
-	
-	/*
-	// For debugging display count stuff...
-	int displayCount = SDL_GetNumVideoDisplays();
-	for(int i = 0; i < displayCount; i++)
+	// Submits render commands by activating their materials and rendering their submeshes.
+	class MaterialRenderBackend : public RenderBackend
 	{
-		float hdpi = 0.0f;
-		float vdpi = 0.0f;
-		SDL_GetDisplayDPI(i, nullptr, &hdpi, &vdpi);
-		//SDL_Log("%f, %f", hdpi, vdpi);
-	}
-	*/
-	
-    // Initialize GLEW.
-    glewExperimental = GL_TRUE;
-    if(glewInit() != GLEW_OK)
+	public:
+		void ActivateShader(const RenderCommand& command) override
+		{
+			command.material->ActivateShader();
+		}
+		
+		void ActivateMaterial(const RenderCommand& command) override
+		{
+			command.material->ActivateParameters();
+		}
+		
+		void Draw(const RenderCommand& command) override
+		{
+			command.material->SetObjectToWorldMatrix(command.objectToWorldMatrix);
+			command.material->SetMorphWeight(command.submesh->GetMorphWeight());
+			command.submesh->Render();
+		}
+	};
+}
+
+/*static*/ bool Renderer::sHeadless = false;
+
+bool Renderer::Initialize(bool headless)
+{
+    // Create window and GL context, unless running headless.
+    sHeadless = headless;
+    if(!sHeadless && !InitializeContext())
     {
-        SDL_Log("Failed to initialize GLEW.");
         return false;
     }
-    
-    // Clear any GLEW error.
-    glGetError();
-    
-    // Our clear color will be BLACK!
-    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-    
-    // For use with alpha blending during render loop.
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 	
     // Load default shader.
 	Shader* defaultShader = Services::GetAssets()->LoadShader("3D-Diffuse-Tex");
@@ -244,6 +221,8 @@ bool Renderer::Initialize()
 
 void Renderer::Shutdown()
 {
+    if(sHeadless) { return; }
+    Material::DestroyCameraBuffer();
     SDL_GL_DeleteContext(mContext);
     SDL_DestroyWindow(mWindow);
     SDL_QuitSubSystem(SDL_INIT_VIDEO);
@@ -251,6 +230,19 @@ void Renderer::Shutdown()
 
 void Renderer::Render()
 {
+	// Nothing to render to when headless.
+	// Still build and sort the mesh queue though, so its CPU cost shows up in headless timings.
+	if(sHeadless)
+	{
+		if(mCamera != nullptr)
+		{
+			QueueOpaqueMeshes();
+			NullRenderBackend nullBackend;
+			mOpaqueQueue.Submit(nullBackend);
+		}
+		return;
+	}
+	
 	// Enable opaque rendering (no blend, write to & test depth buffer).
 	// Do this BEFORE clear to avoid some glitchy graphics.
 	glDisable(GL_BLEND); // do not perform alpha blending (opaque rendering)
@@ -301,21 +293,24 @@ void Renderer::Render()
 	}
 	
 	// STEP 2B: OPAQUE MESH RENDERING
-	// Render opaque meshes (no particular order).
-	// Sorting is probably not worthwhile b/c BSP likely mostly filled the z-buffer at this point.
-	// And with the z-buffer, we can render opaque meshed correctly regardless of order.
-	for(auto& meshRenderer : mMeshRenderers)
-	{
-		meshRenderer->RenderOpaque();
-	}
+	// Render opaque meshes, sorted to minimize state changes (shader, then texture, then front-to-back).
+	// With the z-buffer, we can render opaque meshes correctly regardless of order.
+	QueueOpaqueMeshes();
+	MaterialRenderBackend backend;
+	mOpaqueQueue.Submit(backend);
 	
 	// Turn off alpha test.
 	Material::UseAlphaTest(false);
 	
 	// STEP 3: TRANSLUCENT WORLD RENDERING
-	// So far, GK3 doesn't seem to have any translucent geometry AT ALL!
-	// Everything is either opaque or alpha test.
-	// If we DO need translucent rendering, it probably can only be meshes or BSP, but not both.
+	// GK3 has very little translucent geometry - almost everything is either opaque or alpha test.
+	// Translucent BSP polygons were gathered back-to-front during opaque BSP rendering.
+	if(mBSP != nullptr)
+	{
+		glEnable(GL_BLEND); // do alpha blending
+		glDepthMask(GL_FALSE); // don't write to the depth buffer
+		mBSP->RenderTranslucent();
+	}
 	
 	// STEP 4: (TRANSLUCENT) UI RENDERING
 	glEnable(GL_BLEND); // do alpha blending
@@ -356,6 +351,81 @@ void Renderer::Render()
 	SDL_GL_SwapWindow(mWindow);
 }
 
+bool Renderer::InitializeContext()
+{
+    // Init video subsystem.
+    if(SDL_InitSubSystem(SDL_INIT_VIDEO) != 0)
+    {
+        return false;
+    }
+    
+    // Tell SDL we want to use OpenGL 3.3
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
+    
+    // Request some GL parameters, just in case
+    SDL_GL_SetAttribute(SDL_GL_RED_SIZE, 8);
+    SDL_GL_SetAttribute(SDL_GL_GREEN_SIZE, 8);
+    SDL_GL_SetAttribute(SDL_GL_BLUE_SIZE, 8);
+    SDL_GL_SetAttribute(SDL_GL_ALPHA_SIZE, 8);
+    SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 24);
+    SDL_GL_SetAttribute(SDL_GL_STENCIL_SIZE, 8);
+    SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
+    SDL_GL_SetAttribute(SDL_GL_ACCELERATED_VISUAL, 1);
+    
+    // Create a window.
+    mWindow = SDL_CreateWindow("GK3", 100, 100, mScreenWidth, mScreenHeight, SDL_WINDOW_OPENGL);
+    if(!mWindow) { return false; }
+    
+    // Create OpenGL context.
+    mContext = SDL_GL_CreateContext(mWindow);
+	
+	/*
+	// For debugging display count stuff...
+	int displayCount = SDL_GetNumVideoDisplays();
+	for(int i = 0; i < displayCount; i++)
+	{
+		float hdpi = 0.0f;
+		float vdpi = 0.0f;
+		SDL_GetDisplayDPI(i, nullptr, &hdpi, &vdpi);
+		//SDL_Log("%f, %f", hdpi, vdpi);
+	}
+	*/
+	
+    // Initialize GLEW.
+    glewExperimental = GL_TRUE;
+    if(glewInit() != GLEW_OK)
+    {
+        SDL_Log("Failed to initialize GLEW.");
+        return false;
+    }
+    
+    // Clear any GLEW error.
+    glGetError();
+    
+    // Our clear color will be BLACK!
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    
+    // For use with alpha blending during render loop.
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    
+    // Camera matrices are shared by all shaders via a uniform buffer.
+    Material::CreateCameraBuffer();
+    
+    // Context created successfully!
+    return true;
+}
+
+void Renderer::QueueOpaqueMeshes()
+{
+	Vector3 cameraPosition = mCamera->GetOwner()->GetPosition();
+	for(auto& meshRenderer : mMeshRenderers)
+	{
+		meshRenderer->AddOpaqueToQueue(mOpaqueQueue, cameraPosition);
+	}
+}
+
 void Renderer::AddMeshRenderer(MeshRenderer* mr)
 {
     mMeshRenderers.push_back(mr);
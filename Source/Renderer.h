@@ -14,6 +14,7 @@
 
 #include "Material.h"
 #include "Matrix4.h"
+#include "RenderQueue.h"
 #include "Vector2.h"
 
 class BSP;
@@ -26,9 +27,12 @@ class Skybox;
 class Renderer
 {
 public:
-    bool Initialize();
+    // When headless, no window or GL context is created. GPU resources keep only their CPU-side data, and rendering does nothing.
+    bool Initialize(bool headless = false);
     void Shutdown();
     
+    static bool IsHeadless() { return sHeadless; }
+    
     void Render();
     
     void SetCamera(Camera* camera) { mCamera = camera; }
@@ -41,12 +45,18 @@ public:
     
 	void SetSkybox(Skybox* skybox);
     
+    // Stats for opaque mesh draws in the most recent frame.
+    const RenderStats& GetOpaqueStats() const { return mOpaqueQueue.GetStats(); }
+    
     int GetWindowWidth() { return mScreenWidth; }
 	int GetWindowHeight() { return mScreenHeight; }
 	
 	Vector2 GetWindowSize() { return Vector2(static_cast<float>(mScreenWidth), static_cast<float>(mScreenHeight)); }
     
 private:
+    // True if running without a window or GL context.
+    static bool sHeadless;
+    
     // Screen's width and height, in pixels.
     int mScreenWidth = 1024;
     int mScreenHeight = 768;
@@ -62,6 +72,9 @@ private:
     
     // List of mesh components to render.
     std::vector<MeshRenderer*> mMeshRenderers;
+    
+    // Draws for opaque meshes, collected and sorted each frame.
+    RenderQueue mOpaqueQueue;
 	
     // A BSP to render.
     BSP* mBSP = nullptr;
@@ -69,4 +82,7 @@ private:
     // A skybox to render.
 	Material mSkyboxMaterial;
     Skybox* mSkybox = nullptr;
+    
+    bool InitializeContext();
+    void QueueOpaqueMeshes();
 };
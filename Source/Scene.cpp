@@ -100,6 +100,16 @@ void Scene::Load()
 	
 	// Set BSP to be rendered.
     Services::GetRenderer()->SetBSP(mSceneData->GetBSP());
+	
+	// Build floor height grid - actors are placed on the floor as they're loaded, so do this first.
+	BSP* bsp = mSceneData->GetBSP();
+	if(bsp != nullptr)
+	{
+		std::vector<Vector3> floorVertices;
+		mFloorSurfaces.clear();
+		bsp->GetObjectTriangles(mSceneData->GetFloorModelName(), floorVertices, mFloorSurfaces);
+		mFloorGrid.Build(floorVertices);
+	}
     
     // Figure out if we have a skybox, and set it to be rendered.
     Services::GetRenderer()->SetSkybox(mSceneData->GetSkybox());
@@ -327,6 +337,9 @@ void Scene::Unload()
 	Services::GetRenderer()->SetBSP(nullptr);
 	Services::GetRenderer()->SetSkybox(nullptr);
 	
+	mFloorGrid = HeightGrid();
+	mFloorSurfaces.clear();
+	
 	delete mSceneData;
 	mSceneData = nullptr;
 }
@@ -502,23 +515,12 @@ void Scene::Interact(const Ray& ray, GKObject* interactHint)
 
 float Scene::GetFloorY(const Vector3& position) const
 {
-	// Calculate ray origin using passed position, but really high in the air!
-	Vector3 rayOrigin = position;
-	rayOrigin.y = 10000.0f;
-	
-	// Create ray with origin high in the sky and pointing straight down.
-	Ray downRay(rayOrigin, -Vector3::UnitY);
-	
-	// Raycast straight down and test against the floor BSP.
+	// Equivalent to raycasting straight down from high in the air against the floor BSP object.
 	// If we hit something, just use the Y hit position as the floor's Y.
-	BSP* bsp = mSceneData->GetBSP();
-	if(bsp != nullptr)
+	float floorY = 0.0f;
+	if(mFloorGrid.GetHeight(position, [this](int triangleIndex) { return mFloorSurfaces[triangleIndex]->interactive; }, floorY))
 	{
-		RaycastHit hitInfo;
-		if(bsp->RaycastSingle(downRay, mSceneData->GetFloorModelName(), hitInfo))
-		{
-			return downRay.GetPoint(hitInfo.t).y;
-		}
+		return floorY;
 	}
 	
 	// If didn't hit floor, just return 0.
@@ -526,6 +528,15 @@ float Scene::GetFloorY(const Vector3& position) const
 	return 0.0f;
 }
 
+void Scene::GetFloorY(const std::vector<Vector3>& positions, std::vector<float>& outFloorYs) const
+{
+	outFloorYs.resize(positions.size());
+	for(int i = 0; i < positions.size(); i++)
+	{
+		outFloorYs[i] = GetFloorY(positions[i]);
+	}
+}
+
 GKActor* Scene::GetSceneObjectByModelName(const std::string& modelName) const
 {
 	for(auto& object : mObjects)
@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "Collisions.h"
+#include "HeightGrid.h"
 #include "SceneData.h"
 #include "Timeblock.h"
 
@@ -25,6 +26,7 @@ class ActionBar;
 class Animator;
 class BSP;
 class BSPActor;
+struct BSPSurface;
 class GameCamera;
 class GKActor;
 class GKObject;
@@ -59,6 +61,7 @@ public:
     void Interact(const Ray& ray, GKObject* interactHint = nullptr);
 	
 	float GetFloorY(const Vector3& position) const;
+	void GetFloorY(const std::vector<Vector3>& positions, std::vector<float>& outFloorYs) const;
 	
 	const std::string& GetEgoName() const { return mEgoName; }
 	GKActor* GetEgo() const { return mEgo; }
@@ -109,6 +112,11 @@ private:
 	// Actors in the BSP.
 	std::vector<BSPActor*> mBSPActors;
 	
+	// Floor model triangles, for quickly finding floor height at a position.
+	// Each triangle's surface is kept, since surfaces can be made non-interactive at runtime.
+	HeightGrid mFloorGrid;
+	std::vector<const BSPSurface*> mFloorSurfaces;
+	
     // The name of actor and actor who we are controlling in the scene.
 	// We sometimes need just the name - that's safer during scene loading.
 	std::string mEgoName;
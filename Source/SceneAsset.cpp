@@ -28,10 +28,10 @@ void SceneAsset::ParseFromData(char *data, int dataLength)
     parser.ParseAll();
     
     // Load any BSP override specified. Otherwise, the name of the SCN asset is used for the BSP too.
-    std::vector<IniSection> topSections = parser.GetSections("");
+    std::vector<IniSection*> topSections = parser.GetSections("");
     for(auto& section : topSections)
     {
-        for(auto& line : section.lines)
+        for(auto& line : section->lines)
         {
 			IniKeyValue& entry = line.entries.front();
             if(StringUtil::EqualsIgnoreCase(entry.key, "bsp"))
@@ -48,7 +48,7 @@ void SceneAsset::ParseFromData(char *data, int dataLength)
 	}
     
     // Load a skybox, if any.
-    IniSection skyboxSection = parser.GetSection("SKYBOX");
+    IniSection& skyboxSection = parser.GetSection("SKYBOX");
     if(skyboxSection.lines.size() > 0)
     {
         mSkybox = new Skybox();
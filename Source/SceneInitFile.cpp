@@ -101,7 +101,7 @@ SceneInitFile::SceneInitFile(const std::string& name, char* data, int dataLength
 
 SceneInitFile::~SceneInitFile()
 {
-	//TODO: delete any block conditions - we own them after compiling!
+	// Block conditions aren't deleted here - they're owned by the sheep manager, and may be shared with other scenes.
 }
 
 const SceneActor* SceneInitFile::FindCurrentEgo() const
@@ -163,22 +163,22 @@ void SceneInitFile::ParseFromData(char *data, int dataLength)
     parser.ParseAll();
     
     // Read in general section.
-    std::vector<IniSection> generals = parser.GetSections("GENERAL");
+    std::vector<IniSection*> generals = parser.GetSections("GENERAL");
     for(auto& section : generals)
     {
 		mGeneralBlocks.emplace_back();
 		GeneralBlock& general = mGeneralBlocks.back();
 		
         // Compile and save condition.
-        if(!section.condition.empty())
+        if(!section->condition.empty())
         {
 			// Why is this called "Int Evaluation"? Not sure - but testing in GK3 seems to suggest it is...
-			general.conditionText = section.condition;
-			general.condition = Services::GetSheep()->Compile("Int Evaluation", section.condition);
+			general.conditionText = section->condition;
+			general.condition = Services::GetSheep()->CompileCached("Int Evaluation", section->condition);
         }
         
 		// Handle all key/value pairs in this block.
-        for(auto& line : section.lines)
+        for(auto& line : section->lines)
         {
 			IniKeyValue& first = line.entries.front();
 			if(StringUtil::EqualsIgnoreCase(first.key, "scene"))
@@ -245,7 +245,7 @@ void SceneInitFile::ParseFromData(char *data, int dataLength)
             }
             else if(StringUtil::EqualsIgnoreCase(first.key, "skybox"))
             {
-				for(int i = 1; i < section.lines.size(); ++i)
+				for(int i = 1; i < section->lines.size(); ++i)
 				{
 					IniKeyValue& keyValue = line.entries[i];
 					
@@ -279,21 +279,21 @@ void SceneInitFile::ParseFromData(char *data, int dataLength)
     }
     
     // Read in cameras.
-    std::vector<IniSection> inspectCameras = parser.GetSections("INSPECT_CAMERAS");
+    std::vector<IniSection*> inspectCameras = parser.GetSections("INSPECT_CAMERAS");
     for(auto& section : inspectCameras)
     {
 		mInspectCameras.emplace_back();
 		ConditionalBlock<SceneCamera>& cameraBlock = mInspectCameras.back();
 		
         // Compile and save condition.
-        if(!section.condition.empty())
+        if(!section->condition.empty())
         {
-			cameraBlock.conditionText = section.condition;
-			cameraBlock.condition = Services::GetSheep()->Compile("Int Evaluation", section.condition);
+			cameraBlock.conditionText = section->condition;
+			cameraBlock.condition = Services::GetSheep()->CompileCached("Int Evaluation", section->condition);
         }
         
 		// Handle creation of each camera in this block.
-        for(auto& line : section.lines)
+        for(auto& line : section->lines)
         {
 			cameraBlock.items.emplace_back();
 			SceneCamera& camera = cameraBlock.items.back();
@@ -319,21 +319,21 @@ void SceneInitFile::ParseFromData(char *data, int dataLength)
         }
     }
     
-    std::vector<IniSection> roomCameras = parser.GetSections("ROOM_CAMERAS");
+    std::vector<IniSection*> roomCameras = parser.GetSections("ROOM_CAMERAS");
     for(auto& section : roomCameras)
     {
 		mRoomCameras.emplace_back();
 		ConditionalBlock<RoomSceneCamera>& cameraBlock = mRoomCameras.back();
 		
         // Compile and save condition.
-        if(!section.condition.empty())
+        if(!section->condition.empty())
         {
-			cameraBlock.conditionText = section.condition;
-			cameraBlock.condition = Services::GetSheep()->Compile("Int Evaluation", section.condition);
+			cameraBlock.conditionText = section->condition;
+			cameraBlock.condition = Services::GetSheep()->CompileCached("Int Evaluation", section->condition);
         }
         
 		// Handle creation of each camera in this block.
-        for(auto& line : section.lines)
+        for(auto& line : section->lines)
         {
 			cameraBlock.items.emplace_back();
 			RoomSceneCamera& camera = cameraBlock.items.back();
@@ -367,21 +367,21 @@ void SceneInitFile::ParseFromData(char *data, int dataLength)
         }
     }
     
-    std::vector<IniSection> cinematicCameras = parser.GetSections("CINEMATIC_CAMERAS");
+    std::vector<IniSection*> cinematicCameras = parser.GetSections("CINEMATIC_CAMERAS");
     for(auto& section : cinematicCameras)
     {
 		mCinematicCameras.emplace_back();
 		ConditionalBlock<SceneCamera>& cameraBlock = mCinematicCameras.back();
 		
         // Compile and save condition.
-        if(!section.condition.empty())
+        if(!section->condition.empty())
         {
-			cameraBlock.conditionText = section.condition;
-			cameraBlock.condition = Services::GetSheep()->Compile("Int Evaluation", section.condition);
+			cameraBlock.conditionText = section->condition;
+			cameraBlock.condition = Services::GetSheep()->CompileCached("Int Evaluation", section->condition);
         }
         
 		// Handle creation of each camera in this block.
-        for(auto& line : section.lines)
+        for(auto& line : section->lines)
         {
 			cameraBlock.items.emplace_back();
 			SceneCamera& camera = cameraBlock.items.back();
@@ -409,21 +409,21 @@ void SceneInitFile::ParseFromData(char *data, int dataLength)
         }
     }
     
-    std::vector<IniSection> DialogueSceneCameras = parser.GetSections("DIALOGUE_CAMERAS");
+    std::vector<IniSection*> DialogueSceneCameras = parser.GetSections("DIALOGUE_CAMERAS");
     for(auto& section : DialogueSceneCameras)
     {
 		mDialogueCameras.emplace_back();
 		ConditionalBlock<DialogueSceneCamera>& cameraBlock = mDialogueCameras.back();
 		
         // Compile and save condition.
-        if(!section.condition.empty())
+        if(!section->condition.empty())
         {
-			cameraBlock.conditionText = section.condition;
-			cameraBlock.condition = Services::GetSheep()->Compile("Int Evaluation", section.condition);
+			cameraBlock.conditionText = section->condition;
+			cameraBlock.condition = Services::GetSheep()->CompileCached("Int Evaluation", section->condition);
         }
         
 		// Create each camera in this block.
-        for(auto& line : section.lines)
+        for(auto& line : section->lines)
         {
             cameraBlock.items.emplace_back();
 			DialogueSceneCamera& camera = cameraBlock.items.back();
@@ -468,21 +468,21 @@ void SceneInitFile::ParseFromData(char *data, int dataLength)
     }
     
     // Read in positions.
-    std::vector<IniSection> positionSections = parser.GetSections("POSITIONS");
+    std::vector<IniSection*> positionSections = parser.GetSections("POSITIONS");
     for(auto& section : positionSections)
     {
 		mPositions.emplace_back();
 		ConditionalBlock<ScenePosition>& positionBlock = mPositions.back();
 		
         // Compile and save condition.
-        if(!section.condition.empty())
+        if(!section->condition.empty())
         {
-			positionBlock.conditionText = section.condition;
-			positionBlock.condition = Services::GetSheep()->Compile("Int Evaluation", section.condition);
+			positionBlock.conditionText = section->condition;
+			positionBlock.condition = Services::GetSheep()->CompileCached("Int Evaluation", section->condition);
         }
         
 		// Create each scene position.
-        for(auto& line : section.lines)
+        for(auto& line : section->lines)
         {
 			positionBlock.items.emplace_back();
 			ScenePosition& position = positionBlock.items.back();
@@ -512,21 +512,21 @@ void SceneInitFile::ParseFromData(char *data, int dataLength)
     }
     
     // Read in actors.
-    std::vector<IniSection> actorSections = parser.GetSections("ACTORS");
+    std::vector<IniSection*> actorSections = parser.GetSections("ACTORS");
     for(auto& section : actorSections)
     {
 		mActors.emplace_back();
 		ConditionalBlock<SceneActor>& actorBlock = mActors.back();
 		
         // Compile and save condition.
-        if(!section.condition.empty())
+        if(!section->condition.empty())
         {
-			actorBlock.conditionText = section.condition;
-			actorBlock.condition = Services::GetSheep()->Compile("Int Evaluation", section.condition);
+			actorBlock.conditionText = section->condition;
+			actorBlock.condition = Services::GetSheep()->CompileCached("Int Evaluation", section->condition);
         }
         
 		// Create each actor defined in the block.
-        for(auto& line : section.lines)
+        for(auto& line : section->lines)
         {
 			actorBlock.items.emplace_back();
 			SceneActor& actor = actorBlock.items.back();
@@ -589,21 +589,21 @@ void SceneInitFile::ParseFromData(char *data, int dataLength)
     }
     
     // Read in models.
-    std::vector<IniSection> modelSections = parser.GetSections("MODELS");
+    std::vector<IniSection*> modelSections = parser.GetSections("MODELS");
     for(auto& section : modelSections)
     {
 		mModels.emplace_back();
 		ConditionalBlock<SceneModel>& modelBlock = mModels.back();
 		
         // Compile and save condition.
-        if(!section.condition.empty())
+        if(!section->condition.empty())
         {
-			modelBlock.conditionText = section.condition;
-            modelBlock.condition = Services::GetSheep()->Compile("Int Evaluation", section.condition);
+			modelBlock.conditionText = section->condition;
+            modelBlock.condition = Services::GetSheep()->CompileCached("Int Evaluation", section->condition);
         }
         
 		// Create each model defined in block.
-        for(auto& line : section.lines)
+        for(auto& line : section->lines)
         {
 			modelBlock.items.emplace_back();
 			SceneModel& model = modelBlock.items.back();
@@ -668,21 +668,21 @@ void SceneInitFile::ParseFromData(char *data, int dataLength)
     }
     
     // Read in regions and triggers.
-    std::vector<IniSection> regionSections = parser.GetSections("REGIONS");
+    std::vector<IniSection*> regionSections = parser.GetSections("REGIONS");
     for(auto& section : regionSections)
     {
 		mRegions.emplace_back();
 		ConditionalBlock<SceneRegionOrTrigger>& regionBlock = mRegions.back();
 		
         // Compile and save condition.
-        if(!section.condition.empty())
+        if(!section->condition.empty())
         {
-			regionBlock.conditionText = section.condition;
-            regionBlock.condition = Services::GetSheep()->Compile("Int Evaluation", section.condition);
+			regionBlock.conditionText = section->condition;
+            regionBlock.condition = Services::GetSheep()->CompileCached("Int Evaluation", section->condition);
         }
         
 		// Create each region.
-        for(auto& line : section.lines)
+        for(auto& line : section->lines)
         {
 			regionBlock.items.emplace_back();
 			SceneRegionOrTrigger& region = regionBlock.items.back();
@@ -703,21 +703,21 @@ void SceneInitFile::ParseFromData(char *data, int dataLength)
         }
     }
     
-    std::vector<IniSection> triggerSections = parser.GetSections("TRIGGERS");
+    std::vector<IniSection*> triggerSections = parser.GetSections("TRIGGERS");
     for(auto& section : triggerSections)
     {
 		mTriggers.emplace_back();
 		ConditionalBlock<SceneRegionOrTrigger>& triggerBlock = mTriggers.back();
 		
         // Compile and save condition.
-        if(!section.condition.empty())
+        if(!section->condition.empty())
         {
-			triggerBlock.conditionText = section.condition;
-            triggerBlock.condition = Services::GetSheep()->Compile("Int Evaluation", section.condition);
+			triggerBlock.conditionText = section->condition;
+            triggerBlock.condition = Services::GetSheep()->CompileCached("Int Evaluation", section->condition);
         }
         
 		// Create each trigger defined.
-        for(auto& line : section.lines)
+        for(auto& line : section->lines)
         {
 			triggerBlock.items.emplace_back();
 			SceneRegionOrTrigger& region = triggerBlock.items.back();
@@ -736,21 +736,21 @@ void SceneInitFile::ParseFromData(char *data, int dataLength)
         }
     }
     
-    std::vector<IniSection> ambientSections = parser.GetSections("AMBIENT");
+    std::vector<IniSection*> ambientSections = parser.GetSections("AMBIENT");
     for(auto& section : ambientSections)
     {
 		mSoundtracks.emplace_back();
 		ConditionalBlock<Soundtrack*>& soundtrackBlock = mSoundtracks.back();
 		
         // Compile and save condition.
-        if(!section.condition.empty())
+        if(!section->condition.empty())
         {
-			soundtrackBlock.conditionText = section.condition;
-            soundtrackBlock.condition = Services::GetSheep()->Compile("Int Evaluation", section.condition);
+			soundtrackBlock.conditionText = section->condition;
+            soundtrackBlock.condition = Services::GetSheep()->CompileCached("Int Evaluation", section->condition);
         }
         
 		// Add soundtracks.
-        for(auto& line : section.lines)
+        for(auto& line : section->lines)
         {
             Soundtrack* soundtrack = Services::GetAssets()->LoadSoundtrack(line.entries[0].key);
             if(soundtrack != nullptr)
@@ -760,20 +760,20 @@ void SceneInitFile::ParseFromData(char *data, int dataLength)
         }
     }
     
-    std::vector<IniSection> actionSections = parser.GetSections("ACTIONS");
+    std::vector<IniSection*> actionSections = parser.GetSections("ACTIONS");
     for(auto& section : actionSections)
     {
 		mActions.emplace_back();
 		ConditionalBlock<NVC*>& actionBlock = mActions.back();
 		
         // Compile and save condition.
-        if(!section.condition.empty())
+        if(!section->condition.empty())
         {
-			actionBlock.conditionText = section.condition;
-            actionBlock.condition = Services::GetSheep()->Compile("Int Evaluation", section.condition);
+			actionBlock.conditionText = section->condition;
+            actionBlock.condition = Services::GetSheep()->CompileCached("Int Evaluation", section->condition);
         }
         
-        for(auto& line : section.lines)
+        for(auto& line : section->lines)
         {
             NVC* nvc = Services::GetAssets()->LoadNVC(line.entries[0].key);
             if(nvc != nullptr)
@@ -11,11 +11,17 @@
 
 #include "Color32.h"
 #include "Matrix4.h"
+#include "Renderer.h"
 #include "Vector3.h"
 #include "VertexDefinition.h"
 
+/*static*/ GLuint Shader::sActiveProgram = GL_NONE;
+
 Shader::Shader(const char* vertShaderPath, const char* fragShaderPath)
 {
+    // No GL context to compile with. The shader is still usable, but does nothing.
+    if(Renderer::IsHeadless()) { return; }
+    
     // Load vertex and fragment shaders, and compile them.
     GLuint vertexShader = LoadAndCompileShaderFromFile(vertShaderPath, GL_VERTEX_SHADER);
     GLuint fragmentShader = LoadAndCompileShaderFromFile(fragShaderPath, GL_FRAGMENT_SHADER);
@@ -56,78 +62,89 @@ Shader::Shader(const char* vertShaderPath, const char* fragShaderPath)
     glDetachShader(mProgram, vertexShader);
     glDetachShader(mProgram, fragmentShader);
     
-    // After shader program is compiled and linked, it's possible to query the program
-    // to determine the uniforms that exist in the program.
+    // Camera matrices are provided to all shaders in a uniform buffer.
+    GLuint cameraBlockIndex = glGetUniformBlockIndex(mProgram, "Camera");
+    if(cameraBlockIndex != GL_INVALID_INDEX)
+    {
+        glUniformBlockBinding(mProgram, cameraBlockIndex, kCameraBlockBinding);
+    }
     
-    // This *may* be useful in the future so that a material knows what uniforms exist.
-    // But for now, we are assuming that the material has explicitly defined values for all uniforms.
-    //RefreshUniforms();
+    // After shader program is compiled and linked, query the program for its uniforms and their locations.
+    // Doing this once avoids asking GL for a uniform's location every time it's set.
+    RefreshUniforms();
 }
 
 Shader::~Shader()
 {
+    if(mProgram == GL_NONE) { return; }
+    if(sActiveProgram == mProgram)
+    {
+        sActiveProgram = GL_NONE;
+    }
     glDeleteProgram(mProgram);
 }
 
+bool Shader::IsGood() const
+{
+    // When headless, shaders are never compiled, but are still usable.
+    return mProgram != GL_NONE || Renderer::IsHeadless();
+}
+
 void Shader::Activate()
 {
-    if(mProgram != GL_NONE)
+    if(mProgram != GL_NONE && mProgram != sActiveProgram)
     {
         glUseProgram(mProgram);
+        sActiveProgram = mProgram;
     }
 }
 
-void Shader::SetUniformInt(const char* name, int value)
+void Shader::SetUniformInt(int uniformIndex, int value)
 {
-    if(mProgram != GL_NONE)
+    if(mUniforms.ChangeValue(uniformIndex, value))
     {
-        GLuint loc = glGetUniformLocation(mProgram, name);
-        glUniform1i(loc, value);
+        glUniform1i(mUniforms.Get(uniformIndex).location, value);
     }
 }
 
-void Shader::SetUniformFloat(const char* name, float value)
+void Shader::SetUniformFloat(int uniformIndex, float value)
 {
-    if(mProgram != GL_NONE)
+    if(mUniforms.ChangeValue(uniformIndex, &value, 1))
     {
-        GLuint loc = glGetUniformLocation(mProgram, name);
-        glUniform1f(loc, value);
+        glUniform1f(mUniforms.Get(uniformIndex).location, value);
     }
 }
 
-void Shader::SetUniformVector3(const char* name, const Vector3& vector)
+void Shader::SetUniformVector3(int uniformIndex, const Vector3& vector)
 {
-    if(mProgram != GL_NONE)
+    GLfloat values[3] = { vector.x, vector.y, vector.z };
+    if(mUniforms.ChangeValue(uniformIndex, values, 3))
     {
-        GLuint vecLoc = glGetUniformLocation(mProgram, name);
-        glUniform3f(vecLoc, vector.x, vector.y, vector.z);
+        glUniform3f(mUniforms.Get(uniformIndex).location, vector.x, vector.y, vector.z);
     }
 }
 
-void Shader::SetUniformVector4(const char *name, const Vector4& vector)
+void Shader::SetUniformVector4(int uniformIndex, const Vector4& vector)
 {
-    if(mProgram != GL_NONE)
+    GLfloat values[4] = { vector.x, vector.y, vector.z, vector.w };
+    if(mUniforms.ChangeValue(uniformIndex, values, 4))
     {
-        GLuint vecLoc = glGetUniformLocation(mProgram, name);
-        glUniform4f(vecLoc, vector.x, vector.y, vector.z, vector.w);
+        glUniform4f(mUniforms.Get(uniformIndex).location, vector.x, vector.y, vector.z, vector.w);
     }
 }
 
-void Shader::SetUniformMatrix4(const char* name, const Matrix4& mat)
+void Shader::SetUniformMatrix4(int uniformIndex, const Matrix4& mat)
 {
-    if(mProgram != GL_NONE)
-    {
-        GLuint loc = glGetUniformLocation(mProgram, name);
-        glUniformMatrix4fv(loc, 1, GL_FALSE, mat);
-    }
+    if(uniformIndex < 0) { return; }
+    glUniformMatrix4fv(mUniforms.Get(uniformIndex).location, 1, GL_FALSE, mat);
 }
 
-void Shader::SetUniformColor(const char* name, const Color32& color)
+void Shader::SetUniformColor(int uniformIndex, const Color32& color)
 {
-    if(mProgram != GL_NONE)
+    GLfloat values[4] = { color.GetR() / 255.0f, color.GetG() / 255.0f, color.GetB() / 255.0f, color.GetA() / 255.0f };
+    if(mUniforms.ChangeValue(uniformIndex, values, 4))
     {
-        GLuint vecLoc = glGetUniformLocation(mProgram, name);
-        glUniform4f(vecLoc, color.GetR() / 255.0f, color.GetG() / 255.0f, color.GetB() / 255.0f, color.GetA() / 255.0f);
+        glUniform4f(mUniforms.Get(uniformIndex).location, values[0], values[1], values[2], values[3]);
     }
 }
 
@@ -204,89 +221,29 @@ bool Shader::IsProgramLinked(GLuint program)
     return true;
 }
 
-/*
 void Shader::RefreshUniforms()
 {
     // Save listing of uniforms used by this shader.
     const GLsizei kMaxUniformNameLength = 32;
     GLchar uniformNameBuffer[kMaxUniformNameLength];
     GLsizei uniformNameLength = 0;
-    GLsizei uniformSize = 0;
+    GLint uniformSize = 0;
     GLenum uniformType = GL_NONE;
     
     GLint uniformCount = 0;
     glGetProgramiv(mProgram, GL_ACTIVE_UNIFORMS, &uniformCount);
-    for(GLuint i = 0; i < uniformCount; ++i)
+    for(GLint i = 0; i < uniformCount; ++i)
     {
         glGetActiveUniform(mProgram, i, kMaxUniformNameLength, &uniformNameLength, &uniformSize, &uniformType, uniformNameBuffer);
         
         // If returned name length is 0, that means the uniform is not valid (compile/link failed?).
         if(uniformNameLength <= 0) { continue; }
         
-        // We only want to track user-defined uniforms.
-        // We want to ignore built-in OpenGL uniforms, which have "gl_" prefix.
-        // We want to ignore built-in G-Engine uniforms, which have a "g" prefix.
-        // So really, we can just ignore any uniform with a "g" prefix to cover both scenarios!
-        if(uniformNameLength > 0 && uniformNameBuffer[0] == 'g') { continue; }
-        printf("Uniform %d, Type %u, Name %s\n", i, uniformType, uniformNameBuffer);
-           
-        // Convert GLenum type to an actual enum type.
-        UniformType type = UniformType::Unknown;
-        switch(uniformType)
-        {
-        case GL_FLOAT:
-            type = UniformType::Float;
-            break;
-        case GL_INT:
-            type = UniformType::Int;
-            break;
-        case GL_UNSIGNED_INT:
-            type = UniformType::Uint;
-            break;
-        case GL_BOOL:
-            type = UniformType::Bool;
-            break;
-            
-        case GL_FLOAT_VEC2:
-            type = UniformType::Vector2;
-            break;
-        case GL_FLOAT_VEC3:
-            type = UniformType::Vector3;
-            break;
-        case GL_FLOAT_VEC4:
-            type = UniformType::Vector4;
-            break;
-            
-        case GL_FLOAT_MAT2:
-            type = UniformType::Matrix2;
-            break;
-        case GL_FLOAT_MAT3:
-            type = UniformType::Matrix3;
-            break;
-        case GL_FLOAT_MAT4:
-            type = UniformType::Matrix4;
-            break;
-            
-        case GL_SAMPLER_2D:
-            type = UniformType::Texture2D;
-            break;
-        case GL_SAMPLER_CUBE:
-            type = UniformType::TextureCube;
-            break;
-            
-        default:
-            std::cout << "Unknown uniform type in shader: " << uniformType << std::endl;
-            break;
-        }
+        // Uniforms in uniform blocks (and built-in OpenGL uniforms, with "gl_" prefix) have no location, and can't be set individually.
+        GLint location = glGetUniformLocation(mProgram, uniformNameBuffer);
+        if(location < 0) { continue; }
         
-        // Create and save uniform info.
-        if(type != UniformType::Unknown)
-        {
-            Uniform uniform;
-            uniform.type = type;
-            uniform.name = std::string(uniformNameBuffer);
-            mUniforms.push_back(uniform);
-        }
+        // Save uniform info.
+        mUniforms.Add(uniformNameBuffer, ShaderUniforms::GetUniformType(uniformType), location);
     }
 }
-*/
@@ -6,76 +6,68 @@
 // A compiled and linked shader program.
 //
 #pragma once
-#include <string>
-#include <vector>
-
 #include <GL/glew.h>
 
+#include "ShaderUniforms.h"
+
 class Color32;
 class Matrix4;
 class Vector3;
 class Vector4;
 
-enum class UniformType
-{
-    Unknown,
-    
-    Float,
-    Int,
-    Uint,
-    Bool,
-    
-    Vector2,
-    Vector3,
-    Vector4,
-    
-    Matrix2,
-    Matrix3,
-    Matrix4,
-    
-    Texture2D,
-    TextureCube
-    //TODO: Add more as needed
-};
-
-struct Uniform
-{
-    // Type of the uniform.
-    UniformType type = UniformType::Unknown;
-    
-    // Uniform name.
-    std::string name;
-};
-
 class Shader
 {
 public:
+    // Binding point of the "Camera" uniform block, in all shaders.
+    static const GLuint kCameraBlockBinding = 0;
+    
     Shader(const char* vertShaderPath, const char* fragShaderPath);
     ~Shader();
     
     void Activate();
     
-	void SetUniformInt(const char* name, int value);
-	void SetUniformFloat(const char* name, float value);
+    // Uniform locations are looked up once, after linking. Uniforms are referred to by index into that table.
+    // Returns -1 if the uniform doesn't exist (or isn't used by the shader). Setting uniform -1 does nothing.
+    int GetUniformIndex(const char* name) const { return mUniforms.GetIndex(name); }
+    int GetUniformIndex(BuiltInUniform builtIn) const { return mUniforms.GetIndex(builtIn); }
+    
+	void SetUniformInt(int uniformIndex, int value);
+	void SetUniformFloat(int uniformIndex, float value);
+	
+    void SetUniformVector3(int uniformIndex, const Vector3& vector);
+	void SetUniformVector4(int uniformIndex, const Vector4& vector);
+    
+    void SetUniformMatrix4(int uniformIndex, const Matrix4& mat);
+    
+    void SetUniformColor(int uniformIndex, const Color32& color);
+    
+    // Convenience versions for uniforms that are rarely set.
+	void SetUniformInt(const char* name, int value) { SetUniformInt(GetUniformIndex(name), value); }
+	void SetUniformFloat(const char* name, float value) { SetUniformFloat(GetUniformIndex(name), value); }
 	
-    void SetUniformVector3(const char* name, const Vector3& vector);
-	void SetUniformVector4(const char* name, const Vector4& vector);
+    void SetUniformVector3(const char* name, const Vector3& vector) { SetUniformVector3(GetUniformIndex(name), vector); }
+	void SetUniformVector4(const char* name, const Vector4& vector) { SetUniformVector4(GetUniformIndex(name), vector); }
     
-    void SetUniformMatrix4(const char* name, const Matrix4& mat);
+    void SetUniformMatrix4(const char* name, const Matrix4& mat) { SetUniformMatrix4(GetUniformIndex(name), mat); }
     
-    void SetUniformColor(const char* name, const Color32& color);
+    void SetUniformColor(const char* name, const Color32& color) { SetUniformColor(GetUniformIndex(name), color); }
     
-    bool IsGood() const { return mProgram != GL_NONE; }
+    bool IsGood() const;
     
 private:
+    // The program currently in use, so activating it again can be skipped.
+    static GLuint sActiveProgram;
+    
     // Handle to the compiled and linked GL shader program.
     GLuint mProgram = GL_NONE;
     
-    // Uniforms for this shader, excluding "built-in" ones.
-    //std::vector<Uniform> mUniforms;
+    // Active uniforms in this shader, with their locations and last set values.
+    ShaderUniforms mUniforms;
     
     GLuint LoadAndCompileShaderFromFile(const char* filePath, GLuint shaderType);
     
     bool IsShaderCompiled(GLuint shader);
     bool IsProgramLinked(GLuint program);
+    
+    void RefreshUniforms();
 };
@@ -0,0 +1,125 @@
+//
+// ShaderUniforms.cpp
+//
+// Clark Kromenaker
+//
+#include "ShaderUniforms.h"
+
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+    const char* kBuiltInUniformNames[] = {
+        "gObjectToWorldMatrix",
+        "gAlphaTest",
+        "gMorphWeight"
+    };
+}
+
+/*static*/ UniformType ShaderUniforms::GetUniformType(GLenum glType)
+{
+    switch(glType)
+    {
+    case GL_FLOAT:
+        return UniformType::Float;
+    case GL_INT:
+        return UniformType::Int;
+    case GL_UNSIGNED_INT:
+        return UniformType::Uint;
+    case GL_BOOL:
+        return UniformType::Bool;
+        
+    case GL_FLOAT_VEC2:
+        return UniformType::Vector2;
+    case GL_FLOAT_VEC3:
+        return UniformType::Vector3;
+    case GL_FLOAT_VEC4:
+        return UniformType::Vector4;
+        
+    case GL_FLOAT_MAT2:
+        return UniformType::Matrix2;
+    case GL_FLOAT_MAT3:
+        return UniformType::Matrix3;
+    case GL_FLOAT_MAT4:
+        return UniformType::Matrix4;
+        
+    case GL_SAMPLER_2D:
+        return UniformType::Texture2D;
+    case GL_SAMPLER_CUBE:
+        return UniformType::TextureCube;
+        
+    default:
+        std::cout << "Unknown uniform type in shader: " << glType << std::endl;
+        return UniformType::Unknown;
+    }
+}
+
+ShaderUniforms::ShaderUniforms()
+{
+    for(int& index : mBuiltInIndexes)
+    {
+        index = -1;
+    }
+}
+
+void ShaderUniforms::Add(const std::string& name, UniformType type, GLint location)
+{
+    Uniform uniform;
+    uniform.type = type;
+    uniform.name = name;
+    uniform.location = location;
+    mUniforms.push_back(uniform);
+    
+    // Remember where built-in uniforms are, since they're set for every draw.
+    int index = static_cast<int>(mUniforms.size()) - 1;
+    for(int i = 0; i < static_cast<int>(BuiltInUniform::Count); ++i)
+    {
+        if(name == kBuiltInUniformNames[i])
+        {
+            mBuiltInIndexes[i] = index;
+        }
+    }
+}
+
+int ShaderUniforms::GetIndex(const char* name) const
+{
+    // Shaders have few uniforms, so a linear search is fine.
+    for(size_t i = 0; i < mUniforms.size(); ++i)
+    {
+        if(std::strcmp(mUniforms[i].name.c_str(), name) == 0)
+        {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+bool ShaderUniforms::ChangeValue(int index, GLint value)
+{
+    if(index < 0) { return false; }
+    
+    Uniform& uniform = mUniforms[index];
+    if(uniform.hasValue && uniform.intValue == value)
+    {
+        return false;
+    }
+    uniform.intValue = value;
+    uniform.hasValue = true;
+    return true;
+}
+
+bool ShaderUniforms::ChangeValue(int index, const GLfloat* values, int count)
+{
+    if(index < 0) { return false; }
+    
+    // If the uniform already has this value, no need to set it again.
+    Uniform& uniform = mUniforms[index];
+    if(uniform.hasValue && std::memcmp(uniform.floatValues, values, count * sizeof(GLfloat)) == 0)
+    {
+        return false;
+    }
+    std::memcpy(uniform.floatValues, values, count * sizeof(GLfloat));
+    uniform.hasValue = true;
+    return true;
+}
@@ -0,0 +1,92 @@
+//
+// ShaderUniforms.h
+//
+// Clark Kromenaker
+//
+// The uniforms of a shader program, with their locations and last set values.
+// Doesn't call GL itself; the shader asks whether a value changed before setting it.
+//
+#pragma once
+#include <string>
+#include <vector>
+
+#include <GL/glew.h>
+
+enum class UniformType
+{
+    Unknown,
+    
+    Float,
+    Int,
+    Uint,
+    Bool,
+    
+    Vector2,
+    Vector3,
+    Vector4,
+    
+    Matrix2,
+    Matrix3,
+    Matrix4,
+    
+    Texture2D,
+    TextureCube
+    //TODO: Add more as needed
+};
+
+struct Uniform
+{
+    // Type of the uniform.
+    UniformType type = UniformType::Unknown;
+    
+    // Uniform name.
+    std::string name;
+    
+    // Location of the uniform in the shader program.
+    GLint location = -1;
+    
+    // The last value set, so setting the same value again can be skipped.
+    // Matrices aren't remembered; they rarely stay the same between draws.
+    bool hasValue = false;
+    GLint intValue = 0;
+    GLfloat floatValues[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+};
+
+// Uniforms that the engine sets for every shader, when present.
+// Camera matrices (gViewMatrix, gProjMatrix, gWorldToProjMatrix) aren't here - they're in the "Camera" uniform block.
+enum class BuiltInUniform
+{
+    ObjectToWorldMatrix,    // gObjectToWorldMatrix
+    AlphaTest,              // gAlphaTest
+    MorphWeight,            // gMorphWeight
+    Count
+};
+
+class ShaderUniforms
+{
+public:
+    static UniformType GetUniformType(GLenum glType);
+    
+    ShaderUniforms();
+    
+    void Add(const std::string& name, UniformType type, GLint location);
+    int GetCount() const { return static_cast<int>(mUniforms.size()); }
+    
+    // Returns -1 if there's no uniform with the name.
+    int GetIndex(const char* name) const;
+    int GetIndex(BuiltInUniform builtIn) const { return mBuiltInIndexes[static_cast<int>(builtIn)]; }
+    
+    const Uniform& Get(int index) const { return mUniforms[index]; }
+    
+    // Remembers the value for the uniform, returning true if it's different from the last value (and so must be set in GL).
+    // Always false for index -1.
+    bool ChangeValue(int index, GLint value);
+    bool ChangeValue(int index, const GLfloat* values, int count);
+    
+private:
+    // Active uniforms in the shader, with their locations.
+    std::vector<Uniform> mUniforms;
+    
+    // Indexes of built-in uniforms in the uniforms list.
+    int mBuiltInIndexes[static_cast<int>(BuiltInUniform::Count)];
+};
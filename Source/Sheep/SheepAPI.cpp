@@ -63,8 +63,8 @@ size_t CalcHashForSysFunc(const SysImport& sysImport)
 }
 
 // A list of every defined system function. Add to this by calling AddSysFuncDecl.
-// Functions are added by using RegFuncX macros, which in turn call AddSysFuncDecl and put function pointers into call maps.
-void AddSysFuncDecl(const std::string& name, char retType, std::initializer_list<char> argTypes, bool waitable, bool dev)
+// Functions are added by using RegFuncX macros, which in turn call AddSysFuncDecl with a pointer to a function that calls the actual function.
+void AddSysFuncDecl(const std::string& name, char retType, std::initializer_list<char> argTypes, bool waitable, bool dev, SysFuncCaller caller)
 {
 	SysFuncDecl sysFunc;
 	sysFunc.name = name;
@@ -75,6 +75,7 @@ void AddSysFuncDecl(const std::string& name, char retType, std::initializer_list
 	}
 	sysFunc.waitable = waitable;
 	sysFunc.devOnly = dev;
+	sysFunc.caller = caller;
 	
 	sysFuncs.push_back(sysFunc);
 	
@@ -105,126 +106,6 @@ SysFuncDecl* GetSysFuncDecl(const SysImport* sysImport)
 	return nullptr;
 }
 
-// Maps from function name to a function pointer.
-// Each map is for a different number of arguments (0-8).
-std::map<std::string, Value (*)(const Value&)> map0;
-std::map<std::string, Value (*)(const Value&)> map1;
-std::map<std::string, Value (*)(const Value&, const Value&)> map2;
-std::map<std::string, Value (*)(const Value&, const Value&, const Value&)> map3;
-std::map<std::string, Value (*)(const Value&, const Value&, const Value&,
-                                const Value&)> map4;
-std::map<std::string, Value (*)(const Value&, const Value&, const Value&,
-                                const Value&, const Value&)> map5;
-std::map<std::string, Value (*)(const Value&, const Value&, const Value&,
-                                const Value&, const Value&, const Value&)> map6;
-std::map<std::string, Value (*)(const Value&, const Value&, const Value&,
-                                const Value&, const Value&, const Value&,
-                                const Value&)> map7;
-std::map<std::string, Value (*)(const Value&, const Value&, const Value&,
-                                const Value&, const Value&, const Value&,
-                                const Value&, const Value&)> map8;
-
-Value CallSysFunc(const std::string& name)
-{
-	auto it = map0.find(name);
-	if(it != map0.end())
-	{
-		return it->second(0);
-	}
-	else
-	{
-		std::cout << "Couldn't find SysFunc0 " << name << std::endl;
-		return Value(0);
-	}
-}
-
-Value CallSysFunc(const std::string& name, const Value& x1)
-{
-	auto it = map1.find(name);
-	if(it != map1.end())
-	{
-		return it->second(x1);
-	}
-	else
-	{
-		std::cout << "Couldn't find SysFunc1 " << name << std::endl;
-		return Value(0);
-	}
-}
-
-Value CallSysFunc(const std::string& name, const Value& x1, const Value& x2)
-{
-	auto it = map2.find(name);
-	if(it != map2.end())
-	{
-		return it->second(x1, x2);
-	}
-	else
-	{
-		std::cout << "Couldn't find SysFunc2 " << name << std::endl;
-		return Value(0);
-	}
-}
-
-Value CallSysFunc(const std::string& name, const Value& x1, const Value& x2, const Value& x3)
-{
-	auto it = map3.find(name);
-	if(it != map3.end())
-	{
-		return it->second(x1, x2, x3);
-	}
-	else
-	{
-		std::cout << "Couldn't find SysFunc3 " << name << std::endl;
-		return Value(0);
-	}
-}
-
-Value CallSysFunc(const std::string& name, const Value& x1, const Value& x2, const Value& x3,
-                  const Value& x4)
-{
-	auto it = map4.find(name);
-	if(it != map4.end())
-	{
-		return it->second(x1, x2, x3, x4);
-	}
-	else
-	{
-		std::cout << "Couldn't find SysFunc4 " << name << std::endl;
-		return Value(0);
-	}
-}
-
-Value CallSysFunc(const std::string& name, const Value& x1, const Value& x2, const Value& x3,
-                  const Value& x4, const Value& x5)
-{
-	auto it = map5.find(name);
-	if(it != map5.end())
-	{
-		return it->second(x1, x2, x3, x4, x5);
-	}
-	else
-	{
-		std::cout << "Couldn't find SysFunc5 " << name << std::endl;
-		return Value(0);
-	}
-}
-
-Value CallSysFunc(const std::string& name, const Value& x1, const Value& x2, const Value& x3,
-                  const Value& x4, const Value& x5, const Value& x6)
-{
-	auto it = map6.find(name);
-	if(it != map6.end())
-	{
-		return it->second(x1, x2, x3, x4, x5, x6);
-	}
-	else
-	{
-		std::cout << "Couldn't find SysFunc6 " << name << std::endl;
-		return Value(0);
-	}
-}
-
 // Helper for reporting back to Sheep VM that an error occurred.
 void ExecError()
 {
@@ -232,7 +113,7 @@ void ExecError()
 }
 
 // ACTORS
-shpvoid Blink(std::string actorName)
+shpvoid Blink(const std::string& actorName)
 {
 	GKActor* actor = GEngine::Instance()->GetScene()->GetActorByNoun(actorName);
 	if(actor != nullptr)
@@ -247,7 +128,7 @@ shpvoid Blink(std::string actorName)
 }
 RegFunc1(Blink, void, string, IMMEDIATE, REL_FUNC);
 
-shpvoid BlinkX(std::string actorName, std::string blinkAnim)
+shpvoid BlinkX(const std::string& actorName, const std::string& blinkAnim)
 {
 	GKActor* actor = GEngine::Instance()->GetScene()->GetActorByNoun(actorName);
 	if(actor != nullptr)
@@ -262,7 +143,7 @@ shpvoid BlinkX(std::string actorName, std::string blinkAnim)
 }
 RegFunc2(BlinkX, void, string, string, IMMEDIATE, REL_FUNC);
 
-shpvoid ClearMood(std::string actorName)
+shpvoid ClearMood(const std::string& actorName)
 {
 	// Get actor and make sure it's valid.
 	GKActor* actor = GEngine::Instance()->GetScene()->GetActorByNoun(actorName);
@@ -278,7 +159,7 @@ shpvoid ClearMood(std::string actorName)
 }
 RegFunc1(ClearMood, void, string, IMMEDIATE, REL_FUNC);
 
-shpvoid EnableEyeJitter(std::string actorName)
+shpvoid EnableEyeJitter(const std::string& actorName)
 {
 	GKActor* actor = GEngine::Instance()->GetScene()->GetActorByNoun(actorName);
 	if(actor != nullptr)
@@ -293,7 +174,7 @@ shpvoid EnableEyeJitter(std::string actorName)
 }
 RegFunc1(EnableEyeJitter, void, string, IMMEDIATE, REL_FUNC);
 
-shpvoid DisableEyeJitter(std::string actorName)
+shpvoid DisableEyeJitter(const std::string& actorName)
 {
 	GKActor* actor = GEngine::Instance()->GetScene()->GetActorByNoun(actorName);
 	if(actor != nullptr)
@@ -308,7 +189,7 @@ shpvoid DisableEyeJitter(std::string actorName)
 }
 RegFunc1(DisableEyeJitter, void, string, IMMEDIATE, REL_FUNC);
 
-shpvoid EyeJitter(std::string actorName)
+shpvoid EyeJitter(const std::string& actorName)
 {
 	GKActor* actor = GEngine::Instance()->GetScene()->GetActorByNoun(actorName);
 	if(actor != nullptr)
@@ -323,7 +204,7 @@ shpvoid EyeJitter(std::string actorName)
 }
 RegFunc1(EyeJitter, void, string, IMMEDIATE, REL_FUNC);
 
-shpvoid DumpActorPosition(std::string actorName)
+shpvoid DumpActorPosition(const std::string& actorName)
 {
 	GKActor* actor = GEngine::Instance()->GetScene()->GetActorByNoun(actorName);
 	if(actor != nullptr)
@@ -338,7 +219,7 @@ shpvoid DumpActorPosition(std::string actorName)
 }
 RegFunc1(DumpActorPosition, void, string, IMMEDIATE, DEV_FUNC);
 
-shpvoid Expression(std::string actorName, std::string expression)
+shpvoid Expression(const std::string& actorName, const std::string& expression)
 {
 	GKActor* actor = GEngine::Instance()->GetScene()->GetActorByNoun(actorName);
 	if(actor != nullptr)
@@ -359,7 +240,7 @@ int GetEgoCurrentLocationCount()
 }
 RegFunc0(GetEgoCurrentLocationCount, int, IMMEDIATE, REL_FUNC);
 
-int GetEgoLocationCount(std::string locationName)
+int GetEgoLocationCount(const std::string& locationName)
 {
 	// Make sure it's a valid location.
 	if(!Services::Get<LocationManager>()->IsValidLocation(locationName))
@@ -395,19 +276,19 @@ int GetPositionCount()
 }
 RegFunc0(GetPositionCount, int, IMMEDIATE, DEV_FUNC);
 
-shpvoid Glance(std::string actorName, int percentX, int percentY, int durationMs)
+shpvoid Glance(const std::string& actorName, int percentX, int percentY, int durationMs)
 {
     return 0;
 }
 
-shpvoid GlanceX(std::string actorName, int leftPercentX, int leftPercentY,
+shpvoid GlanceX(const std::string& actorName, int leftPercentX, int leftPercentY,
                 int rightPercentX, int rightPercentY, int durationMs)
 {
     return 0;
 }
 */
 
-shpvoid InitEgoPosition(std::string positionName)
+shpvoid InitEgoPosition(const std::string& positionName)
 {
     if(!GEngine::Instance()->GetScene()->InitEgoPosition(positionName))
 	{
@@ -417,7 +298,7 @@ shpvoid InitEgoPosition(std::string positionName)
 }
 RegFunc1(InitEgoPosition, void, string, IMMEDIATE, REL_FUNC);
 
-int IsActorAtLocation(std::string actorName, std::string locationName)
+int IsActorAtLocation(const std::string& actorName, const std::string& locationName)
 {
 	// Validate actor name.
 	if(!Services::Get<CharacterManager>()->IsValidName(actorName))
@@ -440,7 +321,7 @@ int IsActorAtLocation(std::string actorName, std::string locationName)
 }
 RegFunc2(IsActorAtLocation, int, string, string, IMMEDIATE, REL_FUNC);
 
-int IsActorNear(std::string actorName, std::string positionName, float distance)
+int IsActorNear(const std::string& actorName, const std::string& positionName, float distance)
 {
 	// Make sure distance is valid.
 	if(distance < 0.0f)
@@ -468,7 +349,7 @@ int IsActorNear(std::string actorName, std::string positionName, float distance)
 }
 RegFunc3(IsActorNear, int, string, string, float, IMMEDIATE, REL_FUNC);
 
-int IsWalkingActorNear(std::string actorName, std::string positionName, float distance)
+int IsWalkingActorNear(const std::string& actorName, const std::string& positionName, float distance)
 {
 	// Make sure distance is valid.
 	if(distance < 0.0f)
@@ -495,7 +376,7 @@ int IsWalkingActorNear(std::string actorName, std::string positionName, float di
 }
 RegFunc3(IsWalkingActorNear, int, string, string, float, IMMEDIATE, REL_FUNC);
  
-int IsActorOffstage(std::string actorName)
+int IsActorOffstage(const std::string& actorName)
 {
 	// Validate actor name.
 	if(!Services::Get<CharacterManager>()->IsValidName(actorName))
@@ -508,7 +389,7 @@ int IsActorOffstage(std::string actorName)
 }
 RegFunc1(IsActorOffstage, int, string, IMMEDIATE, REL_FUNC);
 
-int IsCurrentEgo(string actorName)
+int IsCurrentEgo(const std::string& actorName)
 {
 	const std::string& egoName = GEngine::Instance()->GetScene()->GetEgoName();
 	return StringUtil::EqualsIgnoreCase(egoName, actorName) ? 1 : 0;
@@ -516,35 +397,35 @@ int IsCurrentEgo(string actorName)
 RegFunc1(IsCurrentEgo, int, string, IMMEDIATE, REL_FUNC);
 
 /*
-shpvoid LookitActor(std::string actorName, std::string otherActorName,
+shpvoid LookitActor(const std::string& actorName, const std::string& otherActorName,
 					 std::string componentsSpec, float durationSec)
 {
 	return 0;
 }
 RegFunc4(LookitActor, void, string, string, string, float, IMMEDIATE, REL_FUNC);
 
-shpvoid LookitActorQuick(std::string actorName, std::string otherActorName,
+shpvoid LookitActorQuick(const std::string& actorName, const std::string& otherActorName,
 						 std::string componentsSpec, float durationSec)
 {
 	return 0;
 }
 RegFunc4(LookitActorQuick, void, string, string, string, float, IMMEDIATE, REL_FUNC);
 
-shpvoid LookitModel(std::string actorName, std::string modelName,
+shpvoid LookitModel(const std::string& actorName, const std::string& modelName,
 					std::string componentsSpec, float durationSec)
 {
 	return 0;
 }
 RegFunc4(LookitModel, void, string, string, string, float, IMMEDIATE, REL_FUNC);
 
-shpvoid LookitModelQuick(std::string actorName, std::string modelName,
+shpvoid LookitModelQuick(const std::string& actorName, const std::string& modelName,
 						 std::string componentsSpec, float durationSec)
 {
 	return 0;
 }
 RegFunc4(LookitModelQuick, void, string, string, string, float, IMMEDIATE, REL_FUNC);
 
-shpvoid LookitModelX(std::string actorName, std::string modelName, int mesh,
+shpvoid LookitModelX(const std::string& actorName, const std::string& modelName, int mesh,
 					 std::string boxModifier, float offsetX, float offsetY, float offsetZ,
 					 std::string componentsSpec, float durationSec)
 {
@@ -569,7 +450,7 @@ shpvoid LookitModelX(std::string actorName, std::string modelName, int mesh,
 //LookitCancel
 */
 
-shpvoid SetActorLocation(string actorName, string locationName)
+shpvoid SetActorLocation(const std::string& actorName, const std::string& locationName)
 {
 	// Validate actor name.
 	if(!Services::Get<CharacterManager>()->IsValidName(actorName))
@@ -591,7 +472,7 @@ shpvoid SetActorLocation(string actorName, string locationName)
 }
 RegFunc2(SetActorLocation, void, string, string, IMMEDIATE, REL_FUNC);
 
-shpvoid SetActorOffstage(string actorName)
+shpvoid SetActorOffstage(const std::string& actorName)
 {
 	// Validate actor name.
 	if(!Services::Get<CharacterManager>()->IsValidName(actorName))
@@ -605,7 +486,7 @@ shpvoid SetActorOffstage(string actorName)
 }
 RegFunc1(SetActorOffstage, void, string, IMMEDIATE, REL_FUNC);
 
-shpvoid SetActorPosition(std::string actorName, std::string positionName)
+shpvoid SetActorPosition(const std::string& actorName, const std::string& positionName)
 {
 	// Get needed data.
 	GKActor* actor = GEngine::Instance()->GetScene()->GetActorByNoun(actorName);
@@ -629,7 +510,7 @@ RegFunc2(SetActorPosition, void, string, string, IMMEDIATE, REL_FUNC);
 
 // SetEgo
 
-shpvoid SetEgoLocationCount(std::string locationName, int count)
+shpvoid SetEgoLocationCount(const std::string& locationName, int count)
 {
 	// Make sure it's a valid location.
 	if(!Services::Get<LocationManager>()->IsValidLocation(locationName))
@@ -645,7 +526,7 @@ shpvoid SetEgoLocationCount(std::string locationName, int count)
 }
 RegFunc2(SetEgoLocationCount, void, string, int, IMMEDIATE, DEV_FUNC);
 
-shpvoid SetIdleGAS(std::string actorName, std::string gasName)
+shpvoid SetIdleGAS(const std::string& actorName, const std::string& gasName)
 {
 	// Get actor and make sure it's valid.
 	GKActor* actor = GEngine::Instance()->GetScene()->GetActorByNoun(actorName);
@@ -674,7 +555,7 @@ shpvoid SetIdleGAS(std::string actorName, std::string gasName)
 }
 RegFunc2(SetIdleGAS, void, string, string, WAITABLE, REL_FUNC);
 
-shpvoid SetListenGAS(std::string actorName, std::string gasName)
+shpvoid SetListenGAS(const std::string& actorName, const std::string& gasName)
 {
 	// Get actor and make sure it's valid.
 	GKActor* actor = GEngine::Instance()->GetScene()->GetActorByNoun(actorName);
@@ -703,7 +584,7 @@ shpvoid SetListenGAS(std::string actorName, std::string gasName)
 }
 RegFunc2(SetListenGAS, void, string, string, WAITABLE, REL_FUNC);
 
-shpvoid SetTalkGAS(std::string actorName, std::string gasName)
+shpvoid SetTalkGAS(const std::string& actorName, const std::string& gasName)
 {
 	// Get actor and make sure it's valid.
 	GKActor* actor = GEngine::Instance()->GetScene()->GetActorByNoun(actorName);
@@ -732,7 +613,7 @@ shpvoid SetTalkGAS(std::string actorName, std::string gasName)
 }
 RegFunc2(SetTalkGAS, void, string, string, WAITABLE, REL_FUNC);
 
-shpvoid SetMood(std::string actorName, std::string moodName)
+shpvoid SetMood(const std::string& actorName, const std::string& moodName)
 {
 	// Get actor and make sure it's valid.
 	GKActor* actor = GEngine::Instance()->GetScene()->GetActorByNoun(actorName);
@@ -754,8 +635,8 @@ RegFunc2(SetMood, void, string, string, IMMEDIATE, REL_FUNC);
 
 //SetPrevEgo
 
-shpvoid SetWalkAnim(std::string actorName, std::string start, std::string cont,
-					std::string startTurnLeft, std::string startTurnRight)
+shpvoid SetWalkAnim(const std::string& actorName, const std::string& start, const std::string& cont,
+					std::string startTurnLeft, const std::string& startTurnRight)
 {
 	std::cout << "SetWalkAnim" << std::endl;
 	return 0;
@@ -763,7 +644,7 @@ shpvoid SetWalkAnim(std::string actorName, std::string start, std::string cont,
 RegFunc5(SetWalkAnim, void, string, string, string, string, string, IMMEDIATE, REL_FUNC);
 */
  
-shpvoid StartIdleFidget(std::string actorName)
+shpvoid StartIdleFidget(const std::string& actorName)
 {
 	GKActor* actor = GEngine::Instance()->GetScene()->GetActorByNoun(actorName);
 	if(actor != nullptr)
@@ -774,7 +655,7 @@ shpvoid StartIdleFidget(std::string actorName)
 }
 RegFunc1(StartIdleFidget, void, string, WAITABLE, REL_FUNC);
 
-shpvoid StartListenFidget(std::string actorName)
+shpvoid StartListenFidget(const std::string& actorName)
 {
 	GKActor* actor = GEngine::Instance()->GetScene()->GetActorByNoun(actorName);
 	if(actor != nullptr)
@@ -785,7 +666,7 @@ shpvoid StartListenFidget(std::string actorName)
 }
 RegFunc1(StartListenFidget, void, string, WAITABLE, REL_FUNC);
 
-shpvoid StartTalkFidget(std::string actorName) // WAIT
+shpvoid StartTalkFidget(const std::string& actorName) // WAIT
 {
 	GKActor* actor = GEngine::Instance()->GetScene()->GetActorByNoun(actorName);
 	if(actor != nullptr)
@@ -796,7 +677,7 @@ shpvoid StartTalkFidget(std::string actorName) // WAIT
 }
 RegFunc1(StartTalkFidget, void, string, WAITABLE, REL_FUNC);
 
-shpvoid StopFidget(std::string actorName)
+shpvoid StopFidget(const std::string& actorName)
 {
 	//TODO: Should be waitable for complex fidgets.
 	Scene* scene = GEngine::Instance()->GetScene();
@@ -813,14 +694,14 @@ shpvoid StopFidget(std::string actorName)
 RegFunc1(StopFidget, void, string, WAITABLE, REL_FUNC);
  
 /*
-shpvoid TurnHead(std::string actorName, int percentX, int percentY, int durationMs)
+shpvoid TurnHead(const std::string& actorName, int percentX, int percentY, int durationMs)
 {
 	std::cout << "TurnHead" << std::endl;
 	return 0;
 }
 RegFunc4(TurnHead, void, string, int, int, int, WAITABLE, REL_FUNC);
 
-shpvoid TurnToModel(std::string actorName, std::string modelName)
+shpvoid TurnToModel(const std::string& actorName, const std::string& modelName)
 {
 	std::cout << "TurnToModel" << std::endl;
 	return 0;
@@ -828,7 +709,7 @@ shpvoid TurnToModel(std::string actorName, std::string modelName)
 RegFunc2(TurnToModel, void, string, string, WAITABLE, REL_FUNC);
 */
  
-shpvoid WalkerBoundaryBlockModel(std::string modelName)
+shpvoid WalkerBoundaryBlockModel(const std::string& modelName)
 {
 	std::cout << "WalkerBoundaryBlockModel" << std::endl;
 	return 0;
@@ -844,7 +725,7 @@ shpvoid WalkerBoundaryBlockRegion(int regionIndex, int regionBoundaryIndex)
 RegFunc2(WalkerBoundaryBlockRegion, void, int, int, IMMEDIATE, REL_FUNC);
 */
  
-shpvoid WalkerBoundaryUnblockModel(std::string modelName)
+shpvoid WalkerBoundaryUnblockModel(const std::string& modelName)
 {
 	std::cout << "WalkerBoundaryUnblockModel" << std::endl;
 	return 0;
@@ -859,35 +740,35 @@ shpvoid WalkerBoundaryUnblockRegion(int regionIndex, int regionBoundaryIndex)
 }
 RegFunc2(WalkerBoundaryUnblockRegion, void, int, int, IMMEDIATE, REL_FUNC);
 
-shpvoid WalkNear(std::string actorName, std::string positionName)
+shpvoid WalkNear(const std::string& actorName, const std::string& positionName)
 {
 	std::cout << "WalkNear" << std::endl;
 	return 0;
 }
 RegFunc2(WalkNear, void, string, string, WAITABLE, REL_FUNC);
 
-shpvoid WalkNearModel(std::string actorName, std::string modelName)
+shpvoid WalkNearModel(const std::string& actorName, const std::string& modelName)
 {
 	std::cout << "WalkNearModel" << std::endl;
 	return 0;
 }
 RegFunc2(WalkNearModel, void, string, string, WAITABLE, REL_FUNC);
 
-shpvoid WalkTo(std::string actorName, std::string positionName)
+shpvoid WalkTo(const std::string& actorName, const std::string& positionName)
 {
 	std::cout << "WalkTo" << std::endl;
 	return 0;
 }
 RegFunc2(WalkTo, void, string, string, WAITABLE, REL_FUNC);
 
-shpvoid WalkToAnimation(std::string actorName, std::string animationName)
+shpvoid WalkToAnimation(const std::string& actorName, const std::string& animationName)
 {
 	std::cout << "WalkToAnimation" << std::endl;
 	return 0;
 }
 RegFunc2(WalkToAnimation, void, string, string, WAITABLE, REL_FUNC);
 
-shpvoid WalkToSeeModel(std::string actorName, std::string modelName)
+shpvoid WalkToSeeModel(const std::string& actorName, const std::string& modelName)
 {
 	std::cout << "WalkToSeeModel" << std::endl;
 	return 0;
@@ -897,7 +778,7 @@ RegFunc2(WalkToSeeModel, void, string, string, WAITABLE, REL_FUNC);
 //WalkToXZ
 */
  
-int WasEgoEverInLocation(string locationName)
+int WasEgoEverInLocation(const std::string& locationName)
 {
 	// Make sure it's a valid location.
 	if(!Services::Get<LocationManager>()->IsValidLocation(locationName))
@@ -928,7 +809,7 @@ RegFunc1(WasEgoEverInLocation, int, string, IMMEDIATE, REL_FUNC);
 
 //AnimEvent
 
-shpvoid StartDialogue(std::string licensePlate, int numLines)
+shpvoid StartDialogue(const std::string& licensePlate, int numLines)
 {
 	SheepThread* currentThread = Services::GetSheep()->GetCurrentThread();
 	Services::Get<DialogueManager>()->StartDialogue(licensePlate, numLines, true, currentThread->AddWait());
@@ -936,7 +817,7 @@ shpvoid StartDialogue(std::string licensePlate, int numLines)
 }
 RegFunc2(StartDialogue, void, string, int, WAITABLE, REL_FUNC);
 
-shpvoid StartDialogueNoFidgets(std::string licensePlate, int numLines)
+shpvoid StartDialogueNoFidgets(const std::string& licensePlate, int numLines)
 {
 	SheepThread* currentThread = Services::GetSheep()->GetCurrentThread();
 	Services::Get<DialogueManager>()->StartDialogue(licensePlate, numLines, false, currentThread->AddWait());
@@ -966,7 +847,7 @@ RegFunc1(ContinueDialogueNoFidgets, void, int, WAITABLE, REL_FUNC);
 
 //DumpAnimator
 
-shpvoid SetConversation(std::string conversationName)
+shpvoid SetConversation(const std::string& conversationName)
 {
 	//TODO: Why is this waitable?
 	Services::Get<DialogueManager>()->SetConversation(conversationName);
@@ -982,13 +863,13 @@ shpvoid EndConversation()
 }
 RegFunc0(EndConversation, void, WAITABLE, REL_FUNC);
 
-shpvoid SetDefaultDialogueCamera(std::string cameraName)
+shpvoid SetDefaultDialogueCamera(const std::string& cameraName)
 {
 	return 0;
 }
 RegFunc1(SetDefaultDialogueCamera, void, string, IMMEDIATE, REL_FUNC);
  
-shpvoid StartAnimation(std::string animationName)
+shpvoid StartAnimation(const std::string& animationName)
 {
 	Animation* animation = Services::GetAssets()->LoadAnimation(animationName);
 	if(animation != nullptr)
@@ -1000,7 +881,7 @@ shpvoid StartAnimation(std::string animationName)
 }
 RegFunc1(StartAnimation, void, string, WAITABLE, REL_FUNC);
 
-shpvoid StartMoveAnimation(std::string animationName)
+shpvoid StartMoveAnimation(const std::string& animationName)
 {
 	Animation* animation = Services::GetAssets()->LoadAnimation(animationName);
 	if(animation != nullptr)
@@ -1013,7 +894,7 @@ shpvoid StartMoveAnimation(std::string animationName)
 RegFunc1(StartMoveAnimation, void, string, WAITABLE, REL_FUNC);
 
 /*
-shpvoid StartMom(std::string momAnimationName)
+shpvoid StartMom(const std::string& momAnimationName)
 {
 	std::cout << "StartMom" << std::endl;
 	return 0;
@@ -1021,7 +902,7 @@ shpvoid StartMom(std::string momAnimationName)
 RegFunc1(StartMom, void, string, WAITABLE, REL_FUNC);
 */
  
-shpvoid LoopAnimation(std::string animationName)
+shpvoid LoopAnimation(const std::string& animationName)
 {
 	Animation* animation = Services::GetAssets()->LoadAnimation(animationName);
 	if(animation != nullptr)
@@ -1032,7 +913,7 @@ shpvoid LoopAnimation(std::string animationName)
 }
 RegFunc1(LoopAnimation, void, string, IMMEDIATE, REL_FUNC);
 
-shpvoid StopAnimation(std::string animationName)
+shpvoid StopAnimation(const std::string& animationName)
 {
 	Animation* animation = Services::GetAssets()->LoadAnimation(animationName);
 	if(animation != nullptr)
@@ -1046,14 +927,14 @@ RegFunc1(StopAnimation, void, string, IMMEDIATE, REL_FUNC);
 //StopAllAnimations
 
 /*
-shpvoid StartMorphAnimation(std::string animationName, int animStartFrame, int morphFrames)
+shpvoid StartMorphAnimation(const std::string& animationName, int animStartFrame, int morphFrames)
 {
 	std::cout << "StartMorphAnimation" << std::endl;
 	return 0;
 }
 RegFunc3(StartMorphAnimation, void, string, int, int, WAITABLE, REL_FUNC);
 
-shpvoid StopMorphAnimation(std::string animationName)
+shpvoid StopMorphAnimation(const std::string& animationName)
 {
 	std::cout << "StopMorphAnimation" << std::endl;
 	return 0;
@@ -1063,7 +944,7 @@ RegFunc1(StopMorphAnimation, void, string, IMMEDIATE, REL_FUNC);
 //StopAllMorphAnimations
 */
  
-shpvoid StartVoiceOver(string dialogueName, int numLines)
+shpvoid StartVoiceOver(const std::string& dialogueName, int numLines)
 {
 	if(numLines > 1)
 	{
@@ -1078,7 +959,7 @@ shpvoid StartVoiceOver(string dialogueName, int numLines)
 }
 RegFunc2(StartVoiceOver, void, string, int, WAITABLE, REL_FUNC);
 
-shpvoid StartYak(string yakAnimationName)
+shpvoid StartYak(const std::string& yakAnimationName)
 {
 	Animation* yak = Services::GetAssets()->LoadYak(yakAnimationName);
 	SheepThread* currentThread = Services::GetSheep()->GetCurrentThread();
@@ -1088,7 +969,7 @@ shpvoid StartYak(string yakAnimationName)
 RegFunc1(StartYak, void, string, WAITABLE, DEV_FUNC);
 
 // APPLICATION
-shpvoid AddPath(std::string pathName)
+shpvoid AddPath(const std::string& pathName)
 {
 	Services::GetAssets()->AddSearchPath(pathName);
 	return 0;
@@ -1123,14 +1004,14 @@ shpvoid DumpLayerStack()
 }
 RegFunc0(DumpLayerStack, void, IMMEDIATE, DEV_FUNC);
 
-shpvoid Edit(std::string filename)
+shpvoid Edit(const std::string& filename)
 {
 	// Should open text editor defined in INI or default with file.
 	return 0;
 }
 RegFunc1(Edit, void, string, IMMEDIATE, DEV_FUNC);
 
-shpvoid Open(std::string filename)
+shpvoid Open(const std::string& filename)
 {
 	// Tells OS to open a particular file.
 	return 0;
@@ -1171,7 +1052,7 @@ shpvoid Screenshot()
 }
 RegFunc0(Screenshot, void, IMMEDIATE, REL_FUNC);
 
-shpvoid ScreenshotX(std::string filename)
+shpvoid ScreenshotX(const std::string& filename)
 {
 	return 0;
 }
@@ -1189,7 +1070,7 @@ shpvoid ShowDrivingInterface()
 }
 RegFunc0(ShowDrivingInterface, void, IMMEDIATE, REL_FUNC);
 
-shpvoid ShowFingerprintInterface(std::string nounName)
+shpvoid ShowFingerprintInterface(const std::string& nounName)
 {
 	return 0;
 }
@@ -1211,14 +1092,14 @@ RegFunc0(StartGame, void, IMMEDIATE, DEV_FUNC);
  
 // CAMERA
 /*
-shpvoid CameraBoundaryBlockModel(std::string modelName)
+shpvoid CameraBoundaryBlockModel(const std::string& modelName)
 {
 	std::cout << "CameraBoundaryBlockModel" << std::endl;
 	return 0;
 }
 RegFunc1(CameraBoundaryBlockModel, void, string, IMMEDIATE, REL_FUNC);
 
-shpvoid CameraBoundaryUnblockModel(std::string modelName)
+shpvoid CameraBoundaryUnblockModel(const std::string& modelName)
 {
 	std::cout << "CameraBoundaryUnblockModel" << std::endl;
 	return 0;
@@ -1226,7 +1107,7 @@ shpvoid CameraBoundaryUnblockModel(std::string modelName)
 RegFunc1(CameraBoundaryUnblockModel, void, string, IMMEDIATE, REL_FUNC);
 */
  
-shpvoid CutToCameraAngle(std::string cameraName)
+shpvoid CutToCameraAngle(const std::string& cameraName)
 {
 	GEngine::Instance()->GetScene()->SetCameraPosition(cameraName);
 	return 0;
@@ -1241,7 +1122,7 @@ shpvoid CutToCameraAngleX(float horizAngle, float vertAngle, float x, float y, f
 RegFunc5(CutToCameraAngleX, void, float, float, float, float, float, IMMEDIATE, DEV_FUNC);
 */
  
-shpvoid ForceCutToCameraAngle(std::string cameraName)
+shpvoid ForceCutToCameraAngle(const std::string& cameraName)
 {
 	GEngine::Instance()->GetScene()->SetCameraPosition(cameraName);
 	return 0;
@@ -1249,7 +1130,7 @@ shpvoid ForceCutToCameraAngle(std::string cameraName)
 RegFunc1(ForceCutToCameraAngle, void, string, IMMEDIATE, REL_FUNC);
 
 /*
-shpvoid DefaultInspect(std::string noun)
+shpvoid DefaultInspect(const std::string& noun)
 {
 	std::cout << "DefaultInspect" << std::endl;
 	return 0;
@@ -1289,7 +1170,7 @@ shpvoid SetCameraGlide(int glide)
 }
 RegFunc1(SetCameraGlide, void, int, IMMEDIATE, REL_FUNC);
 
-shpvoid GlideToCameraAngle(std::string cameraName)
+shpvoid GlideToCameraAngle(const std::string& cameraName)
 {
 	return 0;
 }
@@ -1409,7 +1290,31 @@ RegFunc1(SetCameraFOV, void, float, IMMEDIATE, REL_FUNC);
 //DumpDebugFlags
 //DumpFile
 //DumpLockedObjects
-//DumpMemoryUsage
+
+shpvoid DumpMemoryUsage()
+{
+	const AssetCache& assetCache = Services::GetAssets()->GetAssetCache();
+	const float kBytesPerMB = 1024.0f * 1024.0f;
+	
+	std::stringstream ss;
+	ss << "Asset memory usage: " << (assetCache.GetMemoryUsage() / kBytesPerMB) << "MB of "
+	   << (assetCache.GetMemoryBudget() / kBytesPerMB) << "MB budget ("
+	   << assetCache.GetCount() << " assets, " << assetCache.GetUnreferencedCount() << " unreferenced)";
+	Services::GetReports()->Log("Dump", ss.str());
+	
+	// Break down by asset type.
+	for(auto& entry : assetCache.GetMemoryUsageByType())
+	{
+		if(entry.second.count == 0) { continue; }
+		
+		ss.str("");
+		ss << "  " << entry.first << ": " << entry.second.count << " assets, " << (entry.second.memorySize / kBytesPerMB) << "MB";
+		Services::GetReports()->Log("Dump", ss.str());
+	}
+	return 0;
+}
+RegFunc0(DumpMemoryUsage, void, IMMEDIATE, DEV_FUNC);
+
 //DumpPathFileMap
 //DumpUsedPaths
 //DumpUsedFiles
@@ -1421,7 +1326,7 @@ RegFunc1(SetCameraFOV, void, float, IMMEDIATE, REL_FUNC);
 //SetTimeMultiplier
 
 // ENGINE
-shpvoid Call(std::string functionName)
+shpvoid Call(const std::string& functionName)
 {
 	SheepThread* currentThread = Services::GetSheep()->GetCurrentThread();
 	if(currentThread != nullptr && currentThread->mContext != nullptr)
@@ -1436,7 +1341,7 @@ shpvoid Call(std::string functionName)
 }
 RegFunc1(Call, void, string, WAITABLE, REL_FUNC);
 
-shpvoid CallDefaultSheep(string fileName)
+shpvoid CallDefaultSheep(const std::string& fileName)
 {
 	SheepScript* script = Services::GetAssets()->LoadSheep(fileName);
 	if(script != nullptr)
@@ -1448,30 +1353,32 @@ shpvoid CallDefaultSheep(string fileName)
 }
 RegFunc1(CallDefaultSheep, void, string, WAITABLE, REL_FUNC);
 
-shpvoid CallSheep(string fileName, string functionName)
+shpvoid CallSheep(const std::string& fileName, const std::string& functionName)
 {
 	// Make sure function name has the '$' suffix.
 	// Some GK3 data files do this, some don't!
-	if(functionName[functionName.size() - 1] != '$')
+	SheepThread* currentThread = Services::GetSheep()->GetCurrentThread();
+	if(!functionName.empty() && functionName.back() != '$')
 	{
-		functionName.append("$");
+		Services::GetSheep()->Execute(fileName, functionName + "$", currentThread != nullptr ? currentThread->AddWait() : nullptr);
+	}
+	else
+	{
+		Services::GetSheep()->Execute(fileName, functionName, currentThread != nullptr ? currentThread->AddWait() : nullptr);
 	}
-	
-	SheepThread* currentThread = Services::GetSheep()->GetCurrentThread();
-	Services::GetSheep()->Execute(fileName, functionName, currentThread != nullptr ? currentThread->AddWait() : nullptr);
     return 0;
 }
 RegFunc2(CallSheep, void, string, string, WAITABLE, REL_FUNC);
 
 /*
-shpvoid CallGlobal(std::string functionName)
+shpvoid CallGlobal(const std::string& functionName)
 {
 	std::cout << "CallGlobal" << std::endl;
 	return 0;
 }
 RegFunc1(CallGlobal, void, string, WAITABLE, REL_FUNC);
 
-shpvoid CallGlobalSheep(std::string sheepFileName, std::string functionName)
+shpvoid CallGlobalSheep(const std::string& sheepFileName, const std::string& functionName)
 {
 	std::cout << "CallGlobalSheep" << std::endl;
 	return 0;
@@ -1491,7 +1398,7 @@ RegFunc2(CallGlobalSheep, void, string, string, WAITABLE, REL_FUNC);
 //DisableSheepCaching
 //DisableCurrentSheepCaching
 
-shpvoid Extract(std::string fileSpec, std::string outputPath)
+shpvoid Extract(const std::string& fileSpec, const std::string& outputPath)
 {
 	//TODO: fileSpec should support regex if surrounded by { }.
 	//TODO: fileSpec prefixed with @ indicates a "listing file" - what's a listing file? Perhaps a file that lists assets to extract?
@@ -1625,7 +1532,7 @@ RegFunc1(SetTimerSeconds, void, float, WAITABLE, REL_FUNC);
 //DumpCaseLogic
 //ResetCaseLogic
 
-int GetFlag(std::string flagName)
+int GetFlag(const std::string& flagName)
 {
 	return Services::Get<GameProgress>()->GetFlag(flagName);
 }
@@ -1643,14 +1550,14 @@ int GetFlagInt(int flagEnum)
 RegFunc1(GetFlagInt, int, int, IMMEDIATE, REL_FUNC);
 */
  
-shpvoid SetFlag(std::string flagName)
+shpvoid SetFlag(const std::string& flagName)
 {
 	Services::Get<GameProgress>()->SetFlag(flagName);
 	return 0;
 }
 RegFunc1(SetFlag, void, string, IMMEDIATE, REL_FUNC);
 
-shpvoid ClearFlag(std::string flagName)
+shpvoid ClearFlag(const std::string& flagName)
 {
 	Services::Get<GameProgress>()->ClearFlag(flagName);
 	return 0;
@@ -1667,7 +1574,7 @@ RegFunc0(DumpFlags, void, IMMEDIATE, DEV_FUNC);
  
 //DumpNouns
 
-int GetChatCount(std::string noun)
+int GetChatCount(const std::string& noun)
 {
 	return Services::Get<GameProgress>()->GetChatCount(noun);
 }
@@ -1683,34 +1590,34 @@ int GetChatCountInt(int nounEnum)
 RegFunc1(GetChatCountInt, int, int, IMMEDIATE, REL_FUNC);
 */
  
-shpvoid SetChatCount(std::string noun, int count)
+shpvoid SetChatCount(const std::string& noun, int count)
 {
 	Services::Get<GameProgress>()->SetChatCount(noun, count);
 	return 0;
 }
 RegFunc2(SetChatCount, void, string, int, IMMEDIATE, DEV_FUNC);
 
-int GetGameVariableInt(std::string varName)
+int GetGameVariableInt(const std::string& varName)
 {
 	return Services::Get<GameProgress>()->GetGameVariable(varName);
 }
 RegFunc1(GetGameVariableInt, int, string, IMMEDIATE, REL_FUNC);
 
-shpvoid IncGameVariableInt(std::string varName)
+shpvoid IncGameVariableInt(const std::string& varName)
 {
 	Services::Get<GameProgress>()->IncGameVariable(varName);
 	return 0;
 }
 RegFunc1(IncGameVariableInt, void, string, IMMEDIATE, REL_FUNC);
 
-shpvoid SetGameVariableInt(std::string varName, int value)
+shpvoid SetGameVariableInt(const std::string& varName, int value)
 {
 	Services::Get<GameProgress>()->SetGameVariable(varName, value);
 	return 0;
 }
 RegFunc2(SetGameVariableInt, void, string, int, IMMEDIATE, REL_FUNC);
 
-int GetNounVerbCount(std::string noun, std::string verb)
+int GetNounVerbCount(const std::string& noun, const std::string& verb)
 {
 	return Services::Get<GameProgress>()->GetNounVerbCount(noun, verb);
 }
@@ -1726,7 +1633,7 @@ int GetNounVerbCountInt(int nounEnum, int verbEnum)
 RegFunc2(GetNounVerbCountInt, int, int, int, IMMEDIATE, REL_FUNC);
 */
  
-shpvoid IncNounVerbCount(string noun, string verb)
+shpvoid IncNounVerbCount(const std::string& noun, const std::string& verb)
 {
 	//TODO: Throw an error if the given noun corresponds to a "Topic".
 	Services::Get<GameProgress>()->IncNounVerbCount(noun, verb);
@@ -1734,7 +1641,7 @@ shpvoid IncNounVerbCount(string noun, string verb)
 }
 RegFunc2(IncNounVerbCount, void, string, string, IMMEDIATE, REL_FUNC);
 
-shpvoid IncNounVerbCountBoth(string noun, string verb)
+shpvoid IncNounVerbCountBoth(const std::string& noun, const std::string& verb)
 {
 	//TODO: HelpCommand says this sets the noun/verb count for both Gabe and Grace.
 	//TODO: Does that imply SetNounVerbCount tracks per-Ego?
@@ -1743,7 +1650,7 @@ shpvoid IncNounVerbCountBoth(string noun, string verb)
 }
 RegFunc2(IncNounVerbCountBoth, void, string, string, IMMEDIATE, REL_FUNC);
 
-shpvoid SetNounVerbCount(string noun, string verb, int count)
+shpvoid SetNounVerbCount(const std::string& noun, const std::string& verb, int count)
 {
 	//TODO: Throw an error if the given noun corresponds to a "Topic".
 	Services::Get<GameProgress>()->SetNounVerbCount(noun, verb, count);
@@ -1751,7 +1658,7 @@ shpvoid SetNounVerbCount(string noun, string verb, int count)
 }
 RegFunc3(SetNounVerbCount, void, string, string, int, IMMEDIATE, REL_FUNC);
 
-shpvoid SetNounVerbCountBoth(string noun, string verb, int count)
+shpvoid SetNounVerbCountBoth(const std::string& noun, const std::string& verb, int count)
 {
 	//TODO: HelpCommand says this sets the noun/verb count for both Gabe and Grace.
 	//TODO: Does that imply SetNounVerbCount tracks per-Ego?
@@ -1759,7 +1666,7 @@ shpvoid SetNounVerbCountBoth(string noun, string verb, int count)
 }
 RegFunc3(SetNounVerbCountBoth, void, string, string, int, IMMEDIATE, REL_FUNC);
 
-shpvoid TriggerNounVerb(std::string noun, std::string verb)
+shpvoid TriggerNounVerb(const std::string& noun, const std::string& verb)
 {
 	//TODO: Validate noun or throw error.
 	//TODO: Validate verb or throw error.
@@ -1792,14 +1699,14 @@ shpvoid SetScore(int score)
 }
 RegFunc1(SetScore, void, int, IMMEDIATE, DEV_FUNC);
 
-shpvoid ChangeScore(std::string scoreValue)
+shpvoid ChangeScore(const std::string& scoreValue)
 {
 	std::cout << "ChangeScore " << scoreValue << std::endl;
 	return 0;
 }
 RegFunc1(ChangeScore, void, string, IMMEDIATE, REL_FUNC);
 
-int GetTopicCount(std::string noun, std::string verb)
+int GetTopicCount(const std::string& noun, const std::string& verb)
 {
 	//TODO: Validate noun. Must be a valid noun. Seems to include any scene nouns, inventory nouns, actor nouns.
 	if(!Services::Get<VerbManager>()->IsTopic(verb))
@@ -1819,7 +1726,7 @@ int GetTopicCountInt(int nounEnum, int verbEnum)
 }
 RegFunc2(GetTopicCountInt, int, int, int, IMMEDIATE, REL_FUNC);
  
-int HasTopicsLeft(std::string noun)
+int HasTopicsLeft(const std::string& noun)
 {
 	//TODO: Validate noun.
 	bool hasTopics = Services::Get<ActionManager>()->HasTopicsLeft(noun);
@@ -1827,7 +1734,7 @@ int HasTopicsLeft(std::string noun)
 }
 RegFunc1(HasTopicsLeft, int, string, IMMEDIATE, REL_FUNC);
 
-shpvoid SetTopicCount(std::string noun, std::string verb, int count)
+shpvoid SetTopicCount(const std::string& noun, const std::string& verb, int count)
 {
 	//TODO: Validate noun or report error.
 	//TODO: Validate verb or report error.
@@ -1836,28 +1743,28 @@ shpvoid SetTopicCount(std::string noun, std::string verb, int count)
 }
 RegFunc3(SetTopicCount, void, string, string, int, IMMEDIATE, DEV_FUNC);
  
-int IsCurrentLocation(std::string location)
+int IsCurrentLocation(const std::string& location)
 {
 	std::string currentLocation = Services::Get<LocationManager>()->GetLocation();
 	return StringUtil::EqualsIgnoreCase(currentLocation, location) ? 1 : 0;
 }
 RegFunc1(IsCurrentLocation, int, string, IMMEDIATE, REL_FUNC);
 
-int IsCurrentTime(std::string timeblock)
+int IsCurrentTime(const std::string& timeblock)
 {
 	std::string currentTimeblock = Services::Get<GameProgress>()->GetTimeblock().ToString();
 	return StringUtil::EqualsIgnoreCase(currentTimeblock, timeblock) ? 1 : 0;
 }
 RegFunc1(IsCurrentTime, int, string, IMMEDIATE, REL_FUNC);
 
-int WasLastLocation(std::string location)
+int WasLastLocation(const std::string& location)
 {
 	std::string lastLocation = Services::Get<LocationManager>()->GetLastLocation();
 	return StringUtil::EqualsIgnoreCase(lastLocation, location) ? 1 : 0;
 }
 RegFunc1(WasLastLocation, int, string, IMMEDIATE, REL_FUNC);
 
-int WasLastTime(std::string timeblock)
+int WasLastTime(const std::string& timeblock)
 {
 	std::string lastTimeblock = Services::Get<GameProgress>()->GetLastTimeblock().ToString();
 	return StringUtil::EqualsIgnoreCase(lastTimeblock, timeblock) ? 1 : 0;
@@ -1867,7 +1774,7 @@ RegFunc1(WasLastTime, int, string, IMMEDIATE, REL_FUNC);
 //ResetGameData
 
 /*
-shpvoid SetGameTimer(std::string noun, std::string verb, int milliseconds)
+shpvoid SetGameTimer(const std::string& noun, const std::string& verb, int milliseconds)
 {
 	std::cout << "SetGameTimer" << std::endl;
 	return 0;
@@ -1900,14 +1807,14 @@ int GetRandomInt(int lower, int upper)
 RegFunc2(GetRandomInt, int, int, int, IMMEDIATE, REL_FUNC);
 
 /*
-shpvoid PlayFullScreenMovie(std::string movieName)
+shpvoid PlayFullScreenMovie(const std::string& movieName)
 {
 	std::cout << "PlayFullScreenMovie" << std::endl;
 	return 0;
 }
 RegFunc1(PlayFullScreenMovie, void, string, WAITABLE, REL_FUNC);
 
-shpvoid PlayMovie(std::string movieName)
+shpvoid PlayMovie(const std::string& movieName)
 {
 	std::cout << "PlayMovie" << std::endl;
 	return 0;
@@ -1925,7 +1832,7 @@ RegFunc1(SetPamphletPage, void, int, WAITABLE, REL_FUNC);
 // INSETS
 //DumpInsetNames
 /*
-shpvoid ShowInset(std::string insetName)
+shpvoid ShowInset(const std::string& insetName)
 {
 	std::cout << "ShowInset" << std::endl;
 	return 0;
@@ -1939,14 +1846,14 @@ shpvoid HideInset()
 }
 RegFunc0(HideInset, void, IMMEDIATE, REL_FUNC);
 
-shpvoid ShowPlate(std::string plateName)
+shpvoid ShowPlate(const std::string& plateName)
 {
 	std::cout << "ShowPlate" << std::endl;
 	return 0;
 }
 RegFunc1(ShowPlate, void, string, IMMEDIATE, REL_FUNC);
 
-shpvoid HidePlate(std::string plateName)
+shpvoid HidePlate(const std::string& plateName)
 {
 	std::cout << "HidePlate" << std::endl;
 	return 0;
@@ -1955,7 +1862,7 @@ RegFunc1(HidePlate, void, string, IMMEDIATE, REL_FUNC);
 */
  
 // INVENTORY
-shpvoid CombineInvItems(std::string firstItemName, std::string secondItemName,
+shpvoid CombineInvItems(const std::string& firstItemName, const std::string& secondItemName,
 						std::string combinedItemName)
 {
 	// All three items must be valid.
@@ -1990,7 +1897,7 @@ shpvoid CombineInvItems(std::string firstItemName, std::string secondItemName,
 }
 RegFunc3(CombineInvItems, void, string, string, string, IMMEDIATE, REL_FUNC);
 
-int DoesEgoHaveInvItem(std::string itemName)
+int DoesEgoHaveInvItem(const std::string& itemName)
 {
 	// This function does work with invalid inventory item names.
 	const std::string& egoName = GEngine::Instance()->GetScene()->GetEgoName();
@@ -1999,7 +1906,7 @@ int DoesEgoHaveInvItem(std::string itemName)
 }
 RegFunc1(DoesEgoHaveInvItem, int, string, IMMEDIATE, REL_FUNC);
 
-int DoesGabeHaveInvItem(std::string itemName)
+int DoesGabeHaveInvItem(const std::string& itemName)
 {
 	// This function does work with invalid inventory item names.
 	bool hasItem = Services::Get<InventoryManager>()->HasInventoryItem("Gabriel", itemName);
@@ -2007,7 +1914,7 @@ int DoesGabeHaveInvItem(std::string itemName)
 }
 RegFunc1(DoesGabeHaveInvItem, int, string, IMMEDIATE, REL_FUNC);
 
-int DoesGraceHaveInvItem(std::string itemName)
+int DoesGraceHaveInvItem(const std::string& itemName)
 {
 	// This function does work with invalid inventory item names.
 	bool hasItem = Services::Get<InventoryManager>()->HasInventoryItem("Grace", itemName);
@@ -2015,7 +1922,7 @@ int DoesGraceHaveInvItem(std::string itemName)
 }
 RegFunc1(DoesGraceHaveInvItem, int, string, IMMEDIATE, REL_FUNC);
 
-shpvoid EgoTakeInvItem(std::string itemName)
+shpvoid EgoTakeInvItem(const std::string& itemName)
 {
 	// It must be a valid inventory item.
 	if(!Services::Get<InventoryManager>()->IsValidInventoryItem(itemName))
@@ -2047,7 +1954,7 @@ shpvoid DumpEgoActiveInvItem()
 }
 RegFunc0(DumpEgoActiveInvItem, void, IMMEDIATE, DEV_FUNC);
 
-shpvoid SetEgoActiveInvItem(std::string itemName)
+shpvoid SetEgoActiveInvItem(const std::string& itemName)
 {
 	// It must be a valid inventory item.
 	if(!Services::Get<InventoryManager>()->IsValidInventoryItem(itemName))
@@ -2084,7 +1991,7 @@ shpvoid HideInventory()
 }
 RegFunc0(HideInventory, void, IMMEDIATE, REL_FUNC);
 
-shpvoid InventoryInspect(std::string itemName)
+shpvoid InventoryInspect(const std::string& itemName)
 {
 	Services::Get<InventoryManager>()->InventoryInspect(itemName);
 	return 0;
@@ -2098,7 +2005,7 @@ shpvoid InventoryUninspect()
 }
 RegFunc0(InventoryUninspect, void, IMMEDIATE, REL_FUNC);
 
-shpvoid SetInvItemStatus(std::string itemName, std::string status)
+shpvoid SetInvItemStatus(const std::string& itemName, const std::string& status)
 {
 	std::cout << "SetInvItemStatus: " << itemName << ", " << status << std::endl;
 	
@@ -2171,38 +2078,38 @@ RegFunc2(SetInvItemStatus, void, string, string, IMMEDIATE, REL_FUNC);
  
 // MODELS
 /*
-shpvoid SetModelShadowTexture(std::string modelName, std::string textureName)
+shpvoid SetModelShadowTexture(const std::string& modelName, const std::string& textureName)
 {
 	std::cout << "SetModelShadowTexture" << std::endl;
 	return 0;
 }
 
-shpvoid ClearModelShadowTexture(std::string modelName)
+shpvoid ClearModelShadowTexture(const std::string& modelName)
 {
 	std::cout << "ClearModelShadowTexture" << std::endl;
 	return 0;
 }
 
-shpvoid SetPropGas(std::string modelName, std::string gasName)
+shpvoid SetPropGas(const std::string& modelName, const std::string& gasName)
 {
 	std::cout << "SetPropGas" << std::endl;
 	return 0;
 }
 
-shpvoid ClearPropGas(std::string modelName)
+shpvoid ClearPropGas(const std::string& modelName)
 {
 	std::cout << "ClearPropGas" << std::endl;
 	return 0;
 }
 */
 
-int DoesModelExist(std::string modelName)
+int DoesModelExist(const std::string& modelName)
 {
 	GKActor* object = GEngine::Instance()->GetScene()->GetSceneObjectByModelName(modelName);
 	return object != nullptr ? 1 : 0;
 }
 
-int DoesSceneModelExist(std::string modelName)
+int DoesSceneModelExist(const std::string& modelName)
 {
 	return GEngine::Instance()->GetScene()->DoesSceneModelExist(modelName) ? 1 : 0;
 }
@@ -2211,7 +2118,7 @@ int DoesSceneModelExist(std::string modelName)
 //DumpModelNames
 //DumpSceneModelNames
 
-shpvoid ShowModel(std::string modelName)
+shpvoid ShowModel(const std::string& modelName)
 {
 	GKActor* object = GEngine::Instance()->GetScene()->GetSceneObjectByModelName(modelName);
 	if(object != nullptr)
@@ -2222,7 +2129,7 @@ shpvoid ShowModel(std::string modelName)
 }
 RegFunc1(ShowModel, void, string, IMMEDIATE, REL_FUNC);
 
-shpvoid HideModel(std::string modelName)
+shpvoid HideModel(const std::string& modelName)
 {
 	GKActor* object = GEngine::Instance()->GetScene()->GetSceneObjectByModelName(modelName);
 	if(object != nullptr)
@@ -2234,14 +2141,14 @@ shpvoid HideModel(std::string modelName)
 RegFunc1(HideModel, void, string, IMMEDIATE, REL_FUNC);
 
 /*
-shpvoid ShowModelGroup(std::string groupName)
+shpvoid ShowModelGroup(const std::string& groupName)
 {
 	std::cout << "ShowModelGroup" << std::endl;
 	return 0;
 }
 RegFunc1(ShowModelGroup, void, string, IMMEDIATE, REL_FUNC);
 
-shpvoid HideModelGroup(std::string groupName)
+shpvoid HideModelGroup(const std::string& groupName)
 {
 	std::cout << "HideModelGroup" << std::endl;
 	return 0;
@@ -2249,21 +2156,21 @@ shpvoid HideModelGroup(std::string groupName)
 RegFunc1(HideModelGroup, void, string, IMMEDIATE, REL_FUNC);
 */
  
-shpvoid ShowSceneModel(std::string modelName)
+shpvoid ShowSceneModel(const std::string& modelName)
 {
 	GEngine::Instance()->GetScene()->SetSceneModelVisibility(modelName, true);
 	return 0;
 }
 RegFunc1(ShowSceneModel, void, string, IMMEDIATE, REL_FUNC);
 
-shpvoid HideSceneModel(std::string modelName)
+shpvoid HideSceneModel(const std::string& modelName)
 {
 	GEngine::Instance()->GetScene()->SetSceneModelVisibility(modelName, false);
 	return 0;
 }
 RegFunc1(HideSceneModel, void, string, IMMEDIATE, REL_FUNC);
 
-int IsModelVisible(std::string modelName)
+int IsModelVisible(const std::string& modelName)
 {
 	GKActor* object = GEngine::Instance()->GetScene()->GetSceneObjectByModelName(modelName);
 	if(object != nullptr)
@@ -2274,21 +2181,21 @@ int IsModelVisible(std::string modelName)
 }
 RegFunc1(IsModelVisible, int, string, IMMEDIATE, REL_FUNC);
 
-int IsSceneModelVisible(std::string modelName)
+int IsSceneModelVisible(const std::string& modelName)
 {
 	return GEngine::Instance()->GetScene()->IsSceneModelVisible(modelName) ? 1 : 0;
 }
 RegFunc1(IsSceneModelVisible, int, string, IMMEDIATE, REL_FUNC);
 
 /*
-shpvoid StartPropFidget(std::string modelName)
+shpvoid StartPropFidget(const std::string& modelName)
 {
 	std::cout << "StartPropFidget" << std::endl;
 	return 0;
 }
 RegFunc1(StartPropFidget, void, string, IMMEDIATE, REL_FUNC);
 
-shpvoid StopPropFidget(std::string modelName)
+shpvoid StopPropFidget(const std::string& modelName)
 {
 	std::cout << "StopPropFidget" << std::endl;
 	return 0;
@@ -2297,7 +2204,7 @@ RegFunc1(StopPropFidget, void, string, IMMEDIATE, REL_FUNC);
 */
  
 // REPORTS
-shpvoid AddStreamContent(std::string streamName, std::string content)
+shpvoid AddStreamContent(const std::string& streamName, const std::string& content)
 {
 	if(StringUtil::EqualsIgnoreCase(content, "begin"))
 	{
@@ -2357,78 +2264,78 @@ shpvoid AddStreamContent(std::string streamName, std::string content)
 }
 RegFunc2(AddStreamContent, void, string, string, IMMEDIATE, DEV_FUNC);
 
-shpvoid ClearStreamContent(std::string streamName)
+shpvoid ClearStreamContent(const std::string& streamName)
 {
 	Services::GetReports()->ClearStreamContent(streamName);
 	return 0;
 }
 RegFunc1(ClearStreamContent, void, string, IMMEDIATE, DEV_FUNC);
 
-shpvoid RemoveStreamContent(std::string streamName, std::string content)
+shpvoid RemoveStreamContent(const std::string& streamName, const std::string& content)
 {
 	return 0;
 }
 RegFunc2(RemoveStreamContent, void, string, string, IMMEDIATE, DEV_FUNC);
 
-shpvoid AddStreamOutput(std::string streamName, std::string output)
+shpvoid AddStreamOutput(const std::string& streamName, const std::string& output)
 {
 	return 0;
 }
 RegFunc2(AddStreamOutput, void, string, string, IMMEDIATE, DEV_FUNC);
 
-shpvoid ClearStreamOutput(std::string streamName)
+shpvoid ClearStreamOutput(const std::string& streamName)
 {
 	Services::GetReports()->ClearStreamOutput(streamName);
 	return 0;
 }
 RegFunc1(ClearStreamOutput, void, string, IMMEDIATE, DEV_FUNC);
 
-shpvoid RemoveStreamOutput(std::string streamName, std::string output)
+shpvoid RemoveStreamOutput(const std::string& streamName, const std::string& output)
 {
 	return 0;
 }
 RegFunc2(RemoveStreamOutput, void, string, string, IMMEDIATE, DEV_FUNC);
 
-shpvoid DisableStream(std::string streamName)
+shpvoid DisableStream(const std::string& streamName)
 {
 	Services::GetReports()->DisableStream(streamName);
 	return 0;
 }
 RegFunc1(DisableStream, void, string, IMMEDIATE, DEV_FUNC);
 
-shpvoid EnableStream(std::string streamName)
+shpvoid EnableStream(const std::string& streamName)
 {
 	Services::GetReports()->EnableStream(streamName);
 	return 0;
 }
 RegFunc1(EnableStream, void, string, IMMEDIATE, DEV_FUNC);
 
-shpvoid HideReportGraph(std::string graphType)
+shpvoid HideReportGraph(const std::string& graphType)
 {
 	return 0;
 }
 RegFunc1(HideReportGraph, void, string, IMMEDIATE, DEV_FUNC);
 
-shpvoid ShowReportGraph(std::string graphType)
+shpvoid ShowReportGraph(const std::string& graphType)
 {
 	return 0;
 }
 RegFunc1(ShowReportGraph, void, string, IMMEDIATE, DEV_FUNC);
 
-shpvoid SetStreamAction(std::string streamName, std::string action)
+shpvoid SetStreamAction(const std::string& streamName, const std::string& action)
 {
 	return 0;
 }
 RegFunc2(SetStreamAction, void, string, string, IMMEDIATE, DEV_FUNC);
 
-shpvoid SetStreamFilename(std::string streamName, std::string filename)
+shpvoid SetStreamFilename(const std::string& streamName, const std::string& filename)
 {
 	Services::GetReports()->SetStreamFilename(streamName, filename);
 	return 0;
 }
 RegFunc2(SetStreamFilename, void, string, string, IMMEDIATE, DEV_FUNC);
 
-shpvoid SetStreamFileTruncate(std::string streamName, int truncate)
+shpvoid SetStreamFileTruncate(const std::string& streamName, int truncate)
 {
 	Services::GetReports()->SetStreamFileTruncate(streamName, truncate != 0);
 	return 0;
@@ -2437,7 +2344,7 @@ RegFunc2(SetStreamFileTruncate, void, string, int, IMMEDIATE, DEV_FUNC);
 
 // SCENE
 /*
-shpvoid CallSceneFunction(std::string parameter)
+shpvoid CallSceneFunction(const std::string& parameter)
 {
 	std::cout << "CallSceneFunction" << std::endl;
 	return 0;
@@ -2452,14 +2359,14 @@ RegFunc1(CallSceneFunction, void, string, WAITABLE, REL_FUNC);
 
 //ReEnter
 
-shpvoid SetLocation(std::string location)
+shpvoid SetLocation(const std::string& location)
 {
 	GEngine::Instance()->LoadScene(location);
 	return 0;
 }
 RegFunc1(SetLocation, void, string, WAITABLE, REL_FUNC);
 
-shpvoid SetLocationTime(std::string location, std::string timeblock)
+shpvoid SetLocationTime(const std::string& location, const std::string& timeblock)
 {
 	Services::Get<GameProgress>()->SetTimeblock(Timeblock(timeblock));
 	GEngine::Instance()->LoadScene(location);
@@ -2467,7 +2374,7 @@ shpvoid SetLocationTime(std::string location, std::string timeblock)
 }
 RegFunc2(SetLocationTime, void, string, string, WAITABLE, REL_FUNC);
 
-shpvoid SetTime(std::string timeblock)
+shpvoid SetTime(const std::string& timeblock)
 {
 	// Change time, but load in to the same scene we are currently in.
 	Services::Get<GameProgress>()->SetTimeblock(Timeblock(timeblock));
@@ -2477,7 +2384,7 @@ shpvoid SetTime(std::string timeblock)
 RegFunc1(SetTime, void, string, WAITABLE, REL_FUNC);
 
 /*
-shpvoid SetScene(std::string sceneName)
+shpvoid SetScene(const std::string& sceneName)
 {
 	// Loads a new SCN file. I wonder how often this happens?
 	std::cout << "SetScene" << std::endl;
@@ -2485,7 +2392,7 @@ shpvoid SetScene(std::string sceneName)
 }
 RegFunc1(SetScene, void, string, WAITABLE, REL_FUNC);
 
-shpvoid Warp(std::string locationAndTime)
+shpvoid Warp(const std::string& locationAndTime)
 {
 	// Lots of input handling to figure out string and handle errors...
 	// Wonder if this is ever used?
@@ -2502,7 +2409,7 @@ RegFunc1(Warp, void, string, WAITABLE, REL_FUNC);
 //GetVolume
 //SetVolume
 
-shpvoid PlaySound(std::string soundName)
+shpvoid PlaySound(const std::string& soundName)
 {
 	Audio* audio = Services::GetAssets()->LoadAudio(soundName);
 	if(audio != nullptr)
@@ -2514,7 +2421,7 @@ shpvoid PlaySound(std::string soundName)
 RegFunc1(PlaySound, void, string, WAITABLE, REL_FUNC);
 
 /*
-shpvoid StopSound(std::string soundName)
+shpvoid StopSound(const std::string& soundName)
 {
 	std::cout << "StopSound" << std::endl;
 	return 0;
@@ -2529,7 +2436,7 @@ shpvoid StopAllSounds()
 RegFunc0(StopAllSounds, void, IMMEDIATE, REL_FUNC);
 */
  
-shpvoid PlaySoundTrack(std::string soundtrackName)
+shpvoid PlaySoundTrack(const std::string& soundtrackName)
 {
 	Soundtrack* soundtrack = Services::GetAssets()->LoadSoundtrack(soundtrackName);
 	if(soundtrack != nullptr)
@@ -2541,7 +2448,7 @@ shpvoid PlaySoundTrack(std::string soundtrackName)
 RegFunc1(PlaySoundTrack, void, string, WAITABLE, REL_FUNC);
 
 /*
-shpvoid StopSoundTrack(std::string soundtrackName)
+shpvoid StopSoundTrack(const std::string& soundtrackName)
 {
 	std::cout << "StopSoundTrack" << std::endl;
 	return 0;
@@ -2564,7 +2471,7 @@ shpvoid PrintFloat(float value)
 }
 RegFunc1(PrintFloat, void, float, IMMEDIATE, DEV_FUNC);
 
-shpvoid PrintFloatX(std::string category, float value)
+shpvoid PrintFloatX(const std::string& category, float value)
 {
 	Services::GetReports()->Log(category, std::to_string(value));
 	return 0;
@@ -2578,7 +2485,7 @@ shpvoid PrintInt(int value)
 }
 RegFunc1(PrintInt, void, int, IMMEDIATE, DEV_FUNC);
 
-shpvoid PrintIntX(std::string category, int value)
+shpvoid PrintIntX(const std::string& category, int value)
 {
 	Services::GetReports()->Log(category, std::to_string(value));
 	return 0;
@@ -2594,7 +2501,7 @@ shpvoid PrintIntHex(int value)
 }
 RegFunc1(PrintIntHex, void, int, IMMEDIATE, DEV_FUNC);
 
-shpvoid PrintIntHexX(std::string category, int value)
+shpvoid PrintIntHexX(const std::string& category, int value)
 {
 	std::stringstream ss;
 	ss << std::hex << std::setw(2) << std::setfill('0') << std::uppercase << value;
@@ -2603,14 +2510,14 @@ shpvoid PrintIntHexX(std::string category, int value)
 }
 RegFunc2(PrintIntHexX, void, string, int, IMMEDIATE, DEV_FUNC);
 
-shpvoid PrintString(std::string string)
+shpvoid PrintString(const std::string& string)
 {
 	Services::GetReports()->Log("SheepScript", string);
 	return 0;
 }
 RegFunc1(PrintString, void, string, IMMEDIATE, DEV_FUNC);
 
-shpvoid PrintStringX(std::string category, std::string string)
+shpvoid PrintStringX(const std::string& category, const std::string& string)
 {
 	Services::GetReports()->Log(category, string);
 	return 0;
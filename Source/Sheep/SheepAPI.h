@@ -12,7 +12,12 @@
 #include <string>
 
 #include "SheepScript.h"
-#include "Value.h"
+#include "SheepValue.h"
+
+// Calls a system function, with arguments taken directly from the sheep stack (in order).
+// String arguments are passed as the strings in "argStrings", which the stack owns (one per argument; others are unused).
+// A string result is stored in "outString", and the returned value points to it.
+typedef SheepValue (*SysFuncCaller)(SheepValue* args, const std::string* argStrings, std::string& outString);
 
 // A "full" system function declaration.
 // Contains extra data about a function that is helpful, but doesn't uniquely identify the function signature.
@@ -26,6 +31,9 @@ struct SysFuncDecl : public SysImport
 	// If true, this function can only work in dev builds.
 	bool devOnly = false;
 	
+	// Calls the actual function.
+	SysFuncCaller caller = nullptr;
+	
 	//TODO: For in-game help output, we may need to store argument names AND description text.
 	// For example, HelpCommand("AddStreamContent") outputs this:
 	/*
@@ -35,18 +43,34 @@ struct SysFuncDecl : public SysImport
 	*/
 };
 
-void AddSysFuncDecl(const std::string& name, char retType, std::initializer_list<char> argTypes, bool waitable, bool dev);
+void AddSysFuncDecl(const std::string& name, char retType, std::initializer_list<char> argTypes, bool waitable, bool dev, SysFuncCaller caller);
 SysFuncDecl* GetSysFuncDecl(const std::string& name);
 SysFuncDecl* GetSysFuncDecl(const SysImport* sysImport);
 
-// Functions for calling functions of various argument lengths.
-Value CallSysFunc(const std::string& name);
-Value CallSysFunc(const std::string& name, const Value& x1);
-Value CallSysFunc(const std::string& name, const Value& x1, const Value& x2);
-Value CallSysFunc(const std::string& name, const Value& x1, const Value& x2, const Value& x3);
-Value CallSysFunc(const std::string& name, const Value& x1, const Value& x2, const Value& x3, const Value& x4);
-Value CallSysFunc(const std::string& name, const Value& x1, const Value& x2, const Value& x3, const Value& x4, const Value& x5);
-Value CallSysFunc(const std::string& name, const Value& x1, const Value& x2, const Value& x3, const Value& x4, const Value& x5, const Value& x6);
+// Converts a sheep stack value to a system function argument type.
+// Strings are passed by reference to the string the stack owns, so they aren't copied.
+template<typename T> struct SysFuncArg;
+template<> struct SysFuncArg<int>
+{
+	static int Get(SheepValue& value, const std::string&) { return value.GetInt(); }
+};
+template<> struct SysFuncArg<float>
+{
+	static float Get(SheepValue& value, const std::string&) { return value.GetFloat(); }
+};
+template<> struct SysFuncArg<std::string>
+{
+	static const std::string& Get(SheepValue&, const std::string& str) { return str; }
+};
+
+// Converts a system function return value to a sheep value.
+inline SheepValue SysFuncResult(int value, std::string&) { return SheepValue(value); }
+inline SheepValue SysFuncResult(float value, std::string&) { return SheepValue(value); }
+inline SheepValue SysFuncResult(const std::string& value, std::string& outString)
+{
+	outString = value;
+	return SheepValue(outString.c_str());
+}
 
 // These are used in the below macros to convert keywords into integers using ## macro operator.
 #define void_TYPE 0
@@ -55,204 +79,199 @@ Value CallSysFunc(const std::string& name, const Value& x1, const Value& x2, con
 #define string_TYPE 3
 
 // Macros that register functions of various argument lengths with the system.
-// Creates a function with same name as the actual function, but which uses generic "Value" args and return type.
-// The generic function just calls the real function with correct argument types.
-
-// Also registers an entry in the function map with a pointer to the "generic function".
-// Flow is: Look Up in Map -> Calls Generic Function -> Calls Actual Function
+// Creates a "caller" function, which converts args from the sheep stack to the correct types and calls the actual function.
+// The caller is stored in the function's declaration, so the VM can call it directly, with no lookups or allocations.
+// Functions should take string args as "const std::string&" - taking them by value would copy each one.
+// Since args are passed as an array, supporting more args only requires another macro.
 #define RegFunc0(name, ret, waitable, dev)          					\
-    Value name(const Value& x1) {                   					\
-        return name();                              					\
+    SheepValue name##_Call(SheepValue*, const std::string*, std::string& outString) {	\
+        return SysFuncResult(name(), outString);						\
     }                                               					\
     struct name##_ {                                					\
         name##_() {                                 					\
-            map0[#name]=&name;                      					\
-            AddSysFuncDecl(#name, ret##_TYPE, { }, waitable, dev); 		\
+            AddSysFuncDecl(#name, ret##_TYPE, { }, waitable, dev, &name##_Call); \
         }                                           					\
     } name##_instance
 
 #define RegFunc1(name, ret, t1, waitable, dev)                     		\
-    Value name(const Value& x1) {                   					\
-        return name(x1.to<t1>());                   					\
+    SheepValue name##_Call(SheepValue* args, const std::string* argStrings, std::string& outString) {	\
+        return SysFuncResult(name(SysFuncArg<t1>::Get(args[0], argStrings[0])), outString);	\
     }                                               					\
     struct name##_ {                                					\
         name##_() {                                 					\
-            map1[#name]=&name;                      					\
-            AddSysFuncDecl(#name, ret##_TYPE, { t1##_TYPE }, waitable, dev);			\
+            AddSysFuncDecl(#name, ret##_TYPE, { t1##_TYPE }, waitable, dev, &name##_Call); \
         }                                           					\
     } name##_instance
 
 #define RegFunc2(name, ret, t1, t2, waitable, dev)                      \
-    Value name(const Value& x1, const Value& x2) {          			\
-        return name(x1.to<t1>(), x2.to<t2>());              			\
+    SheepValue name##_Call(SheepValue* args, const std::string* argStrings, std::string& outString) {	\
+        return SysFuncResult(name(SysFuncArg<t1>::Get(args[0], argStrings[0]), SysFuncArg<t2>::Get(args[1], argStrings[1])), outString); \
     }                                                       			\
     struct name##_ {                                        			\
         name##_() {                                         			\
-            map2[#name]=&name;                              			\
-            AddSysFuncDecl(#name, ret##_TYPE, { t1##_TYPE, t2##_TYPE }, waitable, dev); \
+            AddSysFuncDecl(#name, ret##_TYPE, { t1##_TYPE, t2##_TYPE }, waitable, dev, &name##_Call); \
         }                                                   			\
     } name##_instance
 
-#define RegFunc3(name, ret, t1, t2, t3, waitable, dev)                      \
-	Value name(const Value& x1, const Value& x2, const Value& x3) {          			\
-		return name(x1.to<t1>(), x2.to<t2>(), x3.to<t3>());              			\
+#define RegFunc3(name, ret, t1, t2, t3, waitable, dev)                  \
+	SheepValue name##_Call(SheepValue* args, const std::string* argStrings, std::string& outString) {	\
+		return SysFuncResult(name(SysFuncArg<t1>::Get(args[0], argStrings[0]), SysFuncArg<t2>::Get(args[1], argStrings[1]), SysFuncArg<t3>::Get(args[2], argStrings[2])), outString); \
 	}                                                       			\
 	struct name##_ {                                        			\
 		name##_() {                                         			\
-			map3[#name]=&name;                              			\
-			AddSysFuncDecl(#name, ret##_TYPE, { t1##_TYPE, t2##_TYPE, t3##_TYPE }, waitable, dev); \
+			AddSysFuncDecl(#name, ret##_TYPE, { t1##_TYPE, t2##_TYPE, t3##_TYPE }, waitable, dev, &name##_Call); \
 		}                                                   			\
 	} name##_instance
 
-#define RegFunc4(name, ret, t1, t2, t3, t4, waitable, dev)                      \
-	Value name(const Value& x1, const Value& x2, const Value& x3, const Value& x4) {          			\
-		return name(x1.to<t1>(), x2.to<t2>(), x3.to<t3>(), x4.to<t4>());              			\
+#define RegFunc4(name, ret, t1, t2, t3, t4, waitable, dev)              \
+	SheepValue name##_Call(SheepValue* args, const std::string* argStrings, std::string& outString) {	\
+		return SysFuncResult(name(SysFuncArg<t1>::Get(args[0], argStrings[0]), SysFuncArg<t2>::Get(args[1], argStrings[1]), SysFuncArg<t3>::Get(args[2], argStrings[2]), \
+								  SysFuncArg<t4>::Get(args[3], argStrings[3])), outString); \
 	}                                                       			\
 	struct name##_ {                                        			\
 		name##_() {                                         			\
-			map4[#name]=&name;                              			\
-			AddSysFuncDecl(#name, ret##_TYPE, { t1##_TYPE, t2##_TYPE, t3##_TYPE, t4##_TYPE }, waitable, dev); \
+			AddSysFuncDecl(#name, ret##_TYPE, { t1##_TYPE, t2##_TYPE, t3##_TYPE, t4##_TYPE }, waitable, dev, &name##_Call); \
 		}                                                   			\
 	} name##_instance
 
-#define RegFunc5(name, ret, t1, t2, t3, t4, t5, waitable, dev)                      \
-	Value name(const Value& x1, const Value& x2, const Value& x3, const Value& x4, const Value& x5) {          			\
-		return name(x1.to<t1>(), x2.to<t2>(), x3.to<t3>(), x4.to<t4>(), x5.to<t5>());              			\
+#define RegFunc5(name, ret, t1, t2, t3, t4, t5, waitable, dev)          \
+	SheepValue name##_Call(SheepValue* args, const std::string* argStrings, std::string& outString) {	\
+		return SysFuncResult(name(SysFuncArg<t1>::Get(args[0], argStrings[0]), SysFuncArg<t2>::Get(args[1], argStrings[1]), SysFuncArg<t3>::Get(args[2], argStrings[2]), \
+								  SysFuncArg<t4>::Get(args[3], argStrings[3]), SysFuncArg<t5>::Get(args[4], argStrings[4])), outString); \
 	}                                                       			\
 	struct name##_ {                                        			\
 		name##_() {                                         			\
-			map5[#name]=&name;                              			\
-			AddSysFuncDecl(#name, ret##_TYPE, { t1##_TYPE, t2##_TYPE, t3##_TYPE, t4##_TYPE, t5##_TYPE }, waitable, dev); \
+			AddSysFuncDecl(#name, ret##_TYPE, { t1##_TYPE, t2##_TYPE, t3##_TYPE, t4##_TYPE, t5##_TYPE }, waitable, dev, &name##_Call); \
 		}                                                   			\
 	} name##_instance
 
 #define shpvoid int
 
 // ACTORS
-shpvoid Blink(std::string actorName);
-shpvoid BlinkX(std::string actorName, std::string blinkAnim);
+shpvoid Blink(const std::string& actorName);
+shpvoid BlinkX(const std::string& actorName, const std::string& blinkAnim);
 
-shpvoid ClearMood(std::string actorName);
+shpvoid ClearMood(const std::string& actorName);
 
-shpvoid EnableEyeJitter(std::string actorName);
-shpvoid DisableEyeJitter(std::string actorName);
-shpvoid EyeJitter(std::string actorName);
+shpvoid EnableEyeJitter(const std::string& actorName);
+shpvoid DisableEyeJitter(const std::string& actorName);
+shpvoid EyeJitter(const std::string& actorName);
 
-shpvoid DumpActorPosition(std::string actorName); // DEV
+shpvoid DumpActorPosition(const std::string& actorName); // DEV
 
-shpvoid Expression(std::string actorName, std::string expression);
+shpvoid Expression(const std::string& actorName, const std::string& expression);
 
 int GetEgoCurrentLocationCount();
-int GetEgoLocationCount(std::string locationName);
+int GetEgoLocationCount(const std::string& locationName);
 
 std::string GetEgoName();
 
 std::string GetIndexedPosition(int index); // DEV
 int GetPositionCount(); // DEV
 
-shpvoid Glance(std::string actorName, int percentX, int percentY, int durationMs); // WAIT
-shpvoid GlanceX(std::string actorName, int leftPercentX, int leftPercentY,
+shpvoid Glance(const std::string& actorName, int percentX, int percentY, int durationMs); // WAIT
+shpvoid GlanceX(const std::string& actorName, int leftPercentX, int leftPercentY,
                 int rightPercentX, int rightPercentY, int durationMs); // WAIT
 
-shpvoid InitEgoPosition(std::string positionName);
+shpvoid InitEgoPosition(const std::string& positionName);
 
-int IsActorAtLocation(std::string actorName, std::string locationName);
-int IsActorNear(std::string actorName, std::string positionName, float distance);
-int IsWalkingActorNear(std::string actorName, std::string positionName, float distance);
+int IsActorAtLocation(const std::string& actorName, const std::string& locationName);
+int IsActorNear(const std::string& actorName, const std::string& positionName, float distance);
+int IsWalkingActorNear(const std::string& actorName, const std::string& positionName, float distance);
 
-int IsActorOffstage(std::string actorName);
+int IsActorOffstage(const std::string& actorName);
 
-int IsCurrentEgo(std::string actorName);
+int IsCurrentEgo(const std::string& actorName);
 
-shpvoid LookitActor(std::string actorName, std::string otherActorName,
+shpvoid LookitActor(const std::string& actorName, const std::string& otherActorName,
                     std::string componentsSpec, float durationSec);
-shpvoid LookitActorQuick(std::string actorName, std::string otherActorName,
+shpvoid LookitActorQuick(const std::string& actorName, const std::string& otherActorName,
                          std::string componentsSpec, float durationSec);
 
-shpvoid LookitModel(std::string actorName, std::string modelName,
+shpvoid LookitModel(const std::string& actorName, const std::string& modelName,
                     std::string componentsSpec, float durationSec);
-shpvoid LookitModelQuick(std::string actorName, std::string modelName,
+shpvoid LookitModelQuick(const std::string& actorName, const std::string& modelName,
                          std::string componentsSpec, float durationSec);
-shpvoid LookitModelX(std::string actorName, std::string modelName, int mesh,
+shpvoid LookitModelX(const std::string& actorName, const std::string& modelName, int mesh,
                      std::string boxModifier, float offsetX, float offsetY, float offsetZ,
                      std::string componentsSpec, float durationSec);
-shpvoid LookitModelQuickX(std::string actorName, std::string modelName, int mesh,
+shpvoid LookitModelQuickX(const std::string& actorName, const std::string& modelName, int mesh,
                           std::string boxModifier, float offsetX, float offsetY, float offsetZ,
                           std::string componentsSpec, float durationSec);
 
-shpvoid LookitNoun(std::string actorName, std::string nounName,
+shpvoid LookitNoun(const std::string& actorName, const std::string& nounName,
                    std::string componentsSpec, float durationSec);
-shpvoid LookitNounQuick(std::string actorName, std::string nounName,
+shpvoid LookitNounQuick(const std::string& actorName, const std::string& nounName,
                         std::string componentsSpec, float durationSec);
 
-shpvoid LookitPoint(std::string actorName, float x, float y, float z,
+shpvoid LookitPoint(const std::string& actorName, float x, float y, float z,
                     std::string componentsSpec, float durationSec);
 
-shpvoid LookitCameraAngle(std::string actorName, std::string cameraAngleName,
+shpvoid LookitCameraAngle(const std::string& actorName, const std::string& cameraAngleName,
                           std::string componentsSpec, float durationSec); // DEV
-shpvoid LookitMouse(std::string actorName, std::string componentsSpec, float durationSec); // DEV
-shpvoid LookitPlayer(std::string actorName, std::string componentsSpec, float durationSec); // DEV
+shpvoid LookitMouse(const std::string& actorName, const std::string& componentsSpec, float durationSec); // DEV
+shpvoid LookitPlayer(const std::string& actorName, const std::string& componentsSpec, float durationSec); // DEV
 
-shpvoid LookitCancel(std::string actorName);
+shpvoid LookitCancel(const std::string& actorName);
 
-shpvoid LookitLock(std::string actorName, std::string componentsSpec, float durationSec);
-shpvoid LookitUnlock(std::string actorName, std::string componentsSpec);
+shpvoid LookitLock(const std::string& actorName, const std::string& componentsSpec, float durationSec);
+shpvoid LookitUnlock(const std::string& actorName, const std::string& componentsSpec);
 
-shpvoid SetActorLocation(std::string actorName, std::string locationName);
-shpvoid SetActorOffstage(std::string actorName);
+shpvoid SetActorLocation(const std::string& actorName, const std::string& locationName);
+shpvoid SetActorOffstage(const std::string& actorName);
 
-shpvoid SetActorPosition(std::string actorName, std::string positionName);
+shpvoid SetActorPosition(const std::string& actorName, const std::string& positionName);
 
-shpvoid SetEyeOffsets(std::string actorName, float leftX, float leftY,
+shpvoid SetEyeOffsets(const std::string& actorName, float leftX, float leftY,
                       float rightX, float rightY); // DEV
 
-shpvoid SetEgo(std::string actorName);
-shpvoid SetEgoLocationCount(std::string locationName, int count); // DEV
+shpvoid SetEgo(const std::string& actorName);
+shpvoid SetEgoLocationCount(const std::string& locationName, int count); // DEV
 
-shpvoid SetIdleGAS(std::string actorName, std::string gasName); // WAIT
-shpvoid SetListenGAS(std::string actorName, std::string gasName); // WAIT
-shpvoid SetTalkGAS(std::string actorName, std::string gasName); // WAIT
+shpvoid SetIdleGAS(const std::string& actorName, const std::string& gasName); // WAIT
+shpvoid SetListenGAS(const std::string& actorName, const std::string& gasName); // WAIT
+shpvoid SetTalkGAS(const std::string& actorName, const std::string& gasName); // WAIT
 
-shpvoid SetMood(std::string actorName, std::string moodName);
+shpvoid SetMood(const std::string& actorName, const std::string& moodName);
 
 shpvoid SetNextEgo(); // DEV
 shpvoid SetPrevEgo(); // DEV
 
-shpvoid SetWalkAnim(std::string actorName, std::string start, std::string cont,
-                    std::string startTurnLeft, std::string startTurnRight);
+shpvoid SetWalkAnim(const std::string& actorName, const std::string& start, const std::string& cont,
+                    std::string startTurnLeft, const std::string& startTurnRight);
 
-shpvoid StartIdleFidget(std::string actorName); // WAIT
-shpvoid StartListenFidget(std::string actorName); // WAIT
-shpvoid StartTalkFidget(std::string actorName); // WAIT
-shpvoid StopFidget(std::string actorName); // WAIT
+shpvoid StartIdleFidget(const std::string& actorName); // WAIT
+shpvoid StartListenFidget(const std::string& actorName); // WAIT
+shpvoid StartTalkFidget(const std::string& actorName); // WAIT
+shpvoid StopFidget(const std::string& actorName); // WAIT
 
-shpvoid TurnHead(std::string actorName, int percentX, int percentY, int durationMs); // WAIT
-shpvoid TurnToModel(std::string actorName, std::string modelName); // WAIT
+shpvoid TurnHead(const std::string& actorName, int percentX, int percentY, int durationMs); // WAIT
+shpvoid TurnToModel(const std::string& actorName, const std::string& modelName); // WAIT
 
-shpvoid WalkerBoundaryBlockModel(std::string modelName);
+shpvoid WalkerBoundaryBlockModel(const std::string& modelName);
 shpvoid WalkerBoundaryBlockRegion(int regionIndex, int regionBoundaryIndex);
-shpvoid WalkerBoundaryUnblockModel(std::string modelName);
+shpvoid WalkerBoundaryUnblockModel(const std::string& modelName);
 shpvoid WalkerBoundaryUnblockRegion(int regionIndex, int regionBoundaryIndex);
 
-shpvoid WalkNear(std::string actorName, std::string positionName); // WAIT
-shpvoid WalkNearModel(std::string actorName, std::string modelName); // WAIT
-shpvoid WalkTo(std::string actorName, std::string positionName); // WAIT
-shpvoid WalkToAnimation(std::string actorName, std::string animationName); // WAIT
-shpvoid WalkToSeeModel(std::string actorName, std::string modelName); // WAIT
-shpvoid WalkToXZ(std::string actorName, float xPos, float zPos); // DEV, WAIT
+shpvoid WalkNear(const std::string& actorName, const std::string& positionName); // WAIT
+shpvoid WalkNearModel(const std::string& actorName, const std::string& modelName); // WAIT
+shpvoid WalkTo(const std::string& actorName, const std::string& positionName); // WAIT
+shpvoid WalkToAnimation(const std::string& actorName, const std::string& animationName); // WAIT
+shpvoid WalkToSeeModel(const std::string& actorName, const std::string& modelName); // WAIT
+shpvoid WalkToXZ(const std::string& actorName, float xPos, float zPos); // DEV, WAIT
 
-int WasEgoEverInLocation(std::string locationName);
+int WasEgoEverInLocation(const std::string& locationName);
 
 // ANIMATION AND DIALOGUE
-shpvoid AddCaptionDefault(std::string captionText); // DEV
-shpvoid AddCaptionEgo(std::string captionText); // DEV
-shpvoid AddCaptionVoiceOver(std::string captionText); // DEV
+shpvoid AddCaptionDefault(const std::string& captionText); // DEV
+shpvoid AddCaptionEgo(const std::string& captionText); // DEV
+shpvoid AddCaptionVoiceOver(const std::string& captionText); // DEV
 shpvoid ClearCaptionText(); // DEV
 
-shpvoid AnimEvent(std::string eventType, std::string eventData); // DEV
+shpvoid AnimEvent(const std::string& eventType, const std::string& eventData); // DEV
 
-shpvoid StartDialogue(std::string dialogueName, int numLines); // WAIT
-shpvoid StartDialogueNoFidgets(std::string dialogueName, int numLines); // WAIT
+shpvoid StartDialogue(const std::string& dialogueName, int numLines); // WAIT
+shpvoid StartDialogueNoFidgets(const std::string& dialogueName, int numLines); // WAIT
 shpvoid ContinueDialogue(int numLines); // WAIT
 shpvoid ContinueDialogueNoFidgets(int numLines); // WAIT
 
@@ -261,35 +280,35 @@ shpvoid DisableInterpolation(); // DEV
 
 shpvoid DumpAnimator(); // DEV
 
-shpvoid SetConversation(std::string conversationName); // WAIT
+shpvoid SetConversation(const std::string& conversationName); // WAIT
 shpvoid EndConversation(); // WAIT
 
-shpvoid SetDefaultDialogueCamera(std::string cameraName);
+shpvoid SetDefaultDialogueCamera(const std::string& cameraName);
 
-shpvoid StartAnimation(std::string animationName); // WAIT
-shpvoid StartMoveAnimation(std::string animName); // WAIT
-shpvoid StartMom(std::string momAnimationName); // WAIT
-shpvoid LoopAnimation(std::string animationName);
-shpvoid StopAnimation(std::string animationName);
+shpvoid StartAnimation(const std::string& animationName); // WAIT
+shpvoid StartMoveAnimation(const std::string& animName); // WAIT
+shpvoid StartMom(const std::string& momAnimationName); // WAIT
+shpvoid LoopAnimation(const std::string& animationName);
+shpvoid StopAnimation(const std::string& animationName);
 shpvoid StopAllAnimations(); // DEV
 
-shpvoid StartMorphAnimation(std::string animationName, int animStartFrame, int morphFrames); // WAIT
-shpvoid StopMorphAnimation(std::string animationName);
+shpvoid StartMorphAnimation(const std::string& animationName, int animStartFrame, int morphFrames); // WAIT
+shpvoid StopMorphAnimation(const std::string& animationName);
 shpvoid StopAllMorphAnimations(); // DEV
 
-shpvoid StartVoiceOver(std::string dialogueName, int numLines); // WAIT
-shpvoid StartYak(std::string yakAnimName); // WAIT, DEV
+shpvoid StartVoiceOver(const std::string& dialogueName, int numLines); // WAIT
+shpvoid StartYak(const std::string& yakAnimName); // WAIT, DEV
 
 // APPLICATION
-shpvoid AddPath(std::string pathName); // DEV
+shpvoid AddPath(const std::string& pathName); // DEV
 shpvoid FullScanPaths(); // DEV
 shpvoid RescanPaths(); // DEV
 
 shpvoid DumpBuildInfo(); // DEV
 shpvoid DumpLayerStack(); // DEV
 
-shpvoid Edit(std::string filename); // DEV
-shpvoid Open(std::string filename); // DEV
+shpvoid Edit(const std::string& filename); // DEV
+shpvoid Open(const std::string& filename); // DEV
 
 shpvoid ForceQuitGame(); // DEV
 shpvoid QuitApp(); // DEV
@@ -299,25 +318,25 @@ shpvoid FullReset(); // DEV
 shpvoid RefreshScreen(); // DEV
 
 shpvoid Screenshot();
-shpvoid ScreenshotX(std::string filename); // DEV
+shpvoid ScreenshotX(const std::string& filename); // DEV
 
 shpvoid ShowBinocs();
 shpvoid ShowDrivingInterface();
-shpvoid ShowFingerprintInterface(std::string nounName);
+shpvoid ShowFingerprintInterface(const std::string& nounName);
 shpvoid ShowSidney();
 
 shpvoid StartGame(); // DEV
 
 // CAMERA
-shpvoid CameraBoundaryBlockModel(std::string modelName);
-shpvoid CameraBoundaryUnblockModel(std::string modelName);
+shpvoid CameraBoundaryBlockModel(const std::string& modelName);
+shpvoid CameraBoundaryUnblockModel(const std::string& modelName);
 
-shpvoid CutToCameraAngle(std::string cameraName);
+shpvoid CutToCameraAngle(const std::string& cameraName);
 shpvoid CutToCameraAngleX(float horizAngle, float vertAngle,
                           float x, float y, float z); // DEV
-shpvoid ForceCutToCameraAngle(std::string cameraName);
+shpvoid ForceCutToCameraAngle(const std::string& cameraName);
 
-shpvoid DefaultInspect(std::string noun); // WAIT
+shpvoid DefaultInspect(const std::string& noun); // WAIT
 
 shpvoid EnableCameraBoundaries(); // DEV
 shpvoid DisableCameraBoundaries(); // DEV
@@ -329,7 +348,7 @@ int GetCameraAngleCount(); // DEV
 std::string GetIndexedCameraAngle(int index); // DEV
 
 shpvoid SetCameraGlide(int glide);
-shpvoid GlideToCameraAngle(std::string cameraName); // WAIT
+shpvoid GlideToCameraAngle(const std::string& cameraName); // WAIT
 
 shpvoid InspectObject(); // WAIT
 shpvoid Uninspect(); // WAIT
@@ -344,13 +363,13 @@ shpvoid HideConstruction(); // DEV
 std::string CreateCameraAngleGizmo(); // DEV
 std::string CreateCameraAngleGizmoX(float horizAngle, float vertAngle,
                                     float x, float y, float z); // DEV
-shpvoid ShowCameraAngleGizmo(std::string cameraName); // DEV
-shpvoid HideCameraAngleGizmo(std::string cameraName); // DEV
+shpvoid ShowCameraAngleGizmo(const std::string& cameraName); // DEV
+shpvoid HideCameraAngleGizmo(const std::string& cameraName); // DEV
 
 std::string CreatePositionGizmo(); // DEV
 std::string CreatePositionGizmoX(float heading, float x, float y, float z); // DEV
-shpvoid ShowPositionGizmo(std::string positionName); // DEV
-shpvoid HidePositionGizmo(std::string positionName); // DEV
+shpvoid ShowPositionGizmo(const std::string& positionName); // DEV
+shpvoid HidePositionGizmo(const std::string& positionName); // DEV
 
 shpvoid ShowAmbientMapGizmo(); // DEV
 shpvoid HideAmbientMapGizmo(); // DEV
@@ -360,46 +379,46 @@ shpvoid HideWalkerBoundaryGizmo(); // DEV
 
 shpvoid SetSceneViewport(int xPercent, int yPercent, int widthPercent, int heightPercent); // DEV
 
-shpvoid TextInspectCameraGizmo(std::string cameraName); // DEV
-shpvoid TextInspectCameraGizmoX(std::string cameraName, int xPercent,
+shpvoid TextInspectCameraGizmo(const std::string& cameraName); // DEV
+shpvoid TextInspectCameraGizmoX(const std::string& cameraName, int xPercent,
                                 int yPercent, int fontSize); // DEV
 
-shpvoid TextInspectPositionGizmo(std::string positionName); // DEV
-shpvoid TextInspectPositionGizmoX(std::string positionName, int xPercent,
+shpvoid TextInspectPositionGizmo(const std::string& positionName); // DEV
+shpvoid TextInspectPositionGizmoX(const std::string& positionName, int xPercent,
                                 int yPercent, int fontSize); // DEV
 
-shpvoid ViewportInspectCameraGizmo(std::string cameraName); // DEV
-shpvoid ViewportInspectCameraGizmoX(std::string cameraName, int xPercent,
+shpvoid ViewportInspectCameraGizmo(const std::string& cameraName); // DEV
+shpvoid ViewportInspectCameraGizmoX(const std::string& cameraName, int xPercent,
                                     int yPercent, int widthPercent, int heightPercent); // DEV
 
 // DEBUGGING (ALL DEV)
-shpvoid AddTemplate(std::string templateText, std::string expandedText, int removeTemplate);
-shpvoid RemoveTemplate(std::string templateText);
+shpvoid AddTemplate(const std::string& templateText, const std::string& expandedText, int removeTemplate);
+shpvoid RemoveTemplate(const std::string& templateText);
 
-shpvoid Alias(std::string alias, std::string sheepCommand);
-shpvoid Unalias(std::string alias);
+shpvoid Alias(const std::string& alias, const std::string& sheepCommand);
+shpvoid Unalias(const std::string& alias);
 
-shpvoid BindDebugKey(std::string keyName, std::string sheepCommand);
-shpvoid UnbindDebugKey(std::string keyName);
+shpvoid BindDebugKey(const std::string& keyName, const std::string& sheepCommand);
+shpvoid UnbindDebugKey(const std::string& keyName);
 
 shpvoid OpenConsole();
 shpvoid CloseConsole();
 shpvoid ToggleConsole();
 
-shpvoid SetConsole(std::string command);
-shpvoid InsertConsole(std::string command);
+shpvoid SetConsole(const std::string& command);
+shpvoid InsertConsole(const std::string& command);
 shpvoid ClearConsole();
 shpvoid ClearConsoleBuffer();
 
-int GetDebugFlag(std::string flagName);
-shpvoid SetDebugFlag(std::string flagName);
-shpvoid ClearDebugFlag(std::string flagName);
-shpvoid ToggleDebugFlag(std::string flagName);
+int GetDebugFlag(const std::string& flagName);
+shpvoid SetDebugFlag(const std::string& flagName);
+shpvoid ClearDebugFlag(const std::string& flagName);
+shpvoid ToggleDebugFlag(const std::string& flagName);
 
 shpvoid DumpDebugFlags();
-shpvoid DumpFile(std::string filename);
+shpvoid DumpFile(const std::string& filename);
 shpvoid DumpLockedObjects();
-shpvoid DumpMemoryUsage();
+shpvoid DumpMemoryUsage(); // DEV
 shpvoid DumpPathFileMap();
 shpvoid DumpUsedPaths();
 shpvoid DumpUsedFiles();
@@ -411,14 +430,14 @@ float GetTimeMultiplier();
 shpvoid SetTimeMultiplier(float multiplier);
 
 // ENGINE
-shpvoid Call(std::string functionName); // WAIT
-shpvoid CallDefaultSheep(std::string sheepFileName); // WAIT
-shpvoid CallSheep(std::string sheepFileName, std::string functionName); // WAIT
+shpvoid Call(const std::string& functionName); // WAIT
+shpvoid CallDefaultSheep(const std::string& sheepFileName); // WAIT
+shpvoid CallSheep(const std::string& sheepFileName, const std::string& functionName); // WAIT
 
-shpvoid CallGlobal(std::string functionName); // WAIT
-shpvoid CallGlobalSheep(std::string sheepFileName, std::string functionName); // WAIT
+shpvoid CallGlobal(const std::string& functionName); // WAIT
+shpvoid CallGlobalSheep(const std::string& sheepFileName, const std::string& functionName); // WAIT
 
-shpvoid CallIndexedSheep(std::string sheepFileName, int sheepIndex, std::string functionName); // DEV, WAIT
+shpvoid CallIndexedSheep(const std::string& sheepFileName, int sheepIndex, const std::string& functionName); // DEV, WAIT
 
 shpvoid EnableCinematics(); // DEV
 shpvoid DisableCinematics(); // DEV
@@ -430,17 +449,17 @@ shpvoid EnableSheepCaching(); // DEV
 shpvoid DisableSheepCaching(); // DEV
 shpvoid DisableCurrentSheepCaching(); // DEV
 
-shpvoid Extract(std::string fileSpec, std::string outputPath);
+shpvoid Extract(const std::string& fileSpec, const std::string& outputPath);
 
 shpvoid DumpActiveSheepObjects(); // DEV
 shpvoid DumpActiveSheepThreads(); // DEV
 shpvoid DumpCommands(); // DEV
-shpvoid DumpRawSheep(std::string sheepName); // DEV
+shpvoid DumpRawSheep(const std::string& sheepName); // DEV
 shpvoid DumpSheepEngine(); // DEV
 
-shpvoid ExecCommand(std::string sheepCommand); // DEV, WAIT
-shpvoid FindCommand(std::string commandGuess); // DEV
-shpvoid HelpCommand(std::string commandName); // DEV
+shpvoid ExecCommand(const std::string& sheepCommand); // DEV, WAIT
+shpvoid FindCommand(const std::string& commandGuess); // DEV
+shpvoid HelpCommand(const std::string& commandName); // DEV
 
 std::string GetCurrentSheepFunction();
 std::string GetCurrentSheepName();
@@ -449,14 +468,14 @@ shpvoid SetGlobalSheep();
 shpvoid SetTopSheep();
 
 shpvoid NukeAllSheep(); // DEV
-shpvoid NukeSheep(std::string sheepName); // DEV
+shpvoid NukeSheep(const std::string& sheepName); // DEV
 
 float GetGamma(); // DEV
 shpvoid SetGamma(float gamma); // DEV
 
-shpvoid SaveSprite(std::string spriteName, std::string fileName); // DEV
-shpvoid SaveTexture(std::string textureName, std::string fileName); // DEV
-shpvoid SaveTextureX(std::string textureName, int surfaceIndex, std::string fileName); // DEV
+shpvoid SaveSprite(const std::string& spriteName, const std::string& fileName); // DEV
+shpvoid SaveTexture(const std::string& textureName, const std::string& fileName); // DEV
+shpvoid SaveTextureX(const std::string& textureName, int surfaceIndex, const std::string& fileName); // DEV
 
 shpvoid SetRenderFlat(); // DEV
 shpvoid SetRenderFull(); // DEV
@@ -485,63 +504,63 @@ shpvoid UnloadAllSounds(); // DEV
 shpvoid UnloadAllSprites(); // DEV
 shpvoid UnloadAllTextures(); // DEV
 
-shpvoid UnloadAnimation(std::string animName); // DEV
-shpvoid UnloadModel(std::string modelName); // DEV
-shpvoid UnloadMovie(std::string movieName); // DEV
-shpvoid UnloadScene(std::string sceneName); // DEV
-shpvoid UnloadSound(std::string soundName); // DEV
-shpvoid UnloadSprite(std::string spriteName); // DEV
-shpvoid UnloadTexture(std::string textureName); // DEV
+shpvoid UnloadAnimation(const std::string& animName); // DEV
+shpvoid UnloadModel(const std::string& modelName); // DEV
+shpvoid UnloadMovie(const std::string& movieName); // DEV
+shpvoid UnloadScene(const std::string& sceneName); // DEV
+shpvoid UnloadSound(const std::string& soundName); // DEV
+shpvoid UnloadSprite(const std::string& spriteName); // DEV
+shpvoid UnloadTexture(const std::string& textureName); // DEV
 
 // GAME LOGIC
-shpvoid AddCaseLogic(std::string caseVal, std::string logic); // DEV
-shpvoid CheckCase(std::string noun, std::string verb, std::string caseVal); // DEV
+shpvoid AddCaseLogic(const std::string& caseVal, const std::string& logic); // DEV
+shpvoid CheckCase(const std::string& noun, const std::string& verb, const std::string& caseVal); // DEV
 shpvoid CommitCaseLogic(); // DEV
 shpvoid DumpCaseCode(); // DEV
 shpvoid ResetCaseLogic(); // DEV
 
-int GetFlag(std::string flagName);
+int GetFlag(const std::string& flagName);
 int GetFlagInt(int flagEnum);
-shpvoid SetFlag(std::string flagName);
-shpvoid ClearFlag(std::string flagName);
+shpvoid SetFlag(const std::string& flagName);
+shpvoid ClearFlag(const std::string& flagName);
 
 shpvoid DumpFlags(); // DEV
 shpvoid DumpNouns(); // DEV
 
-int GetChatCount(std::string noun);
+int GetChatCount(const std::string& noun);
 int GetChatCountInt(int nounEnum);
-shpvoid SetChatCount(std::string noun, int count); // DEV
+shpvoid SetChatCount(const std::string& noun, int count); // DEV
 
-int GetGameVariableInt(std::string varName);
-shpvoid IncGameVariableInt(std::string varName);
-shpvoid SetGameVariableInt(std::string varName, int value);
+int GetGameVariableInt(const std::string& varName);
+shpvoid IncGameVariableInt(const std::string& varName);
+shpvoid SetGameVariableInt(const std::string& varName, int value);
 
-int GetNounVerbCount(std::string noun, std::string verb);
+int GetNounVerbCount(const std::string& noun, const std::string& verb);
 int GetNounVerbCountInt(int nounEnum, int verbEnum);
-shpvoid IncNounVerbCount(std::string noun, std::string verb);
-shpvoid IncNounVerbCountBoth(std::string noun, std::string verb);
-shpvoid SetNounVerbCount(std::string noun, std::string verb, int count);
-shpvoid SetNounVerbCountBoth(std::string noun, std::string verb, int count);
-shpvoid TriggerNounVerb(std::string noun, std::string verb); // DEV
+shpvoid IncNounVerbCount(const std::string& noun, const std::string& verb);
+shpvoid IncNounVerbCountBoth(const std::string& noun, const std::string& verb);
+shpvoid SetNounVerbCount(const std::string& noun, const std::string& verb, int count);
+shpvoid SetNounVerbCountBoth(const std::string& noun, const std::string& verb, int count);
+shpvoid TriggerNounVerb(const std::string& noun, const std::string& verb); // DEV
 
 int GetScore();
 shpvoid IncreaseScore(int value);
 shpvoid SetScore(int score); // DEV
-shpvoid ChangeScore(std::string scoreValue);
+shpvoid ChangeScore(const std::string& scoreValue);
 
-int GetTopicCount(std::string noun, std::string verb);
+int GetTopicCount(const std::string& noun, const std::string& verb);
 int GetTopicCountInt(int nounEnum, int verbEnum);
-int HasTopicsLeft(std::string noun);
-shpvoid SetTopicCount(std::string noun, std::string verb, int count); // DEV
+int HasTopicsLeft(const std::string& noun);
+shpvoid SetTopicCount(const std::string& noun, const std::string& verb, int count); // DEV
 
-int IsCurrentLocation(std::string location);
-int IsCurrentTime(std::string timeblock);
-int WasLastLocation(std::string location);
-int WasLastTime(std::string timeblock);
+int IsCurrentLocation(const std::string& location);
+int IsCurrentTime(const std::string& timeblock);
+int WasLastLocation(const std::string& location);
+int WasLastTime(const std::string& timeblock);
 
 shpvoid ResetGameData(); // DEV
 
-shpvoid SetGameTimer(std::string noun, std::string verb, int milliseconds);
+shpvoid SetGameTimer(const std::string& noun, const std::string& verb, int milliseconds);
 
 // GENERAL
 shpvoid DrawFilledRect(int left, int top, int right, int bottom,
@@ -552,133 +571,133 @@ shpvoid FollowOnDrivingMap(int followState); // WAIT
 float GetRandomFloat(float lower, float upper);
 int GetRandomInt(int lower, int upper);
 
-shpvoid PlayFullScreenMovie(std::string movieName); // WAIT
-shpvoid PlayMovie(std::string movieName); // WAIT
+shpvoid PlayFullScreenMovie(const std::string& movieName); // WAIT
+shpvoid PlayMovie(const std::string& movieName); // WAIT
 
 shpvoid SetPamphletPage(int page);
 
 // INSETS
 shpvoid DumpInsetNames(); // DEV
 
-shpvoid ShowInset(std::string insetName);
+shpvoid ShowInset(const std::string& insetName);
 shpvoid HideInset();
 
-shpvoid ShowPlate(std::string plateName);
-shpvoid HidePlate(std::string plateName);
+shpvoid ShowPlate(const std::string& plateName);
+shpvoid HidePlate(const std::string& plateName);
 
 // INVENTORY
-shpvoid CombineInvItems(std::string firstItemName, std::string secondItemName,
+shpvoid CombineInvItems(const std::string& firstItemName, const std::string& secondItemName,
                         std::string combinedItemName);
 
-int DoesEgoHaveInvItem(std::string itemName);
-int DoesGabeHaveInvItem(std::string itemName);
-int DoesGraceHaveInvItem(std::string itemName);
-shpvoid EgoTakeInvItem(std::string itemName);
+int DoesEgoHaveInvItem(const std::string& itemName);
+int DoesGabeHaveInvItem(const std::string& itemName);
+int DoesGraceHaveInvItem(const std::string& itemName);
+shpvoid EgoTakeInvItem(const std::string& itemName);
 
 shpvoid DumpEgoActiveInvItem(); // DEV
-shpvoid SetEgoActiveInvItem(std::string itemName);
+shpvoid SetEgoActiveInvItem(const std::string& itemName);
 
 shpvoid ShowInventory();
 shpvoid HideInventory();
 
-shpvoid InventoryInspect(std::string itemName);
+shpvoid InventoryInspect(const std::string& itemName);
 shpvoid InventoryUninspect();
 
-shpvoid SetInvItemStatus(std::string itemName, std::string status);
+shpvoid SetInvItemStatus(const std::string& itemName, const std::string& status);
 
 // MODELS
-shpvoid SetModelShadowTexture(std::string modelName, std::string textureName);
-shpvoid ClearModelShadowTexture(std::string modelName);
+shpvoid SetModelShadowTexture(const std::string& modelName, const std::string& textureName);
+shpvoid ClearModelShadowTexture(const std::string& modelName);
 
-shpvoid SetPropGas(std::string modelName, std::string gasName);
-shpvoid ClearPropGas(std::string modelName);
+shpvoid SetPropGas(const std::string& modelName, const std::string& gasName);
+shpvoid ClearPropGas(const std::string& modelName);
 
-int DoesModelExist(std::string modelName);
-int DoesSceneModelExist(std::string modelName);
+int DoesModelExist(const std::string& modelName);
+int DoesSceneModelExist(const std::string& modelName);
 
-shpvoid DumpModel(std::string modelName); // DEV
+shpvoid DumpModel(const std::string& modelName); // DEV
 shpvoid DumpModelNames(); // DEV
 shpvoid DumpSceneModelNames(); // DEV
 
-shpvoid ShowModel(std::string modelName);
-shpvoid HideModel(std::string modelName);
+shpvoid ShowModel(const std::string& modelName);
+shpvoid HideModel(const std::string& modelName);
 
-shpvoid ShowModelGroup(std::string groupName);
-shpvoid HideModelGroup(std::string groupName);
+shpvoid ShowModelGroup(const std::string& groupName);
+shpvoid HideModelGroup(const std::string& groupName);
 
-shpvoid ShowSceneModel(std::string modelName);
-shpvoid HideSceneModel(std::string modelName);
+shpvoid ShowSceneModel(const std::string& modelName);
+shpvoid HideSceneModel(const std::string& modelName);
 
-int IsModelVisible(std::string modelName);
-int IsSceneModelVisible(std::string modelName);
+int IsModelVisible(const std::string& modelName);
+int IsSceneModelVisible(const std::string& modelName);
 
-shpvoid StartPropFidget(std::string modelName);
-shpvoid StopPropFidget(std::string modelName);
+shpvoid StartPropFidget(const std::string& modelName);
+shpvoid StopPropFidget(const std::string& modelName);
 
 // REPORTS (ALL DEV)
-shpvoid AddStreamContent(std::string streamName, std::string content);
-shpvoid ClearStreamContent(std::string streamName);
-shpvoid RemoveStreamContent(std::string streamName, std::string content);
+shpvoid AddStreamContent(const std::string& streamName, const std::string& content);
+shpvoid ClearStreamContent(const std::string& streamName);
+shpvoid RemoveStreamContent(const std::string& streamName, const std::string& content);
 
-shpvoid AddStreamOutput(std::string streamName, std::string output);
-shpvoid ClearStreamOutput(std::string streamName);
-shpvoid RemoveStreamOutput(std::string streamName, std::string output);
+shpvoid AddStreamOutput(const std::string& streamName, const std::string& output);
+shpvoid ClearStreamOutput(const std::string& streamName);
+shpvoid RemoveStreamOutput(const std::string& streamName, const std::string& output);
 
-shpvoid DisableStream(std::string stream);
-shpvoid EnableStream(std::string stream);
+shpvoid DisableStream(const std::string& stream);
+shpvoid EnableStream(const std::string& stream);
 
-shpvoid HideReportGraph(std::string graphType);
-shpvoid ShowReportGraph(std::string graphType);
+shpvoid HideReportGraph(const std::string& graphType);
+shpvoid ShowReportGraph(const std::string& graphType);
 
-shpvoid SetStreamAction(std::string streamName, std::string action);
-shpvoid SetStreamFilename(std::string streamName, std::string filename);
-shpvoid SetStreamFileTruncate(std::string streamName, int truncate);
+shpvoid SetStreamAction(const std::string& streamName, const std::string& action);
+shpvoid SetStreamFilename(const std::string& streamName, const std::string& filename);
+shpvoid SetStreamFileTruncate(const std::string& streamName, int truncate);
 
 // SCENE
-shpvoid CallSceneFunction(std::string parameter); // WAIT
+shpvoid CallSceneFunction(const std::string& parameter); // WAIT
 
 shpvoid DumpLocations(); // DEV
-shpvoid DumpPosition(std::string positionName); // DEV
+shpvoid DumpPosition(const std::string& positionName); // DEV
 shpvoid DumpPositions(); // DEV
 shpvoid DumpTimes(); // DEV
 
 shpvoid ReEnter(); // DEV, WAIT
 
-shpvoid SetLocation(std::string location); // WAIT
-shpvoid SetLocationTime(std::string location, std::string timeblock); // WAIT
-shpvoid SetTime(std::string timeblock); // WAIT
+shpvoid SetLocation(const std::string& location); // WAIT
+shpvoid SetLocationTime(const std::string& location, const std::string& timeblock); // WAIT
+shpvoid SetTime(const std::string& timeblock); // WAIT
 
-shpvoid SetScene(std::string sceneName); // WAIT
+shpvoid SetScene(const std::string& sceneName); // WAIT
 
-shpvoid Warp(std::string locationAndTime); // WAIT
+shpvoid Warp(const std::string& locationAndTime); // WAIT
 
 // SOUND
-shpvoid EnableSound(std::string soundType); // DEV
-shpvoid DisableSound(std::string soundType); // DEV
+shpvoid EnableSound(const std::string& soundType); // DEV
+shpvoid DisableSound(const std::string& soundType); // DEV
 
-shpvoid GetVolume(std::string soundType); // DEV
-shpvoid SetVolume(std::string soundType); // DEV
+shpvoid GetVolume(const std::string& soundType); // DEV
+shpvoid SetVolume(const std::string& soundType); // DEV
 
-shpvoid PlaySound(std::string soundName); // WAIT
-shpvoid StopSound(std::string soundName);
+shpvoid PlaySound(const std::string& soundName); // WAIT
+shpvoid StopSound(const std::string& soundName);
 shpvoid StopAllSounds();
 
-shpvoid PlaySoundTrack(std::string soundtrackName); // WAIT
-shpvoid StopSoundTrack(std::string soundtrackName); // WAIT
+shpvoid PlaySoundTrack(const std::string& soundtrackName); // WAIT
+shpvoid StopSoundTrack(const std::string& soundtrackName); // WAIT
 shpvoid StopAllSoundTracks();
 
 // TRACING (ALL DEV)
 shpvoid PrintFloat(float value);
-shpvoid PrintFloatX(std::string category, float value);
+shpvoid PrintFloatX(const std::string& category, float value);
 
 shpvoid PrintInt(int value);
-shpvoid PrintIntX(std::string category, int value);
+shpvoid PrintIntX(const std::string& category, int value);
 
 shpvoid PrintIntHex(int value);
-shpvoid PrintIntHexX(std::string category, int value);
+shpvoid PrintIntHexX(const std::string& category, int value);
 
-shpvoid PrintString(std::string message);
-shpvoid PrintStringX(std::string category, std::string message);
+shpvoid PrintString(const std::string& message);
+shpvoid PrintStringX(const std::string& category, const std::string& message);
 
 // UNDOCUMENTED
 int IsTopLayerInventory();
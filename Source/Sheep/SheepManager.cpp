@@ -5,9 +5,26 @@
 //
 #include "SheepManager.h"
 
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "BinaryReader.h"
+#include "BinaryWriter.h"
+#include "FileSystem.h"
 #include "Services.h"
+#include "SheepScript.h"
 #include "StringUtil.h"
 
+SheepManager::~SheepManager()
+{
+	for(auto& entry : mCompiledScripts)
+	{
+		delete entry.second;
+	}
+}
+
 SheepScript* SheepManager::Compile(const char* filePath)
 {
     return mCompiler.Compile(filePath);
@@ -23,10 +40,145 @@ SheepScript* SheepManager::Compile(const std::string& name, std::istream& stream
     return mCompiler.Compile(name, stream);
 }
 
+SheepScript* SheepManager::CompileCached(const std::string& name, const std::string& sheep)
+{
+	auto it = mCompiledScripts.find(sheep);
+	if(it != mCompiledScripts.end())
+	{
+		return it->second;
+	}
+	
+	SheepScript* script = mCompiler.Compile(name, sheep);
+	mCompiledScripts[sheep] = script;
+	mCompiledScriptsChanged = true;
+	return script;
+}
+
 SheepScript* SheepManager::CompileEval(const std::string& sheep)
 {
 	std::string fullSheep = StringUtil::Format(mEvalHusk, sheep.c_str());
-	return mCompiler.Compile("Case Evaluation", fullSheep);
+	return CompileCached("Case Evaluation", fullSheep);
+}
+
+void SheepManager::LoadCompiledCache()
+{
+	// No cache yet is fine - it'll be created by the first save.
+	std::string cachePath = Path::Combine({ kCompiledCacheDirectory, kCompiledCacheFileName });
+	std::ifstream cacheFile(cachePath, std::ios::in | std::ios::binary | std::ios::ate);
+	if(!cacheFile.good()) { return; }
+	int fileSize = (int)cacheFile.tellg();
+	cacheFile.close();
+	
+	// Ignore caches from other versions - those scripts will just be compiled again.
+	BinaryReader reader(cachePath);
+	if(!reader.OK()) { return; }
+	if(reader.ReadString(12) != "SheepCache" || reader.ReadInt() != kCompiledCacheVersion || !reader.OK()) { return; }
+	
+	// Lengths come from disk, so don't trust them further than the end of the file.
+	auto readLength = [&reader, fileSize]() -> int {
+		int length = reader.ReadInt();
+		if(!reader.OK() || length < 0 || length > fileSize - reader.GetPosition()) { return -1; }
+		return length;
+	};
+	
+	// Each entry is the script name, the sheep it was compiled from, and the compiled script data.
+	int scriptCount = reader.ReadInt();
+	if(!reader.OK() || scriptCount < 0) { return; }
+	int loadedCount = 0;
+	std::vector<char> data;
+	for(int i = 0; i < scriptCount; ++i)
+	{
+		int nameLength = readLength();
+		if(nameLength < 0) { break; }
+		std::string name = reader.ReadString(nameLength);
+		
+		int sheepLength = readLength();
+		if(sheepLength < 0) { break; }
+		std::string sheep = reader.ReadString(sheepLength);
+		
+		int dataLength = readLength();
+		if(dataLength < 0) { break; }
+		data.resize(dataLength);
+		reader.Read(data.data(), dataLength);
+		if(!reader.OK()) { break; }
+		
+		if(mCompiledScripts.find(sheep) == mCompiledScripts.end())
+		{
+			mCompiledScripts[sheep] = new SheepScript(name, data.data(), dataLength);
+		}
+		++loadedCount;
+	}
+	
+	// Whatever was read before a bad entry is still usable; the rest gets compiled again and the cache rewritten.
+	if(loadedCount < scriptCount)
+	{
+		std::cout << "Compiled sheep cache is incomplete or corrupt!" << std::endl;
+		mCompiledScriptsChanged = true;
+	}
+}
+
+void SheepManager::SaveCompiledCache()
+{
+	if(!mCompiledScriptsChanged) { return; }
+	mCompiledScriptsChanged = false;
+	
+	// Make sure the output directory exists.
+	Directory::CreateAll(kCompiledCacheDirectory);
+	
+	// Write to a temp file and swap it in when done, so a crash mid-save can't leave a truncated cache behind.
+	std::string cachePath = Path::Combine({ kCompiledCacheDirectory, kCompiledCacheFileName });
+	std::string tempPath = cachePath + ".tmp";
+	{
+		BinaryWriter writer(tempPath.c_str());
+		if(!writer.OK()) { return; }
+		
+		// Sheep that failed to compile isn't saved, so it gets another chance next run.
+		int scriptCount = 0;
+		for(auto& entry : mCompiledScripts)
+		{
+			if(entry.second != nullptr) { ++scriptCount; }
+		}
+		
+		std::string identifier = "SheepCache";
+		identifier.resize(12, '\0');
+		writer.WriteString(identifier);
+		writer.WriteInt(kCompiledCacheVersion);
+		writer.WriteInt(scriptCount);
+		for(auto& entry : mCompiledScripts)
+		{
+			if(entry.second == nullptr) { continue; }
+			
+			std::string name = entry.second->GetName();
+			writer.WriteInt((int)name.size());
+			writer.WriteString(name);
+			writer.WriteInt((int)entry.first.size());
+			writer.WriteString(entry.first);
+			
+			// Script data size isn't known until it's written, so write it, then go back and fill in the size.
+			int sizePosition = writer.GetPosition();
+			writer.WriteInt(0);
+			entry.second->WriteToData(writer);
+			int endPosition = writer.GetPosition();
+			writer.Seek(sizePosition);
+			writer.WriteInt(endPosition - sizePosition - 4);
+			writer.Seek(endPosition);
+		}
+		
+		if(!writer.OK())
+		{
+			std::cout << "Failed to write compiled sheep cache!" << std::endl;
+			std::remove(tempPath.c_str());
+			return;
+		}
+	}
+	
+	// Rename won't replace an existing file on all platforms, so remove the old cache first.
+	std::remove(cachePath.c_str());
+	if(std::rename(tempPath.c_str(), cachePath.c_str()) != 0)
+	{
+		std::cout << "Failed to replace compiled sheep cache!" << std::endl;
+		std::remove(tempPath.c_str());
+	}
 }
 
 void SheepManager::Execute(const std::string& sheepName, const std::string& functionName, std::function<void()> finishCallback)
@@ -8,6 +8,8 @@
 //
 #pragma once
 #include <stack>
+#include <string>
+#include <unordered_map>
 
 #include "SheepCompiler.h"
 #include "SheepVM.h"
@@ -15,10 +17,20 @@
 class SheepManager
 {
 public:
+	~SheepManager();
+	
     SheepScript* Compile(const char* filePath);
     SheepScript* Compile(const std::string& name, const std::string& sheep);
     SheepScript* Compile(const std::string& name, std::istream& stream);
+	
+	// Identical sheep is only compiled once; the same script is returned for it every time after.
+	// The manager owns these scripts, so callers must not delete them.
+	SheepScript* CompileCached(const std::string& name, const std::string& sheep);
 	SheepScript* CompileEval(const std::string& sheep);
+	
+	// Scripts compiled with CompileCached can be saved to disk, so later runs don't need to compile them again.
+	void LoadCompiledCache();
+	void SaveCompiledCache();
     
 	void Execute(const std::string& sheepName, const std::string& functionName, std::function<void()> finishCallback);
 	void Execute(SheepScript* script, std::function<void()> finishCallback);
@@ -30,6 +42,7 @@ public:
 	SheepThread* GetCurrentThread() const { return mVirtualMachine.GetCurrentThread(); }
 	bool IsAnyRunning() const { return mVirtualMachine.IsAnyRunning(); }
 	void FlagExecutionError() { mVirtualMachine.FlagExecutionError(); }
+	void SetThreadedCodeEnabled(bool enabled) { mVirtualMachine.SetThreadedCodeEnabled(enabled); }
 	
 private:
 	// Compiles text-based sheep script into sheep bytecode, represented as a SheepScript asset.
@@ -39,4 +52,16 @@ private:
 	SheepVM mVirtualMachine;
 	
 	std::string mEvalHusk = "symbols { int n$ = 0; int v$ = 0; } code { X$() %s }";
+	
+	// Scripts compiled with CompileCached, keyed by their sheep text.
+	// Sheep that failed to compile maps to null, so it isn't compiled (and doesn't log errors) again.
+	std::unordered_map<std::string, SheepScript*> mCompiledScripts;
+	
+	// If true, scripts were compiled since the cache was loaded/saved, so it should be saved again.
+	bool mCompiledScriptsChanged = false;
+	
+	// Where compiled scripts are saved. Version must change if the compiler's output changes.
+	const std::string kCompiledCacheDirectory = "Cache";
+	const std::string kCompiledCacheFileName = "SHEEP.BIN";
+	const int kCompiledCacheVersion = 1;
 };
@@ -0,0 +1,141 @@
+//
+// SheepProgram.cpp
+//
+// Clark Kromenaker
+//
+#include "SheepProgram.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "BinaryReader.h"
+#include "SheepAPI.h"
+#include "SheepScript.h"
+
+SheepProgram::SheepProgram(SheepScript& script)
+{
+	mValid = Decode(script);
+	if(!mValid)
+	{
+		mOps.clear();
+		mOpOffsets.clear();
+	}
+}
+
+int SheepProgram::GetOpIndex(int bytecodeOffset) const
+{
+	auto it = std::lower_bound(mOpOffsets.begin(), mOpOffsets.end(), bytecodeOffset);
+	if(it == mOpOffsets.end() || *it != bytecodeOffset) { return -1; }
+	return static_cast<int>(it - mOpOffsets.begin());
+}
+
+bool SheepProgram::Decode(SheepScript& script)
+{
+	char* bytecode = script.GetBytecode();
+	int bytecodeLength = script.GetBytecodeLength();
+	if(bytecode == nullptr) { return false; }
+	BinaryReader reader(bytecode, bytecodeLength);
+	if(!reader.OK()) { return false; }
+
+	// First, decode each instruction into an op, with branch targets still as bytecode offsets.
+	std::vector<SheepOp> ops;
+	std::vector<int> opOffsets;
+	std::unordered_set<int> branchTargets;
+	while(reader.GetPosition() < bytecodeLength)
+	{
+		opOffsets.push_back(reader.GetPosition());
+		unsigned char instruction = reader.ReadUByte();
+
+		SheepOp op;
+		op.opcode = instruction < static_cast<unsigned char>(SheepOpcode::PushStringConst) ? static_cast<SheepOpcode>(instruction) : SheepOpcode::Unknown;
+		switch(op.opcode)
+		{
+		case SheepOpcode::CallSysFunctionV:
+		case SheepOpcode::CallSysFunctionI:
+		case SheepOpcode::CallSysFunctionF:
+		case SheepOpcode::CallSysFunctionS:
+			op.intValue = reader.ReadInt();
+			op.sysImport = script.GetSysImport(op.intValue);
+			if(op.sysImport != nullptr)
+			{
+				op.sysFunc = GetSysFuncDecl(op.sysImport);
+			}
+			break;
+
+		case SheepOpcode::Branch:
+		case SheepOpcode::BranchGoto:
+		case SheepOpcode::BranchIfZero:
+			op.intValue = reader.ReadInt();
+			branchTargets.insert(op.intValue);
+			break;
+
+		case SheepOpcode::StoreI:
+		case SheepOpcode::StoreF:
+		case SheepOpcode::StoreS:
+		case SheepOpcode::LoadI:
+		case SheepOpcode::LoadF:
+		case SheepOpcode::LoadS:
+		case SheepOpcode::PushI:
+		case SheepOpcode::PushS:
+		case SheepOpcode::IToF:
+		case SheepOpcode::FToI:
+			op.intValue = reader.ReadInt();
+			break;
+
+		case SheepOpcode::PushF:
+			op.floatValue = reader.ReadFloat();
+			break;
+
+		case SheepOpcode::Unknown:
+			op.intValue = static_cast<char>(instruction);
+			break;
+
+		default:
+			break;
+		}
+
+		// An operand that runs off the end of the bytecode can't be decoded.
+		if(!reader.OK()) { return false; }
+		ops.push_back(op);
+	}
+
+	// Running off the end of the bytecode ends execution.
+	SheepOp endOp;
+	endOp.opcode = SheepOpcode::End;
+	ops.push_back(endOp);
+	opOffsets.push_back(bytecodeLength);
+
+	// Next, combine pushing a string constant offset and then getting the string into a single op.
+	// This can't be done if something branches to the "GetString", or if the string constant doesn't exist.
+	for(size_t i = 0; i < ops.size(); ++i)
+	{
+		if(ops[i].opcode == SheepOpcode::PushS && i + 1 < ops.size() && ops[i + 1].opcode == SheepOpcode::GetString &&
+		   branchTargets.find(opOffsets[i + 1]) == branchTargets.end())
+		{
+			std::string* stringConst = script.GetStringConst(ops[i].intValue);
+			if(stringConst != nullptr)
+			{
+				SheepOp op;
+				op.opcode = SheepOpcode::PushStringConst;
+				op.stringValue = stringConst->c_str();
+				mOps.push_back(op);
+				mOpOffsets.push_back(opOffsets[i]);
+				++i;
+				continue;
+			}
+		}
+		mOps.push_back(ops[i]);
+		mOpOffsets.push_back(opOffsets[i]);
+	}
+
+	// Finally, convert branch targets to op indexes. Branching anywhere but the start of an op can't be supported.
+	for(auto& op : mOps)
+	{
+		if(op.opcode == SheepOpcode::Branch || op.opcode == SheepOpcode::BranchGoto || op.opcode == SheepOpcode::BranchIfZero)
+		{
+			op.intValue = GetOpIndex(op.intValue);
+			if(op.intValue < 0) { return false; }
+		}
+	}
+	return true;
+}
@@ -0,0 +1,133 @@
+//
+// SheepProgram.h
+//
+// Clark Kromenaker
+//
+// Sheep bytecode, decoded ahead of time into a compact array of operations.
+//
+// Bytecode stores variable-length instructions with operands that must be read and looked up
+// each time they're executed (sys function imports, string constant offsets, branch byte offsets).
+// A program does that work once: each op has its operands resolved (sys function declarations,
+// string constant pointers, branch targets as op indexes), so the VM can execute ops directly.
+//
+// Sheep threads track execution by bytecode offset, so ops remember their bytecode offsets.
+// Bytecode that can't be decoded safely (e.g. branches into the middle of an instruction) gives an invalid program.
+//
+#pragma once
+#include <vector>
+
+class SheepScript;
+struct SysFuncDecl;
+struct SysImport;
+
+enum class SheepOpcode : unsigned char
+{
+	// Values 0x00 to 0x34 match SheepInstruction values.
+	SitnSpin            = 0x00,
+	Yield               = 0x01,
+	CallSysFunctionV    = 0x02,
+	CallSysFunctionI    = 0x03,
+	CallSysFunctionF    = 0x04,
+	CallSysFunctionS    = 0x05,
+	Branch              = 0x06,
+	BranchGoto          = 0x07,
+	BranchIfZero        = 0x08,
+	BeginWait           = 0x09,
+	EndWait             = 0x0A,
+	ReturnV             = 0x0B,
+	Unknown             = 0x0C, // Any unrecognized instruction.
+	StoreI              = 0x0D,
+	StoreF              = 0x0E,
+	StoreS              = 0x0F,
+	LoadI               = 0x10,
+	LoadF               = 0x11,
+	LoadS               = 0x12,
+	PushI               = 0x13,
+	PushF               = 0x14,
+	PushS               = 0x15,
+	Pop                 = 0x16,
+	AddI                = 0x17,
+	AddF                = 0x18,
+	SubtractI           = 0x19,
+	SubtractF           = 0x1A,
+	MultiplyI           = 0x1B,
+	MultiplyF           = 0x1C,
+	DivideI             = 0x1D,
+	DivideF             = 0x1E,
+	NegateI             = 0x1F,
+	NegateF             = 0x20,
+	IsEqualI            = 0x21,
+	IsEqualF            = 0x22,
+	IsNotEqualI         = 0x23,
+	IsNotEqualF         = 0x24,
+	IsGreaterI          = 0x25,
+	IsGreaterF          = 0x26,
+	IsLessI             = 0x27,
+	IsLessF             = 0x28,
+	IsGreaterEqualI     = 0x29,
+	IsGreaterEqualF     = 0x2A,
+	IsLessEqualI        = 0x2B,
+	IsLessEqualF        = 0x2C,
+	IToF                = 0x2D,
+	FToI                = 0x2E,
+	Modulo              = 0x2F,
+	And                 = 0x30,
+	Or                  = 0x31,
+	Not                 = 0x32,
+	GetString           = 0x33,
+	DebugBreakpoint     = 0x34,
+
+	// Only exist in decoded programs.
+	PushStringConst     = 0x35, // A "PushS" followed by "GetString", combined.
+	End                 = 0x36, // Reached end of bytecode.
+	Count
+};
+
+struct SheepOp
+{
+	SheepOpcode opcode = SheepOpcode::SitnSpin;
+
+	// Operand, depending on the opcode:
+	// Int value to push, variable index, sys import index, stack index, branch target op index, or unknown instruction byte.
+	// Float value to push.
+	union
+	{
+		int intValue = 0;
+		float floatValue;
+	};
+
+	// Resolved operand, depending on the opcode: sys import, or string constant.
+	union
+	{
+		SysImport* sysImport = nullptr;
+		const char* stringValue;
+	};
+
+	// For sys function calls, the function's declaration (null if undeclared).
+	SysFuncDecl* sysFunc = nullptr;
+};
+
+class SheepProgram
+{
+public:
+	SheepProgram(SheepScript& script);
+
+	bool IsValid() const { return mValid; }
+
+	const SheepOp* GetOps() const { return mOps.data(); }
+
+	// Converts between bytecode offsets and op indexes.
+	// Returns -1 if the offset isn't the start of an op (and so can't be executed from).
+	int GetOpIndex(int bytecodeOffset) const;
+	int GetBytecodeOffset(int opIndex) const { return mOpOffsets[opIndex]; }
+
+private:
+	std::vector<SheepOp> mOps;
+
+	// Bytecode offset of each op, in increasing order.
+	std::vector<int> mOpOffsets;
+
+	bool mValid = false;
+
+	bool Decode(SheepScript& script);
+};
@@ -6,9 +6,12 @@
 //
 #include "SheepScript.h"
 
+#include <algorithm>
 #include <iostream>
 
 #include "BinaryReader.h"
+#include "BinaryWriter.h"
+#include "SheepProgram.h"
 #include "SheepScriptBuilder.h"
 #include "StringUtil.h"
 
@@ -32,6 +35,11 @@ SheepScript::SheepScript(const std::string& name, SheepScriptBuilder& builder) :
     std::copy(bytecodeVec.begin(), bytecodeVec.end(), mBytecode);
 }
 
+SheepScript::~SheepScript()
+{
+    delete mProgram;
+}
+
 SysImport* SheepScript::GetSysImport(int index)
 {
     if(index < 0 || index >= mSysImports.size()) { return nullptr; }
@@ -62,6 +70,15 @@ int SheepScript::GetFunctionOffset(std::string functionName)
     return -1;
 }
 
+SheepProgram* SheepScript::GetProgram()
+{
+    if(mProgram == nullptr)
+    {
+        mProgram = new SheepProgram(*this);
+    }
+    return mProgram;
+}
+
 void SheepScript::Dump()
 {
     std::cout << "Dumping sheep " << mName << std::endl << std::endl;
@@ -70,6 +87,187 @@ void SheepScript::Dump()
     std::cout << "--------------------------------------------------------------------------" << std::endl;
 }
 
+namespace
+{
+    // Each section starts with a 12 byte identifier, then two copies of the header size.
+    const int kSectionHeaderSize = 20;
+    
+    void WriteSectionHeader(BinaryWriter& writer, const std::string& identifier)
+    {
+        std::string paddedIdentifier = identifier;
+        paddedIdentifier.resize(12, '\0');
+        writer.WriteString(paddedIdentifier);
+        writer.WriteInt(kSectionHeaderSize);
+        writer.WriteInt(kSectionHeaderSize);
+    }
+    
+    // Names are written as length, then characters with a null terminator (not included in the length).
+    void WriteName(BinaryWriter& writer, const std::string& name)
+    {
+        writer.WriteShort(static_cast<int16_t>(name.size()));
+        writer.WriteString(name);
+        writer.WriteUByte(0);
+    }
+}
+
+void SheepScript::WriteToData(BinaryWriter& writer)
+{
+    // Size of each item in variable-size sections, so offsets and section sizes can be written up front.
+    std::vector<int> sysImportSizes;
+    for(auto& sysImport : mSysImports)
+    {
+        sysImportSizes.push_back(2 + (int)sysImport.name.size() + 1 + 2 + (int)sysImport.argumentTypes.size());
+    }
+    std::vector<std::pair<int, std::string>> functions;
+    for(auto& entry : mFunctions)
+    {
+        functions.push_back(std::make_pair(entry.second, entry.first));
+    }
+    std::sort(functions.begin(), functions.end());
+    std::vector<int> functionSizes;
+    for(auto& entry : functions)
+    {
+        functionSizes.push_back(2 + (int)entry.second.size() + 1 + 2 + 4);
+    }
+    
+    // Bytecode refers to string consts by offset, so they must be written at the same offsets.
+    std::vector<std::pair<int, std::string>> stringConsts(mStringConsts.begin(), mStringConsts.end());
+    std::sort(stringConsts.begin(), stringConsts.end());
+    int stringConstsSize = 0;
+    for(auto& entry : stringConsts)
+    {
+        stringConstsSize = std::max(stringConstsSize, entry.first + (int)entry.second.size() + 1);
+    }
+    
+    // Each variable is an empty name, a type, and a 4 byte value.
+    const int kVariableSize = 2 + 1 + 4 + 4;
+    
+    // Size of each section, including its header. Sys imports, variables, and functions have a count and offsets after the header.
+    auto sum = [](const std::vector<int>& sizes) { int total = 0; for(int size : sizes) { total += size; } return total; };
+    const int kSectionCount = 5;
+    int sectionSizes[kSectionCount] = {
+        kSectionHeaderSize + 8 + 4 * (int)mSysImports.size() + sum(sysImportSizes),
+        kSectionHeaderSize + 8 + 4 * (int)stringConsts.size() + stringConstsSize,
+        kSectionHeaderSize + 8 + 4 * (int)mVariables.size() + kVariableSize * (int)mVariables.size(),
+        kSectionHeaderSize + 8 + 4 * (int)functions.size() + sum(functionSizes),
+        kSectionHeaderSize + 8 + mBytecodeLength
+    };
+    
+    // File header: identifier, version, header size (twice), size of content after header, section count and offsets.
+    const int kHeaderSize = 8 + 4 + 4 + 4 + 4 + 4 + 4 * kSectionCount;
+    int contentSize = 0;
+    for(int size : sectionSizes)
+    {
+        contentSize += size;
+    }
+    writer.WriteString("GK3Sheep");
+    writer.WriteInt(0);
+    writer.WriteInt(kHeaderSize);
+    writer.WriteInt(kHeaderSize);
+    writer.WriteInt(contentSize);
+    writer.WriteInt(kSectionCount);
+    int sectionOffset = 0;
+    for(int size : sectionSizes)
+    {
+        writer.WriteInt(sectionOffset);
+        sectionOffset += size;
+    }
+    
+    // Sys imports.
+    WriteSectionHeader(writer, "SysImports");
+    writer.WriteInt(sum(sysImportSizes));
+    writer.WriteInt((int)mSysImports.size());
+    int itemOffset = 0;
+    for(int size : sysImportSizes)
+    {
+        writer.WriteInt(itemOffset);
+        itemOffset += size;
+    }
+    for(auto& sysImport : mSysImports)
+    {
+        WriteName(writer, sysImport.name);
+        writer.WriteSByte(sysImport.returnType);
+        writer.WriteSByte(static_cast<int8_t>(sysImport.argumentTypes.size()));
+        for(char argumentType : sysImport.argumentTypes)
+        {
+            writer.WriteSByte(argumentType);
+        }
+    }
+    
+    // String consts, with any gaps between them zero-filled.
+    WriteSectionHeader(writer, "StringConsts");
+    writer.WriteInt(stringConstsSize);
+    writer.WriteInt((int)stringConsts.size());
+    for(auto& entry : stringConsts)
+    {
+        writer.WriteInt(entry.first);
+    }
+    int stringOffset = 0;
+    for(auto& entry : stringConsts)
+    {
+        for(; stringOffset < entry.first; ++stringOffset)
+        {
+            writer.WriteUByte(0);
+        }
+        writer.WriteString(entry.second);
+        writer.WriteUByte(0);
+        stringOffset += (int)entry.second.size() + 1;
+    }
+    
+    // Variables.
+    WriteSectionHeader(writer, "Variables");
+    writer.WriteInt(kVariableSize * (int)mVariables.size());
+    writer.WriteInt((int)mVariables.size());
+    for(int i = 0; i < mVariables.size(); ++i)
+    {
+        writer.WriteInt(kVariableSize * i);
+    }
+    for(auto& variable : mVariables)
+    {
+        WriteName(writer, "");
+        switch(variable.type)
+        {
+        default:
+        case SheepValueType::Int:
+            writer.WriteInt(1);
+            writer.WriteInt(variable.intValue);
+            break;
+        case SheepValueType::Float:
+            writer.WriteInt(2);
+            writer.WriteFloat(variable.floatValue);
+            break;
+        case SheepValueType::String:
+            writer.WriteInt(3);
+            writer.WriteInt(0);
+            break;
+        }
+    }
+    
+    // Functions, in code order.
+    WriteSectionHeader(writer, "Functions");
+    writer.WriteInt(sum(functionSizes));
+    writer.WriteInt((int)functions.size());
+    itemOffset = 0;
+    for(int size : functionSizes)
+    {
+        writer.WriteInt(itemOffset);
+        itemOffset += size;
+    }
+    for(auto& entry : functions)
+    {
+        WriteName(writer, entry.second);
+        writer.WriteShort(0);
+        writer.WriteInt(entry.first);
+    }
+    
+    // Code: one code block, containing all bytecode.
+    WriteSectionHeader(writer, "Code");
+    writer.WriteInt(mBytecodeLength);
+    writer.WriteInt(1);
+    writer.WriteInt(0);
+    writer.Write(mBytecode, mBytecodeLength);
+}
+
 void SheepScript::ParseFromData(char *data, int dataLength)
 {
     BinaryReader reader(data, dataLength);
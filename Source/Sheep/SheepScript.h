@@ -14,6 +14,8 @@
 #include "SheepVM.h"
 
 class BinaryReader;
+class BinaryWriter;
+class SheepProgram;
 class SheepScriptBuilder;
 
 struct SysImport
@@ -48,20 +50,30 @@ class SheepScript : public Asset
 public:
     SheepScript(std::string name, char* data, int dataLength);
     SheepScript(const std::string& name, SheepScriptBuilder& builder);
+    ~SheepScript();
     
     SysImport* GetSysImport(int index);
     
     std::string* GetStringConst(int offset);
+    const std::unordered_map<int, std::string>& GetStringConsts() const { return mStringConsts; }
     
     std::vector<SheepValue> GetVariables() { return mVariables; }
     
     int GetFunctionOffset(std::string functionName); 
+    const std::unordered_map<std::string, int>& GetFunctions() const { return mFunctions; }
     
     char* GetBytecode() { return mBytecode; }
     int GetBytecodeLength() { return mBytecodeLength; }
     
+    // Bytecode decoded for faster execution. Decoded the first time it's needed.
+    SheepProgram* GetProgram();
+    
     void Dump();
     
+    // Writes the script in the same binary format it can be parsed from.
+    // Variable names aren't kept after compiling, and string variable defaults aren't read back in, so neither are written.
+    void WriteToData(BinaryWriter& writer);
+    
 private:
     std::vector<SysImport> mSysImports;
     
@@ -80,6 +92,9 @@ private:
     char* mBytecode = nullptr;
     int mBytecodeLength = 0;
     
+    // Decoded bytecode; null until first requested.
+    SheepProgram* mProgram = nullptr;
+    
     void ParseFromData(char* data, int dataLength);
     void ParseSysImportsSection(BinaryReader& reader);
     void ParseStringConstsSection(BinaryReader& reader);
@@ -61,6 +61,53 @@ void SheepStack::PushString(const char* str)
 	#endif
 }
 
+void SheepStack::PushString(const std::string& str)
+{
+	mStackSize++;
+	assert(mStackSize < kMaxStackSize);
+	
+	mStrings[mStackSize - 1] = str;
+	mStack[mStackSize - 1].type = SheepValueType::String;
+	mStack[mStackSize - 1].stringValue = mStrings[mStackSize - 1].c_str();
+	
+	#ifdef SHEEP_DEBUG
+	std::cout << "SHEEP STACK: Push 1 (Stack Size = " << mStackSize << ")" << std::endl;
+	#endif
+}
+
+void SheepStack::PushStringCopy(const char* str)
+{
+	mStackSize++;
+	assert(mStackSize < kMaxStackSize);
+	
+	mStrings[mStackSize - 1] = str;
+	mStack[mStackSize - 1].type = SheepValueType::String;
+	mStack[mStackSize - 1].stringValue = mStrings[mStackSize - 1].c_str();
+	
+	#ifdef SHEEP_DEBUG
+	std::cout << "SHEEP STACK: Push 1 (Stack Size = " << mStackSize << ")" << std::endl;
+	#endif
+}
+
+const std::string& SheepStack::OwnString(int index)
+{
+	assert(index >= 0 && index < mStackSize);
+	int slot = mStackSize - 1 - index;
+	SheepValue& value = mStack[slot];
+	std::string& str = mStrings[slot];
+	if(value.type != SheepValueType::String)
+	{
+		str = value.GetString();
+	}
+	else if(value.stringValue != str.c_str())
+	{
+		str = value.stringValue;
+	}
+	value.type = SheepValueType::String;
+	value.stringValue = str.c_str();
+	return str;
+}
+
 SheepValue& SheepStack::Pop()
 {
 	SheepValue& top = mStack[mStackSize - 1];
@@ -7,6 +7,9 @@
 //
 #pragma once
 
+#include <cassert>
+#include <string>
+
 #include "SheepValue.h"
 
 struct SheepStack
@@ -16,9 +19,18 @@ public:
 	void PushFloat(float val);
 	void PushStringOffset(int val);
 	void PushString(const char* str);
+	void PushString(const std::string& str);
+	void PushStringCopy(const char* str);
 	
 	SheepValue& Peek() { assert(mStackSize > 0); return mStack[mStackSize - 1]; }
 	SheepValue& Peek(int index) { assert(mStackSize > 0 && index < mStackSize); return mStack[mStackSize - 1 - index]; }
+	// Makes the value at an index (from the top) a string the stack owns, converting or copying it if needed.
+	// Each slot's string keeps its memory, so this rarely allocates.
+	const std::string& OwnString(int index);
+	
+	// The strings owned by the top "count" slots, in stack order. Only meaningful for values passed to OwnString.
+	const std::string* PeekStrings(int count) const { assert(count > 0 && count <= mStackSize); return &mStrings[mStackSize - count]; }
+	
 	SheepValue& Pop();
 	void Pop(int count);
 	
@@ -29,4 +41,8 @@ private:
 	static const int kMaxStackSize = 1024;
 	int mStackSize = 0;
 	SheepValue mStack[kMaxStackSize];
+	
+	// Backing storage for strings pushed by value (e.g. sys func results), or owned for sys func args.
+	// Each slot owns its own copy, so nested calls can't clobber each other's results.
+	std::string mStrings[kMaxStackSize];
 };
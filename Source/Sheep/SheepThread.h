@@ -27,6 +27,10 @@ struct SheepThread
 	// Each thread has its own stack.
 	SheepStack mStack;
 	
+	// Scratch buffer for the string returned by a sys func call.
+	// Only valid until the next call; the VM copies it onto the stack right away.
+	std::string mStringResult;
+	
 	// Current code offset for attached sheep (aka the instruction pointer).
 	int mCodeOffset = 0;
 	
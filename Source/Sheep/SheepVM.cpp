@@ -10,6 +10,7 @@
 #include "BinaryReader.h"
 #include "GMath.h"
 #include "SheepAPI.h"
+#include "SheepProgram.h"
 #include "SheepScript.h"
 #include "Services.h"
 #include "StringUtil.h"
@@ -25,6 +26,12 @@ std::string SheepInstance::GetName()
 	return "";
 }
 
+void SheepInstance::StoreString(int varIndex, const char* str)
+{
+	mStringVariables[varIndex] = str;
+	mVariables[varIndex].stringValue = mStringVariables[varIndex].c_str();
+}
+
 SheepVM::~SheepVM()
 {
 	for(auto& instance : mSheepInstances)
@@ -167,6 +174,7 @@ SheepInstance* SheepVM::GetInstance(SheepScript* script)
 	
 	// Create copy of variables for assignment during execution.
 	context->mVariables = script->GetVariables();
+	context->mStringVariables.resize(context->mVariables.size());
 	return context;
 }
 
@@ -193,7 +201,7 @@ SheepThread* SheepVM::GetThread()
 	return useThread;
 }
 
-Value SheepVM::CallSysFunc(SheepThread* thread, SysImport* sysImport)
+SheepValue SheepVM::CallSysFunc(SheepThread* thread, SysImport* sysImport)
 {
 	// Retrieve system function declaration for the system function import.
 	// We need the full declaration to know whether this is a waitable function!
@@ -201,38 +209,50 @@ Value SheepVM::CallSysFunc(SheepThread* thread, SysImport* sysImport)
 	if(sysFunc == nullptr)
 	{
 		std::cout << "Sheep uses undeclared function " << sysImport->name << std::endl;
-		return Value(0);
+		return SheepValue(0);
 	}
-	
+	return CallSysFunc(thread, sysFunc);
+}
+
+SheepValue SheepVM::CallSysFunc(SheepThread* thread, const SheepOp& op)
+{
+	// Same as above, but the declaration was already looked up when decoding.
+	if(op.sysFunc == nullptr)
+	{
+		std::cout << "Sheep uses undeclared function " << op.sysImport->name << std::endl;
+		return SheepValue(0);
+	}
+	return CallSysFunc(thread, op.sysFunc);
+}
+
+SheepValue SheepVM::CallSysFunc(SheepThread* thread, SysFuncDecl* sysFunc)
+{
 	// Number on top of stack is argument count.
 	// Make sure it matches the argument count from the system function declaration.
 	int argCount = thread->mStack.Pop().intValue;
-	assert(argCount == sysFunc->argumentTypes.size());
+	if(argCount != sysFunc->argumentTypes.size())
+	{
+		std::cout << "SheepVM: " << sysFunc->name << " expects " << sysFunc->argumentTypes.size() << " args, but got " << argCount << std::endl;
+		thread->mStack.Pop(argCount);
+		return SheepValue(0);
+	}
 	
-	// Retrieve the arguments, of the expected types, from the stack.
-	std::vector<Value> args;
-	for(int i = 0; i < argCount; i++)
-	{
-		SheepValue& sheepValue = thread->mStack.Peek(argCount - 1 - i);
-		//SheepValue sheepValue = mStack[mStackSize - (argCount - i)];
-		int argType = sysFunc->argumentTypes[i];
-		switch(argType)
+	// Arguments are on the stack in order, so the function can read them in place.
+	// String args are passed as strings the stack owns, so they don't need to be copied into new strings for each call.
+	SheepValue* args = nullptr;
+	const std::string* argStrings = nullptr;
+	if(argCount > 0)
+	{
+		for(int i = 0; i < argCount; ++i)
 		{
-		case 1:
-			args.push_back(sheepValue.GetInt());
-			break;
-		case 2:
-			args.push_back(sheepValue.GetFloat());
-			break;
-		case 3:
-			args.push_back(sheepValue.GetString());
-			break;
-		default:
-			std::cout << "Invalid arg type: " << argType << std::endl;
-			break;
+			if(sysFunc->argumentTypes[i] == string_TYPE)
+			{
+				thread->mStack.OwnString(argCount - 1 - i);
+			}
 		}
+		args = &thread->mStack.Peek(argCount - 1);
+		argStrings = thread->mStack.PeekStrings(argCount);
 	}
-	thread->mStack.Pop(argCount);
 	
 	/*
 	{
@@ -240,19 +260,7 @@ Value SheepVM::CallSysFunc(SheepThread* thread, SysImport* sysImport)
 		std::cout << "SysFunc " << sysFunc->name << "(";
 		for(int i = 0; i < argCount; i++)
 		{
-			switch(sysFunc->argumentTypes[i])
-			{
-			case 1:
-				std::cout << args[i].to<int>();
-				break;
-			case 2:
-				std::cout << args[i].to<float>();
-				break;
-			case 3:
-				std::cout << args[i].to<std::string>();
-				break;
-			}
-
+			std::cout << args[i].GetString();
 			if(i < argCount - 1)
 			{
 				std::cout << ", ";
@@ -262,35 +270,9 @@ Value SheepVM::CallSysFunc(SheepThread* thread, SysImport* sysImport)
 	}
 	*/
 	
-	// Based on argument count, call the appropriate function variant.
-	Value v = Value(0);
-	switch(argCount)
-	{
-	case 0:
-		v = ::CallSysFunc(sysFunc->name);
-		break;
-	case 1:
-		v = ::CallSysFunc(sysFunc->name, args[0]);
-		break;
-	case 2:
-		v = ::CallSysFunc(sysFunc->name, args[0], args[1]);
-		break;
-	case 3:
-		v = ::CallSysFunc(sysFunc->name, args[0], args[1], args[2]);
-		break;
-	case 4:
-		v = ::CallSysFunc(sysFunc->name, args[0], args[1], args[2], args[3]);
-		break;
-	case 5:
-		v = ::CallSysFunc(sysFunc->name, args[0], args[1], args[2], args[3], args[4]);
-		break;
-	case 6:
-		v = ::CallSysFunc(sysFunc->name, args[0], args[1], args[2], args[3], args[4], args[5]);
-		break;
-	default:
-		std::cout << "SheepVM: Unimplemented arg count: " << argCount << std::endl;
-		break;
-	}
+	// Call the function directly. Args are converted to the correct types by the caller.
+	SheepValue result = sysFunc->caller(args, argStrings, thread->mStringResult);
+	thread->mStack.Pop(argCount);
 	
 	// Output a general execution exception if we encountered a problem in the sys func call.
 	if(mExecutionError)
@@ -300,7 +282,7 @@ Value SheepVM::CallSysFunc(SheepThread* thread, SysImport* sysImport)
 	}
 	
 	// Return result of sys func call.
-	return v;
+	return result;
 }
 
 SheepThread* SheepVM::ExecuteInternal(SheepScript *script, int bytecodeOffset,
@@ -359,6 +341,49 @@ void SheepVM::ExecuteInternal(SheepThread* thread)
 		Services::GetReports()->Log("SheepMachine", "Sheep " + thread->GetName() + " released at line -1");
 	}
 	
+	// Execute decoded ops if possible, since that's much faster.
+	// Otherwise (or if disabled, to validate against), interpret the bytecode directly.
+	SheepProgram* program = mThreadedCodeEnabled ? thread->mContext->mSheepScript->GetProgram() : nullptr;
+	int opIndex = (program != nullptr && program->IsValid()) ? program->GetOpIndex(thread->mCodeOffset) : -1;
+	if(opIndex >= 0)
+	{
+		ExecuteProgram(thread, *program, opIndex);
+	}
+	else if(!ExecuteBytecode(thread))
+	{
+		return;
+	}
+	
+	// If thread is no longer running, notify anyone who was waiting for the thread to finish.
+	// If we get here and the thread IS running, it means the thread was blocked due to a wait!
+	if(!thread->mRunning)
+	{
+		Services::GetReports()->Log("SheepMachine", "Sheep " + thread->GetName() + " is exiting");
+		
+		// Thread is no longer using execution context.
+		thread->mContext->mReferenceCount--;
+		
+		// Call my wait callback - someone might have been waiting for this thread to finish.
+		if(thread->mWaitCallback)
+		{
+			thread->mWaitCallback();
+		}
+	}
+	else if(thread->mInWaitBlock)
+	{
+		Services::GetReports()->Log("SheepMachine", "Sheep " + thread->GetName() + " is blocked at line -1");
+	}
+	else
+	{
+		Services::GetReports()->Log("SheepMachine", "Sheep " + thread->GetName() + " is in some weird unexpected state!");
+	}
+	
+	// Restore previously executing thread.
+	mCurrentThread = prevThread;
+}
+
+bool SheepVM::ExecuteBytecode(SheepThread* thread)
+{
 	// Get instance/script we'll be using.
 	SheepInstance* instance = thread->mContext;
 	SheepScript* script = instance->mSheepScript;
@@ -369,7 +394,7 @@ void SheepVM::ExecuteInternal(SheepThread* thread)
     
     // Create reader for the bytecode.
     BinaryReader reader(bytecode, bytecodeLength);
-    if(!reader.OK()) { return; }
+    if(!reader.OK()) { return false; }
     
     // Skip ahead to desired offset.
     reader.Skip(thread->mCodeOffset);
@@ -420,12 +445,12 @@ void SheepVM::ExecuteInternal(SheepThread* thread)
 				#endif
 				
 				// Execute the system function.
-                Value value = CallSysFunc(thread, sysFunc);
+                SheepValue value = CallSysFunc(thread, sysFunc);
 				
 				// Though this is void return, we still push type of "shpvoid" onto stack.
 				// The compiler generates an extra "Pop" instruction after a CallSysFunctionV.
 				// This matches how the original game's compiler generated instructions!
-				thread->mStack.PushInt(value.to<shpvoid>());
+				thread->mStack.PushInt(value.GetInt());
                 break;
             }
             case SheepInstruction::CallSysFunctionI:
@@ -443,10 +468,10 @@ void SheepVM::ExecuteInternal(SheepThread* thread)
 				#endif
 				
 				// Execute the system function.
-                Value value = CallSysFunc(thread, sysFunc);
+                SheepValue value = CallSysFunc(thread, sysFunc);
 				
 				// Push the int result onto the stack.
-				thread->mStack.PushInt(value.to<int>());
+				thread->mStack.PushInt(value.GetInt());
                 break;
             }
             case SheepInstruction::CallSysFunctionF:
@@ -464,10 +489,10 @@ void SheepVM::ExecuteInternal(SheepThread* thread)
 				#endif
 				
 				// Execute the system function.
-                Value value = CallSysFunc(thread, sysFunc);
+                SheepValue value = CallSysFunc(thread, sysFunc);
 				
 				// Push the float result onto the stack.
-				thread->mStack.PushFloat(value.to<float>());
+				thread->mStack.PushFloat(value.GetFloat());
                 break;
             }
             case SheepInstruction::CallSysFunctionS:
@@ -485,10 +510,18 @@ void SheepVM::ExecuteInternal(SheepThread* thread)
 				#endif
 				
 				// Execute the system function.
-                Value value = CallSysFunc(thread, sysFunc);
+                SheepValue value = CallSysFunc(thread, sysFunc);
 				
-				// Push the string result onto the stack.
-				thread->mStack.PushString(value.to<std::string>().c_str()); //TODO: Seems like this could cause problems? Where is value's string coming from? What if it is deallocated???
+				// Push a copy of the string result onto the stack.
+				// The sys func writes into a per-thread scratch buffer, which the next call reuses.
+				if(value.type == SheepValueType::String)
+				{
+					thread->mStack.PushStringCopy(value.stringValue);
+				}
+				else
+				{
+					thread->mStack.PushString(value.GetString());
+				}
                 break;
             }
             case SheepInstruction::Branch:
@@ -606,7 +639,7 @@ void SheepVM::ExecuteInternal(SheepThread* thread)
 					
                     assert(instance->mVariables[varIndex].type == SheepValueType::String);
 					SheepValue& value = thread->mStack.Pop();
-                    instance->mVariables[varIndex].stringValue = value.stringValue;
+                    instance->StoreString(varIndex, value.stringValue);
                 }
                 break;
             }
@@ -1096,31 +1129,526 @@ void SheepVM::ExecuteInternal(SheepThread* thread)
 	{
 		thread->mRunning = false;
 	}
+	return true;
+}
+
+// Where supported, ops are dispatched with "computed goto" (jumping straight from one op's code to the next).
+// This is faster than a switch in a loop, as it avoids bounds checks and gives the CPU more to go on when predicting branches.
+#if defined(__GNUC__) || defined(__clang__)
+#define SHEEP_COMPUTED_GOTO
+#endif
+
+void SheepVM::ExecuteProgram(SheepThread* thread, const SheepProgram& program, int opIndex)
+{
+	// Get instance/script/stack we'll be using.
+	SheepInstance* instance = thread->mContext;
+	SheepScript* script = instance->mSheepScript;
+	SheepStack& stack = thread->mStack;
 	
-	// If thread is no longer running, notify anyone who was waiting for the thread to finish.
-	// If we get here and the thread IS running, it means the thread was blocked due to a wait!
-	if(!thread->mRunning)
+	// Current op (aka the instruction pointer).
+	const SheepOp* ops = program.GetOps();
+	const SheepOp* op = ops + opIndex;
+	
+	// Each op's code ends by moving to the next op (SHEEP_NEXT), moving to a specific op (SHEEP_JUMP), or stopping (goto Stop).
+	#ifdef SHEEP_COMPUTED_GOTO
+	static void* const kDispatchTable[] = {
+		&&op_SitnSpin, &&op_Yield, &&op_CallSysFunctionV, &&op_CallSysFunctionI, &&op_CallSysFunctionF, &&op_CallSysFunctionS,
+		&&op_Branch, &&op_BranchGoto, &&op_BranchIfZero, &&op_BeginWait, &&op_EndWait, &&op_ReturnV, &&op_Unknown,
+		&&op_StoreI, &&op_StoreF, &&op_StoreS, &&op_LoadI, &&op_LoadF, &&op_LoadS, &&op_PushI, &&op_PushF, &&op_PushS, &&op_Pop,
+		&&op_AddI, &&op_AddF, &&op_SubtractI, &&op_SubtractF, &&op_MultiplyI, &&op_MultiplyF, &&op_DivideI, &&op_DivideF,
+		&&op_NegateI, &&op_NegateF, &&op_IsEqualI, &&op_IsEqualF, &&op_IsNotEqualI, &&op_IsNotEqualF, &&op_IsGreaterI, &&op_IsGreaterF,
+		&&op_IsLessI, &&op_IsLessF, &&op_IsGreaterEqualI, &&op_IsGreaterEqualF, &&op_IsLessEqualI, &&op_IsLessEqualF,
+		&&op_IToF, &&op_FToI, &&op_Modulo, &&op_And, &&op_Or, &&op_Not, &&op_GetString, &&op_DebugBreakpoint,
+		&&op_PushStringConst, &&op_End
+	};
+	static_assert(sizeof(kDispatchTable) / sizeof(kDispatchTable[0]) == static_cast<int>(SheepOpcode::Count), "Dispatch table must have an entry for each opcode");
+	
+	#define SHEEP_OP(name) op_##name
+	#define SHEEP_DISPATCH() goto *kDispatchTable[static_cast<int>(op->opcode)]
+	#define SHEEP_NEXT() ++op; SHEEP_DISPATCH()
+	#define SHEEP_JUMP(index) op = ops + (index); SHEEP_DISPATCH()
+	SHEEP_DISPATCH();
+	#else
+	#define SHEEP_OP(name) case SheepOpcode::name
+	#define SHEEP_NEXT() ++op; continue
+	#define SHEEP_JUMP(index) op = ops + (index); continue
+	for(;;)
 	{
-		Services::GetReports()->Log("SheepMachine", "Sheep " + thread->GetName() + " is exiting");
+	switch(op->opcode)
+	{
+	#endif
+	
+	SHEEP_OP(SitnSpin):
+	SHEEP_OP(DebugBreakpoint):
+	{
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(Yield):
+	{
+		++op;
+		goto Stop;
+	}
+	SHEEP_OP(CallSysFunctionV):
+	{
+		if(op->sysImport == nullptr)
+		{
+			std::cout << "Invalid function index " << op->intValue << std::endl;
+			SHEEP_NEXT();
+		}
+		// Though this is void return, we still push type of "shpvoid" onto stack.
+		// The compiler generates an extra "Pop" instruction after a CallSysFunctionV.
+		stack.PushInt(CallSysFunc(thread, *op).GetInt());
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(CallSysFunctionI):
+	{
+		if(op->sysImport == nullptr)
+		{
+			std::cout << "Invalid function index " << op->intValue << std::endl;
+			SHEEP_NEXT();
+		}
+		stack.PushInt(CallSysFunc(thread, *op).GetInt());
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(CallSysFunctionF):
+	{
+		if(op->sysImport == nullptr)
+		{
+			std::cout << "Invalid function index " << op->intValue << std::endl;
+			SHEEP_NEXT();
+		}
+		stack.PushFloat(CallSysFunc(thread, *op).GetFloat());
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(CallSysFunctionS):
+	{
+		if(op->sysImport == nullptr)
+		{
+			std::cout << "Invalid function index " << op->intValue << std::endl;
+			SHEEP_NEXT();
+		}
+		SheepValue value = CallSysFunc(thread, *op);
+		if(value.type == SheepValueType::String)
+		{
+			stack.PushStringCopy(value.stringValue);
+		}
+		else
+		{
+			stack.PushString(value.GetString());
+		}
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(Branch):
+	SHEEP_OP(BranchGoto):
+	{
+		SHEEP_JUMP(op->intValue);
+	}
+	SHEEP_OP(BranchIfZero):
+	{
+		// If top item on stack is zero, we will branch.
+		// This operation also pops off the stack.
+		if(stack.Pop().intValue == 0)
+		{
+			SHEEP_JUMP(op->intValue);
+		}
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(BeginWait):
+	{
+		thread->mInWaitBlock = true;
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(EndWait):
+	{
+		// If waiting on one or more WAIT-able functions, we need to STOP thread execution for now!
+		if(thread->mWaitCounter > 0)
+		{
+			thread->mBlocked = true;
+			++op;
+			goto Stop;
+		}
+		thread->mInWaitBlock = false;
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(ReturnV):
+	{
+		thread->mRunning = false;
+		++op;
+		goto Stop;
+	}
+	SHEEP_OP(StoreI):
+	{
+		if(op->intValue >= 0 && op->intValue < instance->mVariables.size())
+		{
+			assert(instance->mVariables[op->intValue].type == SheepValueType::Int);
+			instance->mVariables[op->intValue].intValue = stack.Pop().intValue;
+		}
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(StoreF):
+	{
+		if(op->intValue >= 0 && op->intValue < instance->mVariables.size())
+		{
+			assert(instance->mVariables[op->intValue].type == SheepValueType::Float);
+			instance->mVariables[op->intValue].floatValue = stack.Pop().floatValue;
+		}
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(StoreS):
+	{
+		if(op->intValue >= 0 && op->intValue < instance->mVariables.size())
+		{
+			assert(instance->mVariables[op->intValue].type == SheepValueType::String);
+			instance->StoreString(op->intValue, stack.Pop().stringValue);
+		}
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(LoadI):
+	{
+		if(op->intValue >= 0 && op->intValue < instance->mVariables.size())
+		{
+			assert(instance->mVariables[op->intValue].type == SheepValueType::Int);
+			stack.PushInt(instance->mVariables[op->intValue].intValue);
+		}
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(LoadF):
+	{
+		if(op->intValue >= 0 && op->intValue < instance->mVariables.size())
+		{
+			assert(instance->mVariables[op->intValue].type == SheepValueType::Float);
+			stack.PushFloat(instance->mVariables[op->intValue].floatValue);
+		}
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(LoadS):
+	{
+		if(op->intValue >= 0 && op->intValue < instance->mVariables.size())
+		{
+			assert(instance->mVariables[op->intValue].type == SheepValueType::String);
+			stack.PushString(instance->mVariables[op->intValue].stringValue);
+		}
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(PushI):
+	{
+		stack.PushInt(op->intValue);
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(PushF):
+	{
+		stack.PushFloat(op->floatValue);
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(PushS):
+	{
+		stack.PushStringOffset(op->intValue);
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(GetString):
+	{
+		std::string* stringPtr = script->GetStringConst(stack.Pop().intValue);
+		if(stringPtr != nullptr)
+		{
+			stack.PushString(stringPtr->c_str());
+		}
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(PushStringConst):
+	{
+		stack.PushString(op->stringValue);
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(Pop):
+	{
+		stack.Pop(1);
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(AddI):
+	{
+		assert(stack.Size() >= 2);
+		int int1 = stack.Peek(1).intValue;
+		int int2 = stack.Peek(0).intValue;
+		stack.Pop(2);
+		stack.PushInt(int1 + int2);
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(AddF):
+	{
+		assert(stack.Size() >= 2);
+		float float1 = stack.Peek(1).floatValue;
+		float float2 = stack.Peek(0).floatValue;
+		stack.Pop(2);
+		stack.PushFloat(float1 + float2);
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(SubtractI):
+	{
+		assert(stack.Size() >= 2);
+		int int1 = stack.Peek(1).intValue;
+		int int2 = stack.Peek(0).intValue;
+		stack.Pop(2);
+		stack.PushInt(int1 - int2);
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(SubtractF):
+	{
+		assert(stack.Size() >= 2);
+		float float1 = stack.Peek(1).floatValue;
+		float float2 = stack.Peek(0).floatValue;
+		stack.Pop(2);
+		stack.PushFloat(float1 - float2);
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(MultiplyI):
+	{
+		assert(stack.Size() >= 2);
+		int int1 = stack.Peek(1).intValue;
+		int int2 = stack.Peek(0).intValue;
+		stack.Pop(2);
+		stack.PushInt(int1 * int2);
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(MultiplyF):
+	{
+		assert(stack.Size() >= 2);
+		float float1 = stack.Peek(1).floatValue;
+		float float2 = stack.Peek(0).floatValue;
+		stack.Pop(2);
+		stack.PushFloat(float1 * float2);
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(DivideI):
+	{
+		assert(stack.Size() >= 2);
+		int int1 = stack.Peek(1).intValue;
+		int int2 = stack.Peek(0).intValue;
+		stack.Pop(2);
 		
-		// Thread is no longer using execution context.
-		thread->mContext->mReferenceCount--;
+		// If dividing by zero, we'll spit out an error and just put a zero on the stack.
+		if(int2 != 0)
+		{
+			stack.PushInt(int1 / int2);
+		}
+		else
+		{
+			std::cout << "Divide by zero!" << std::endl;
+			stack.PushInt(0);
+		}
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(DivideF):
+	{
+		assert(stack.Size() >= 2);
+		float float1 = stack.Peek(1).floatValue;
+		float float2 = stack.Peek(0).floatValue;
+		stack.Pop(2);
 		
-		// Call my wait callback - someone might have been waiting for this thread to finish.
-		if(thread->mWaitCallback)
+		// If dividing by zero, we'll spit out an error and just put a zero on the stack.
+		if(!Math::AreEqual(float2, 0.0f))
 		{
-			thread->mWaitCallback();
+			stack.PushFloat(float1 / float2);
+		}
+		else
+		{
+			std::cout << "Divide by zero!" << std::endl;
+			stack.PushFloat(0.0f);
 		}
+		SHEEP_NEXT();
 	}
-	else if(thread->mInWaitBlock)
+	SHEEP_OP(NegateI):
 	{
-		Services::GetReports()->Log("SheepMachine", "Sheep " + thread->GetName() + " is blocked at line -1");
+		assert(stack.Size() >= 1);
+		stack.Peek(0).intValue *= -1;
+		SHEEP_NEXT();
 	}
-	else
+	SHEEP_OP(NegateF):
 	{
-		Services::GetReports()->Log("SheepMachine", "Sheep " + thread->GetName() + " is in some weird unexpected state!");
+		assert(stack.Size() >= 1);
+		stack.Peek(0).floatValue *= -1.0f;
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(IsEqualI):
+	{
+		assert(stack.Size() >= 2);
+		int int1 = stack.Peek(1).intValue;
+		int int2 = stack.Peek(0).intValue;
+		stack.Pop(2);
+		stack.PushInt(int1 == int2 ? 1 : 0);
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(IsEqualF):
+	{
+		assert(stack.Size() >= 2);
+		float float1 = stack.Peek(1).floatValue;
+		float float2 = stack.Peek(0).floatValue;
+		stack.Pop(2);
+		stack.PushInt(Math::AreEqual(float1, float2) ? 1 : 0);
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(IsNotEqualI):
+	{
+		assert(stack.Size() >= 2);
+		int int1 = stack.Peek(1).intValue;
+		int int2 = stack.Peek(0).intValue;
+		stack.Pop(2);
+		stack.PushInt(int1 != int2 ? 1 : 0);
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(IsNotEqualF):
+	{
+		assert(stack.Size() >= 2);
+		float float1 = stack.Peek(1).floatValue;
+		float float2 = stack.Peek(0).floatValue;
+		stack.Pop(2);
+		stack.PushInt(!Math::AreEqual(float1, float2) ? 1 : 0);
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(IsGreaterI):
+	{
+		assert(stack.Size() >= 2);
+		int int1 = stack.Peek(1).intValue;
+		int int2 = stack.Peek(0).intValue;
+		stack.Pop(2);
+		stack.PushInt(int1 > int2 ? 1 : 0);
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(IsGreaterF):
+	{
+		assert(stack.Size() >= 2);
+		float float1 = stack.Peek(1).floatValue;
+		float float2 = stack.Peek(0).floatValue;
+		stack.Pop(2);
+		stack.PushInt(float1 > float2 ? 1 : 0);
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(IsLessI):
+	{
+		assert(stack.Size() >= 2);
+		int int1 = stack.Peek(1).intValue;
+		int int2 = stack.Peek(0).intValue;
+		stack.Pop(2);
+		stack.PushInt(int1 < int2 ? 1 : 0);
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(IsLessF):
+	{
+		assert(stack.Size() >= 2);
+		float float1 = stack.Peek(1).floatValue;
+		float float2 = stack.Peek(0).floatValue;
+		stack.Pop(2);
+		stack.PushInt(float1 < float2 ? 1 : 0);
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(IsGreaterEqualI):
+	{
+		assert(stack.Size() >= 2);
+		int int1 = stack.Peek(1).intValue;
+		int int2 = stack.Peek(0).intValue;
+		stack.Pop(2);
+		stack.PushInt(int1 >= int2 ? 1 : 0);
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(IsGreaterEqualF):
+	{
+		assert(stack.Size() >= 2);
+		float float1 = stack.Peek(1).floatValue;
+		float float2 = stack.Peek(0).floatValue;
+		stack.Pop(2);
+		stack.PushInt(float1 >= float2 ? 1 : 0);
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(IsLessEqualI):
+	{
+		assert(stack.Size() >= 2);
+		int int1 = stack.Peek(1).intValue;
+		int int2 = stack.Peek(0).intValue;
+		stack.Pop(2);
+		stack.PushInt(int1 <= int2 ? 1 : 0);
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(IsLessEqualF):
+	{
+		assert(stack.Size() >= 2);
+		float float1 = stack.Peek(1).floatValue;
+		float float2 = stack.Peek(0).floatValue;
+		stack.Pop(2);
+		stack.PushInt(float1 <= float2 ? 1 : 0);
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(IToF):
+	{
+		SheepValue& value = stack.Peek(op->intValue);
+		value.floatValue = value.intValue;
+		value.type = SheepValueType::Float;
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(FToI):
+	{
+		SheepValue& value = stack.Peek(op->intValue);
+		value.intValue = value.floatValue;
+		value.type = SheepValueType::Int;
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(Modulo):
+	{
+		assert(stack.Size() >= 2);
+		int int1 = stack.Peek(1).intValue;
+		int int2 = stack.Peek(0).intValue;
+		stack.Pop(2);
+		stack.PushInt(int1 % int2);
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(And):
+	{
+		assert(stack.Size() >= 2);
+		int int1 = stack.Peek(1).intValue;
+		int int2 = stack.Peek(0).intValue;
+		stack.Pop(2);
+		stack.PushInt(int1 && int2 ? 1 : 0);
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(Or):
+	{
+		assert(stack.Size() >= 2);
+		int int1 = stack.Peek(1).intValue;
+		int int2 = stack.Peek(0).intValue;
+		stack.Pop(2);
+		stack.PushInt(int1 || int2 ? 1 : 0);
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(Not):
+	{
+		assert(stack.Size() >= 1);
+		int int1 = stack.Peek(0).intValue;
+		stack.Peek(0).intValue = (int1 == 0 ? 1 : 0);
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(Unknown):
+	{
+		std::cout << "Unaccounted for Sheep Instruction: " << op->intValue << std::endl;
+		SHEEP_NEXT();
+	}
+	SHEEP_OP(End):
+	{
+		// Reached end of bytecode, so the thread is no longer running.
+		thread->mRunning = false;
+		goto Stop;
 	}
 	
-	// Restore previously executing thread.
-	mCurrentThread = prevThread;
+	#ifndef SHEEP_COMPUTED_GOTO
+	case SheepOpcode::Count:
+		goto Stop;
+	}
+	}
+	#endif
+	
+	#undef SHEEP_OP
+	#undef SHEEP_DISPATCH
+	#undef SHEEP_NEXT
+	#undef SHEEP_JUMP
+	
+Stop:
+	// Update thread's code offset value.
+	thread->mCodeOffset = program.GetBytecodeOffset(static_cast<int>(op - ops));
 }
@@ -12,9 +12,11 @@
 
 #include "SheepThread.h"
 #include "SheepValue.h"
-#include "Value.h"
 
+class SheepProgram;
 class SheepScript;
+struct SheepOp;
+struct SysFuncDecl;
 struct SysImport;
 
 // GK3 calls these "Object Code" instances.
@@ -28,6 +30,10 @@ struct SheepInstance
 	// These'll likely be modified during execution.
 	std::vector<SheepValue> mVariables;
 	
+	// Storage for strings assigned to string variables, by variable index.
+	// Values on the stack don't outlive their slot, so string variables must point at their own copies.
+	std::vector<std::string> mStringVariables;
+	
 	// For debugging, the last time this object was in use during a sheep thread execution.
 	uint32_t mLastUsedTimeMs = 0;
 	
@@ -36,6 +42,9 @@ struct SheepInstance
 	int mReferenceCount = 0;
 	
 	std::string GetName();
+	
+	// Assigns a string variable a copy of a string.
+	void StoreString(int varIndex, const char* str);
 };
 
 // Notify Links?
@@ -115,6 +124,10 @@ public:
 	
 	void FlagExecutionError() { mExecutionError = true; }
 	
+	// If enabled, scripts are executed from decoded ops where possible. If disabled, bytecode is always interpreted directly.
+	// Mainly useful for validating one against the other.
+	void SetThreadedCodeEnabled(bool enabled) { mThreadedCodeEnabled = enabled; }
+	
 private:
 	std::vector<SheepInstance*> mSheepInstances;
 	std::vector<SheepThread*> mSheepThreads;
@@ -122,13 +135,19 @@ private:
 	SheepThread* mCurrentThread = nullptr;
 	
 	bool mExecutionError = false;
+	
+	bool mThreadedCodeEnabled = true;
 		
 	SheepInstance* GetInstance(SheepScript* script);
 	SheepThread* GetThread();
 	
-    Value CallSysFunc(SheepThread* thread, SysImport* sysImport);
+    SheepValue CallSysFunc(SheepThread* thread, SysImport* sysImport);
+	SheepValue CallSysFunc(SheepThread* thread, const SheepOp& op);
+	SheepValue CallSysFunc(SheepThread* thread, SysFuncDecl* sysFunc);
 	
 	SheepThread* ExecuteInternal(SheepScript* script, int bytecodeOffset, const std::string& functionName, std::function<void()> finishCallback);
 	SheepThread* ExecuteInternal(SheepInstance* instance, int bytecodeOffset, const std::string& functionName, std::function<void()> finishCallback);
 	void ExecuteInternal(SheepThread* thread);
+	bool ExecuteBytecode(SheepThread* thread);
+	void ExecuteProgram(SheepThread* thread, const SheepProgram& program, int opIndex);
 };
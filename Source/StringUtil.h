@@ -141,6 +141,36 @@ namespace StringUtil
         if(str1.size() != str2.size()) { return false; }
         return std::equal(str1.begin(), str1.end(), str2.begin(), iequal());
     }
+
+    // Hash and equality that ignore case, for string-keyed maps that are queried with strings of any case.
+    // Lets lookups skip making a lowercase copy of the key.
+    struct IgnoreCaseHash
+    {
+        std::size_t operator()(const std::string& str) const
+        {
+            // FNV-1a, on lowercase characters.
+            std::size_t hash = 2166136261u;
+            for(char c : str)
+            {
+                hash ^= static_cast<std::size_t>(std::tolower(static_cast<unsigned char>(c)));
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+    };
+    struct IgnoreCaseEqual
+    {
+        bool operator()(const std::string& str1, const std::string& str2) const
+        {
+            return EqualsIgnoreCase(str1, str2);
+        }
+    };
+
+    inline bool EndsWith(const std::string& str, const std::string& suffix)
+    {
+        if(str.size() < suffix.size()) { return false; }
+        return str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
     
     inline bool ToBool(const std::string& str)
     {
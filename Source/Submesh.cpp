@@ -153,6 +153,19 @@ void Submesh::SetPositions(float* positions, bool createCopy)
         mPositions = positions;
     }
     mVertexArray.ChangeVertexData(VertexAttribute::Semantic::Position, mPositions);
+    ClearMorphPositions();
+}
+
+void Submesh::SetMorphPositions(GLuint buffer, unsigned int fromVertexOffset, unsigned int toVertexOffset, float t)
+{
+    mVertexArray.SetMorphPositions(buffer, fromVertexOffset, toVertexOffset);
+    mMorphWeight = t;
+}
+
+void Submesh::ClearMorphPositions()
+{
+    mVertexArray.ClearMorphPositions();
+    mMorphWeight = -1.0f;
 }
 
 void Submesh::SetColors(float* colors, bool createCopy)
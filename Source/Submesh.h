@@ -45,6 +45,17 @@ public:
     void SetPositions(float* positions, bool createCopy = false);
     float* GetPositions() { return mPositions; }
     
+    // Rather than using positions set above, blend between two poses on the GPU (e.g. for vertex animation).
+    // Poses are read from a buffer of positions (see VertexArray::SetMorphPositions). Setting positions stops blending.
+    void SetMorphPositions(GLuint buffer, unsigned int fromVertexOffset, unsigned int toVertexOffset, float t);
+    void ClearMorphPositions();
+    
+    // The buffer morph positions are read from, or GL_NONE if not blending.
+    GLuint GetMorphBuffer() const { return mVertexArray.GetMorphBuffer(); }
+    
+    // How far to blend between morph positions when rendering, or -1 if not blending (see gMorphWeight in shaders).
+    float GetMorphWeight() const { return mMorphWeight; }
+    
     void SetNormals(float* normals, bool createCopy = false);
     float* GetNormals() { return mNormals; }
     
@@ -78,6 +89,9 @@ private:
 	float* mNormals = nullptr;
 	float* mUV1 = nullptr;
     unsigned short* mIndexes = nullptr;
+    
+    // Blend amount between morph positions, or -1 if not blending.
+    float mMorphWeight = -1.0f;
 	
     // Vertex array that actually renders using the underlying rendering system.
     VertexArray mVertexArray;
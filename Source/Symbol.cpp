@@ -0,0 +1,85 @@
+//
+// Symbol.cpp
+//
+// Clark Kromenaker
+//
+#include "Symbol.h"
+
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "StringUtil.h"
+
+namespace
+{
+	// Strings by id. A deque, so references to strings stay valid as more are added.
+	std::deque<std::string>& GetStrings()
+	{
+		static std::deque<std::string> strings;
+		return strings;
+	}
+	
+	// Ids by string.
+	std::unordered_map<std::string, int, StringUtil::IgnoreCaseHash, StringUtil::IgnoreCaseEqual>& GetIds()
+	{
+		static std::unordered_map<std::string, int, StringUtil::IgnoreCaseHash, StringUtil::IgnoreCaseEqual> ids;
+		return ids;
+	}
+	
+	// Symbols may be interned while assets load on other threads.
+	// Lookups of already interned strings are much more common than interning new ones, so they can happen together.
+	std::shared_timed_mutex& GetMutex()
+	{
+		static std::shared_timed_mutex mutex;
+		return mutex;
+	}
+	
+	const std::string kEmptyString;
+}
+
+Symbol::Symbol(const std::string& str)
+{
+	// Usually, the string is already interned.
+	*this = Find(str);
+	if(IsValid()) { return; }
+	
+	// Check again once locked for writing, since another thread may have interned it in the meantime.
+	std::lock_guard<std::shared_timed_mutex> lock(GetMutex());
+	auto it = GetIds().find(str);
+	if(it != GetIds().end())
+	{
+		mId = it->second;
+		return;
+	}
+	
+	mId = static_cast<int>(GetStrings().size());
+	GetStrings().push_back(str);
+	GetIds()[str] = mId;
+}
+
+/*static*/ Symbol Symbol::Find(const std::string& str)
+{
+	Symbol symbol;
+	std::shared_lock<std::shared_timed_mutex> lock(GetMutex());
+	auto it = GetIds().find(str);
+	if(it != GetIds().end())
+	{
+		symbol.mId = it->second;
+	}
+	return symbol;
+}
+
+/*static*/ int Symbol::GetCount()
+{
+	std::shared_lock<std::shared_timed_mutex> lock(GetMutex());
+	return static_cast<int>(GetStrings().size());
+}
+
+const std::string& Symbol::GetString() const
+{
+	if(mId < 0) { return kEmptyString; }
+	std::shared_lock<std::shared_timed_mutex> lock(GetMutex());
+	return GetStrings()[mId];
+}
@@ -0,0 +1,50 @@
+//
+// Symbol.h
+//
+// Clark Kromenaker
+//
+// An interned string. Each distinct string (ignoring case) is stored once, in a global table,
+// and is identified by a small integer id from then on.
+//
+// Symbols are cheap to copy, compare, and hash, and their ids can be used as indexes into flat arrays.
+// So, they're useful as keys for names that are looked up often (nouns, verbs, flags, variables, etc).
+//
+#pragma once
+#include <functional>
+#include <string>
+
+class Symbol
+{
+public:
+	// An invalid symbol, which doesn't refer to any string.
+	Symbol() { }
+	
+	// Interns the string, if it hasn't been interned already.
+	explicit Symbol(const std::string& str);
+	
+	// The symbol for a string, if it has been interned. Otherwise, an invalid symbol (the string isn't interned).
+	static Symbol Find(const std::string& str);
+	
+	// The number of interned strings. Only ever increases.
+	static int GetCount();
+	
+	bool IsValid() const { return mId >= 0; }
+	int GetId() const { return mId; }
+	
+	// The string, as it was first interned (later strings that differ only in case get the same symbol).
+	const std::string& GetString() const;
+	
+	bool operator==(const Symbol& other) const { return mId == other.mId; }
+	bool operator!=(const Symbol& other) const { return mId != other.mId; }
+	
+private:
+	int mId = -1;
+};
+
+namespace std
+{
+	template<> struct hash<Symbol>
+	{
+		std::size_t operator()(const Symbol& symbol) const { return std::hash<int>()(symbol.GetId()); }
+	};
+}
@@ -12,6 +12,10 @@
 #include "BinaryReader.h"
 #include "BinaryWriter.h"
 #include "GMath.h"
+#include "PixelUtil.h"
+#include "Renderer.h"
+
+/*static*/ GLuint Texture::sBoundTextureIds[Texture::kMaxTrackedTextureUnits] = { GL_NONE };
 
 Texture Texture::White(2, 2, Color32::White);
 Texture Texture::Black(2, 2, Color32::Black);
@@ -52,6 +56,13 @@ Texture::~Texture()
 {
 	if(mTextureId != GL_NONE)
 	{
+		for(GLuint& boundTextureId : sBoundTextureIds)
+		{
+			if(boundTextureId == mTextureId)
+			{
+				boundTextureId = GL_NONE;
+			}
+		}
 		glDeleteTextures(1, &mTextureId);
 	}
 	if(mPalette != nullptr)
@@ -73,6 +84,15 @@ Texture::~Texture()
 
 void Texture::Activate(int textureUnit)
 {
+    if(Renderer::IsHeadless()) { return; }
+    
+    // No need to bind if already bound to this unit (unless the pixels have changed).
+    bool tracked = textureUnit >= 0 && textureUnit < kMaxTrackedTextureUnits;
+    if(tracked && !mDirty && mTextureId != GL_NONE && sBoundTextureIds[textureUnit] == mTextureId)
+    {
+        return;
+    }
+    
     glActiveTexture(GL_TEXTURE0 + textureUnit);
     
     if(mDirty)
@@ -82,6 +102,10 @@ void Texture::Activate(int textureUnit)
     }
     
     glBindTexture(GL_TEXTURE_2D, mTextureId);
+    if(tracked)
+    {
+        sBoundTextureIds[textureUnit] = mTextureId;
+    }
 }
 
 void Texture::Deactivate()
@@ -189,39 +213,28 @@ void Texture::BlendPixels(const Texture& source, int sourceX, int sourceY, int s
 	if(destX < 0 || destX >= static_cast<int>(dest.mWidth)) { return; }
 	if(destY < 0 || destY >= static_cast<int>(dest.mHeight)) { return; }
 	
-	// Brute force copy, pixel by pixel!
-	for(int y = sourceY; y < sourceY + sourceHeight && y < static_cast<int>(source.mHeight); ++y)
+	// Only copy the part of the area that fits in both textures.
+	int width = Math::Min(sourceWidth, Math::Min(static_cast<int>(source.mWidth) - sourceX, static_cast<int>(dest.mWidth) - destX));
+	int height = Math::Min(sourceHeight, Math::Min(static_cast<int>(source.mHeight) - sourceY, static_cast<int>(dest.mHeight) - destY));
+	if(width <= 0 || height <= 0) { return; }
+	
+	// Blend row by row. Source alpha decides how much of each color comes from source vs. dest.
+	for(int y = 0; y < height; ++y)
 	{
-		for(int x = sourceX; x < sourceX + sourceWidth && x < static_cast<int>(source.mWidth); ++x)
-		{
-			// Calculate source pixel index.
-			int sourcePixelIndex = (y * source.mWidth + x) * 4;
-			
-			// Calculate dest x/y for this pixel.
-			int copyToY = destY + (y - sourceY);
-			int copyToX = destX + (x - sourceX);
-			if(copyToY < 0 || copyToY >= dest.mHeight) { continue; }
-			if(copyToX < 0 || copyToY >= dest.mWidth) { continue; }
-			
-			// Calculate dest pixel index based on x/y.
-			int destPixelIndex = (copyToY * dest.mWidth + copyToX) * 4;
-			
-			// Interpolate between source/dest pixel colors based on source alpha value.
-			// If source alpha is zero, use 100% dest color - this value will be 0.
-			// If source alpha is 255, use 100% source color - this value will be 1.
-			// If source alpha is between, use X% dest/source color - this value is 0-1.
-			float alphaPercent = (float)source.mPixels[sourcePixelIndex + 3] / 255.0f;
-			
-			// Copy!
-			dest.mPixels[destPixelIndex] = Math::Lerp(dest.mPixels[destPixelIndex], source.mPixels[sourcePixelIndex], alphaPercent);
-			dest.mPixels[destPixelIndex + 1] = Math::Lerp(dest.mPixels[destPixelIndex + 1], source.mPixels[sourcePixelIndex + 1], alphaPercent);
-			dest.mPixels[destPixelIndex + 2] = Math::Lerp(dest.mPixels[destPixelIndex + 2], source.mPixels[sourcePixelIndex + 2], alphaPercent);
-			// Don't make any changes to dest's alpha channel.
-		}
+		const unsigned char* sourceRow = source.mPixels + ((sourceY + y) * source.mWidth + sourceX) * 4;
+		unsigned char* destRow = dest.mPixels + ((destY + y) * dest.mWidth + destX) * 4;
+		PixelUtil::BlendRow(sourceRow, destRow, width);
 	}
 	
+	PixelRect changedRect;
+	changedRect.x = destX;
+	changedRect.y = destY;
+	changedRect.width = width;
+	changedRect.height = height;
+	dest.mChangedRects.push_back(changedRect);
+	
 	// Don't upload dest to GPU here, since we might be doing a bunch of copy operations in a row.
-	// We'll leave it up to the caller to do that manually (for now).
+	// We'll leave it up to the caller to do that manually (see UploadChangesToGPU).
 }
 
 void Texture::SetTransparentColor(Color32 color)
@@ -275,6 +288,18 @@ void Texture::ApplyAlphaChannel(const Texture& alphaTexture)
 
 void Texture::UploadToGPU()
 {
+	// Uploading everything covers any changed areas too.
+	mChangedRects.clear();
+	
+	// Pixels stay on the CPU when there's no GL context.
+	if(Renderer::IsHeadless()) { return; }
+	
+	// Uploading binds this texture to whatever texture unit is active, so tracked bindings can't be trusted anymore.
+	for(GLuint& boundTextureId : sBoundTextureIds)
+	{
+		boundTextureId = GL_NONE;
+	}
+	
 	if(mTextureId == GL_NONE)
 	{
 		// Generate and bind the texture object in OpenGL.
@@ -309,6 +334,35 @@ void Texture::UploadToGPU()
 	}
 }
 
+void Texture::UploadChangesToGPU()
+{
+	// Nothing on the GPU to update yet, so everything has to go up.
+	if(mTextureId == GL_NONE)
+	{
+		UploadToGPU();
+		return;
+	}
+	if(mChangedRects.empty()) { return; }
+	
+	// Binding below changes whatever texture unit is active, so tracked bindings can't be trusted anymore.
+	for(GLuint& boundTextureId : sBoundTextureIds)
+	{
+		boundTextureId = GL_NONE;
+	}
+	glBindTexture(GL_TEXTURE_2D, mTextureId);
+	
+	// Each area's rows are spaced a full texture row apart in the pixel array.
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, mWidth);
+	for(auto& rect : mChangedRects)
+	{
+		glTexSubImage2D(GL_TEXTURE_2D, 0,
+						rect.x, rect.y, rect.width, rect.height,
+						GL_RGBA, GL_UNSIGNED_BYTE, mPixels + (rect.y * mWidth + rect.x) * 4);
+	}
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+	mChangedRects.clear();
+}
+
 void Texture::WriteToFile(std::string filePath)
 {
     BinaryWriter writer(filePath.c_str());
@@ -360,6 +414,29 @@ void Texture::WriteToFile(std::string filePath)
     }
 }
 
+void Texture::WriteBaked(BinaryWriter& writer)
+{
+	// 2 bytes: identifier "BK"
+	writer.WriteUShort(0x4B42);
+	
+	// 9 bytes: width, height, and render type.
+	writer.WriteUInt(mWidth);
+	writer.WriteUInt(mHeight);
+	writer.WriteUByte(static_cast<uint8_t>(mRenderType));
+	
+	// 4 bytes: palette color count, followed by palette colors (BGRA) and palette indexes, if any.
+	unsigned int paletteColorCount = mPaletteIndexes != nullptr ? mPaletteColorCount : 0;
+	writer.WriteUInt(paletteColorCount);
+	if(paletteColorCount > 0)
+	{
+		writer.Write(mPalette, paletteColorCount * 4);
+		writer.Write(mPaletteIndexes, mWidth * mHeight);
+	}
+	
+	// Pixels, RGBA, from the top-left corner.
+	writer.Write(mPixels, mWidth * mHeight * 4);
+}
+
 /*static*/ int Texture::CalculateBmpRowSize(unsigned short bitsPerPixel, unsigned int width)
 {
 	// Calculate number of bytes that should be present in each row.
@@ -370,9 +447,10 @@ void Texture::WriteToFile(std::string filePath)
 
 void Texture::ParseFromData(BinaryReader &reader)
 {
-    // Texture can be in one of two formats:
+    // Texture can be in one of three formats:
     // 1) A custom/compressed format.
     // 2) A normal BMP format.
+    // 3) Our own baked format (see WriteBaked).
     // The first 2 byte value can tell us.
     unsigned short fileIdentifier = reader.ReadUShort();
     if(fileIdentifier == 0x3136) // 16
@@ -383,6 +461,10 @@ void Texture::ParseFromData(BinaryReader &reader)
     {
         ParseFromBmpFormat(reader);
     }
+    else if(fileIdentifier == 0x4B42) // BK
+    {
+        ParseFromBakedFormat(reader);
+    }
 }
 
 void Texture::ParseFromCompressedFormat(BinaryReader& reader)
@@ -513,6 +595,7 @@ void Texture::ParseFromBmpFormat(BinaryReader& reader)
 		// The number of bytes is numColors in palette, time 4 bytes each.
 		// The order of the colors is blue, green, red, alpha.
 		mPalette = new unsigned char[numColorsInColorPalette * 4];
+		mPaletteColorCount = numColorsInColorPalette;
 		reader.Read(mPalette, numColorsInColorPalette * 4);
 		
 		/*
@@ -600,3 +683,27 @@ void Texture::ParseFromBmpFormat(BinaryReader& reader)
 		}
 	}
 }
+
+void Texture::ParseFromBakedFormat(BinaryReader& reader)
+{
+	// 2 bytes: baked identifier (assumed this has already been read in from constructor).
+	// 9 bytes: width, height, and render type.
+	mWidth = reader.ReadUInt();
+	mHeight = reader.ReadUInt();
+	mRenderType = static_cast<RenderType>(reader.ReadUByte());
+	
+	// 4 bytes: palette color count, followed by palette colors and palette indexes, if any.
+	mPaletteColorCount = reader.ReadUInt();
+	if(mPaletteColorCount > 0)
+	{
+		mPalette = new unsigned char[mPaletteColorCount * 4];
+		reader.Read(mPalette, mPaletteColorCount * 4);
+		
+		mPaletteIndexes = new unsigned char[mWidth * mHeight];
+		reader.Read(mPaletteIndexes, mWidth * mHeight);
+	}
+	
+	// Pixels are already in our internal format, so they can be read straight in.
+	mPixels = new unsigned char[mWidth * mHeight * 4];
+	reader.Read(mPixels, mWidth * mHeight * 4);
+}
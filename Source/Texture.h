@@ -12,10 +12,12 @@
 #include <GL/glew.h>
 //#include <OpenGL/gl.h>
 #include <string>
+#include <vector>
 
 #include "Color32.h"
 
 class BinaryReader;
+class BinaryWriter;
 struct SDL_Surface;
 
 class Texture : public Asset
@@ -78,6 +80,7 @@ public:
 	//void Blit(Texture* source, int destX, int destY);
 	
 	// Blend's source pixels into dest based on source's alpha channel.
+	// The blended area is remembered, so UploadChangesToGPU can upload just that part of dest.
 	static void BlendPixels(const Texture& source, Texture& dest, int destX, int destY);
 	static void BlendPixels(const Texture& source, int sourceX, int sourceY, int sourceWidth, int sourceHeight,
 						   Texture& dest, int destX, int destY);
@@ -88,8 +91,16 @@ public:
 	
 	void UploadToGPU();
 	
+	// Uploads only the areas changed by blending pixels since the last upload.
+	// If the texture isn't on the GPU yet, all of it is uploaded.
+	void UploadChangesToGPU();
+	
 	void WriteToFile(std::string filePath);
 	
+	// Writes the texture in baked format: already expanded to 32-bit pixels, so it loads with a straight copy.
+	// Baked textures are read back in by the normal constructors.
+	void WriteBaked(BinaryWriter& writer);
+	
 private:
 	friend class RenderTexture; // To access OpenGL stuff.
 	
@@ -99,6 +110,7 @@ private:
 	
 	// Some textures have palettes.
 	unsigned char* mPalette = nullptr;
+	unsigned int mPaletteColorCount = 0;
 	
 	// If a texture has a palette, the indexes into the palette are stored here.
 	unsigned char* mPaletteIndexes = nullptr;
@@ -110,6 +122,10 @@ private:
     
     // An ID for the texture object generated in OpenGL.
     GLuint mTextureId = GL_NONE;
+    
+    // Texture bound to each texture unit, so binding the same texture again can be skipped.
+    static const int kMaxTrackedTextureUnits = 8;
+    static GLuint sBoundTextureIds[kMaxTrackedTextureUnits];
 	
 	// If there's no alpha, it is an opaque texture.
 	// If it has alpha, but only 255 or 0 (on or off), it's an alpha test texture.
@@ -124,10 +140,21 @@ private:
     
     // If true, texture data in RAM is dirty, so we need to upload to GPU.
     bool mDirty = true;
+    
+    // Areas of pixels changed since the last upload (see UploadChangesToGPU).
+    struct PixelRect
+    {
+        int x = 0;
+        int y = 0;
+        int width = 0;
+        int height = 0;
+    };
+    std::vector<PixelRect> mChangedRects;
 	
 	static int CalculateBmpRowSize(unsigned short bitsPerPixel, unsigned int width);
 	
     void ParseFromData(BinaryReader& reader);
 	void ParseFromCompressedFormat(BinaryReader& reader);
 	void ParseFromBmpFormat(BinaryReader& reader);
+	void ParseFromBakedFormat(BinaryReader& reader);
 };
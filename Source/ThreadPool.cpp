@@ -0,0 +1,72 @@
+//
+// ThreadPool.cpp
+//
+// Clark Kromenaker
+//
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(unsigned int threadCount)
+{
+	// Default to all hardware threads but one. The count may be reported as zero if it can't be determined.
+	if(threadCount == 0)
+	{
+		unsigned int hardwareThreadCount = std::thread::hardware_concurrency();
+		threadCount = hardwareThreadCount > 1 ? hardwareThreadCount - 1 : 1;
+	}
+
+	mThreads.reserve(threadCount);
+	for(unsigned int i = 0; i < threadCount; ++i)
+	{
+		mThreads.emplace_back(&ThreadPool::WorkerLoop, this);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	// Tell workers to stop. They finish any queued jobs before exiting.
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mStopping = true;
+	}
+	mJobAvailable.notify_all();
+
+	for(auto& thread : mThreads)
+	{
+		thread.join();
+	}
+}
+
+void ThreadPool::WaitForIdle()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	mJobFinished.wait(lock, [this]() { return mJobs.empty() && mActiveJobCount == 0; });
+}
+
+void ThreadPool::WorkerLoop()
+{
+	while(true)
+	{
+		std::function<void()> job;
+		{
+			// Sleep until there's a job to do, or we're told to stop.
+			std::unique_lock<std::mutex> lock(mMutex);
+			mJobAvailable.wait(lock, [this]() { return mStopping || !mJobs.empty(); });
+
+			// Only exit once the queue is drained.
+			if(mJobs.empty()) { return; }
+
+			job = std::move(mJobs.front());
+			mJobs.pop_front();
+			++mActiveJobCount;
+		}
+
+		// Do the work outside the lock.
+		job();
+
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			--mActiveJobCount;
+		}
+		mJobFinished.notify_all();
+	}
+}
@@ -0,0 +1,83 @@
+//
+// ThreadPool.h
+//
+// Clark Kromenaker
+//
+// A fixed-size pool of worker threads that execute queued jobs in FIFO order.
+//
+// Jobs must not touch anything that isn't thread-safe (most notably, GL state
+// or engine systems accessed via Services). Results are returned via futures.
+//
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+public:
+	// If thread count is zero, uses one fewer than the number of hardware threads (leaving one for the main thread).
+	ThreadPool(unsigned int threadCount = 0);
+	~ThreadPool();
+
+	// Worker threads can't be copied.
+	ThreadPool(const ThreadPool& other) = delete;
+	ThreadPool& operator=(const ThreadPool& other) = delete;
+
+	// Queues a job to be executed on a worker thread. The returned future receives the job's return value.
+	template<class F> auto Enqueue(F&& job) -> std::future<decltype(job())>;
+
+	// Blocks until all queued jobs have finished executing.
+	void WaitForIdle();
+
+	unsigned int GetThreadCount() const { return static_cast<unsigned int>(mThreads.size()); }
+
+private:
+	// The worker threads.
+	std::vector<std::thread> mThreads;
+
+	// Jobs waiting to be picked up by a worker.
+	std::deque<std::function<void()>> mJobs;
+
+	// Number of jobs currently being executed by workers.
+	unsigned int mActiveJobCount = 0;
+
+	// Guards the job queue and counters.
+	std::mutex mMutex;
+
+	// Signaled when a job is queued (or on shutdown), and when a job completes.
+	std::condition_variable mJobAvailable;
+	std::condition_variable mJobFinished;
+
+	// Set on destruction to tell workers to exit.
+	bool mStopping = false;
+
+	void WorkerLoop();
+};
+
+template<class F> auto ThreadPool::Enqueue(F&& job) -> std::future<decltype(job())>
+{
+	// std::function requires copyable callables, so the packaged task lives in a shared_ptr.
+	typedef decltype(job()) ReturnType;
+	auto task = std::make_shared<std::packaged_task<ReturnType()>>(std::forward<F>(job));
+	std::future<ReturnType> future = task->get_future();
+
+	// With no worker threads, just do the work right away.
+	if(mThreads.empty())
+	{
+		(*task)();
+		return future;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mJobs.push_back([task]() { (*task)(); });
+	}
+	mJobAvailable.notify_one();
+	return future;
+}
@@ -32,7 +32,7 @@ VerbManager::VerbManager()
 	
 	// Everything is contained within the "VERBS" section.
 	// There's only one section in the whole file.
-	IniSection section = parser.GetSection("VERBS");
+	IniSection& section = parser.GetSection("VERBS");
 	
 	// Each line is a single button icon declaration.
 	// Format is: KEYWORD, up=, down=, hover=, disable=, type
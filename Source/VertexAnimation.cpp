@@ -5,10 +5,11 @@
 //
 #include "VertexAnimation.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <iostream>
 #include <vector>
-#include <unordered_map>
 
 #include "BinaryReader.h"
 #include "GMath.h"
@@ -21,206 +22,156 @@ VertexAnimation::VertexAnimation(std::string name, char* data, int dataLength) :
     ParseFromData(data, dataLength);
 }
 
-Vector3 VertexAnimation::SampleVertexPosition(float time, int framesPerSecond, int meshIndex, int submeshIndex, int vertexIndex)
+Vector3 VertexAnimation::SampleVertexPosition(float time, int framesPerSecond, int meshIndex, int submeshIndex, int vertexIndex) const
 {
-	float duration = GetDuration(framesPerSecond);
-	float localTime = time;
-	if(localTime > duration)
-	{
-		localTime = Math::Mod(time, duration);
-	}
-	
-	float currentPoseTime = 0.0f;
-    float nextPoseTime = 0.0f;
-	
-	// Find the first vertex pose defined for this mesh/submesh.
-	VertexAnimationVertexPose* firstVertexPose = nullptr;
-	auto it = mVertexPoses.find(meshIndex);
-	if(it != mVertexPoses.end())
+	// If no vertex keyframes exist, we'll have to return an error state.
+	const SubmeshVertexKeyframes* keyframes = GetVertexKeyframes(meshIndex, submeshIndex);
+	if(keyframes == nullptr || vertexIndex < 0 || vertexIndex >= keyframes->vertexCount)
 	{
-		auto it2 = it->second.find(submeshIndex);
-		if(it2 != it->second.end())
-		{
-			firstVertexPose = it2->second;
-		}
+		return Vector3::Zero;
 	}
 	
-	// If no vertex pose was found, we'll have to return an error state.
-	if(firstVertexPose == nullptr)
+	int keyIndex = 0;
+	int nextKeyIndex = 0;
+	float t = 0.0f;
+	if(!keyframes->timeline.FindKeys(time, framesPerSecond, keyIndex, nextKeyIndex, t))
 	{
 		return Vector3::Zero;
 	}
 	
-	// Calculate how many seconds should be used for a single frame - used later.
-    float secondsPerFrame = 1.0f / framesPerSecond;
-	
-	// Determine the poses right before the desired local time on the animation.
-    VertexAnimationVertexPose* currentVertexPose = firstVertexPose;
-    while(currentVertexPose->mNext != nullptr)
-    {
-        currentPoseTime = secondsPerFrame * currentVertexPose->mFrameNumber;
-        nextPoseTime = secondsPerFrame * currentVertexPose->mNext->mFrameNumber;
-        if(nextPoseTime > localTime) { break; }
-		
-        currentVertexPose = currentVertexPose->mNext;
-    }
-	
-	// Get the next pose, after the desired local time.
-	// If it doesn't exist, loop back to the first pose.
-    VertexAnimationVertexPose* nextVertexPose = currentVertexPose->mNext;
-    if(nextVertexPose == nullptr)
-    {
-		nextVertexPose = currentVertexPose;
-		nextPoseTime = currentPoseTime;
-    }
-    
-    // Determine our "t" value between the current and next pose.
-    float t = 1.0f;
-    if(!Math::IsZero(nextPoseTime - currentPoseTime))
-    {
-        t = (localTime - currentPoseTime) / (nextPoseTime - currentPoseTime);
-    }
-    assert(t >= 0.0f && t <= 1.0f);
-	
-    // Now calculate interpolated positions between current and next poses for this time t.
-	return Vector3::Lerp(currentVertexPose->mVertexPositions[vertexIndex], nextVertexPose->mVertexPositions[vertexIndex], t);
+    // Now calculate interpolated position between current and next keyframes for this time t.
+	return Vector3::Lerp(keyframes->GetKeyPositions(keyIndex)[vertexIndex], keyframes->GetKeyPositions(nextKeyIndex)[vertexIndex], t);
 }
 
-VertexAnimationVertexPose VertexAnimation::SampleVertexPose(float time, int framesPerSecond, int meshIndex, int submeshIndex)
+bool VertexAnimation::SampleVertexPose(float time, int framesPerSecond, int meshIndex, int submeshIndex, float* outPositions) const
 {
-	float duration = GetDuration(framesPerSecond);
-	float localTime = time;
-	if(localTime > duration)
-	{
-		localTime = Math::Mod(time, duration);
-	}
+	// Find vertex keyframes for this mesh/submesh.
+	const SubmeshVertexKeyframes* keyframes = GetVertexKeyframes(meshIndex, submeshIndex);
+	if(keyframes == nullptr) { return false; }
 	
-    float currentPoseTime = 0.0f;
-    float nextPoseTime = 0.0f;
+	int keyIndex = 0;
+	int nextKeyIndex = 0;
+	float t = 0.0f;
+	if(!keyframes->timeline.FindKeys(time, framesPerSecond, keyIndex, nextKeyIndex, t)) { return false; }
 	
-	// Find the first vertex pose defined for this mesh/submesh.
-	VertexAnimationVertexPose* firstVertexPose = nullptr;
-	auto it = mVertexPoses.find(meshIndex);
-	if(it != mVertexPoses.end())
+	// Positions for each keyframe are contiguous, so they can be treated as flat float arrays.
+	const float* from = reinterpret_cast<const float*>(keyframes->GetKeyPositions(keyIndex));
+	const float* to = reinterpret_cast<const float*>(keyframes->GetKeyPositions(nextKeyIndex));
+	int floatCount = keyframes->vertexCount * 3;
+	if(keyIndex == nextKeyIndex)
 	{
-		auto it2 = it->second.find(submeshIndex);
-		if(it2 != it->second.end())
-		{
-			firstVertexPose = it2->second;
-		}
+		std::memcpy(outPositions, from, floatCount * sizeof(float));
+		return true;
 	}
 	
-	// If no vertex pose was found, we'll have to return an error state.
-	if(firstVertexPose == nullptr)
+	// Same math as Vector3::Lerp, but as one flat loop (which the compiler can vectorize).
+	float oneMinusT = 1.0f - t;
+	for(int i = 0; i < floatCount; ++i)
 	{
-		VertexAnimationVertexPose pose;
-		pose.mFrameNumber = -1;
-		return pose;
+		outPositions[i] = oneMinusT * from[i] + t * to[i];
 	}
+	return true;
+}
+
+int VertexAnimation::GetVertexCount(int meshIndex, int submeshIndex) const
+{
+	const SubmeshVertexKeyframes* keyframes = GetVertexKeyframes(meshIndex, submeshIndex);
+	return keyframes != nullptr ? keyframes->vertexCount : 0;
+}
+
+bool VertexAnimation::GetVertexKeys(float time, int framesPerSecond, int meshIndex, int submeshIndex, int& outFromVertexOffset, int& outToVertexOffset, float& outT) const
+{
+	const SubmeshVertexKeyframes* keyframes = GetVertexKeyframes(meshIndex, submeshIndex);
+	if(keyframes == nullptr) { return false; }
 	
-	// Calculate how many seconds should be used for a single frame - used later.
-    float secondsPerFrame = 1.0f / framesPerSecond;
+	int keyIndex = 0;
+	int nextKeyIndex = 0;
+	if(!keyframes->timeline.FindKeys(time, framesPerSecond, keyIndex, nextKeyIndex, outT)) { return false; }
 	
-	// Determine the poses right before the desired local time on the animation.
-    VertexAnimationVertexPose* currentVertexPose = firstVertexPose;
-    while(currentVertexPose->mNext != nullptr)
-    {
-        currentPoseTime = secondsPerFrame * currentVertexPose->mFrameNumber;
-        nextPoseTime = secondsPerFrame * currentVertexPose->mNext->mFrameNumber;
-        if(nextPoseTime > localTime) { break; }
-		
-        currentVertexPose = currentVertexPose->mNext;
-    }
+	// Same layout as GetKeyPositions.
+	outFromVertexOffset = keyIndex * keyframes->vertexCount;
+	outToVertexOffset = nextKeyIndex * keyframes->vertexCount;
+	return true;
+}
+
+const std::vector<Vector3>* VertexAnimation::GetKeyframePositions(int meshIndex, int submeshIndex) const
+{
+	const SubmeshVertexKeyframes* keyframes = GetVertexKeyframes(meshIndex, submeshIndex);
+	return keyframes != nullptr ? &keyframes->positions : nullptr;
+}
+
+VertexAnimationTransformPose VertexAnimation::SampleTransformPose(float time, int framesPerSecond, int meshIndex) const
+{
+	// If no transform keyframes exist for this mesh, return an error state.
+	VertexAnimationTransformPose pose;
+	pose.mFrameNumber = -1;
+	if(meshIndex < 0 || meshIndex >= mTransformKeyframes.size()) { return pose; }
 	
-	// Get the next pose, after the desired local time.
-	// If it doesn't exist, loop back to the first pose.
-    VertexAnimationVertexPose* nextVertexPose = currentVertexPose->mNext;
-    if(nextVertexPose == nullptr)
-    {
-		// Clamp approach.
-		nextVertexPose = currentVertexPose;
-		nextPoseTime = currentPoseTime;
-		
-		// Loop approach.
-        //nextVertexPose = firstVertexPose;
-        //nextPoseTime = GetDuration(framesPerSecond);
-    }
-    
-    // Determine our "t" value between the current and next pose.
-    float t = 1.0f;
-    if(!Math::IsZero(nextPoseTime - currentPoseTime))
-    {
-        t = (localTime - currentPoseTime) / (nextPoseTime - currentPoseTime);
-    }
-    assert(t >= 0.0f && t <= 1.0f);
+	// Determine between which two keyframes the time is located.
+	// E.g. if time is 50% between keyframe 5 and 6, we  want to interpolate 50% between those two poses.
+	const MeshTransformKeyframes& keyframes = mTransformKeyframes[meshIndex];
+	int keyIndex = 0;
+	int nextKeyIndex = 0;
+	float t = 0.0f;
+	if(!keyframes.timeline.FindKeys(time, framesPerSecond, keyIndex, nextKeyIndex, t)) { return pose; }
 	
-    // Now calculate interpolated positions between current and next poses for this time t.
-	VertexAnimationVertexPose pose;
-    for(int i = 0; i < currentVertexPose->mVertexPositions.size(); i++)
-    {
-        pose.mVertexPositions.push_back(Vector3::Lerp(currentVertexPose->mVertexPositions[i], nextVertexPose->mVertexPositions[i], t));
-    }
+	// Finally, create a pose with lerp/slerp that is interpolated between the two poses.
+	const VertexAnimationTransformPose& currentPose = keyframes.poses[keyIndex];
+	const VertexAnimationTransformPose& nextPose = keyframes.poses[nextKeyIndex];
+	pose.mFrameNumber = currentPose.mFrameNumber;
+    pose.mLocalPosition = Vector3::Lerp(currentPose.mLocalPosition, nextPose.mLocalPosition, t);
+	pose.mLocalScale = Vector3::Lerp(currentPose.mLocalScale, nextPose.mLocalScale, t);
+    Quaternion::Slerp(pose.mLocalRotation, currentPose.mLocalRotation, nextPose.mLocalRotation, t);
     return pose;
 }
 
-VertexAnimationTransformPose VertexAnimation::SampleTransformPose(float time, int framesPerSecond, int meshIndex)
+void VertexAnimation::KeyframeTimeline::BuildFrameLookup(int frameCount)
 {
-	// Calculate how many seconds should be used for a single frame.
-	float secondsPerFrame = 1.0f / framesPerSecond;
+	// For each frame, the last keyframe at or before it.
+	// The first keyframe is used for any frames before it (which doesn't happen in practice - first keyframe is frame 0).
+	frameKeyIndexes.resize(frameCount);
+	int keyIndex = 0;
+	for(int frame = 0; frame < frameCount; ++frame)
+	{
+		while(keyIndex + 1 < keyFrameNumbers.size() && keyFrameNumbers[keyIndex + 1] <= frame)
+		{
+			++keyIndex;
+		}
+		frameKeyIndexes[frame] = keyIndex;
+	}
+}
+
+bool VertexAnimation::KeyframeTimeline::FindKeys(float time, int framesPerSecond, int& outKeyIndex, int& outNextKeyIndex, float& outT) const
+{
+	if(keyFrameNumbers.empty() || frameKeyIndexes.empty()) { return false; }
 	
 	// Caller may pass in a global time that extends beyond the local time of this particular animation.
 	// Desire here is for the animation to "loop", so we calculate how many seconds in we are.
-	float duration = GetDuration(framesPerSecond);
+	float secondsPerFrame = 1.0f / framesPerSecond;
+	float duration = secondsPerFrame * frameKeyIndexes.size();
 	float localTime = time;
 	if(localTime > duration)
 	{
 		localTime = Math::Mod(time, duration);
 	}
 	
-	// Determine between which two transform poses the desired local time is located.
-	// E.g. if local time is 50% between pose 5 and 6, we  want to interpolate 50% between those two poses.
-    float currentPoseTime = 0.0f;
-    float nextPoseTime = 0.0f;
-    VertexAnimationTransformPose* firstTransformPose = mTransformPoses[meshIndex];
-    VertexAnimationTransformPose* currentTransformPose = firstTransformPose;
-    while(currentTransformPose->mNext != nullptr)
-    {
-        currentPoseTime = secondsPerFrame * currentTransformPose->mFrameNumber;
-        nextPoseTime = secondsPerFrame * currentTransformPose->mNext->mFrameNumber;
-        if(nextPoseTime > localTime) { break; }
-        
-        // Move on to next one.
-        currentTransformPose = currentTransformPose->mNext;
-    }
+	// Look up the keyframe right before the desired local time on the animation.
+	int frame = Math::Clamp(static_cast<int>(localTime * framesPerSecond), 0, static_cast<int>(frameKeyIndexes.size()) - 1);
+	outKeyIndex = frameKeyIndexes[frame];
 	
-	// If there is no "next" pose, we can either loop to the first pose, or "clamp" on the last pose.
+	// If there is no "next" keyframe, we can either loop to the first keyframe, or "clamp" on the last keyframe.
 	// Testing suggests GK3 expects the "clamp" approach, but more generally, a parameter for this might make sense.
-    VertexAnimationTransformPose* nextTransformPose = currentTransformPose->mNext;
-    if(nextTransformPose == nullptr)
-    {
-		// Clamp approach.
-		nextTransformPose = currentTransformPose;
-		nextPoseTime = currentPoseTime;
-		
-		// Loop approach.
-        //nextTransformPose = firstTransformPose;
-        //nextPoseTime = GetDuration(framesPerSecond);
-    }
-	
-    // Determine our "t" value between the prev and next pose.
-    float t = 1.0f;
-	if(!Math::IsZero(nextPoseTime - currentPoseTime))
-    {
-        t = (localTime - currentPoseTime) / (nextPoseTime - currentPoseTime);
-    }
-    assert(t >= 0.0f && t <= 1.0f);
+	outNextKeyIndex = outKeyIndex + 1 < keyFrameNumbers.size() ? outKeyIndex + 1 : outKeyIndex;
 	
-	// Finally, create a pose with lerp/slerp that is interpolated between the two poses.
-    VertexAnimationTransformPose pose;
-    pose.mLocalPosition = Vector3::Lerp(currentTransformPose->mLocalPosition, nextTransformPose->mLocalPosition, t);
-	pose.mLocalScale = Vector3::Lerp(currentTransformPose->mLocalScale, nextTransformPose->mLocalScale, t);
-    Quaternion::Slerp(pose.mLocalRotation, currentTransformPose->mLocalRotation, nextTransformPose->mLocalRotation, t);
-    return pose;
+	// Determine our "t" value between the current and next keyframe.
+	float keyTime = secondsPerFrame * keyFrameNumbers[outKeyIndex];
+	float nextKeyTime = secondsPerFrame * keyFrameNumbers[outNextKeyIndex];
+	outT = 1.0f;
+	if(!Math::IsZero(nextKeyTime - keyTime))
+	{
+		outT = Math::Clamp((localTime - keyTime) / (nextKeyTime - keyTime), 0.0f, 1.0f);
+	}
+	return true;
 }
 
 void VertexAnimation::ParseFromData(char *data, int dataLength)
@@ -269,9 +220,6 @@ void VertexAnimation::ParseFromData(char *data, int dataLength)
         offsets.push_back(reader.ReadUInt());
     }
     
-    std::unordered_map<int, VertexAnimationVertexPose*> lastVertexPoseLookup;
-    std::unordered_map<int, VertexAnimationTransformPose*> lastTransformPoseLookup;
-	
 	// Read in data for each keyframe.
     for(int i = 0; i < mFrameCount; i++)
     {
@@ -322,37 +270,26 @@ void VertexAnimation::ParseFromData(char *data, int dataLength)
                     std::cout << "        Submesh Index: " << submeshIndex << std::endl;
                     #endif
 					
-					// This is a pretty sorry hash...but assuming we'll never
-					// have more than 1000 submeshes (pretty likely for GK3), this'll do OK.
-                    int hash = meshIndex * 1000 + submeshIndex;
-					
-					// Create a vertex pose for this frame and stick it in our dictionary and linked list.
-                    VertexAnimationVertexPose* vertexPose = new VertexAnimationVertexPose();
-                    vertexPose->mFrameNumber = i;
-                    if(i == 0)
-                    {
-                        mVertexPoses[meshIndex][submeshIndex] = vertexPose;
-                        lastVertexPoseLookup[hash] = vertexPose;
-                    }
-                    else
-                    {
-                        lastVertexPoseLookup[hash]->mNext = vertexPose;
-                        lastVertexPoseLookup[hash] = vertexPose;
-                    }
-                    
                     // 2 bytes: Vertex count.
                     unsigned short vertexCount = reader.ReadUShort();
                     #ifdef DEBUG_OUTPUT
                     std::cout << "        Vertex Count: " << vertexCount << std::endl;
                     #endif
                     
+					// Add a keyframe for this frame.
+					Vector3* positions = AddVertexKeyframe(meshIndex, submeshIndex, i, vertexCount);
+					int keyVertexCount = mVertexKeyframes[meshIndex][submeshIndex].vertexCount;
+                    
                     // Next, three floats per vertex (X, Y, Z).
                     for(int k = 0; k < vertexCount; k++)
                     {
                         float x = reader.ReadFloat();
 						float z = reader.ReadFloat();
                         float y = reader.ReadFloat();
-                        vertexPose->mVertexPositions.push_back(Vector3(x, y, z));
+                        if(k < keyVertexCount)
+                        {
+                            positions[k] = Vector3(x, y, z);
+                        }
                     }
                 }
                 // Identifier 1 also is vertex data, but in a compressed format.
@@ -372,29 +309,15 @@ void VertexAnimation::ParseFromData(char *data, int dataLength)
                     std::cout << "        Submesh Index: " << submeshIndex << std::endl;
                     #endif
                     
-                    // Find position data from last recorded frame.
-                    int hash = meshIndex * 1000 + submeshIndex;
-                    std::vector<Vector3>& prevPositions = lastVertexPoseLookup[hash]->mVertexPositions;
-					
-					// Create a vertex pose to hold this new data and insert it into the vertex pose chain.
-                    VertexAnimationVertexPose* vertexPose = new VertexAnimationVertexPose();
-                    vertexPose->mFrameNumber = i;
-                    if(i == 0)
-                    {
-						mVertexPoses[meshIndex][submeshIndex] = vertexPose;
-                        lastVertexPoseLookup[hash] = vertexPose;
-                    }
-                    else
-                    {
-                        lastVertexPoseLookup[hash]->mNext = vertexPose;
-                        lastVertexPoseLookup[hash] = vertexPose;
-                    }
-					
                     // 2 bytes: Vertex count.
                     unsigned short vertexCount = reader.ReadUShort();
                     #ifdef DEBUG_OUTPUT
                     std::cout << "        Vertex Count: " << vertexCount << std::endl;
                     #endif
+					
+					// Add a keyframe for this frame. Positions start out the same as the last keyframe, and the data here is deltas from those.
+					Vector3* positions = AddVertexKeyframe(meshIndex, submeshIndex, i, vertexCount);
+					int keyVertexCount = mVertexKeyframes[meshIndex][submeshIndex].vertexCount;
                     
                     // Next ((VertexCount/4) + 1) bytes: Compression info for vertex data.
                     // Every 2 bits indicates how the vertex at that index is compressed.
@@ -433,9 +356,10 @@ void VertexAnimation::ParseFromData(char *data, int dataLength)
                     {
 						// 0 means no vertex data, so just use whatever we had for the previous frame.
 						// If the vertex data hasn't changed since last frame, it isn't stored, to save space.
+						Vector3 delta;
                         if(vertexDataFormat[k] == 0)
                         {
-                            vertexPose->mVertexPositions.push_back(prevPositions[k]);
+                            continue;
                         }
                         // 1 means (X, Y, Z) are compressed in next 3 bytes.
 						// This tends to be used for storing vertex position delta for internal vertices in a mesh.
@@ -444,7 +368,7 @@ void VertexAnimation::ParseFromData(char *data, int dataLength)
                             float x = DecompressFloatFromByte(reader.ReadByte());
 							float z = DecompressFloatFromByte(reader.ReadByte());
                             float y = DecompressFloatFromByte(reader.ReadByte());
-                            vertexPose->mVertexPositions.push_back(prevPositions[k] + Vector3(x, y, z));
+                            delta = Vector3(x, y, z);
                         }
                         // 2 means (X, Y, Z) are compressed in next 3 ushorts.
 						// This tends to be used for storing vertex position deltas where meshes meet (like a knee or elbow).
@@ -453,7 +377,7 @@ void VertexAnimation::ParseFromData(char *data, int dataLength)
                             float x = DecompressFloatFromUShort(reader.ReadUShort());
 							float z = DecompressFloatFromUShort(reader.ReadUShort());
 							float y = DecompressFloatFromUShort(reader.ReadUShort());
-							vertexPose->mVertexPositions.push_back(prevPositions[k] + Vector3(x, y, z));
+							delta = Vector3(x, y, z);
                         }
                         // 3 means (X, Y, Z) are not compressed - just floats.
                         else if(vertexDataFormat[k] == 3)
@@ -461,7 +385,12 @@ void VertexAnimation::ParseFromData(char *data, int dataLength)
                             float x = reader.ReadFloat();
 							float z = reader.ReadFloat();
                             float y = reader.ReadFloat();
-                            vertexPose->mVertexPositions.push_back(prevPositions[k] + Vector3(x, y, z));
+                            delta = Vector3(x, y, z);
+                        }
+                        
+                        if(k < keyVertexCount)
+                        {
+                            positions[k] += delta;
                         }
                     }
                     
@@ -519,21 +448,20 @@ void VertexAnimation::ParseFromData(char *data, int dataLength)
                     std::cout << "        Mesh Position: " << meshPos << std::endl;
                     #endif
                     
-                    VertexAnimationTransformPose* transformPose = new VertexAnimationTransformPose();
-                    transformPose->mFrameNumber = i;
-                    transformPose->mLocalPosition = meshPos;
-                    transformPose->mLocalRotation = rotQuat;
-					transformPose->mLocalScale = scale;
-                    if(i == 0)
-                    {
-                        mTransformPoses.push_back(transformPose);
-                        lastTransformPoseLookup[meshIndex] = transformPose;
-                    }
-                    else
+                    // Add a transform keyframe for this frame.
+                    if(meshIndex >= mTransformKeyframes.size())
                     {
-                        lastTransformPoseLookup[meshIndex]->mNext = transformPose;
-                        lastTransformPoseLookup[meshIndex] = transformPose;
+                        mTransformKeyframes.resize(meshIndex + 1);
                     }
+                    MeshTransformKeyframes& keyframes = mTransformKeyframes[meshIndex];
+                    keyframes.timeline.keyFrameNumbers.push_back(i);
+                    keyframes.poses.emplace_back();
+                    
+                    VertexAnimationTransformPose& transformPose = keyframes.poses.back();
+                    transformPose.mFrameNumber = i;
+                    transformPose.mLocalPosition = meshPos;
+                    transformPose.mLocalRotation = rotQuat;
+					transformPose.mLocalScale = scale;
                 }
                 // Identifier 3 is min/max data.
                 else if(dataId == 3)
@@ -566,6 +494,59 @@ void VertexAnimation::ParseFromData(char *data, int dataLength)
             } // while(byteCount > 0)
         } // iterate mesh groups
     } // iterate keyframes
+    
+    // Now that all keyframes are known, build lookups from frame to keyframe.
+    for(auto& meshKeyframes : mVertexKeyframes)
+    {
+        for(auto& submeshKeyframes : meshKeyframes)
+        {
+            submeshKeyframes.timeline.BuildFrameLookup(mFrameCount);
+        }
+    }
+    for(auto& meshKeyframes : mTransformKeyframes)
+    {
+        meshKeyframes.timeline.BuildFrameLookup(mFrameCount);
+    }
+}
+
+Vector3* VertexAnimation::AddVertexKeyframe(int meshIndex, int submeshIndex, int frameNumber, int vertexCount)
+{
+	if(meshIndex >= mVertexKeyframes.size())
+	{
+		mVertexKeyframes.resize(meshIndex + 1);
+	}
+	if(submeshIndex >= mVertexKeyframes[meshIndex].size())
+	{
+		mVertexKeyframes[meshIndex].resize(submeshIndex + 1);
+	}
+	SubmeshVertexKeyframes& keyframes = mVertexKeyframes[meshIndex][submeshIndex];
+	
+	// The first keyframe decides the vertex count. Later keyframes should match, but extra vertices are ignored if not.
+	int keyIndex = static_cast<int>(keyframes.timeline.keyFrameNumbers.size());
+	if(keyIndex == 0)
+	{
+		keyframes.vertexCount = vertexCount;
+	}
+	keyframes.timeline.keyFrameNumbers.push_back(frameNumber);
+	
+	// Start from the previous keyframe's positions, if any.
+	keyframes.positions.resize((keyIndex + 1) * keyframes.vertexCount);
+	Vector3* positions = keyframes.positions.data() + keyIndex * keyframes.vertexCount;
+	if(keyIndex > 0)
+	{
+		std::copy(positions - keyframes.vertexCount, positions, positions);
+	}
+	return positions;
+}
+
+const VertexAnimation::SubmeshVertexKeyframes* VertexAnimation::GetVertexKeyframes(int meshIndex, int submeshIndex) const
+{
+	if(meshIndex < 0 || meshIndex >= mVertexKeyframes.size()) { return nullptr; }
+	if(submeshIndex < 0 || submeshIndex >= mVertexKeyframes[meshIndex].size()) { return nullptr; }
+	
+	// A submesh may not be animated at all, even if later submeshes are.
+	const SubmeshVertexKeyframes& keyframes = mVertexKeyframes[meshIndex][submeshIndex];
+	return keyframes.timeline.keyFrameNumbers.empty() ? nullptr : &keyframes;
 }
 
 float VertexAnimation::DecompressFloatFromByte(unsigned char val)
@@ -12,19 +12,10 @@
 #include "Asset.h"
 
 #include <vector>
-#include <unordered_map>
 
 #include "Matrix4.h"
 #include "Vector3.h"
 
-struct VertexAnimationVertexPose
-{
-    int mFrameNumber = 0;
-    
-    std::vector<Vector3> mVertexPositions;
-    VertexAnimationVertexPose* mNext = nullptr;
-};
-
 struct VertexAnimationTransformPose
 {
     int mFrameNumber = 0;
@@ -32,8 +23,6 @@ struct VertexAnimationTransformPose
     Quaternion mLocalRotation;
     Vector3 mLocalPosition;
 	Vector3 mLocalScale;
-	
-    VertexAnimationTransformPose* mNext = nullptr;
     
     Matrix4 GetMeshToLocalMatrix()
     {
@@ -49,13 +38,27 @@ public:
     VertexAnimation(std::string name, char* data, int dataLength);
     
 	// Queries the position of a single vertex at a particular time of the animation.
-	Vector3 SampleVertexPosition(float time, int framesPerSecond, int meshIndex, int submeshIndex, int vertexIndex);
+	Vector3 SampleVertexPosition(float time, int framesPerSecond, int meshIndex, int submeshIndex, int vertexIndex) const;
 	
 	// Queries positions of ALL vertices for a submesh at a particular time of the animation.
-	VertexAnimationVertexPose SampleVertexPose(float time, int framesPerSecond, int meshIndex, int submeshIndex);
+	// Positions are written to the passed buffer, which must have room for (vertex count * 3) floats.
+	// Returns false (and writes nothing) if this animation has no vertex data for the submesh.
+	bool SampleVertexPose(float time, int framesPerSecond, int meshIndex, int submeshIndex, float* outPositions) const;
+	
+	// Number of vertices animated for a submesh, or 0 if the submesh isn't animated.
+	int GetVertexCount(int meshIndex, int submeshIndex) const;
+	
+	// For blending on the GPU: finds the two keyframe poses to blend between for a submesh at a particular time, and how far to blend (t).
+	// Poses are given as vertex offsets into the submesh's keyframe buffer. Returns false if this animation has no vertex data for the submesh.
+	bool GetVertexKeys(float time, int framesPerSecond, int meshIndex, int submeshIndex, int& outFromVertexOffset, int& outToVertexOffset, float& outT) const;
+	
+	// All keyframe positions for a submesh, back-to-back (the layout GetVertexKeys offsets refer to), e.g. to upload to the GPU.
+	// Null if this animation has no vertex data for the submesh.
+	const std::vector<Vector3>* GetKeyframePositions(int meshIndex, int submeshIndex) const;
 	
 	// Queries a mesh's transform properties (position, rotation, scale) at a particular time of the animation.
-	VertexAnimationTransformPose SampleTransformPose(float time, int framesPerSecond, int meshIndex);
+	// If this animation has no transform data for the mesh, the pose's frame number is -1.
+	VertexAnimationTransformPose SampleTransformPose(float time, int framesPerSecond, int meshIndex) const;
     
 	// Length and duration.
 	int GetFrameCount() const { return mFrameCount; }
@@ -71,16 +74,50 @@ private:
 	// If we ever play the animation on a mismatched model, the graphics will probably glitch out.
 	std::string mModelName;
     
-	// Each array element is the FIRST vertex pose for each mesh/submesh index.
-	// Subsequent poses for the mesh are stored in the "next" of the first pose.
-	std::unordered_map<int, std::unordered_map<int, VertexAnimationVertexPose*>> mVertexPoses;
-	
-	// Each element of array is the FIRST transform poses for each mesh index.
-	// Subsequent poses for the mesh are stored in the "next" of the first pose.
-    std::vector<VertexAnimationTransformPose*> mTransformPoses;
+    // Frame numbers of the keyframes for one mesh or submesh (in order),
+    // plus a lookup from each frame of the animation to the last keyframe at or before it.
+    struct KeyframeTimeline
+    {
+        std::vector<int> keyFrameNumbers;
+        std::vector<int> frameKeyIndexes;
+        
+        void BuildFrameLookup(int frameCount);
+        
+        // Finds the keyframes to interpolate between at a time, and how far between them (t) the time is.
+        bool FindKeys(float time, int framesPerSecond, int& outKeyIndex, int& outNextKeyIndex, float& outT) const;
+    };
+    
+    // Vertex keyframes for a submesh. All keyframe positions are stored back-to-back in one array.
+    // The positions for keyframe N start at index (N * vertexCount).
+    struct SubmeshVertexKeyframes
+    {
+        KeyframeTimeline timeline;
+        int vertexCount = 0;
+        std::vector<Vector3> positions;
+        
+        const Vector3* GetKeyPositions(int keyIndex) const { return &positions[keyIndex * vertexCount]; }
+    };
+    
+    // Transform keyframes for a mesh.
+    struct MeshTransformKeyframes
+    {
+        KeyframeTimeline timeline;
+        std::vector<VertexAnimationTransformPose> poses;
+    };
+    
+    // Vertex keyframes, indexed by mesh index, then submesh index.
+    std::vector<std::vector<SubmeshVertexKeyframes>> mVertexKeyframes;
+    
+    // Transform keyframes, indexed by mesh index.
+    std::vector<MeshTransformKeyframes> mTransformKeyframes;
     
     void ParseFromData(char* data, int dataLength);
     
+    // Adds a keyframe to a submesh, returning where to put its positions.
+    // New positions start out the same as the previous keyframe, since compressed keyframes only store changes.
+    Vector3* AddVertexKeyframe(int meshIndex, int submeshIndex, int frameNumber, int vertexCount);
+    const SubmeshVertexKeyframes* GetVertexKeyframes(int meshIndex, int submeshIndex) const;
+    
     float DecompressFloatFromByte(unsigned char val);
     float DecompressFloatFromUShort(unsigned short val);
 };
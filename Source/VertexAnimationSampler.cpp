@@ -0,0 +1,164 @@
+//
+// VertexAnimationSampler.cpp
+//
+// Clark Kromenaker
+//
+#include "VertexAnimationSampler.h"
+
+#include <future>
+
+#include "Submesh.h"
+#include "ThreadPool.h"
+#include "VertexAnimation.h"
+
+// Below this many vertices in a batch, handing work to other threads costs more than it saves.
+static const size_t kMinParallelVertexCount = 4096;
+
+VertexAnimationSampler::~VertexAnimationSampler()
+{
+	delete mThreadPool;
+}
+
+void VertexAnimationSampler::CreateThreadPool(unsigned int threadCount)
+{
+	delete mThreadPool;
+	mThreadPool = new ThreadPool(threadCount);
+}
+
+void VertexAnimationSampler::AddRequest(VertexAnimation* animation, float time, int framesPerSecond, int meshIndex, int submeshIndex, Submesh* submesh)
+{
+	Request request;
+	request.animation = animation;
+	request.time = time;
+	request.framesPerSecond = framesPerSecond;
+	request.meshIndex = meshIndex;
+	request.submeshIndex = submeshIndex;
+	request.submesh = submesh;
+	
+	auto it = mRequestIndexes.find(submesh);
+	if(it != mRequestIndexes.end())
+	{
+		mRequests[it->second] = request;
+	}
+	else
+	{
+		mRequestIndexes[submesh] = mRequests.size();
+		mRequests.push_back(request);
+	}
+}
+
+void VertexAnimationSampler::RemoveRequest(Submesh* submesh)
+{
+	auto it = mRequestIndexes.find(submesh);
+	if(it == mRequestIndexes.end()) { return; }
+	
+	// Order doesn't matter, so move the last request into the removed one's place.
+	size_t index = it->second;
+	mRequestIndexes.erase(it);
+	if(index != mRequests.size() - 1)
+	{
+		mRequests[index] = mRequests.back();
+		mRequestIndexes[mRequests[index].submesh] = index;
+	}
+	mRequests.pop_back();
+}
+
+void VertexAnimationSampler::SampleAll()
+{
+	if(mRequests.empty()) { return; }
+	Sample();
+	
+	// Copy samples into submeshes. This uploads to the GPU, so must be done on the main thread.
+	for(auto& request : mRequests)
+	{
+		if(request.sampled)
+		{
+			request.submesh->SetPositions(&mStagingPositions[request.stagingOffset], true);
+		}
+	}
+	ClearRequests();
+}
+
+void VertexAnimationSampler::Sample()
+{
+	// Give each request its own range of the staging buffer.
+	size_t floatCount = 0;
+	for(auto& request : mRequests)
+	{
+		request.stagingOffset = floatCount;
+		request.stagingFloatCount = request.animation->GetVertexCount(request.meshIndex, request.submeshIndex) * 3;
+		floatCount += request.stagingFloatCount;
+	}
+	mStagingPositions.resize(floatCount);
+	
+	// Sample. Each job samples a run of requests with roughly the same number of vertices as other jobs.
+	// Requests only read from animations and write to their own staging range, so jobs don't need to synchronize.
+	size_t vertexCount = floatCount / 3;
+	if(mThreadPool == nullptr || vertexCount < kMinParallelVertexCount)
+	{
+		SampleRequests(0, mRequests.size());
+	}
+	else
+	{
+		// The calling thread takes a share of the work too, rather than sitting idle.
+		size_t jobCount = mThreadPool->GetThreadCount() + 1;
+		size_t floatsPerJob = (floatCount + jobCount - 1) / jobCount;
+		
+		std::vector<std::future<void>> jobs;
+		size_t begin = 0;
+		while(begin < mRequests.size())
+		{
+			size_t end = begin;
+			size_t jobFloatCount = 0;
+			while(end < mRequests.size() && (end == begin || jobFloatCount < floatsPerJob))
+			{
+				jobFloatCount += mRequests[end].stagingFloatCount;
+				++end;
+			}
+			
+			if(end == mRequests.size())
+			{
+				SampleRequests(begin, end);
+			}
+			else
+			{
+				jobs.push_back(mThreadPool->Enqueue([this, begin, end]() {
+					SampleRequests(begin, end);
+				}));
+			}
+			begin = end;
+		}
+		for(auto& job : jobs)
+		{
+			job.get();
+		}
+	}
+}
+
+const float* VertexAnimationSampler::GetSampledPositions(Submesh* submesh) const
+{
+	auto it = mRequestIndexes.find(submesh);
+	if(it == mRequestIndexes.end()) { return nullptr; }
+	
+	const Request& request = mRequests[it->second];
+	return request.sampled ? &mStagingPositions[request.stagingOffset] : nullptr;
+}
+
+void VertexAnimationSampler::ClearRequests()
+{
+	mRequests.clear();
+	mRequestIndexes.clear();
+}
+
+void VertexAnimationSampler::SampleRequests(size_t begin, size_t end)
+{
+	for(size_t i = begin; i < end; ++i)
+	{
+		// Nothing to sample if the animation has no vertex data for the submesh.
+		Request& request = mRequests[i];
+		request.sampled = request.stagingFloatCount > 0 &&
+						  request.animation->SampleVertexPose(request.time, request.framesPerSecond,
+															  request.meshIndex, request.submeshIndex,
+															  &mStagingPositions[request.stagingOffset]);
+	}
+}
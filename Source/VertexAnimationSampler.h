@@ -0,0 +1,86 @@
+//
+// VertexAnimationSampler.h
+//
+// Clark Kromenaker
+//
+// Samples vertex animations for many submeshes in one batch, spread across worker threads.
+//
+// During actor updates, vertex animators add sample requests rather than sampling right away.
+// After all actors have updated, all requests are sampled in parallel into staging buffers.
+// Results are then copied into submeshes (and uploaded to the GPU) on the main thread.
+//
+#pragma once
+#include <unordered_map>
+#include <vector>
+
+class Submesh;
+class ThreadPool;
+class VertexAnimation;
+
+class VertexAnimationSampler
+{
+public:
+	VertexAnimationSampler() = default;
+	~VertexAnimationSampler();
+	
+	// Worker threads can't be copied.
+	VertexAnimationSampler(const VertexAnimationSampler& other) = delete;
+	VertexAnimationSampler& operator=(const VertexAnimationSampler& other) = delete;
+	
+	// Creates worker threads to spread sampling across (thread count as for ThreadPool).
+	// These only ever sample, so a batch never waits behind other queued work, like asset loads.
+	// Without them, everything is sampled on the calling thread.
+	void CreateThreadPool(unsigned int threadCount = 0);
+	
+	// Requests a submesh's vertices be sampled from an animation at a time.
+	// The animation's vertex count for the submesh must match the submesh's vertex count.
+	// If a request already exists for the submesh this frame, it is replaced (only the latest sample would be visible anyway).
+	void AddRequest(VertexAnimation* animation, float time, int framesPerSecond, int meshIndex, int submeshIndex, Submesh* submesh);
+	
+	// Drops any request for a submesh this frame (e.g. if it's now played on the GPU, so a CPU sample would overwrite it).
+	void RemoveRequest(Submesh* submesh);
+	
+	// Samples all requests and applies them to their submeshes. Must be called on the main thread.
+	void SampleAll();
+	
+	// Samples all requests, without applying them to submeshes.
+	void Sample();
+	
+	// Positions sampled for a submesh's request by Sample, or null if there's no request or the animation had no vertex data for it.
+	const float* GetSampledPositions(Submesh* submesh) const;
+	
+	// Discards requests without sampling them (e.g. if the submeshes are about to be deleted).
+	void ClearRequests();
+	
+	int GetRequestCount() const { return static_cast<int>(mRequests.size()); }
+	
+private:
+	struct Request
+	{
+		VertexAnimation* animation = nullptr;
+		float time = 0.0f;
+		int framesPerSecond = 15;
+		int meshIndex = 0;
+		int submeshIndex = 0;
+		Submesh* submesh = nullptr;
+		
+		// Where this request's positions go in the staging buffer, and how many floats they take up.
+		size_t stagingOffset = 0;
+		size_t stagingFloatCount = 0;
+		
+		// Whether the animation had vertex data for this submesh.
+		bool sampled = false;
+	};
+	std::vector<Request> mRequests;
+	
+	// Maps submesh to index of its request, to replace repeat requests.
+	std::unordered_map<Submesh*, size_t> mRequestIndexes;
+	
+	// Sampled positions for all requests, back-to-back.
+	std::vector<float> mStagingPositions;
+	
+	// Worker threads, only used for sampling.
+	ThreadPool* mThreadPool = nullptr;
+	
+	void SampleRequests(size_t begin, size_t end);
+};
@@ -8,17 +8,83 @@
 #include <vector>
 
 #include "Actor.h"
+#include "GEngine.h"
 #include "Mesh.h"
 #include "MeshRenderer.h"
+#include "Renderer.h"
 #include "VertexAnimation.h"
+#include "VertexAnimationSampler.h"
 
 TYPE_DEF_CHILD(Component, VertexAnimator);
 
+/*static*/ bool VertexAnimator::sUseGPUPlayback = false;
+/*static*/ std::unordered_map<VertexAnimation*, std::vector<std::vector<GLuint>>> VertexAnimator::sKeyframeBuffers;
+
+/*static*/ GLuint VertexAnimator::GetKeyframeBuffer(VertexAnimation* animation, int meshIndex, int submeshIndex)
+{
+	if(Renderer::IsHeadless()) { return GL_NONE; }
+	
+	const std::vector<Vector3>* positions = animation->GetKeyframePositions(meshIndex, submeshIndex);
+	if(positions == nullptr) { return GL_NONE; }
+	
+	std::vector<std::vector<GLuint>>& buffers = sKeyframeBuffers[animation];
+	if(meshIndex >= buffers.size())
+	{
+		buffers.resize(meshIndex + 1);
+	}
+	if(submeshIndex >= buffers[meshIndex].size())
+	{
+		buffers[meshIndex].resize(submeshIndex + 1, GL_NONE);
+	}
+	
+	// Keyframes never change after loading, so uploading once is enough.
+	GLuint& buffer = buffers[meshIndex][submeshIndex];
+	if(buffer == GL_NONE)
+	{
+		glGenBuffers(1, &buffer);
+		glBindBuffer(GL_ARRAY_BUFFER, buffer);
+		glBufferData(GL_ARRAY_BUFFER, positions->size() * sizeof(Vector3), positions->data(), GL_STATIC_DRAW);
+	}
+	return buffer;
+}
+
+/*static*/ void VertexAnimator::DeleteKeyframeBuffers(VertexAnimation* animation)
+{
+	auto it = sKeyframeBuffers.find(animation);
+	if(it == sKeyframeBuffers.end()) { return; }
+	
+	for(auto& meshBuffers : it->second)
+	{
+		for(auto& buffer : meshBuffers)
+		{
+			if(buffer != GL_NONE)
+			{
+				glDeleteBuffers(1, &buffer);
+			}
+		}
+	}
+	sKeyframeBuffers.erase(it);
+}
+
 VertexAnimator::VertexAnimator(Actor* owner) : Component(owner)
 {
 	mMeshRenderer = owner->GetComponent<MeshRenderer>();
 }
 
+VertexAnimator::~VertexAnimator()
+{
+	// Submeshes belong to models, which outlive this animator (and may outlive the animation too).
+	StopMorphing();
+}
+
+void VertexAnimator::SampleOnCPU(int meshIndex, int submeshIndex)
+{
+	if(!IsSampledOnCPU(meshIndex, submeshIndex))
+	{
+		mCPUSubmeshes.emplace_back(meshIndex, submeshIndex);
+	}
+}
+
 void VertexAnimator::Start(VertexAnimation* anim, int framesPerSecond, std::function<void()> stopCallback)
 {
 	// If we're interrupting some other anim, fire the stop callback for that other anim.
@@ -47,6 +113,9 @@ void VertexAnimator::Stop(VertexAnimation* anim)
 	// Stop if animation matches playing one OR null was passed in.
 	if(mVertexAnimation != nullptr && (mVertexAnimation == anim || anim == nullptr))
 	{
+		// Submeshes keep their last pose, but on the CPU.
+		StopMorphing();
+		
 		// Fire stop callback if an animation was in progress.
 		if(mStopCallback != nullptr)
 		{
@@ -63,8 +132,9 @@ void VertexAnimator::Sample(VertexAnimation* animation, int frame)
 {
 	if(animation != nullptr)
 	{
+		// A single pose is sampled on the CPU, since it isn't played (and so would never stop blending on the GPU).
 		//TODO: Should not assume 15.0f here, probably?
-		TakeSample(animation, frame * (1.0f / 15.0f));
+		TakeSample(animation, frame * (1.0f / 15.0f), false);
 	}
 }
 
@@ -89,21 +159,56 @@ void VertexAnimator::OnUpdate(float deltaTime)
 	}
 }
 
-void VertexAnimator::TakeSample(VertexAnimation* animation, float time)
+void VertexAnimator::TakeSample(VertexAnimation* animation, float time, bool allowGPU)
 {
+	// Remember which submeshes blend on the GPU for this sample, so they can be given CPU positions when playback stops.
+	bool useGPU = allowGPU && sUseGPUPlayback;
+	if(useGPU)
+	{
+		mMorphedSubmeshes.clear();
+		mMorphAnimation = animation;
+		mMorphTime = time;
+	}
+	
 	// Iterate through each mesh and sample it in the vertex animation.
 	// We need to sample both vertex poses and transform poses to get the right result.
+	VertexAnimationSampler& sampler = GEngine::Instance()->GetVertexAnimationSampler();
 	const std::vector<Mesh*> meshes = mMeshRenderer->GetMeshes();
 	for(int i = 0; i < meshes.size(); i++)
 	{
 		const std::vector<Submesh*>& submeshes = meshes[i]->GetSubmeshes();
 		for(int j = 0; j < submeshes.size(); j++)
 		{
-			VertexAnimationVertexPose sample = animation->SampleVertexPose(time, mFramesPerSecond, i, j);
-			if(sample.mFrameNumber >= 0)
+			// Skip submeshes the animation doesn't animate, or that don't match the animation's vertex count.
+			Submesh* submesh = submeshes[j];
+			int vertexCount = animation->GetVertexCount(i, j);
+			if(vertexCount == 0 || vertexCount != submesh->GetVertexCount()) { continue; }
+			
+			// On the GPU, the shader blends two keyframes that are already uploaded - just choose which ones.
+			if(useGPU && !IsSampledOnCPU(i, j))
 			{
-                submeshes[j]->SetPositions(reinterpret_cast<float*>(sample.mVertexPositions.data()), true);
+				GLuint keyframeBuffer = GetKeyframeBuffer(animation, i, j);
+				int fromVertexOffset = 0;
+				int toVertexOffset = 0;
+				float t = 0.0f;
+				if(keyframeBuffer != GL_NONE && animation->GetVertexKeys(time, mFramesPerSecond, i, j, fromVertexOffset, toVertexOffset, t))
+				{
+					// A CPU sample requested earlier this frame would clear the morph when applied, so drop it.
+					sampler.RemoveRequest(submesh);
+					submesh->SetMorphPositions(keyframeBuffer, fromVertexOffset, toVertexOffset, t);
+					
+					MorphedSubmesh morphed;
+					morphed.submesh = submesh;
+					morphed.meshIndex = i;
+					morphed.submeshIndex = j;
+					morphed.keyframeBuffer = keyframeBuffer;
+					mMorphedSubmeshes.push_back(morphed);
+					continue;
+				}
 			}
+			
+			// Vertex sampling is the expensive part, so it's done for all animators at once after actors update.
+			sampler.AddRequest(animation, time, mFramesPerSecond, i, j, submesh);
 		}
 		
 		VertexAnimationTransformPose transformSample = animation->SampleTransformPose(time, mFramesPerSecond, i);
@@ -113,3 +218,37 @@ void VertexAnimator::TakeSample(VertexAnimation* animation, float time)
 		}
 	}
 }
+
+bool VertexAnimator::IsSampledOnCPU(int meshIndex, int submeshIndex) const
+{
+	for(auto& cpuSubmesh : mCPUSubmeshes)
+	{
+		if(cpuSubmesh.first == meshIndex && cpuSubmesh.second == submeshIndex)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void VertexAnimator::StopMorphing()
+{
+	// Submeshes still blending the animation's keyframes get the same pose as CPU positions, which also stops the blending.
+	// Submeshes given other positions since (or blending some other animation) are left alone.
+	for(auto& morphed : mMorphedSubmeshes)
+	{
+		if(morphed.submesh->GetMorphBuffer() != morphed.keyframeBuffer) { continue; }
+		
+		mSamplePositions.resize(morphed.submesh->GetVertexCount() * 3);
+		if(mMorphAnimation->SampleVertexPose(mMorphTime, mFramesPerSecond, morphed.meshIndex, morphed.submeshIndex, mSamplePositions.data()))
+		{
+			morphed.submesh->SetPositions(mSamplePositions.data(), true);
+		}
+		else
+		{
+			morphed.submesh->ClearMorphPositions();
+		}
+	}
+	mMorphedSubmeshes.clear();
+	mMorphAnimation = nullptr;
+}
@@ -9,8 +9,14 @@
 #include "Component.h"
 
 #include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <GL/glew.h>
 
 class MeshRenderer;
+class Submesh;
 class VertexAnimation;
 
 /*
@@ -34,7 +40,24 @@ class VertexAnimator : public Component
 {
 	TYPE_DECL_CHILD();
 public:
+	// Play vertex animations by blending keyframes on the GPU, rather than sampling them on the CPU.
+	// Off by default, since CPU-side positions (used for raycasts) are then only updated when playback stops.
+	// Without a GL context, animations are always sampled on the CPU.
+	static void SetUseGPUPlayback(bool useGPU) { sUseGPUPlayback = useGPU; }
+	
+	// GPU buffer holding all keyframe positions for an animation's submesh. Uploaded the first time it's asked for.
+	// GL_NONE if the submesh isn't animated, or there's no GL context.
+	static GLuint GetKeyframeBuffer(VertexAnimation* animation, int meshIndex, int submeshIndex);
+	
+	// Deletes an animation's keyframe buffers. Must be called when the animation is deleted.
+	static void DeleteKeyframeBuffers(VertexAnimation* animation);
+	
 	VertexAnimator(Actor* owner);
+	~VertexAnimator();
+	
+	// Always samples a submesh on the CPU, even with GPU playback.
+	// For submeshes whose vertex positions are read during playback (e.g. a character's hip).
+	void SampleOnCPU(int meshIndex, int submeshIndex);
 	
 	void Start(VertexAnimation* anim, int framesPerSecond, std::function<void()> stopCallback);
 	void Start(VertexAnimation* anim, int framesPerSecond, std::function<void()> stopCallback, float time);
@@ -48,6 +71,11 @@ protected:
 	void OnUpdate(float deltaTime) override;
 	
 private:
+	static bool sUseGPUPlayback;
+	
+	// Keyframe buffers for each animation played on the GPU, indexed by mesh index, then submesh index.
+	static std::unordered_map<VertexAnimation*, std::vector<std::vector<GLuint>>> sKeyframeBuffers;
+	
 	// The mesh renderer that will be animated.
 	MeshRenderer* mMeshRenderer = nullptr;
 	
@@ -64,5 +92,26 @@ private:
 	// Timer for tracking progress on vertex animation.
 	float mVertexAnimationTimer = 0.0f;
 	
-	void TakeSample(VertexAnimation* animation, float time);
+	// Submeshes always sampled on the CPU, as (mesh index, submesh index).
+	std::vector<std::pair<int, int>> mCPUSubmeshes;
+	
+	// Submeshes blending keyframes on the GPU, as of the last sample.
+	// When playback stops, they're given CPU positions for the last sample, so nothing refers to the animation's keyframe buffers after that.
+	struct MorphedSubmesh
+	{
+		Submesh* submesh = nullptr;
+		int meshIndex = 0;
+		int submeshIndex = 0;
+		GLuint keyframeBuffer = GL_NONE;
+	};
+	std::vector<MorphedSubmesh> mMorphedSubmeshes;
+	VertexAnimation* mMorphAnimation = nullptr;
+	float mMorphTime = 0.0f;
+	
+	// Positions for submeshes sampled on the spot, rather than by the batch sampler.
+	std::vector<float> mSamplePositions;
+	
+	void TakeSample(VertexAnimation* animation, float time, bool allowGPU = true);
+	bool IsSampledOnCPU(int meshIndex, int submeshIndex) const;
+	void StopMorphing();
 };
@@ -7,6 +7,8 @@
 
 #include <iostream>
 
+#include "Renderer.h"
+
 // Some OpenGL calls take in array indexes/offsets as pointers.
 // This macro just makes the syntax clearer for the reader.
 #define BUFFER_OFFSET(i) ((char *)NULL + (i))
@@ -14,6 +16,14 @@
 VertexArray::VertexArray(const MeshDefinition& data) :
     mData(data)
 {
+    // With no GL context, there's nothing to upload to - just keep the definition.
+    if(Renderer::IsHeadless())
+    {
+        mData.vertexData = nullptr;
+        mData.indexData = nullptr;
+        return;
+    }
+    
     // Generate and bind VBO.
     glGenBuffers(1, &mVBO);
     glBindBuffer(GL_ARRAY_BUFFER, mVBO);
@@ -102,6 +112,7 @@ VertexArray::VertexArray(const MeshDefinition& data) :
 
 VertexArray::~VertexArray()
 {
+    if(Renderer::IsHeadless()) { return; }
     glDeleteBuffers(1, &mVBO);
     glDeleteVertexArrays(1, &mVAO);
     glDeleteBuffers(1, &mIBO);
@@ -118,15 +129,23 @@ VertexArray& VertexArray::operator=(VertexArray&& other)
     mVBO = other.mVBO;
     mVAO = other.mVAO;
     mIBO = other.mIBO;
+    mIBOCapacity = other.mIBOCapacity;
+    mMorphBuffer = other.mMorphBuffer;
+    mMorphFromVertexOffset = other.mMorphFromVertexOffset;
+    mMorphToVertexOffset = other.mMorphToVertexOffset;
     
     other.mVBO = GL_NONE;
     other.mVAO = GL_NONE;
     other.mIBO = GL_NONE;
+    other.mIBOCapacity = 0;
+    other.mMorphBuffer = GL_NONE;
     return *this;
 }
 
 void VertexArray::ChangeVertexData(void* data)
 {
+    if(mVBO == GL_NONE) { return; }
+    
     // Assuming that the data is the correct size to fill the entire buffer.
     glBindBuffer(GL_ARRAY_BUFFER, mVBO);
     glBufferSubData(GL_ARRAY_BUFFER, 0, mData.vertexCount * mData.vertexDefinition.CalculateSize(), data);
@@ -153,6 +172,7 @@ void VertexArray::ChangeVertexData(VertexAttribute::Semantic semantic, void *dat
         // Update sub-data, if semantic matches.
         if(attribute.semantic == semantic)
         {
+            if(mVBO == GL_NONE) { return; }
             glBindBuffer(GL_ARRAY_BUFFER, mVBO);
             glBufferSubData(GL_ARRAY_BUFFER, offset, attributeSize, data);
             return;
@@ -165,20 +185,46 @@ void VertexArray::ChangeVertexData(VertexAttribute::Semantic semantic, void *dat
 
 void VertexArray::ChangeIndexData(unsigned short* indexes, unsigned int count)
 {
-    // If changing existing buffer contents, but the count is different, we must create delete old buffer and make a new one.
-    if(mIBO != GL_NONE && mData.indexCount != count)
-    {
-        glDeleteBuffers(1, &mIBO);
-        mIBO = GL_NONE;
-    }
-    
-    // Update index count.
+    // Update index count. The existing buffer is reused if it's big enough.
     mData.indexCount = count;
     
     // Refresh IBO contents with new data.
     RefreshIBOContents(indexes, count);
 }
 
+void VertexArray::SetMorphPositions(GLuint buffer, unsigned int fromVertexOffset, unsigned int toVertexOffset)
+{
+    if(mVAO == GL_NONE || buffer == GL_NONE) { return; }
+    
+    // Animations usually stay on the same keyframes for a few frames, so often there's nothing to change.
+    if(buffer == mMorphBuffer && fromVertexOffset == mMorphFromVertexOffset && toVertexOffset == mMorphToVertexOffset) { return; }
+    mMorphBuffer = buffer;
+    mMorphFromVertexOffset = fromVertexOffset;
+    mMorphToVertexOffset = toVertexOffset;
+    
+    // Attribute pointers are stored in the VAO, and refer to whatever buffer is bound when they're set.
+    glBindVertexArray(mVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    
+    GLuint fromAttributeId = static_cast<GLuint>(VertexAttribute::Semantic::MorphPosition1);
+    glEnableVertexAttribArray(fromAttributeId);
+    glVertexAttribPointer(fromAttributeId, 3, GL_FLOAT, GL_FALSE, 0, BUFFER_OFFSET(fromVertexOffset * 3 * sizeof(GLfloat)));
+    
+    GLuint toAttributeId = static_cast<GLuint>(VertexAttribute::Semantic::MorphPosition2);
+    glEnableVertexAttribArray(toAttributeId);
+    glVertexAttribPointer(toAttributeId, 3, GL_FLOAT, GL_FALSE, 0, BUFFER_OFFSET(toVertexOffset * 3 * sizeof(GLfloat)));
+}
+
+void VertexArray::ClearMorphPositions()
+{
+    if(mMorphBuffer == GL_NONE) { return; }
+    mMorphBuffer = GL_NONE;
+    
+    glBindVertexArray(mVAO);
+    glDisableVertexAttribArray(static_cast<GLuint>(VertexAttribute::Semantic::MorphPosition1));
+    glDisableVertexAttribArray(static_cast<GLuint>(VertexAttribute::Semantic::MorphPosition2));
+}
+
 void VertexArray::DrawTriangles() const
 {
     DrawTriangles(0, mData.indexCount > 0 ? mData.indexCount : mData.vertexCount);
@@ -226,6 +272,8 @@ void VertexArray::Draw(GLenum mode) const
 
 void VertexArray::Draw(GLenum mode, unsigned int offset, unsigned int count) const
 {
+    if(mVAO == GL_NONE) { return; }
+    
     // Bind vertex array object.
     glBindVertexArray(mVAO);
     
@@ -247,19 +295,24 @@ void VertexArray::Draw(GLenum mode, unsigned int offset, unsigned int count) con
                     
 void VertexArray::RefreshIBOContents(unsigned short* indexData, int indexCount)
 {
-    if(indexData != nullptr && indexCount > 0)
+    if(indexCount > 0 && !Renderer::IsHeadless())
     {
-        // Either create new buffer and fill with index data,
+        // Either create new buffer (or grow existing one) and fill with index data,
         // Or populate existing buffer with new data.
-        if(mIBO == GL_NONE)
+        // Index data can be null when creating, to allocate a buffer that is filled in later.
+        if(mIBO == GL_NONE || indexCount > mIBOCapacity)
         {
-            glGenBuffers(1, &mIBO);
+            if(mIBO == GL_NONE)
+            {
+                glGenBuffers(1, &mIBO);
+            }
             glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIBO);
             
             GLenum glUsage = (mData.meshUsage == MeshUsage::Static) ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW;
             glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount * sizeof(GLushort), indexData, glUsage);
+            mIBOCapacity = indexCount;
         }
-        else
+        else if(indexData != nullptr)
         {
             glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIBO);
             glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indexCount * sizeof(GLushort), indexData);
@@ -66,6 +66,12 @@ public:
     
     void ChangeIndexData(unsigned short* indexes, unsigned int count);
     
+    // Reads the morph position attributes (see VertexAttribute::Semantic) from another buffer of tightly packed positions.
+    // Offsets are in vertices, so one buffer can hold many poses back-to-back.
+    void SetMorphPositions(GLuint buffer, unsigned int fromVertexOffset, unsigned int toVertexOffset);
+    void ClearMorphPositions();
+    GLuint GetMorphBuffer() const { return mMorphBuffer; }
+    
     void DrawTriangles() const;
     void DrawTriangles(unsigned int offset, unsigned int count) const;
     
@@ -93,9 +99,17 @@ private:
     // It's optional, but improves performance.
     GLuint mIBO = GL_NONE;
     
+    // Number of indexes the IBO has room for. Changing index data only reallocates if more room is needed.
+    unsigned int mIBOCapacity = 0;
+    
     // The VAO (vertex array object) provides mapping info for the VBO.
     // The VBO is just a big chunk of memory. The VAO dictates how to interpret the memory to read vertex data.
     GLuint mVAO = GL_NONE;
     
+    // Morph position source currently set in the VAO, if any.
+    GLuint mMorphBuffer = GL_NONE;
+    unsigned int mMorphFromVertexOffset = 0;
+    unsigned int mMorphToVertexOffset = 0;
+    
     void RefreshIBOContents(unsigned short* indexData, int indexCount);
 };
@@ -10,7 +10,9 @@ const char* gAttributeNames[] = {
     "vNormal",
     "vColor",
     "vUV1",
-    "vUV2"
+    "vUV2",
+    "vMorphPos1",
+    "vMorphPos2"
 };
 
 VertexAttribute VertexAttribute::Position {
@@ -30,6 +30,8 @@ struct VertexAttribute
         Color,
         UV1,
         UV2,
+        MorphPosition1,     // For vertex animation on the GPU: positions to blend from and to.
+        MorphPosition2,
         SemanticCount
     };
     
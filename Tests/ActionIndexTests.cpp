@@ -0,0 +1,195 @@
+//
+// ActionIndexTests.cpp
+//
+// Clark Kromenaker
+//
+// Tests for ActionIndex.
+//
+#include "catch.hh"
+
+#include <deque>
+#include <unordered_set>
+
+#include "ActionIndex.h"
+#include "NVC.h"
+
+namespace
+{
+	// Verbs starting with "INV_" are inventory items, and "T_" are topics. Anything else is a normal verb.
+	ActionIndex::VerbTypes GetTestVerbTypes(const std::string& verb)
+	{
+		ActionIndex::VerbTypes verbTypes;
+		verbTypes.isInventoryItem = verb.compare(0, 4, "INV_") == 0 || verb == "ANY_INV_ITEM";
+		verbTypes.isTopic = verb.compare(0, 2, "T_") == 0;
+		verbTypes.isVerb = !verbTypes.isInventoryItem && !verbTypes.isTopic;
+		return verbTypes;
+	}
+	
+	// Action sets for tests, with cases that are met unless they're "FALSE".
+	struct TestActionSets
+	{
+		std::deque<Action> actions;
+		ActionIndex index;
+		ActionIndex::CaseFunc isCaseMet = [](const Action* action, VerbType) { return action->caseLabel != "FALSE"; };
+		
+		void Add(std::initializer_list<std::initializer_list<const char*>> nvcs)
+		{
+			std::vector<Action*> actionSet;
+			for(auto& nvc : nvcs)
+			{
+				auto it = nvc.begin();
+				actions.emplace_back();
+				actions.back().noun = *it++;
+				actions.back().verb = *it++;
+				actions.back().caseLabel = *it++;
+				actions.back().scriptText = *it;
+				actionSet.push_back(&actions.back());
+			}
+			index.AddActionSet(actionSet, &GetTestVerbTypes);
+		}
+		
+		const Action* GetAction(const std::string& noun, const std::string& verb)
+		{
+			int verbId = index.GetVerbId(verb);
+			bool verbIsInventoryItem = verbId >= 0 ? index.IsVerbType(verbId, VerbType::Inventory) : GetTestVerbTypes(verb).isInventoryItem;
+			return index.GetAction(index.GetNounId(noun), verbId, verbIsInventoryItem, isCaseMet);
+		}
+		
+		std::unordered_set<std::string> GetActionScripts(const std::string& noun, VerbType verbType)
+		{
+			std::vector<const Action*> result;
+			index.GetActions(index.GetNounId(noun), verbType, isCaseMet, result);
+			std::unordered_set<std::string> scripts;
+			for(auto& action : result)
+			{
+				scripts.insert(action->scriptText);
+			}
+			REQUIRE(scripts.size() == result.size());
+			return scripts;
+		}
+	};
+}
+
+TEST_CASE("ActionIndex gives nouns and verbs ids ignoring case")
+{
+	TestActionSets sets;
+	sets.Add({
+		{ "Candy", "Look", "", "look" },
+		{ "CANDY", "PICKUP", "", "pickup" },
+		{ "Gabriel", "look", "", "gabe" }
+	});
+	
+	REQUIRE(sets.index.GetNounId("candy") == 0);
+	REQUIRE(sets.index.GetNounId("CANDY") == 0);
+	REQUIRE(sets.index.GetNounId("gabriel") == 1);
+	REQUIRE(sets.index.GetNounId("Grace") == -1);
+	REQUIRE(sets.index.GetVerbId("LOOK") == 0);
+	REQUIRE(sets.index.GetVerbId("PickUp") == 1);
+	REQUIRE(sets.index.GetNoun(0) == "Candy");
+	
+	// Lookups ignore case too.
+	REQUIRE(sets.GetAction("CANDY", "look")->scriptText == "look");
+	REQUIRE(sets.GetAction("candy", "pickup")->scriptText == "pickup");
+	REQUIRE(sets.GetAction("GABRIEL", "LOOK")->scriptText == "gabe");
+	REQUIRE(sets.GetAction("grace", "look") == nullptr);
+	REQUIRE(sets.index.GetActions(sets.index.GetNounId("candy"), sets.index.GetVerbId("look")).size() == 1);
+	
+	sets.index.Clear();
+	REQUIRE(sets.index.GetNounId("candy") == -1);
+	REQUIRE(sets.GetAction("candy", "look") == nullptr);
+}
+
+TEST_CASE("ActionIndex GetAction prefers specific actions from later action sets")
+{
+	TestActionSets sets;
+	sets.Add({
+		{ "ANY_OBJECT", "LOOK", "", "any-look" },
+		{ "ANY_OBJECT", "ANY_INV_ITEM", "", "any-any" },
+		{ "CANDY", "LOOK", "", "candy-look" },
+		{ "CANDY", "PICKUP", "FALSE", "candy-pickup" },
+		{ "CANDY", "ANY_INV_ITEM", "", "candy-any" }
+	});
+	
+	// Exact matches beat wildcards.
+	REQUIRE(sets.GetAction("CANDY", "LOOK")->scriptText == "candy-look");
+	
+	// ANY_OBJECT applies to any noun, even ones no action set mentions.
+	REQUIRE(sets.GetAction("GRACE", "LOOK")->scriptText == "any-look");
+	
+	// Actions whose case isn't met are never used.
+	REQUIRE(sets.GetAction("CANDY", "PICKUP") == nullptr);
+	
+	// ANY_INV_ITEM applies to inventory items only, even ones no action set mentions.
+	REQUIRE(sets.GetAction("CANDY", "INV_KEY")->scriptText == "candy-any");
+	REQUIRE(sets.GetAction("GRACE", "INV_KEY")->scriptText == "any-any");
+	REQUIRE(sets.GetAction("CANDY", "TALK") == nullptr);
+	
+	// Later action sets override earlier ones.
+	sets.Add({
+		{ "CANDY", "LOOK", "", "candy-look-2" },
+		{ "CANDY", "PICKUP", "", "candy-pickup-2" }
+	});
+	REQUIRE(sets.GetAction("CANDY", "LOOK")->scriptText == "candy-look-2");
+	REQUIRE(sets.GetAction("CANDY", "PICKUP")->scriptText == "candy-pickup-2");
+}
+
+TEST_CASE("ActionIndex GetActions gives one action per verb")
+{
+	TestActionSets sets;
+	sets.Add({
+		{ "ANY_OBJECT", "LOOK", "", "any-look" },
+		{ "ANY_OBJECT", "THINK", "", "any-think" },
+		{ "ANY_OBJECT", "ANY_INV_ITEM", "", "any-any" },
+		{ "CANDY", "LOOK", "", "candy-look" },
+		{ "CANDY", "EAT", "FALSE", "candy-eat-unmet" },
+		{ "CANDY", "EAT", "", "candy-eat" },
+		{ "CANDY", "EAT", "", "candy-eat-second" },
+		{ "CANDY", "T_FLAVOR", "", "candy-topic" },
+		{ "CANDY", "INV_KEY", "", "candy-key" }
+	});
+	
+	// Wildcard actions are replaced by specific ones, unmet cases are skipped, and only the first met action per verb in an action set is used.
+	// Other types of verbs (and ANY_INV_ITEM) aren't included.
+	std::unordered_set<std::string> expected = { "candy-look", "any-think", "candy-eat" };
+	REQUIRE(sets.GetActionScripts("candy", VerbType::Normal) == expected);
+	
+	expected = { "candy-topic" };
+	REQUIRE(sets.GetActionScripts("CANDY", VerbType::Topic) == expected);
+	REQUIRE(sets.index.HasTopics(sets.index.GetNounId("Candy"), sets.isCaseMet));
+	
+	expected = { "candy-key" };
+	REQUIRE(sets.GetActionScripts("candy", VerbType::Inventory) == expected);
+	
+	// Nouns not in any action set still get wildcard actions.
+	expected = { "any-look", "any-think" };
+	REQUIRE(sets.GetActionScripts("GRACE", VerbType::Normal) == expected);
+	REQUIRE(!sets.index.HasTopics(sets.index.GetNounId("GRACE"), sets.isCaseMet));
+	
+	// A later action set replaces actions for the same verb.
+	sets.Add({
+		{ "ANY_OBJECT", "THINK", "", "any-think-2" },
+		{ "CANDY", "EAT", "FALSE", "candy-eat-unmet-2" }
+	});
+	expected = { "candy-look", "any-think-2", "candy-eat" };
+	REQUIRE(sets.GetActionScripts("candy", VerbType::Normal) == expected);
+}
+
+TEST_CASE("ActionIndex GetActions reuses the given vector")
+{
+	TestActionSets sets;
+	sets.Add({
+		{ "CANDY", "LOOK", "", "candy-look" },
+		{ "CANDY", "EAT", "", "candy-eat" }
+	});
+	
+	int nounId = sets.index.GetNounId("CANDY");
+	std::vector<const Action*> actions;
+	sets.index.GetActions(nounId, VerbType::Normal, sets.isCaseMet, actions);
+	REQUIRE(actions.size() == 2);
+	
+	// Old results are replaced, and the memory is reused.
+	const Action* const* data = actions.data();
+	sets.index.GetActions(nounId, VerbType::Normal, sets.isCaseMet, actions);
+	REQUIRE(actions.size() == 2);
+	REQUIRE(actions.data() == data);
+}
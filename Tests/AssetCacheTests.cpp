@@ -0,0 +1,94 @@
+//
+// AssetCacheTests.cpp
+//
+// Clark Kromenaker
+//
+// Tests for AssetCache class.
+//
+#include "catch.hh"
+#include "AssetCache.h"
+
+namespace
+{
+	int deletedCount = 0;
+
+	void DeleteInt(void* asset)
+	{
+		delete static_cast<int*>(asset);
+		++deletedCount;
+	}
+
+	void AddInt(AssetCache& cache, const std::string& name, size_t memorySize, bool evictable = true,
+				const std::vector<std::string>& dependencies = std::vector<std::string>())
+	{
+		cache.Add(name, new int(0), &DeleteInt, "INT", memorySize, evictable, dependencies);
+	}
+}
+
+TEST_CASE("AssetCache pins assets used outside a scope")
+{
+	deletedCount = 0;
+	{
+		AssetCache cache;
+		cache.SetMemoryBudget(0);
+		AddInt(cache, "A", 100);
+
+		REQUIRE(cache.Trim() == 0);
+		REQUIRE(cache.Contains("A"));
+		REQUIRE(cache.GetMemoryUsage() == 100);
+	}
+	REQUIRE(deletedCount == 1);
+}
+
+TEST_CASE("AssetCache evicts least recently used unreferenced assets down to budget")
+{
+	deletedCount = 0;
+	AssetCache cache;
+	cache.SetMemoryBudget(250);
+
+	cache.BeginScope();
+	AddInt(cache, "A", 100);
+	AddInt(cache, "B", 100);
+	AddInt(cache, "C", 100);
+	AddInt(cache, "D", 100, false);
+	cache.EndScope();
+	REQUIRE(cache.GetUnreferencedCount() == 4);
+
+	// Use "A" again in a new scope, so it's referenced, and "B" is now least recently used.
+	cache.BeginScope();
+	REQUIRE(cache.Get("A") != nullptr);
+
+	// Non-evictable "D" stays, so evicting "B" and "C" is needed to get to budget.
+	REQUIRE(cache.Trim() == 2);
+	REQUIRE(cache.Contains("A"));
+	REQUIRE(!cache.Contains("B"));
+	REQUIRE(!cache.Contains("C"));
+	REQUIRE(cache.Contains("D"));
+	REQUIRE(cache.GetMemoryUsage() == 200);
+	REQUIRE(cache.GetMemoryUsageByType().at("INT").count == 2);
+	REQUIRE(deletedCount == 2);
+}
+
+TEST_CASE("AssetCache keeps dependencies until their dependent is evicted")
+{
+	deletedCount = 0;
+	AssetCache cache;
+	cache.SetMemoryBudget(0);
+
+	// "Parent" uses "Child" while being constructed.
+	cache.BeginScope();
+	cache.BeginConstruct();
+	AddInt(cache, "CHILD", 10);
+	std::vector<std::string> dependencies = cache.EndConstruct();
+	REQUIRE(dependencies.size() == 1);
+	AddInt(cache, "PARENT", 10, true, dependencies);
+
+	// The scope only references "Parent", but "Parent" references "Child".
+	cache.EndScope();
+	REQUIRE(cache.GetUnreferencedCount() == 1);
+
+	// Evicting the parent releases the child, so both can go.
+	REQUIRE(cache.Trim() == 2);
+	REQUIRE(cache.GetCount() == 0);
+	REQUIRE(cache.GetMemoryUsage() == 0);
+}
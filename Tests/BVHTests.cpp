@@ -0,0 +1,125 @@
+//
+// BVHTests.cpp
+//
+// Clark Kromenaker
+//
+// Tests for BVH class.
+//
+#include "catch.hh"
+#include "BVH.h"
+
+#include <cstdlib>
+
+namespace
+{
+	float RandomRange(float min, float max)
+	{
+		return min + (max - min) * (static_cast<float>(std::rand()) / RAND_MAX);
+	}
+
+	Vector3 RandomPoint(float min, float max)
+	{
+		return Vector3(RandomRange(min, max), RandomRange(min, max), RandomRange(min, max));
+	}
+
+	// A bunch of small random triangles, spread over a large area.
+	std::vector<Vector3> CreateRandomTriangles(int count)
+	{
+		std::vector<Vector3> vertices;
+		for(int i = 0; i < count; ++i)
+		{
+			Vector3 center = RandomPoint(-500.0f, 500.0f);
+			for(int j = 0; j < 3; ++j)
+			{
+				vertices.push_back(center + RandomPoint(-40.0f, 40.0f));
+			}
+		}
+		return vertices;
+	}
+
+	Ray CreateRandomRay()
+	{
+		Vector3 origin = RandomPoint(-600.0f, 600.0f);
+		Vector3 target = RandomPoint(-300.0f, 300.0f);
+		Vector3 direction = target - origin;
+		return Ray(origin, direction.Normalize());
+	}
+}
+
+TEST_CASE("BVH raycasts match testing every triangle")
+{
+	std::srand(1234);
+	std::vector<Vector3> vertices = CreateRandomTriangles(2000);
+
+	BVH bvh;
+	bvh.Build(vertices);
+	REQUIRE(bvh.GetTriangleCount() == 2000);
+
+	// Only accept even triangles, to make sure filters are respected.
+	auto filter = [](int triangleIndex) { return triangleIndex % 2 == 0; };
+
+	int hitCount = 0;
+	for(int i = 0; i < 500; ++i)
+	{
+		Ray ray = CreateRandomRay();
+
+		// Brute force: test every triangle in order.
+		std::vector<BVH::Hit> expectedHits;
+		BVH::Hit expectedNearest;
+		for(int j = 0; j < bvh.GetTriangleCount(); ++j)
+		{
+			RaycastHit hitInfo;
+			if(filter(j) && Collisions::TestRayTriangle(ray, vertices[j * 3], vertices[j * 3 + 1], vertices[j * 3 + 2], hitInfo))
+			{
+				BVH::Hit hit;
+				hit.triangleIndex = j;
+				hit.t = hitInfo.t;
+				expectedHits.push_back(hit);
+				if(hit.t < expectedNearest.t)
+				{
+					expectedNearest = hit;
+				}
+			}
+		}
+
+		std::vector<BVH::Hit> hits;
+		bvh.RaycastAll(ray, filter, hits);
+		REQUIRE(hits.size() == expectedHits.size());
+		for(int j = 0; j < hits.size(); ++j)
+		{
+			REQUIRE(hits[j].triangleIndex == expectedHits[j].triangleIndex);
+			REQUIRE(hits[j].t == expectedHits[j].t);
+		}
+
+		BVH::Hit nearest;
+		bool hitAny = bvh.RaycastNearest(ray, filter, nearest);
+		REQUIRE(hitAny == !expectedHits.empty());
+		if(hitAny)
+		{
+			REQUIRE(nearest.triangleIndex == expectedNearest.triangleIndex);
+			REQUIRE(nearest.t == expectedNearest.t);
+			++hitCount;
+		}
+	}
+
+	// Make sure the test is actually testing something.
+	REQUIRE(hitCount > 0);
+}
+
+TEST_CASE("BVH handles rays parallel to an axis")
+{
+	std::vector<Vector3> vertices = {
+		Vector3(-1.0f, 0.0f, -1.0f), Vector3(1.0f, 0.0f, -1.0f), Vector3(0.0f, 0.0f, 1.0f),
+		Vector3(-1.0f, -5.0f, -1.0f), Vector3(1.0f, -5.0f, -1.0f), Vector3(0.0f, -5.0f, 1.0f)
+	};
+	BVH bvh;
+	bvh.Build(vertices);
+
+	auto acceptAll = [](int triangleIndex) { return true; };
+	BVH::Hit hit;
+	REQUIRE(bvh.RaycastNearest(Ray(Vector3(0.0f, 10.0f, 0.0f), -Vector3::UnitY), acceptAll, hit));
+	REQUIRE(hit.triangleIndex == 0);
+	REQUIRE(hit.t == Approx(10.0f));
+
+	REQUIRE(!bvh.RaycastNearest(Ray(Vector3(5.0f, 10.0f, 0.0f), -Vector3::UnitY), acceptAll, hit));
+}
@@ -0,0 +1,121 @@
+//
+// CaseResultCacheTests.cpp
+//
+// Clark Kromenaker
+//
+// Tests for caching NVC case results until the game state they read changes.
+//
+#include "catch.hh"
+
+#include "CaseResultCache.h"
+#include "GameProgress.h"
+#include "SheepAPI.h"
+#include "SheepCompiler.h"
+#include "SheepScript.h"
+#include "SheepVM.h"
+
+// Required for macros to work correctly with "string" instead of "std::string".
+using std::string;
+
+namespace
+{
+	// The game progress that case scripts read in these tests.
+	GameProgress* caseTestProgress = nullptr;
+}
+
+int GetFlag(const std::string& flagName)
+{
+	return caseTestProgress->GetFlag(flagName) ? 1 : 0;
+}
+RegFunc1(GetFlag, int, string, false, false);
+
+int CaseTestUncacheable(const std::string& flagName)
+{
+	return caseTestProgress->GetFlag(flagName) ? 1 : 0;
+}
+RegFunc1(CaseTestUncacheable, int, string, false, false);
+
+TEST_CASE("Cached case results are dropped when game state they read changes")
+{
+	// Flags that are known names, as if some earlier game state used them.
+	Symbol flag("CaseTestFlag");
+	Symbol otherFlag("CaseTestOtherFlag");
+	
+	GameProgress progress;
+	caseTestProgress = &progress;
+	
+	CaseResultCache cache;
+	progress.SetChangeCallback(std::bind(&CaseResultCache::OnGameStateChanged, &cache, std::placeholders::_1));
+	
+	// Compiled the same way as NVC cases.
+	SheepCompiler compiler;
+	SheepScript* script = compiler.Compile("Case", std::string("symbols { int n$ = 0; int v$ = 0; } code { X$() { GetFlag(\"CaseTestFlag\") } }"));
+	REQUIRE(script != nullptr);
+	
+	SheepVM vm;
+	int evaluations = 0;
+	auto evaluate = [&]() {
+		++evaluations;
+		return vm.Evaluate(script, 0, 0);
+	};
+	
+	// The first evaluation is saved, and used again after that.
+	REQUIRE(!cache.Evaluate(script, 1, 2, &progress, evaluate));
+	REQUIRE(!cache.Evaluate(script, 1, 2, &progress, evaluate));
+	REQUIRE(evaluations == 1);
+	REQUIRE(cache.GetResultCount() == 1);
+	
+	// Changing unrelated state keeps the result.
+	progress.SetFlag(otherFlag);
+	REQUIRE(cache.GetResultCount() == 1);
+	
+	// Changing the flag the case read drops the result, so the next evaluation sees the new value.
+	progress.SetFlag("casetestflag");
+	REQUIRE(cache.GetResultCount() == 0);
+	REQUIRE(cache.Evaluate(script, 1, 2, &progress, evaluate));
+	REQUIRE(evaluations == 2);
+	
+	// Scripts calling functions that aren't known to be cacheable are always evaluated.
+	SheepScript* uncacheable = compiler.Compile("Case", std::string("symbols { int n$ = 0; int v$ = 0; } code { X$() { CaseTestUncacheable(\"CaseTestFlag\") } }"));
+	REQUIRE(uncacheable != nullptr);
+	int uncachedEvaluations = 0;
+	auto evaluateUncacheable = [&]() {
+		++uncachedEvaluations;
+		return vm.Evaluate(uncacheable, 0, 0);
+	};
+	REQUIRE(cache.Evaluate(uncacheable, 1, 2, &progress, evaluateUncacheable));
+	REQUIRE(cache.Evaluate(uncacheable, 1, 2, &progress, evaluateUncacheable));
+	REQUIRE(uncachedEvaluations == 2);
+	
+	caseTestProgress = nullptr;
+	delete script;
+	delete uncacheable;
+}
+
+TEST_CASE("Cached case results that read unknown names are dropped when those names are set")
+{
+	GameProgress progress;
+	caseTestProgress = &progress;
+	
+	CaseResultCache cache;
+	progress.SetChangeCallback(std::bind(&CaseResultCache::OnGameStateChanged, &cache, std::placeholders::_1));
+	
+	// This flag name isn't a symbol when the case first reads it.
+	SheepCompiler compiler;
+	SheepScript* script = compiler.Compile("Case", std::string("symbols { int n$ = 0; int v$ = 0; } code { X$() { GetFlag(\"CaseTestUnknownFlag\") } }"));
+	REQUIRE(script != nullptr);
+	
+	SheepVM vm;
+	auto evaluate = [&]() {
+		return vm.Evaluate(script, 0, 0);
+	};
+	REQUIRE(!cache.Evaluate(script, 1, 2, &progress, evaluate));
+	REQUIRE(cache.GetResultCount() == 1);
+	
+	progress.SetFlag("CaseTestUnknownFlag");
+	REQUIRE(cache.GetResultCount() == 0);
+	REQUIRE(cache.Evaluate(script, 1, 2, &progress, evaluate));
+	
+	caseTestProgress = nullptr;
+	delete script;
+}
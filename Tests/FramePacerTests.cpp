@@ -0,0 +1,71 @@
+//
+// FramePacerTests.cpp
+//
+// Clark Kromenaker
+//
+// Tests for FramePacer class.
+//
+#include "catch.hh"
+#include "FramePacer.h"
+
+#include <chrono>
+
+TEST_CASE("FramePacer fixed steps consume accumulated time")
+{
+	FramePacer pacer;
+	REQUIRE(!pacer.IsFixedTimestepEnabled());
+	REQUIRE(pacer.ConsumeFixedSteps(1.0f) == 0);
+
+	pacer.SetFixedTimestep(0.25f);
+	REQUIRE(pacer.IsFixedTimestepEnabled());
+
+	// Partial steps carry over to later frames.
+	REQUIRE(pacer.ConsumeFixedSteps(0.125f) == 0);
+	REQUIRE(pacer.ConsumeFixedSteps(0.125f) == 1);
+	REQUIRE(pacer.ConsumeFixedSteps(0.625f) == 2);
+	REQUIRE(pacer.ConsumeFixedSteps(0.125f) == 1);
+
+	// Too many steps in one frame are capped, and the excess is dropped.
+	int stepCount = pacer.ConsumeFixedSteps(100.0f);
+	REQUIRE(stepCount > 0);
+	REQUIRE(stepCount < 400);
+	REQUIRE(pacer.ConsumeFixedSteps(0.0f) == 0);
+}
+
+TEST_CASE("FramePacer paces frames to target frame rate")
+{
+	FramePacer pacer;
+	pacer.SetTargetFrameRate(100);
+	pacer.SetMaxDeltaTime(1.0f);
+
+	// First frame has no previous frame, so no time has passed.
+	REQUIRE(pacer.WaitForNextFrame() == 0.0f);
+
+	auto start = std::chrono::steady_clock::now();
+	float totalDeltaTime = 0.0f;
+	for(int i = 0; i < 10; ++i)
+	{
+		float deltaTime = pacer.WaitForNextFrame();
+		REQUIRE(deltaTime > 0.0f);
+		totalDeltaTime += deltaTime;
+	}
+	float elapsed = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+
+	// Ten frames at 100 FPS take at least about 0.1 seconds.
+	REQUIRE(elapsed >= 0.09f);
+	REQUIRE(totalDeltaTime >= 0.09f);
+}
+
+TEST_CASE("FramePacer uncapped doesn't wait and clamps delta time")
+{
+	FramePacer pacer;
+	pacer.SetTargetFrameRate(0);
+	REQUIRE(pacer.GetTargetFrameRate() == 0);
+	pacer.SetMaxDeltaTime(0.0f);
+
+	pacer.WaitForNextFrame();
+	for(int i = 0; i < 100; ++i)
+	{
+		REQUIRE(pacer.WaitForNextFrame() == 0.0f);
+	}
+}
@@ -0,0 +1,66 @@
+//
+// FrameTimingsTests.cpp
+//
+// Clark Kromenaker
+//
+// Tests for FrameTimings class.
+//
+#include "catch.hh"
+#include "FrameTimings.h"
+
+TEST_CASE("FrameTimings summarizes subsystem times per frame")
+{
+	FrameTimings timings;
+	for(int i = 0; i < 20; ++i)
+	{
+		timings.BeginFrame();
+		
+		// Times for the same subsystem in one frame are combined.
+		timings.AddTime("Update", static_cast<float>(i));
+		timings.AddTime("Update", 1.0f);
+		
+		// Some subsystems aren't timed every frame.
+		if(i % 2 == 0)
+		{
+			timings.AddTime("Load", 10.0f);
+		}
+		timings.EndFrame();
+	}
+	REQUIRE(timings.GetFrameCount() == 20);
+
+	std::vector<FrameTimings::Summary> summaries = timings.GetSummaries();
+	REQUIRE(summaries.size() == 3);
+	REQUIRE(summaries[0].name == "Frame");
+	REQUIRE(summaries[0].frameCount == 20);
+
+	// Update times are 1 to 20.
+	REQUIRE(summaries[1].name == "Update");
+	REQUIRE(summaries[1].frameCount == 20);
+	REQUIRE(summaries[1].total == Approx(210.0f));
+	REQUIRE(summaries[1].average == Approx(10.5f));
+	REQUIRE(summaries[1].median == Approx(11.0f));
+	REQUIRE(summaries[1].percentile95 == Approx(20.0f));
+	REQUIRE(summaries[1].max == Approx(20.0f));
+
+	REQUIRE(summaries[2].name == "Load");
+	REQUIRE(summaries[2].frameCount == 10);
+	REQUIRE(summaries[2].total == Approx(100.0f));
+
+	REQUIRE(!timings.GetReport().empty());
+}
+
+TEST_CASE("FrameTimings scope does nothing without timings")
+{
+	{
+		FrameTimings::Scope scope(nullptr, "Nothing");
+	}
+
+	FrameTimings timings;
+	timings.BeginFrame();
+	{
+		FrameTimings::Scope scope(&timings, "Something");
+	}
+	timings.EndFrame();
+	REQUIRE(timings.GetSummaries().size() == 2);
+	REQUIRE(timings.GetSummaries()[1].frameCount == 1);
+}
@@ -0,0 +1,109 @@
+//
+// GameProgressTests.cpp
+//
+// Clark Kromenaker
+//
+// Tests for GameProgress.
+//
+#include "catch.hh"
+
+#include "GameProgress.h"
+
+TEST_CASE("GameProgress stores flags, variables, and counts")
+{
+	GameProgress progress;
+	
+	// Flags start cleared, and can be set and cleared.
+	REQUIRE(!progress.GetFlag("GameProgressTestFlag"));
+	progress.SetFlag("GameProgressTestFlag");
+	REQUIRE(progress.GetFlag("GameProgressTestFlag"));
+	REQUIRE(!progress.GetFlag("GameProgressTestOtherFlag"));
+	progress.ClearFlag("GameProgressTestFlag");
+	REQUIRE(!progress.GetFlag("GameProgressTestFlag"));
+	
+	// Variables.
+	REQUIRE(progress.GetGameVariable("GameProgressTestVar") == 0);
+	progress.SetGameVariable("GameProgressTestVar", 5);
+	progress.IncGameVariable("GameProgressTestVar");
+	REQUIRE(progress.GetGameVariable("GameProgressTestVar") == 6);
+	
+	// Chat, topic, and noun/verb counts.
+	progress.IncChatCount("GameProgressTestNoun");
+	progress.IncChatCount("GameProgressTestNoun");
+	REQUIRE(progress.GetChatCount("GameProgressTestNoun") == 2);
+	
+	progress.SetTopicCount("GameProgressTestNoun", "GameProgressTestTopic", 3);
+	progress.IncTopicCount("GameProgressTestNoun", "GameProgressTestTopic");
+	REQUIRE(progress.GetTopicCount("GameProgressTestNoun", "GameProgressTestTopic") == 4);
+	REQUIRE(progress.GetTopicCount("GameProgressTestTopic", "GameProgressTestNoun") == 0);
+	
+	progress.IncNounVerbCount("GameProgressTestNoun", "GameProgressTestVerb");
+	REQUIRE(progress.GetNounVerbCount("GameProgressTestNoun", "GameProgressTestVerb") == 1);
+	REQUIRE(progress.GetNounVerbCount("GameProgressTestVerb", "GameProgressTestNoun") == 0);
+}
+
+TEST_CASE("GameProgress names ignore case")
+{
+	GameProgress progress;
+	progress.SetFlag("GameProgressCaseFlag");
+	REQUIRE(progress.GetFlag("gameprogresscaseflag"));
+	REQUIRE(progress.GetFlag("GAMEPROGRESSCASEFLAG"));
+	progress.ClearFlag("gameProgressCaseFlag");
+	REQUIRE(!progress.GetFlag("GameProgressCaseFlag"));
+	
+	progress.SetGameVariable("GameProgressCaseVar", 7);
+	REQUIRE(progress.GetGameVariable("GAMEPROGRESSCASEVAR") == 7);
+	
+	progress.IncTopicCount("GameProgressCaseNoun", "GameProgressCaseTopic");
+	REQUIRE(progress.GetTopicCount("gameprogresscasenoun", "gameprogresscasetopic") == 1);
+}
+
+TEST_CASE("GameProgress ignores invalid symbols")
+{
+	GameProgress progress;
+	Symbol invalid;
+	Symbol valid("GameProgressValidSymbol");
+	
+	// Setting does nothing.
+	progress.SetFlag(invalid);
+	progress.SetGameVariable(invalid, 3);
+	progress.IncGameVariable(invalid);
+	progress.SetChatCount(invalid, 2);
+	progress.IncChatCount(invalid);
+	progress.SetTopicCount(invalid, valid, 4);
+	progress.IncTopicCount(valid, invalid);
+	progress.SetNounVerbCount(invalid, valid, 5);
+	progress.IncNounVerbCount(valid, invalid);
+	progress.ClearFlag(invalid);
+	
+	// Reading gives false/zero.
+	REQUIRE(!progress.GetFlag(invalid));
+	REQUIRE(progress.GetGameVariable(invalid) == 0);
+	REQUIRE(progress.GetChatCount(invalid) == 0);
+	REQUIRE(progress.GetTopicCount(invalid, valid) == 0);
+	REQUIRE(progress.GetTopicCount(valid, invalid) == 0);
+	REQUIRE(progress.GetNounVerbCount(invalid, valid) == 0);
+	REQUIRE(progress.GetNounVerbCount(valid, invalid) == 0);
+	
+	// Valid names are unaffected.
+	REQUIRE(!progress.GetFlag(valid));
+	REQUIRE(progress.GetChatCount(valid) == 0);
+}
+
+TEST_CASE("GameProgress reads don't intern names")
+{
+	GameProgress progress;
+	int symbolCount = Symbol::GetCount();
+	REQUIRE(!progress.GetFlag("GameProgressNeverSetFlag"));
+	REQUIRE(progress.GetGameVariable("GameProgressNeverSetVar") == 0);
+	REQUIRE(progress.GetChatCount("GameProgressNeverSetNoun") == 0);
+	REQUIRE(progress.GetTopicCount("GameProgressNeverSetNoun", "GameProgressNeverSetTopic") == 0);
+	REQUIRE(progress.GetNounVerbCount("GameProgressNeverSetNoun", "GameProgressNeverSetVerb") == 0);
+	progress.ClearFlag("GameProgressNeverSetFlag");
+	REQUIRE(Symbol::GetCount() == symbolCount);
+	
+	// Setting does.
+	progress.SetFlag("GameProgressNeverSetFlag");
+	REQUIRE(Symbol::GetCount() == symbolCount + 1);
+	REQUIRE(progress.GetFlag("GameProgressNeverSetFlag"));
+}
@@ -0,0 +1,100 @@
+//
+// HeightGridTests.cpp
+//
+// Clark Kromenaker
+//
+// Tests for HeightGrid class.
+//
+#include "catch.hh"
+#include "HeightGrid.h"
+
+#include <cstdlib>
+
+namespace
+{
+	float RandomRange(float min, float max)
+	{
+		return min + (max - min) * (static_cast<float>(std::rand()) / RAND_MAX);
+	}
+}
+
+TEST_CASE("HeightGrid heights match raycasting every triangle")
+{
+	// A bumpy floor made of a grid of quads, plus some overlapping "steps" above it.
+	// Steps come after the floor, so the floor should be used where both are present.
+	std::srand(4321);
+	std::vector<Vector3> vertices;
+	const int kQuadsPerSide = 30;
+	const float kQuadSize = 20.0f;
+	for(int x = 0; x < kQuadsPerSide; ++x)
+	{
+		for(int z = 0; z < kQuadsPerSide; ++z)
+		{
+			Vector3 p0(x * kQuadSize, RandomRange(0.0f, 5.0f), z * kQuadSize);
+			Vector3 p1(p0.x + kQuadSize, RandomRange(0.0f, 5.0f), p0.z);
+			Vector3 p2(p0.x + kQuadSize, RandomRange(0.0f, 5.0f), p0.z + kQuadSize);
+			Vector3 p3(p0.x, RandomRange(0.0f, 5.0f), p0.z + kQuadSize);
+			vertices.insert(vertices.end(), { p0, p1, p2, p0, p2, p3 });
+		}
+	}
+	for(int i = 0; i < 50; ++i)
+	{
+		Vector3 center(RandomRange(0.0f, 600.0f), RandomRange(10.0f, 50.0f), RandomRange(0.0f, 600.0f));
+		vertices.insert(vertices.end(), {
+			center + Vector3(-30.0f, 0.0f, -30.0f), center + Vector3(30.0f, 0.0f, -30.0f), center + Vector3(0.0f, 0.0f, 30.0f)
+		});
+	}
+
+	HeightGrid grid;
+	grid.Build(vertices);
+
+	// Skip some triangles, to make sure filters are respected.
+	auto filter = [](int triangleIndex) { return triangleIndex % 7 != 0; };
+
+	int hitCount = 0;
+	for(int i = 0; i < 2000; ++i)
+	{
+		// Include some points outside the floor, and some exactly on quad edges.
+		Vector3 position(RandomRange(-50.0f, 650.0f), 0.0f, RandomRange(-50.0f, 650.0f));
+		if(i % 10 == 0)
+		{
+			position.x = static_cast<int>(position.x / kQuadSize) * kQuadSize;
+		}
+
+		// Brute force: cast down, and use the first triangle hit.
+		Ray downRay(Vector3(position.x, HeightGrid::kRayOriginY, position.z), -Vector3::UnitY);
+		bool expectedHit = false;
+		float expectedHeight = 0.0f;
+		for(int j = 0; j < grid.GetTriangleCount(); ++j)
+		{
+			RaycastHit hitInfo;
+			if(filter(j) && Collisions::TestRayTriangle(downRay, vertices[j * 3], vertices[j * 3 + 1], vertices[j * 3 + 2], hitInfo))
+			{
+				expectedHit = true;
+				expectedHeight = downRay.GetPoint(hitInfo.t).y;
+				break;
+			}
+		}
+
+		float height = 0.0f;
+		bool hit = grid.GetHeight(position, filter, height);
+		REQUIRE(hit == expectedHit);
+		if(hit)
+		{
+			REQUIRE(height == expectedHeight);
+			++hitCount;
+		}
+	}
+
+	// Make sure the test is actually testing something.
+	REQUIRE(hitCount > 1000);
+}
+
+TEST_CASE("HeightGrid with no triangles has no height")
+{
+	HeightGrid grid;
+	grid.Build(std::vector<Vector3>());
+
+	float height = 0.0f;
+	REQUIRE(!grid.GetHeight(Vector3::Zero, [](int triangleIndex) { return true; }, height));
+}
@@ -0,0 +1,80 @@
+//
+// IniParserTests.cpp
+//
+// Clark Kromenaker
+//
+// Tests for IniParser class.
+//
+#include "catch.hh"
+#include "IniParser.h"
+
+#include <cstring>
+
+TEST_CASE("IniParser reads sections, conditions, and key/value pairs")
+{
+	const char* text =
+		"// Comment at top.\r\n"
+		"[General]\r\n"
+		"\tmodel = gab , pos={1, 2.5, -3}, hidden // trailing comment\r\n"
+		"\r\n"
+		"[ACTORS=GetFlag(Test)]\n"
+		"color=255/128/0\n"
+		"[general]\n"
+		"rect={0, 1, 2, 3}";
+	IniParser parser(text, static_cast<unsigned int>(strlen(text)));
+	parser.ParseAll();
+	
+	// Lookup ignores case, and gives sections in file order.
+	std::vector<IniSection*> generals = parser.GetSections("GENERAL");
+	REQUIRE(generals.size() == 2);
+	REQUIRE(generals[0]->name == "General");
+	REQUIRE(generals[1]->name == "general");
+	
+	IniSection& general = parser.GetSection("general");
+	REQUIRE(&general == generals[0]);
+	REQUIRE(general.lines.size() == 1);
+	
+	const std::vector<IniKeyValue>& entries = general.lines[0].entries;
+	REQUIRE(entries.size() == 3);
+	REQUIRE(entries[0].key == "model");
+	REQUIRE(entries[0].value == "gab");
+	REQUIRE(entries[1].key == "pos");
+	REQUIRE(entries[1].GetValueAsVector3() == Vector3(1.0f, 2.5f, -3.0f));
+	REQUIRE(entries[2].key == "hidden");
+	REQUIRE(entries[2].value == "hidden");
+	
+	IniSection& actors = parser.GetSection("Actors");
+	REQUIRE(actors.condition == "GetFlag(Test)");
+	Color32 color = actors.lines[0].entries[0].GetValueAsColor32();
+	REQUIRE(color.GetR() == 255);
+	REQUIRE(color.GetG() == 128);
+	REQUIRE(color.GetB() == 0);
+	
+	Rect rect = generals[1]->lines[0].entries[0].GetValueAsRect();
+	REQUIRE(rect.GetMin() == Vector2(0.0f, 1.0f));
+	REQUIRE(rect.GetMax() == Vector2(2.0f, 3.0f));
+	
+	// Missing sections are empty.
+	REQUIRE(parser.GetSection("Missing").lines.empty());
+	REQUIRE(parser.GetSections("Missing").empty());
+}
+
+TEST_CASE("IniParser reads line by line")
+{
+	const char* text = "[Section]\n  a=1, b={2, 3}\n// skip\nc\n";
+	IniParser parser(text, static_cast<unsigned int>(strlen(text)));
+	
+	REQUIRE(parser.ReadLine());
+	REQUIRE(parser.ReadKeyValuePair());
+	REQUIRE(parser.GetKeyValue().key == "a");
+	REQUIRE(parser.GetKeyValue().GetValueAsInt() == 1);
+	REQUIRE(parser.ReadKeyValuePair());
+	REQUIRE(parser.GetKeyValue().key == "b");
+	REQUIRE(parser.GetKeyValue().GetValueAsVector2() == Vector2(2.0f, 3.0f));
+	REQUIRE(!parser.ReadKeyValuePair());
+	
+	REQUIRE(parser.ReadLine());
+	REQUIRE(parser.ReadKeyValuePair());
+	REQUIRE(parser.GetKeyValue().key == "c");
+	REQUIRE(!parser.ReadLine());
+}
@@ -0,0 +1,82 @@
+//
+// PixelUtilTests.cpp
+//
+// Clark Kromenaker
+//
+// Tests for PixelUtil functions.
+//
+#include "catch.hh"
+#include "PixelUtil.h"
+
+#include <vector>
+
+TEST_CASE("PixelUtil divides by 255 exactly")
+{
+	int mismatchCount = 0;
+	for(unsigned int value = 0; value <= 255 * 255; ++value)
+	{
+		if(PixelUtil::DivideBy255(value) != value / 255)
+		{
+			++mismatchCount;
+		}
+	}
+	REQUIRE(mismatchCount == 0);
+}
+
+TEST_CASE("PixelUtil blends rows by source alpha")
+{
+	// Every source value against every dest value and alpha.
+	// An odd pixel count makes sure leftover pixels (after SIMD) are blended too.
+	const int kPixelCount = 259;
+	std::vector<unsigned char> source(kPixelCount * 4);
+	std::vector<unsigned char> dest(kPixelCount * 4);
+	
+	int mismatchCount = 0;
+	for(unsigned int alpha = 0; alpha < 256; ++alpha)
+	{
+		for(int i = 0; i < kPixelCount; ++i)
+		{
+			source[i * 4] = static_cast<unsigned char>(i);
+			source[i * 4 + 1] = static_cast<unsigned char>(255 - i);
+			source[i * 4 + 2] = static_cast<unsigned char>(i * 7);
+			source[i * 4 + 3] = static_cast<unsigned char>(alpha);
+		}
+		
+		for(unsigned int destValue = 0; destValue < 256; ++destValue)
+		{
+			for(int i = 0; i < kPixelCount; ++i)
+			{
+				dest[i * 4] = static_cast<unsigned char>(destValue);
+				dest[i * 4 + 1] = static_cast<unsigned char>(destValue);
+				dest[i * 4 + 2] = static_cast<unsigned char>(destValue);
+				dest[i * 4 + 3] = static_cast<unsigned char>(i);
+			}
+			PixelUtil::BlendRow(source.data(), dest.data(), kPixelCount);
+			
+			for(int i = 0; i < kPixelCount; ++i)
+			{
+				for(int channel = 0; channel < 3; ++channel)
+				{
+					unsigned int expected = (destValue * (255 - alpha) + source[i * 4 + channel] * alpha) / 255;
+					if(dest[i * 4 + channel] != expected) { ++mismatchCount; }
+				}
+				
+				// Dest alpha doesn't change.
+				if(dest[i * 4 + 3] != static_cast<unsigned char>(i)) { ++mismatchCount; }
+			}
+		}
+	}
+	REQUIRE(mismatchCount == 0);
+}
+
+TEST_CASE("PixelUtil blends only the given pixels")
+{
+	unsigned char source[] = { 10, 20, 30, 255, 10, 20, 30, 255 };
+	unsigned char dest[] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+	PixelUtil::BlendRow(source, dest, 1);
+	REQUIRE(dest[0] == 10);
+	REQUIRE(dest[1] == 20);
+	REQUIRE(dest[2] == 30);
+	REQUIRE(dest[3] == 0);
+	REQUIRE(dest[4] == 0);
+}
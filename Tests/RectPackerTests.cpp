@@ -0,0 +1,95 @@
+//
+// RectPackerTests.cpp
+//
+// Clark Kromenaker
+//
+// Tests for RectPacker class.
+//
+#include "catch.hh"
+#include "RectPacker.h"
+
+namespace
+{
+	RectPacker::Rect MakeRect(int width, int height)
+	{
+		RectPacker::Rect rect;
+		rect.width = width;
+		rect.height = height;
+		return rect;
+	}
+
+	bool Overlaps(const RectPacker::Rect& a, const RectPacker::Rect& b, int padding)
+	{
+		if(a.page != b.page) { return false; }
+		return a.x - padding < b.x + b.width + padding && b.x - padding < a.x + a.width + padding &&
+			   a.y - padding < b.y + b.height + padding && b.y - padding < a.y + a.height + padding;
+	}
+}
+
+TEST_CASE("RectPacker places rects without overlap, inside pages")
+{
+	std::vector<RectPacker::Rect> rects;
+	for(int i = 0; i < 50; ++i)
+	{
+		rects.push_back(MakeRect(4 + (i * 7) % 29, 4 + (i * 13) % 23));
+	}
+
+	const int kPadding = 1;
+	RectPacker packer(128, 128, kPadding);
+	packer.Pack(rects);
+	REQUIRE(packer.GetPageCount() >= 1);
+
+	for(int i = 0; i < rects.size(); ++i)
+	{
+		const RectPacker::Rect& rect = rects[i];
+		REQUIRE(rect.page >= 0);
+		REQUIRE(rect.page < packer.GetPageCount());
+		REQUIRE(rect.x >= kPadding);
+		REQUIRE(rect.y >= kPadding);
+		REQUIRE(rect.x + rect.width + kPadding <= packer.GetPageWidth(rect.page));
+		REQUIRE(rect.y + rect.height + kPadding <= packer.GetPageHeight(rect.page));
+		REQUIRE(packer.GetPageWidth(rect.page) <= 128);
+		REQUIRE(packer.GetPageHeight(rect.page) <= 128);
+
+		for(int j = i + 1; j < rects.size(); ++j)
+		{
+			REQUIRE(!Overlaps(rect, rects[j], kPadding));
+		}
+	}
+}
+
+TEST_CASE("RectPacker uses more pages when needed")
+{
+	// Four 30x30 rects (32x32 with padding) fit exactly on a 64x64 page.
+	std::vector<RectPacker::Rect> rects(5, MakeRect(30, 30));
+	RectPacker packer(64, 64, 1);
+	packer.Pack(rects);
+	REQUIRE(packer.GetPageCount() == 2);
+	REQUIRE(packer.GetPageWidth(0) == 64);
+	REQUIRE(packer.GetPageHeight(0) == 64);
+	REQUIRE(rects[4].page == 1);
+
+	// Pages shrink to fit.
+	REQUIRE(packer.GetPageWidth(1) == 32);
+	REQUIRE(packer.GetPageHeight(1) == 32);
+}
+
+TEST_CASE("RectPacker gives oversized rects their own page")
+{
+	std::vector<RectPacker::Rect> rects;
+	rects.push_back(MakeRect(8, 8));
+	rects.push_back(MakeRect(100, 10));
+	rects.push_back(MakeRect(8, 8));
+
+	RectPacker packer(64, 64, 2);
+	packer.Pack(rects);
+	REQUIRE(packer.GetPageCount() == 2);
+
+	// Oversized rect is tallest, so it's placed first.
+	REQUIRE(rects[1].page == 0);
+	REQUIRE(packer.GetPageWidth(0) == 104);
+	REQUIRE(packer.GetPageHeight(0) == 14);
+
+	REQUIRE(rects[0].page == 1);
+	REQUIRE(rects[2].page == 1);
+}
@@ -0,0 +1,89 @@
+//
+// RenderQueueTests.cpp
+//
+// Clark Kromenaker
+//
+// Tests for RenderQueue class.
+//
+#include "catch.hh"
+#include "RenderQueue.h"
+
+#include <cstdint>
+#include <string>
+
+namespace
+{
+	// The queue never dereferences state pointers, so fake ones can stand in for real shaders/materials/textures.
+	template<typename T> T* FakePointer(uintptr_t value)
+	{
+		return reinterpret_cast<T*>(value * 16);
+	}
+
+	// Records the calls the queue makes, in order.
+	class RecordingRenderBackend : public RenderBackend
+	{
+	public:
+		std::string calls;
+
+		void ActivateShader(const RenderCommand&) override { calls += "S"; }
+		void ActivateMaterial(const RenderCommand&) override { calls += "M"; }
+		void Draw(const RenderCommand& command) override
+		{
+			calls += std::to_string(static_cast<int>(command.depth));
+		}
+	};
+
+	RenderCommand MakeCommand(uintptr_t shader, uintptr_t material, uintptr_t texture, float depth)
+	{
+		RenderCommand command;
+		command.shader = FakePointer<Shader>(shader);
+		command.material = FakePointer<Material>(material);
+		command.texture = FakePointer<Texture>(texture);
+		command.depth = depth;
+		return command;
+	}
+}
+
+TEST_CASE("RenderQueue sorts by shader, then texture, then depth")
+{
+	RenderQueue queue;
+
+	// Shader 1 is seen first, so it gets submitted first.
+	queue.Add(MakeCommand(1, 10, 100, 5.0f));
+	queue.Add(MakeCommand(2, 20, 200, 1.0f));
+	queue.Add(MakeCommand(1, 11, 101, 2.0f));
+	queue.Add(MakeCommand(1, 10, 100, 3.0f));
+	queue.Add(MakeCommand(2, 20, 200, 4.0f));
+	REQUIRE(queue.GetCommandCount() == 5);
+
+	RecordingRenderBackend backend;
+	queue.Submit(backend);
+	REQUIRE(backend.calls == "SM35M2SM14");
+	REQUIRE(queue.GetCommandCount() == 0);
+
+	const RenderStats& stats = queue.GetStats();
+	REQUIRE(stats.drawCount == 5);
+	REQUIRE(stats.shaderChangeCount == 2);
+	REQUIRE(stats.materialChangeCount == 3);
+	REQUIRE(stats.textureChangeCount == 3);
+}
+
+TEST_CASE("RenderQueue resets material state when shader changes")
+{
+	RenderQueue queue;
+
+	// Same material and texture under two shaders still needs parameters set for each shader.
+	queue.Add(MakeCommand(1, 10, 100, 1.0f));
+	queue.Add(MakeCommand(2, 10, 100, 2.0f));
+
+	RecordingRenderBackend backend;
+	queue.Submit(backend);
+	REQUIRE(backend.calls == "SM1SM2");
+	REQUIRE(queue.GetStats().materialChangeCount == 2);
+	REQUIRE(queue.GetStats().textureChangeCount == 1);
+
+	// Stats are per submit.
+	queue.Submit(backend);
+	REQUIRE(queue.GetStats().drawCount == 0);
+	REQUIRE(queue.GetStats().shaderChangeCount == 0);
+}
@@ -0,0 +1,114 @@
+//
+// ShaderUniformsTests.cpp
+//
+// Clark Kromenaker
+//
+// Tests for ShaderUniforms.
+//
+#include "catch.hh"
+
+#include "ShaderUniforms.h"
+
+TEST_CASE("ShaderUniforms finds uniforms by index")
+{
+	ShaderUniforms uniforms;
+	REQUIRE(uniforms.GetIndex("uColor") == -1);
+	REQUIRE(uniforms.GetIndex(BuiltInUniform::ObjectToWorldMatrix) == -1);
+	REQUIRE(uniforms.GetIndex(BuiltInUniform::AlphaTest) == -1);
+	REQUIRE(uniforms.GetIndex(BuiltInUniform::MorphWeight) == -1);
+	
+	uniforms.Add("uColor", UniformType::Vector4, 3);
+	uniforms.Add("gObjectToWorldMatrix", UniformType::Matrix4, 0);
+	uniforms.Add("uDiffuse", UniformType::Texture2D, 7);
+	uniforms.Add("gAlphaTest", UniformType::Float, 5);
+	REQUIRE(uniforms.GetCount() == 4);
+	
+	// Indexes are positions in the table, not GL locations.
+	REQUIRE(uniforms.GetIndex("uColor") == 0);
+	REQUIRE(uniforms.GetIndex("uDiffuse") == 2);
+	REQUIRE(uniforms.Get(2).location == 7);
+	REQUIRE(uniforms.Get(2).type == UniformType::Texture2D);
+	REQUIRE(uniforms.Get(2).name == "uDiffuse");
+	
+	// Names must match exactly.
+	REQUIRE(uniforms.GetIndex("ucolor") == -1);
+	REQUIRE(uniforms.GetIndex("uColor2") == -1);
+	REQUIRE(uniforms.GetIndex("") == -1);
+	
+	// Built-ins are found when added, and are still missing if not in the shader.
+	REQUIRE(uniforms.GetIndex(BuiltInUniform::ObjectToWorldMatrix) == 1);
+	REQUIRE(uniforms.GetIndex(BuiltInUniform::AlphaTest) == 3);
+	REQUIRE(uniforms.GetIndex(BuiltInUniform::MorphWeight) == -1);
+}
+
+TEST_CASE("ShaderUniforms converts GL uniform types")
+{
+	REQUIRE(ShaderUniforms::GetUniformType(GL_FLOAT) == UniformType::Float);
+	REQUIRE(ShaderUniforms::GetUniformType(GL_INT) == UniformType::Int);
+	REQUIRE(ShaderUniforms::GetUniformType(GL_FLOAT_VEC3) == UniformType::Vector3);
+	REQUIRE(ShaderUniforms::GetUniformType(GL_FLOAT_VEC4) == UniformType::Vector4);
+	REQUIRE(ShaderUniforms::GetUniformType(GL_FLOAT_MAT4) == UniformType::Matrix4);
+	REQUIRE(ShaderUniforms::GetUniformType(GL_SAMPLER_2D) == UniformType::Texture2D);
+	REQUIRE(ShaderUniforms::GetUniformType(GL_SAMPLER_CUBE) == UniformType::TextureCube);
+	REQUIRE(ShaderUniforms::GetUniformType(GL_SAMPLER_3D) == UniformType::Unknown);
+}
+
+TEST_CASE("ShaderUniforms only reports changed values")
+{
+	ShaderUniforms uniforms;
+	uniforms.Add("uDiffuse", UniformType::Texture2D, 0);
+	uniforms.Add("uColor", UniformType::Vector4, 1);
+	uniforms.Add("gAlphaTest", UniformType::Float, 2);
+	
+	// Missing uniforms never need setting.
+	REQUIRE(!uniforms.ChangeValue(-1, 1));
+	GLfloat one = 1.0f;
+	REQUIRE(!uniforms.ChangeValue(-1, &one, 1));
+	
+	// The first value must always be set, even if it matches GL's default.
+	REQUIRE(uniforms.ChangeValue(0, 0));
+	REQUIRE(!uniforms.ChangeValue(0, 0));
+	REQUIRE(uniforms.ChangeValue(0, 1));
+	REQUIRE(!uniforms.ChangeValue(0, 1));
+	REQUIRE(uniforms.Get(0).intValue == 1);
+	
+	GLfloat white[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+	GLfloat red[4] = { 1.0f, 0.0f, 0.0f, 1.0f };
+	REQUIRE(uniforms.ChangeValue(1, white, 4));
+	REQUIRE(!uniforms.ChangeValue(1, white, 4));
+	REQUIRE(uniforms.ChangeValue(1, red, 4));
+	REQUIRE(uniforms.ChangeValue(1, white, 4));
+	
+	// Every component is compared.
+	GLfloat almostWhite[4] = { 1.0f, 1.0f, 1.0f, 0.5f };
+	REQUIRE(uniforms.ChangeValue(1, almostWhite, 4));
+	REQUIRE(uniforms.Get(1).floatValues[3] == 0.5f);
+	
+	// Each uniform remembers its own value.
+	GLfloat alphaTest = 0.0f;
+	REQUIRE(uniforms.ChangeValue(2, &alphaTest, 1));
+	REQUIRE(!uniforms.ChangeValue(2, &alphaTest, 1));
+	alphaTest = 0.1f;
+	REQUIRE(uniforms.ChangeValue(2, &alphaTest, 1));
+	REQUIRE(!uniforms.ChangeValue(1, almostWhite, 4));
+	REQUIRE(!uniforms.ChangeValue(0, 1));
+}
+
+TEST_CASE("ShaderUniforms are separate for each shader")
+{
+	ShaderUniforms first;
+	first.Add("uColor", UniformType::Vector4, 0);
+	ShaderUniforms second;
+	second.Add("uDiffuse", UniformType::Texture2D, 0);
+	second.Add("uColor", UniformType::Vector4, 1);
+	
+	// The same name can have a different index in another shader.
+	REQUIRE(first.GetIndex("uColor") == 0);
+	REQUIRE(second.GetIndex("uColor") == 1);
+	
+	// Setting a value in one shader doesn't stop it being set in another.
+	GLfloat color[4] = { 0.5f, 0.5f, 0.5f, 1.0f };
+	REQUIRE(first.ChangeValue(first.GetIndex("uColor"), color, 4));
+	REQUIRE(second.ChangeValue(second.GetIndex("uColor"), color, 4));
+	REQUIRE(!first.ChangeValue(first.GetIndex("uColor"), color, 4));
+}
@@ -0,0 +1,287 @@
+//
+// SheepTests.cpp
+//
+// Clark Kromenaker
+//
+// Tests for compiling, saving, and running sheep scripts.
+//
+#include "catch.hh"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "BinaryWriter.h"
+#include "SheepAPI.h"
+#include "SheepCompiler.h"
+#include "SheepProgram.h"
+#include "SheepScript.h"
+#include "SheepScriptBuilder.h"
+#include "SheepVM.h"
+
+// Required for macros to work correctly with "string" instead of "std::string".
+using std::string;
+
+// A few system functions for test scripts to call.
+int SheepTestAdd(int a, int b)
+{
+	return a + b;
+}
+RegFunc2(SheepTestAdd, int, int, int, false, false);
+
+std::string SheepTestConcat(const std::string& a, const std::string& b)
+{
+	return a + b;
+}
+RegFunc2(SheepTestConcat, string, string, string, false, false);
+
+// Records what a script did, so separate runs can be compared.
+std::vector<std::string> sheepTestRecords;
+
+shpvoid SheepTestRecord(const std::string& value)
+{
+	sheepTestRecords.push_back(value);
+	return 0;
+}
+RegFunc1(SheepTestRecord, void, string, false, false);
+
+shpvoid SheepTestRecordInt(int value)
+{
+	sheepTestRecords.push_back(std::to_string(value));
+	return 0;
+}
+RegFunc1(SheepTestRecordInt, void, int, false, false);
+
+float SheepTestHalf(float value)
+{
+	return value * 0.5f;
+}
+RegFunc1(SheepTestHalf, float, float, false, false);
+
+namespace
+{
+	const char* kTestSheep =
+		"symbols\n"
+		"{\n"
+		"	int count$ = 3;\n"
+		"	float scale$ = 1.5;\n"
+		"	string name$ = \"Gabe\";\n"
+		"}\n"
+		"code\n"
+		"{\n"
+		"	First$()\n"
+		"	{\n"
+		"		count$ = SheepTestAdd(count$, 2);\n"
+		"		name$ = SheepTestConcat(\"Grace\", name$);\n"
+		"	}\n"
+		"	Second$()\n"
+		"	{\n"
+		"		if(count$ > 4) { name$ = SheepTestConcat(SheepTestConcat(\"a\", \"b\"), SheepTestConcat(\"c\", \"d\")); }\n"
+		"	}\n"
+		"}\n";
+}
+
+TEST_CASE("Compiled sheep survives a WriteToData round trip")
+{
+	SheepCompiler compiler;
+	SheepScript* script = compiler.Compile("RoundTrip", std::string(kTestSheep));
+	REQUIRE(script != nullptr);
+	
+	// Write out, then read back in, just like the compiled sheep cache does.
+	const char* filePath = "SheepRoundTripTest.bin";
+	{
+		BinaryWriter writer(filePath);
+		REQUIRE(writer.OK());
+		script->WriteToData(writer);
+	}
+	std::ifstream file(filePath, std::ios::in | std::ios::binary);
+	std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	file.close();
+	std::remove(filePath);
+	REQUIRE(!data.empty());
+	
+	SheepScript loaded("RoundTrip", data.data(), (int)data.size());
+	
+	// Same system function imports, in the same order (bytecode refers to them by index).
+	int importCount = 0;
+	while(script->GetSysImport(importCount) != nullptr)
+	{
+		SysImport* expected = script->GetSysImport(importCount);
+		SysImport* actual = loaded.GetSysImport(importCount);
+		REQUIRE(actual != nullptr);
+		REQUIRE(actual->name == expected->name);
+		REQUIRE(actual->returnType == expected->returnType);
+		REQUIRE(actual->argumentTypes == expected->argumentTypes);
+		++importCount;
+	}
+	REQUIRE(importCount == 2);
+	REQUIRE(loaded.GetSysImport(importCount) == nullptr);
+	
+	// String constants must keep their offsets, since bytecode refers to them by offset.
+	REQUIRE(!script->GetStringConsts().empty());
+	REQUIRE(loaded.GetStringConsts() == script->GetStringConsts());
+	
+	// Same functions, at the same bytecode offsets.
+	REQUIRE(script->GetFunctions().size() == 2);
+	REQUIRE(loaded.GetFunctions() == script->GetFunctions());
+	
+	// Same variables, with the same defaults (apart from strings, which aren't read back in).
+	std::vector<SheepValue> expectedVariables = script->GetVariables();
+	std::vector<SheepValue> actualVariables = loaded.GetVariables();
+	REQUIRE(actualVariables.size() == expectedVariables.size());
+	for(int i = 0; i < expectedVariables.size(); ++i)
+	{
+		REQUIRE(actualVariables[i].type == expectedVariables[i].type);
+		if(expectedVariables[i].type == SheepValueType::Int)
+		{
+			REQUIRE(actualVariables[i].intValue == expectedVariables[i].intValue);
+		}
+		else if(expectedVariables[i].type == SheepValueType::Float)
+		{
+			REQUIRE(actualVariables[i].floatValue == expectedVariables[i].floatValue);
+		}
+	}
+	
+	// Identical bytecode.
+	REQUIRE(loaded.GetBytecodeLength() == script->GetBytecodeLength());
+	REQUIRE(std::memcmp(loaded.GetBytecode(), script->GetBytecode(), script->GetBytecodeLength()) == 0);
+	
+	delete script;
+}
+
+namespace
+{
+	const char* kExecuteSheep =
+		"symbols\n"
+		"{\n"
+		"	int i$ = 0;\n"
+		"	float f$ = 0.5;\n"
+		"	string s$;\n"
+		"}\n"
+		"code\n"
+		"{\n"
+		"	Run$()\n"
+		"	{\n"
+		"		SheepTestRecord(\"begin\");\n"
+		"		loop$:\n"
+		"		i$ = i$ + 1;\n"
+		"		f$ = SheepTestHalf(f$ * 3.0) + 1.0;\n"
+		"		if(i$ == 2 || i$ == 4) { SheepTestRecord(SheepTestConcat(\"even\", \"-step\")); }\n"
+		"		else if(!(i$ == 3)) { SheepTestRecord(\"odd\"); }\n"
+		"		else { SheepTestRecordInt(SheepTestAdd(i$, 0 - i$ * 4)); }\n"
+		"		if(i$ < 5) { goto loop$; }\n"
+		"		SheepTestRecordInt(i$ * 10 - 3 / 2);\n"
+		"		if(f$ > 10.0) { SheepTestRecord(\"big\"); }\n"
+		"		s$ = SheepTestConcat(SheepTestConcat(\"x\", \"y\"), \"z\");\n"
+		"		SheepTestRecord(s$);\n"
+		"	}\n"
+		"}\n";
+	
+	std::vector<std::string> RunSheep(SheepScript* script, bool threaded)
+	{
+		sheepTestRecords.clear();
+		
+		SheepVM vm;
+		vm.SetThreadedCodeEnabled(threaded);
+		vm.Execute(script, "Run$", nullptr);
+		return sheepTestRecords;
+	}
+}
+
+TEST_CASE("Sheep runs the same from decoded ops as from bytecode")
+{
+	SheepCompiler compiler;
+	SheepScript* script = compiler.Compile("Execute", std::string(kExecuteSheep));
+	REQUIRE(script != nullptr);
+	
+	// String literals are pushed with "PushS" then "GetString", which decoding combines into one op.
+	SheepProgram* program = script->GetProgram();
+	REQUIRE(program != nullptr);
+	REQUIRE(program->IsValid());
+	bool combinedStringConst = false;
+	for(const SheepOp* op = program->GetOps(); op->opcode != SheepOpcode::End; ++op)
+	{
+		if(op->opcode == SheepOpcode::PushStringConst)
+		{
+			combinedStringConst = true;
+			REQUIRE(op->stringValue != nullptr);
+		}
+	}
+	REQUIRE(combinedStringConst);
+	
+	std::vector<std::string> bytecodeResults = RunSheep(script, false);
+	std::vector<std::string> threadedResults = RunSheep(script, true);
+	REQUIRE(!bytecodeResults.empty());
+	REQUIRE(threadedResults == bytecodeResults);
+	
+	// And both got the right answers.
+	std::vector<std::string> expected = {
+		"begin", "odd", "even-step", "-9", "even-step", "odd", "49", "big", "xyz"
+	};
+	REQUIRE(bytecodeResults == expected);
+	
+	delete script;
+}
+
+TEST_CASE("Sheep string results don't overwrite one another")
+{
+	// SheepTestRecord(SheepTestConcat(SheepTestConcat("a", "b"), SheepTestConcat("c", "d")))
+	// Built directly, since both inner results must be on the stack when the outer call is made.
+	SheepCompiler compiler;
+	SheepScriptBuilder builder(&compiler, "Nested");
+	Location loc;
+	builder.AddStringConst("a");
+	builder.AddStringConst("b");
+	builder.AddStringConst("c");
+	builder.AddStringConst("d");
+	builder.BeginCode();
+	builder.StartFunction("Run$");
+	for(const char* arg : { "a", "b", "c", "d" })
+	{
+		builder.PushS(arg);
+		if(arg[0] == 'b' || arg[0] == 'd')
+		{
+			builder.AddSysFuncArg(SheepValue(""), loc);
+			builder.AddSysFuncArg(SheepValue(""), loc);
+			builder.CallSysFunc("SheepTestConcat", loc);
+		}
+	}
+	builder.AddSysFuncArg(SheepValue(""), loc);
+	builder.AddSysFuncArg(SheepValue(""), loc);
+	builder.CallSysFunc("SheepTestConcat", loc);
+	builder.AddSysFuncArg(SheepValue(""), loc);
+	builder.CallSysFunc("SheepTestRecord", loc);
+	builder.EndFunction("Run$");
+	SheepScript script("Nested", builder);
+	
+	std::vector<std::string> expected = { "abcd" };
+	REQUIRE(RunSheep(&script, false) == expected);
+	REQUIRE(RunSheep(&script, true) == expected);
+}
+
+TEST_CASE("Sheep string variables keep their values after the stack moves on")
+{
+	// The variable is assigned from a sys func result, in the same stack slot that later results use.
+	SheepCompiler compiler;
+	SheepScript* script = compiler.Compile("StoreString", std::string(
+		"symbols { string s$; }\n"
+		"code\n"
+		"{\n"
+		"	Run$()\n"
+		"	{\n"
+		"		s$ = SheepTestConcat(\"ab\", \"cd\");\n"
+		"		SheepTestRecord(SheepTestConcat(\"wx\", \"yz\"));\n"
+		"		SheepTestRecord(s$);\n"
+		"		s$ = s$;\n"
+		"		SheepTestRecord(SheepTestConcat(s$, s$));\n"
+		"	}\n"
+		"}\n"));
+	REQUIRE(script != nullptr);
+	
+	std::vector<std::string> expected = { "wxyz", "abcd", "abcdabcd" };
+	REQUIRE(RunSheep(script, false) == expected);
+	REQUIRE(RunSheep(script, true) == expected);
+	delete script;
+}
@@ -0,0 +1,45 @@
+//
+// SymbolTests.cpp
+//
+// Clark Kromenaker
+//
+// Tests for Symbol class.
+//
+#include "catch.hh"
+#include "Symbol.h"
+
+#include <unordered_set>
+
+TEST_CASE("Symbols intern strings ignoring case")
+{
+	Symbol invalid;
+	REQUIRE(!invalid.IsValid());
+	REQUIRE(invalid.GetString().empty());
+	
+	Symbol first("SymbolTestNoun");
+	Symbol same("symboltestnoun");
+	Symbol other("SymbolTestVerb");
+	REQUIRE(first.IsValid());
+	REQUIRE(first == same);
+	REQUIRE(first != other);
+	REQUIRE(first.GetId() != other.GetId());
+	
+	// The string is kept as it was first interned.
+	REQUIRE(same.GetString() == "SymbolTestNoun");
+	REQUIRE(other.GetString() == "SymbolTestVerb");
+	
+	// Usable as a hash key.
+	std::unordered_set<Symbol> symbols { first, same, other };
+	REQUIRE(symbols.size() == 2);
+}
+
+TEST_CASE("Finding a symbol doesn't intern it")
+{
+	int count = Symbol::GetCount();
+	REQUIRE(!Symbol::Find("SymbolTestNotInterned").IsValid());
+	REQUIRE(Symbol::GetCount() == count);
+	
+	Symbol interned("SymbolTestNotInterned");
+	REQUIRE(Symbol::GetCount() == count + 1);
+	REQUIRE(Symbol::Find("symboltestnotinterned") == interned);
+}
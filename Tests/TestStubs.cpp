@@ -0,0 +1,80 @@
+//
+// TestStubs.cpp
+//
+// Clark Kromenaker
+//
+// Minimal stand-ins for engine systems that code under test calls into.
+// Lets things like the sheep compiler and VM be tested without the whole engine.
+//
+#include <deque>
+
+#include "FileSystem.h"
+#include "Localizer.h"
+#include "ReportManager.h"
+#include "Services.h"
+#include "SheepAPI.h"
+#include "StringUtil.h"
+#include "Submesh.h"
+
+// Reports are just dropped.
+ReportManager::ReportManager() { }
+void ReportManager::Log(const std::string&, const std::string&) { }
+static bool sReportsSet = (Services::SetReports(new ReportManager()), true);
+
+std::string Path::GetFileNameNoExtension(const std::string& path)
+{
+	size_t start = path.find_last_of("/\\");
+	std::string fileName = start == std::string::npos ? path : path.substr(start + 1);
+	return fileName.substr(0, fileName.find_last_of('.'));
+}
+
+// Only the system functions registered by tests exist.
+// Function-local, so tests in any file can register functions during static init.
+static std::deque<SysFuncDecl>& GetSysFuncs()
+{
+	static std::deque<SysFuncDecl> sysFuncs;
+	return sysFuncs;
+}
+
+void AddSysFuncDecl(const std::string& name, char retType, std::initializer_list<char> argTypes, bool waitable, bool dev, SysFuncCaller caller)
+{
+	SysFuncDecl sysFunc;
+	sysFunc.name = name;
+	sysFunc.returnType = retType;
+	sysFunc.argumentTypes = argTypes;
+	sysFunc.waitable = waitable;
+	sysFunc.devOnly = dev;
+	sysFunc.caller = caller;
+	GetSysFuncs().push_back(sysFunc);
+}
+
+SysFuncDecl* GetSysFuncDecl(const std::string& name)
+{
+	for(auto& sysFunc : GetSysFuncs())
+	{
+		if(StringUtil::EqualsIgnoreCase(sysFunc.name, name)) { return &sysFunc; }
+	}
+	return nullptr;
+}
+
+SysFuncDecl* GetSysFuncDecl(const SysImport* sysImport)
+{
+	for(auto& sysFunc : GetSysFuncs())
+	{
+		if(StringUtil::EqualsIgnoreCase(sysFunc.name, sysImport->name) && sysFunc.argumentTypes == sysImport->argumentTypes)
+		{
+			return &sysFunc;
+		}
+	}
+	return nullptr;
+}
+
+// No localization; keys are returned as is.
+TYPE_DEF_BASE(Localizer);
+std::string Localizer::GetText(const std::string& key) const
+{
+	return key;
+}
+
+// Nothing is uploaded to the GPU; samplers' results are checked before they're applied.
+void Submesh::SetPositions(float*, bool) { }
@@ -0,0 +1,53 @@
+//
+// ThreadPoolTests.cpp
+//
+// Clark Kromenaker
+//
+// Tests for ThreadPool class.
+//
+#include "catch.hh"
+#include "ThreadPool.h"
+
+#include <atomic>
+
+TEST_CASE("ThreadPool returns job results via futures")
+{
+	ThreadPool pool(4);
+	REQUIRE(pool.GetThreadCount() == 4);
+
+	std::vector<std::future<int>> futures;
+	for(int i = 0; i < 100; ++i)
+	{
+		futures.push_back(pool.Enqueue([i]() { return i * i; }));
+	}
+	for(int i = 0; i < 100; ++i)
+	{
+		REQUIRE(futures[i].get() == i * i);
+	}
+}
+
+TEST_CASE("ThreadPool WaitForIdle waits for all jobs")
+{
+	ThreadPool pool(3);
+
+	std::atomic<int> counter(0);
+	for(int i = 0; i < 500; ++i)
+	{
+		pool.Enqueue([&counter]() { ++counter; });
+	}
+	pool.WaitForIdle();
+	REQUIRE(counter == 500);
+}
+
+TEST_CASE("ThreadPool finishes queued jobs on destruction")
+{
+	std::atomic<int> counter(0);
+	{
+		ThreadPool pool(2);
+		for(int i = 0; i < 200; ++i)
+		{
+			pool.Enqueue([&counter]() { ++counter; });
+		}
+	}
+	REQUIRE(counter == 200);
+}
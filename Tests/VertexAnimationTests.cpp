@@ -0,0 +1,430 @@
+//
+// VertexAnimationTests.cpp
+//
+// Clark Kromenaker
+//
+// Tests for VertexAnimation class.
+//
+#include "catch.hh"
+
+#include <cmath>
+#include <map>
+
+#include "ThreadPool.h"
+#include "VertexAnimation.h"
+#include "VertexAnimationSampler.h"
+
+namespace
+{
+	// Builds the data of an ACT file, block by block.
+	class ActFileBuilder
+	{
+	public:
+		// How a vertex delta is stored in a compressed vertex block.
+		enum class DeltaFormat { None, Byte, UShort, Float };
+		struct Delta
+		{
+			DeltaFormat format;
+			Vector3 value;
+		};
+		
+		ActFileBuilder(int frameCount, int meshCount) : mFrameCount(frameCount), mMeshCount(meshCount) { }
+		
+		void AddVertices(int frame, int meshIndex, int submeshIndex, const std::vector<Vector3>& positions)
+		{
+			std::string block;
+			Append<uint16_t>(block, submeshIndex);
+			Append<uint16_t>(block, positions.size());
+			for(auto& position : positions)
+			{
+				AppendXZY(block, position);
+			}
+			AddBlock(frame, meshIndex, 0, block);
+		}
+		
+		void AddDeltas(int frame, int meshIndex, int submeshIndex, std::initializer_list<Delta> deltas)
+		{
+			std::string block;
+			Append<uint16_t>(block, submeshIndex);
+			Append<uint16_t>(block, deltas.size());
+			
+			// Two bits of format per vertex.
+			std::string formats((deltas.size() / 4) + 1, '\0');
+			int index = 0;
+			for(auto& delta : deltas)
+			{
+				formats[index / 4] |= static_cast<char>(static_cast<int>(delta.format) << ((index % 4) * 2));
+				++index;
+			}
+			block += formats;
+			
+			for(auto& delta : deltas)
+			{
+				float values[3] = { delta.value.x, delta.value.z, delta.value.y };
+				for(float value : values)
+				{
+					if(delta.format == DeltaFormat::Byte)
+					{
+						Append<uint8_t>(block, Compress(value, 5, 0x80));
+					}
+					else if(delta.format == DeltaFormat::UShort)
+					{
+						Append<uint16_t>(block, Compress(value, 8, 0x8000));
+					}
+					else if(delta.format == DeltaFormat::Float)
+					{
+						Append<float>(block, value);
+					}
+				}
+			}
+			AddBlock(frame, meshIndex, 1, block);
+		}
+		
+		// Identity rotation, with a scale and position.
+		void AddTransform(int frame, int meshIndex, const Vector3& position, const Vector3& scale = Vector3::One)
+		{
+			std::string block;
+			Append<float>(block, scale.x); Append<float>(block, 0.0f); Append<float>(block, 0.0f);
+			Append<float>(block, 0.0f); Append<float>(block, 0.0f); Append<float>(block, scale.z);
+			Append<float>(block, 0.0f); Append<float>(block, scale.y); Append<float>(block, 0.0f);
+			Append<float>(block, position.x); Append<float>(block, position.y); Append<float>(block, position.z);
+			AddBlock(frame, meshIndex, 2, block);
+		}
+		
+		std::vector<char> Build() const
+		{
+			// Each frame has data for every mesh, even if it's empty.
+			std::vector<std::string> frames(mFrameCount);
+			for(int frame = 0; frame < mFrameCount; ++frame)
+			{
+				for(int mesh = 0; mesh < mMeshCount; ++mesh)
+				{
+					auto it = mBlocks.find(std::make_pair(frame, mesh));
+					std::string blocks = it != mBlocks.end() ? it->second : std::string();
+					Append<uint16_t>(frames[frame], mesh);
+					Append<uint32_t>(frames[frame], blocks.size());
+					frames[frame] += blocks;
+				}
+			}
+			
+			std::string data = "HTCA";
+			Append<uint32_t>(data, 1);
+			Append<uint32_t>(data, mFrameCount);
+			Append<uint32_t>(data, mMeshCount);
+			Append<uint32_t>(data, 0);
+			std::string modelName = "TEST.MOD";
+			modelName.resize(32, '\0');
+			data += modelName;
+			
+			uint32_t offset = static_cast<uint32_t>(data.size() + mFrameCount * 4);
+			for(auto& frame : frames)
+			{
+				Append<uint32_t>(data, offset);
+				offset += frame.size();
+			}
+			for(auto& frame : frames)
+			{
+				data += frame;
+			}
+			return std::vector<char>(data.begin(), data.end());
+		}
+		
+	private:
+		int mFrameCount = 0;
+		int mMeshCount = 0;
+		
+		// Data blocks for each frame and mesh.
+		std::map<std::pair<int, int>, std::string> mBlocks;
+		
+		template<class T> static void Append(std::string& data, T value)
+		{
+			T typedValue = static_cast<T>(value);
+			data.append(reinterpret_cast<const char*>(&typedValue), sizeof(T));
+		}
+		
+		static void AppendXZY(std::string& data, const Vector3& vector)
+		{
+			Append<float>(data, vector.x);
+			Append<float>(data, vector.z);
+			Append<float>(data, vector.y);
+		}
+		
+		static unsigned int Compress(float value, int fractionBits, unsigned int signFlag)
+		{
+			unsigned int sign = value < 0.0f ? signFlag : 0;
+			return sign | static_cast<unsigned int>(std::abs(value) * (1 << fractionBits) + 0.5f);
+		}
+		
+		void AddBlock(int frame, int meshIndex, unsigned char dataId, const std::string& block)
+		{
+			std::string& blocks = mBlocks[std::make_pair(frame, meshIndex)];
+			Append<uint8_t>(blocks, dataId);
+			Append<uint32_t>(blocks, block.size());
+			blocks += block;
+		}
+	};
+	
+	VertexAnimation* CreateAnimation(const ActFileBuilder& builder)
+	{
+		std::vector<char> data = builder.Build();
+		return new VertexAnimation("TEST.ACT", data.data(), static_cast<int>(data.size()));
+	}
+	
+	void RequireApprox(const Vector3& actual, const Vector3& expected)
+	{
+		REQUIRE(actual.x == Approx(expected.x));
+		REQUIRE(actual.y == Approx(expected.y));
+		REQUIRE(actual.z == Approx(expected.z));
+	}
+}
+
+TEST_CASE("VertexAnimation parses uncompressed and compressed vertex keyframes")
+{
+	ActFileBuilder builder(6, 2);
+	builder.AddVertices(0, 0, 0, { Vector3(1.0f, 2.0f, 3.0f), Vector3(4.0f, 5.0f, 6.0f), Vector3(-1.0f, -2.0f, -3.0f) });
+	
+	// Compressed keyframes store changes from the previous keyframe, so unchanged vertices can be left out.
+	builder.AddDeltas(2, 0, 0, {
+		{ ActFileBuilder::DeltaFormat::Byte, Vector3(0.5f, -0.25f, 1.0f) },
+		{ ActFileBuilder::DeltaFormat::None, Vector3::Zero },
+		{ ActFileBuilder::DeltaFormat::UShort, Vector3(-1.5f, 2.0f, 0.00390625f) }
+	});
+	builder.AddDeltas(4, 0, 0, {
+		{ ActFileBuilder::DeltaFormat::Float, Vector3(0.1f, 0.2f, 0.3f) },
+		{ ActFileBuilder::DeltaFormat::Float, Vector3(1.0f, 1.0f, 1.0f) },
+		{ ActFileBuilder::DeltaFormat::None, Vector3::Zero }
+	});
+	VertexAnimation* animation = CreateAnimation(builder);
+	
+	REQUIRE(animation->GetFrameCount() == 6);
+	REQUIRE(animation->GetDuration(10) == Approx(0.6f));
+	REQUIRE(animation->GetModelName() == "TEST.MOD");
+	REQUIRE(animation->GetVertexCount(0, 0) == 3);
+	
+	// Sampling right on each keyframe gives its positions (stored as x/z/y in the file).
+	RequireApprox(animation->SampleVertexPosition(0.0f, 10, 0, 0, 0), Vector3(1.0f, 2.0f, 3.0f));
+	RequireApprox(animation->SampleVertexPosition(0.0f, 10, 0, 0, 1), Vector3(4.0f, 5.0f, 6.0f));
+	RequireApprox(animation->SampleVertexPosition(0.0f, 10, 0, 0, 2), Vector3(-1.0f, -2.0f, -3.0f));
+	
+	RequireApprox(animation->SampleVertexPosition(0.2f, 10, 0, 0, 0), Vector3(1.5f, 1.75f, 4.0f));
+	RequireApprox(animation->SampleVertexPosition(0.2f, 10, 0, 0, 1), Vector3(4.0f, 5.0f, 6.0f));
+	RequireApprox(animation->SampleVertexPosition(0.2f, 10, 0, 0, 2), Vector3(-2.5f, 0.0f, -2.99609375f));
+	
+	RequireApprox(animation->SampleVertexPosition(0.4f, 10, 0, 0, 0), Vector3(1.6f, 1.95f, 4.3f));
+	RequireApprox(animation->SampleVertexPosition(0.4f, 10, 0, 0, 1), Vector3(5.0f, 6.0f, 7.0f));
+	RequireApprox(animation->SampleVertexPosition(0.4f, 10, 0, 0, 2), Vector3(-2.5f, 0.0f, -2.99609375f));
+	
+	// Submeshes and vertices without data.
+	REQUIRE(animation->GetVertexCount(0, 1) == 0);
+	REQUIRE(animation->GetVertexCount(1, 0) == 0);
+	REQUIRE(animation->GetVertexCount(2, 0) == 0);
+	REQUIRE(animation->SampleVertexPosition(0.0f, 10, 0, 0, 3) == Vector3::Zero);
+	REQUIRE(animation->SampleVertexPosition(0.0f, 10, 1, 0, 0) == Vector3::Zero);
+	
+	float positions[9] = { 0 };
+	REQUIRE(!animation->SampleVertexPose(0.0f, 10, 1, 0, positions));
+	REQUIRE(!animation->SampleVertexPose(0.0f, 10, 0, 1, positions));
+	delete animation;
+}
+
+TEST_CASE("VertexAnimation interpolates between keyframes and clamps at the ends")
+{
+	ActFileBuilder builder(8, 1);
+	builder.AddVertices(0, 0, 0, { Vector3(0.0f, 0.0f, 0.0f), Vector3(1.0f, 1.0f, 1.0f) });
+	builder.AddVertices(2, 0, 0, { Vector3(2.0f, 4.0f, -2.0f), Vector3(1.0f, 1.0f, 1.0f) });
+	builder.AddVertices(4, 0, 0, { Vector3(10.0f, 0.0f, 0.0f), Vector3(-1.0f, -1.0f, -1.0f) });
+	VertexAnimation* animation = CreateAnimation(builder);
+	
+	struct Expected
+	{
+		float time;
+		Vector3 position;
+	};
+	Expected expected[] = {
+		// Before the first keyframe: clamped to it.
+		{ -0.5f, Vector3(0.0f, 0.0f, 0.0f) },
+		{ 0.0f, Vector3(0.0f, 0.0f, 0.0f) },
+		
+		// Between keyframes.
+		{ 0.05f, Vector3(0.5f, 1.0f, -0.5f) },
+		{ 0.1f, Vector3(1.0f, 2.0f, -1.0f) },
+		{ 0.2f, Vector3(2.0f, 4.0f, -2.0f) },
+		{ 0.3f, Vector3(6.0f, 2.0f, -1.0f) },
+		
+		// After the last keyframe: clamped to it, until the end of the animation.
+		{ 0.4f, Vector3(10.0f, 0.0f, 0.0f) },
+		{ 0.6f, Vector3(10.0f, 0.0f, 0.0f) },
+		{ 0.79f, Vector3(10.0f, 0.0f, 0.0f) },
+		
+		// Past the end: loops.
+		{ 0.9f, Vector3(1.0f, 2.0f, -1.0f) },
+		{ 1.75f, Vector3(1.5f, 3.0f, -1.5f) }
+	};
+	for(auto& entry : expected)
+	{
+		INFO("Time " << entry.time);
+		RequireApprox(animation->SampleVertexPosition(entry.time, 10, 0, 0, 0), entry.position);
+		
+		// Sampling the whole pose gives the same positions as sampling each vertex.
+		float positions[6] = { 0 };
+		REQUIRE(animation->SampleVertexPose(entry.time, 10, 0, 0, positions));
+		RequireApprox(Vector3(positions[0], positions[1], positions[2]), entry.position);
+		RequireApprox(Vector3(positions[3], positions[4], positions[5]), animation->SampleVertexPosition(entry.time, 10, 0, 0, 1));
+	}
+	
+	// Frame rate scales time.
+	RequireApprox(animation->SampleVertexPosition(0.05f, 20, 0, 0, 0), Vector3(1.0f, 2.0f, -1.0f));
+	delete animation;
+}
+
+TEST_CASE("VertexAnimation interpolates transform keyframes")
+{
+	ActFileBuilder builder(6, 2);
+	builder.AddTransform(0, 0, Vector3(0.0f, 0.0f, 0.0f));
+	builder.AddTransform(4, 0, Vector3(4.0f, 8.0f, -4.0f), Vector3(3.0f, 1.0f, 2.0f));
+	VertexAnimation* animation = CreateAnimation(builder);
+	
+	VertexAnimationTransformPose pose = animation->SampleTransformPose(0.0f, 10, 0);
+	REQUIRE(pose.mFrameNumber == 0);
+	RequireApprox(pose.mLocalPosition, Vector3(0.0f, 0.0f, 0.0f));
+	RequireApprox(pose.mLocalScale, Vector3(1.0f, 1.0f, 1.0f));
+	
+	pose = animation->SampleTransformPose(0.2f, 10, 0);
+	REQUIRE(pose.mFrameNumber == 0);
+	RequireApprox(pose.mLocalPosition, Vector3(2.0f, 4.0f, -2.0f));
+	RequireApprox(pose.mLocalScale, Vector3(2.0f, 1.0f, 1.5f));
+	
+	// Clamped at the last keyframe.
+	pose = animation->SampleTransformPose(0.5f, 10, 0);
+	REQUIRE(pose.mFrameNumber == 4);
+	RequireApprox(pose.mLocalPosition, Vector3(4.0f, 8.0f, -4.0f));
+	RequireApprox(pose.mLocalScale, Vector3(3.0f, 1.0f, 2.0f));
+	
+	// No transform data for these meshes.
+	REQUIRE(animation->SampleTransformPose(0.0f, 10, 1).mFrameNumber == -1);
+	REQUIRE(animation->SampleTransformPose(0.0f, 10, 2).mFrameNumber == -1);
+	REQUIRE(animation->SampleTransformPose(0.0f, 10, -1).mFrameNumber == -1);
+	delete animation;
+}
+
+TEST_CASE("VertexAnimation keys for blending on the GPU give the sampled pose")
+{
+	ActFileBuilder builder(10, 1);
+	builder.AddVertices(0, 0, 0, { Vector3(0.0f, 0.0f, 0.0f), Vector3(1.0f, 1.0f, 1.0f), Vector3(-2.0f, 4.0f, 8.0f) });
+	builder.AddVertices(3, 0, 0, { Vector3(3.0f, 0.0f, 0.0f), Vector3(1.0f, 2.0f, 1.0f), Vector3(-2.0f, 4.0f, 0.0f) });
+	builder.AddVertices(7, 0, 0, { Vector3(3.0f, 6.0f, 0.0f), Vector3(0.0f, 0.0f, 0.0f), Vector3(2.0f, 4.0f, 0.0f) });
+	VertexAnimation* animation = CreateAnimation(builder);
+	
+	// Keyframe positions are back-to-back, for uploading as one buffer.
+	const std::vector<Vector3>* positions = animation->GetKeyframePositions(0, 0);
+	REQUIRE(positions != nullptr);
+	REQUIRE(positions->size() == 9);
+	REQUIRE(animation->GetKeyframePositions(0, 1) == nullptr);
+	REQUIRE(animation->GetKeyframePositions(1, 0) == nullptr);
+	
+	// The shader blends the two keyframes at the offsets, which must match sampling on the CPU at any time.
+	for(int i = -2; i < 24; ++i)
+	{
+		float time = i * 0.05f;
+		int fromOffset = -1;
+		int toOffset = -1;
+		float t = -1.0f;
+		REQUIRE(animation->GetVertexKeys(time, 10, 0, 0, fromOffset, toOffset, t));
+		REQUIRE(fromOffset % 3 == 0);
+		REQUIRE(toOffset % 3 == 0);
+		REQUIRE(toOffset >= fromOffset);
+		REQUIRE(toOffset + 3 <= positions->size());
+		REQUIRE(t >= 0.0f);
+		REQUIRE(t <= 1.0f);
+		
+		float sampled[9];
+		REQUIRE(animation->SampleVertexPose(time, 10, 0, 0, sampled));
+		for(int v = 0; v < 3; ++v)
+		{
+			Vector3 blended = Vector3::Lerp((*positions)[fromOffset + v], (*positions)[toOffset + v], t);
+			REQUIRE(blended.x == Approx(sampled[v * 3]));
+			REQUIRE(blended.y == Approx(sampled[v * 3 + 1]));
+			REQUIRE(blended.z == Approx(sampled[v * 3 + 2]));
+		}
+	}
+	
+	int fromOffset = 0;
+	int toOffset = 0;
+	float t = 0.0f;
+	REQUIRE(!animation->GetVertexKeys(0.0f, 10, 0, 1, fromOffset, toOffset, t));
+	delete animation;
+}
+
+TEST_CASE("VertexAnimationSampler gives the same samples in parallel as serially")
+{
+	// Enough vertices that sampling is spread across threads.
+	const int kMeshCount = 2;
+	const int kSubmeshCount = 4;
+	const int kVertexCount = 1000;
+	ActFileBuilder builder(20, kMeshCount);
+	for(int mesh = 0; mesh < kMeshCount; ++mesh)
+	{
+		for(int submesh = 0; submesh < kSubmeshCount; ++submesh)
+		{
+			for(int frame = 0; frame < 20; frame += 5)
+			{
+				std::vector<Vector3> positions;
+				for(int i = 0; i < kVertexCount; ++i)
+				{
+					positions.push_back(Vector3(i * 0.5f + frame, mesh - i * 0.25f, submesh * frame - i * 0.125f));
+				}
+				builder.AddVertices(frame, mesh, submesh, positions);
+			}
+		}
+	}
+	VertexAnimation* animation = CreateAnimation(builder);
+	
+	// Submeshes are only used to identify requests until samples are applied, so stand-ins will do.
+	std::vector<char> submeshes(kMeshCount * kSubmeshCount + 1);
+	auto getSubmesh = [&submeshes](int index) { return reinterpret_cast<Submesh*>(&submeshes[index]); };
+	
+	VertexAnimationSampler serialSampler;
+	VertexAnimationSampler parallelSampler;
+	parallelSampler.CreateThreadPool(3);
+	for(VertexAnimationSampler* sampler : { &serialSampler, &parallelSampler })
+	{
+		for(int mesh = 0; mesh < kMeshCount; ++mesh)
+		{
+			for(int submesh = 0; submesh < kSubmeshCount; ++submesh)
+			{
+				int index = mesh * kSubmeshCount + submesh;
+				sampler->AddRequest(animation, index * 0.17f, 10, mesh, submesh, getSubmesh(index));
+			}
+		}
+		
+		// The animation has no data for this one.
+		sampler->AddRequest(animation, 0.0f, 10, 0, kSubmeshCount, getSubmesh(kMeshCount * kSubmeshCount));
+		sampler->Sample();
+	}
+	
+	std::vector<float> expected(kVertexCount * 3);
+	for(int mesh = 0; mesh < kMeshCount; ++mesh)
+	{
+		for(int submesh = 0; submesh < kSubmeshCount; ++submesh)
+		{
+			int index = mesh * kSubmeshCount + submesh;
+			const float* serial = serialSampler.GetSampledPositions(getSubmesh(index));
+			const float* parallel = parallelSampler.GetSampledPositions(getSubmesh(index));
+			REQUIRE(serial != nullptr);
+			REQUIRE(parallel != nullptr);
+			
+			REQUIRE(animation->SampleVertexPose(index * 0.17f, 10, mesh, submesh, expected.data()));
+			for(int i = 0; i < kVertexCount * 3; ++i)
+			{
+				REQUIRE(serial[i] == expected[i]);
+				REQUIRE(parallel[i] == expected[i]);
+			}
+		}
+	}
+	REQUIRE(serialSampler.GetSampledPositions(getSubmesh(kMeshCount * kSubmeshCount)) == nullptr);
+	REQUIRE(parallelSampler.GetSampledPositions(getSubmesh(kMeshCount * kSubmeshCount)) == nullptr);
+	
+	serialSampler.ClearRequests();
+	REQUIRE(serialSampler.GetSampledPositions(getSubmesh(0)) == nullptr);
+	delete animation;
+}